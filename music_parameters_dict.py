@@ -77,6 +77,10 @@ hydro_dict = {
     'Total_evolution_time_tau': 50.,    # the maximum allowed running evolution time (fm/c)
                                         # need to be set to some large enough number
     'Delta_Tau': 0.04,                  # time step to use in the evolution [fm/c]
+    'adaptive_time_step': 0,            # 1: Delta_Tau is the first time step only, the following ones
+                                        #    follow the KT signal speeds
+    'adaptive_CFL': 0.3,                # CFL number of the adaptive time step
+    'adaptive_delta_tau_max': 0.1,      # largest adaptive time step [fm/c]
     'Eta_grid_size': 14.0,              # spatial rapidity range
                                         # [-Eta_grid_size/2, Eta_grid_size/2 - delta_eta]
     'Grid_size_in_eta': 4,              # number of the grid points in spatial rapidity direction
@@ -91,6 +95,9 @@ hydro_dict = {
                                         # [-Y_grid_size_in_fm/2, Y_grid_size_in_fm/2]
     'Grid_size_in_y': 260,              # number of the grid points in y direction
     'Grid_size_in_x': 260,              # number of the grid points in x direction
+    'tile_size_x': 0,                   # cells per cache tile of the grid sweeps in x, y, eta
+    'tile_size_y': 0,                   # (0: chosen from the L2 cache size)
+    'tile_size_eta': 0,
 
     'EOS_to_use': 3,  # type of the equation of state
                       # 0: ideal gas
@@ -110,6 +117,12 @@ hydro_dict = {
                              # 0: energy density and rho_baryon
                              # 1: flow velocity
     'boost_invariant': 0,    # initial condition is boost invariant
+    'transverse_boundary': 0,  # boundary condition in x and y
+                               # 0: zero gradient, 1: periodic, 2: reflective
+    'precompute_flow_derivatives': 1,  # 1: flow derivatives of the whole grid before the viscous update
+                                       # 0: cell by cell, which needs less memory
+    'active_region_threshold': 0.,  # energy density (GeV/fm^3) below which tiles far from the fluid
+                                    # are frozen instead of evolved (0: every cell is evolved)
 
     #viscosity and diffusion options
     'Viscosity_Flag_Yes_1_No_0': 1,               # turn on viscosity in the evolution
@@ -163,6 +176,14 @@ freeze_out_dict = {
                                                   # (only work for freeze_out_method = 4)
     'eps_freeze_max': 0.508,                      # the maximum freeze-out energy density (GeV/fm^3)
     'eps_freeze_min': 0.100,                      # the minimum freeze-out energy density (GeV/fm^3)
+    'freeze_surface_to_file': 1,                  # 0: keep the freeze-out surface in memory for the Cooper-Frye
+                                                  #    of the same run (mode 1 on a single MPI rank only)
+    'freeze_surface_index_for_spectra': 0,        # with several freeze-out thresholds, index (from 0) of the
+                                                  # one whose surface the Cooper-Frye uses
+    'freeze_out_band_margin': 0,                  # 3+1D: search the freeze-out surface only within this many
+                                                  # cubes of the last one (0: search all cubes)
+    'freeze_out_full_sweep_every': 10,            # freeze-out steps after which all cubes are searched again
+    'freeze_surface_double_precision': 0,         # 1: binary freeze-out surface in doubles, 0: in floats
 
     'number_of_particles_to_include': 320,        # number of thermal particles to compute for particle spectra and vn
                                           # current maximum = 320
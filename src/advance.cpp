@@ -5,6 +5,7 @@
 #include "./data.h"
 #include "./cell.h"
 #include "./grid.h"
+#include "./grid_tiles.h"
 #include "./reconst.h"
 #include "./eos.h"
 #include "./evolve.h"
@@ -13,9 +14,9 @@
 using namespace std;
 
 Advance::Advance(const EOS &eosIn, const InitData &DATA_in,
-                 hydro_source &hydro_source_in) :
+                 hydro_source &hydro_source_in, const Domain &domain_in) :
     DATA(DATA_in), eos(eosIn),
-    hydro_source_terms(hydro_source_in),
+    hydro_source_terms(hydro_source_in), domain(domain_in),
     diss_helper(eosIn, DATA_in),
     minmod(DATA_in),
     reconst_helper(eos, DATA_in) {
@@ -24,54 +25,141 @@ Advance::Advance(const EOS &eosIn, const InitData &DATA_in,
     } else {
         flag_add_hydro_source = false;
     }
+    if (DATA_in.transverse_boundary == 1) {
+        transverse_boundary = GridBoundary::periodic;
+    } else if (DATA_in.transverse_boundary == 2) {
+        transverse_boundary = GridBoundary::reflective;
+    } else {
+        transverse_boundary = GridBoundary::zero_gradient;
+    }
+    stage_kernel = select_stage_kernel<>(
+                DATA_in.viscosity_flag == 1, DATA_in.turn_on_shear == 1,
+                DATA_in.turn_on_bulk == 1, DATA_in.turn_on_diff == 1,
+                DATA_in.turn_on_rhob == 1, flag_add_hydro_source,
+                DATA_in.boost_invariant);
+}
+
+
+//! picks the AdvanceIt_stage instantiation for the given physics switches,
+//! one flag at a time
+template<bool... Set, class... Rest>
+Advance::StageKernel Advance::select_stage_kernel(bool flag, Rest... rest) {
+    return(flag ? select_stage_kernel<Set..., true>(rest...)
+                : select_stage_kernel<Set..., false>(rest...));
 }
 
+template<bool... Set>
+Advance::StageKernel Advance::select_stage_kernel() {
+    return(&Advance::AdvanceIt_stage<PhysicsConfig<Set...>>);
+}
+
+
 //! this function evolves one Runge-Kutta step in tau
+//! only the cells of the active tiles are evolved, the others are copied
 void Advance::AdvanceIt(double tau, SCGrid &arena_prev, SCGrid &arena_current,
-                       SCGrid &arena_future, int rk_flag) {
-  const int grid_neta = arena_current.nEta();
-  const int grid_nx   = arena_current.nX();
-  const int grid_ny   = arena_current.nY();
-
-    #pragma omp parallel for collapse(3) schedule(guided)
-    for (int ieta = 0; ieta < grid_neta; ieta++)
-    for (int ix   = 0; ix   < grid_nx;   ix++  )
-    for (int iy   = 0; iy   < grid_ny;   iy++  ) {
-        double eta_s_local = - DATA.eta_size/2. + ieta*DATA.delta_eta;
+                       SCGrid &arena_future, int rk_flag,
+                       const ActiveTiles &active_tiles) {
+    (this->*stage_kernel)(tau, arena_prev, arena_current, arena_future,
+                          rk_flag, active_tiles);
+}
+
+
+template<class Config>
+void Advance::AdvanceIt_stage(double tau, SCGrid &arena_prev,
+                              SCGrid &arena_current, SCGrid &arena_future,
+                              int rk_flag, const ActiveTiles &active_tiles) {
+    // all stencils below read the neighbours of arena_current; at a cut
+    // between two ranks they come from the neighbouring rank, which is
+    // in flight while the EOS of the interior is looked up
+    arena_current.update_halo(transverse_boundary, transverse_boundary,
+                              GridBoundary::zero_gradient);
+    domain.start_halo_exchange(arena_current);
+
+    // the EOS is looked up once per cell and stage; the ghost cells copy
+    // their source cell, so the thermo halo follows the arena halo
+    MakeThermoGrid(arena_current, thermo_current, active_tiles);
+    if (rk_flag > 0 || Config::viscous) {
+        MakeThermoGrid(arena_prev, thermo_prev, active_tiles);
+    }
+    domain.finish_halo_exchange();
+    thermo_current.update_halo(transverse_boundary, transverse_boundary,
+                               GridBoundary::zero_gradient);
+    MakeThermoHalo(arena_current, thermo_current);
+
+    // ideal fluxes are computed once per face before the cell update
+    const double signal_rate = MakeFaceFluxes(tau + rk_flag*DATA.delta_tau,
+                                              arena_current, active_tiles,
+                                              Config::n_directions);
+    max_signal_rate = (rk_flag == 0 ? signal_rate
+                                    : std::max(max_signal_rate, signal_rate));
+    if (Config::viscous && DATA.adaptive_time_step == 1) {
+        const double relaxation_time = MinRelaxationTime(active_tiles);
+        min_relaxation_time = (
+            rk_flag == 0 ? relaxation_time
+                         : std::min(min_relaxation_time, relaxation_time));
+    }
+
+    const bool precomputed_derivatives = (
+            Config::viscous && DATA.precompute_flow_derivatives == 1);
+    if (precomputed_derivatives) {
+        MakeDerivativeGrid(tau, arena_prev, arena_current, active_tiles,
+                           Config::n_directions);
+    }
+
+    const GridTiles &tiles = active_tiles.get_tiles();
+    #pragma omp parallel for schedule(dynamic)
+    for (int itile = 0; itile < tiles.size(); itile++) {
+      if (!active_tiles.tile_active(itile)) {
+        tiles.for_each_cell_in_tile(itile, [&](int ix, int iy, int ieta) {
+            arena_future(ix, iy, ieta) = arena_current(ix, iy, ieta);
+        });
+        continue;
+      }
+      tiles.for_each_cell_in_tile(itile, [&](int ix, int iy, int ieta) {
+        double eta_s_local = (- DATA.eta_size/2.
+                              + (domain.eta_begin() + ieta)*DATA.delta_eta);
         double x_local     = - DATA.x_size  /2. +   ix*DATA.delta_x;
         double y_local     = - DATA.y_size  /2. +   iy*DATA.delta_y;
 
-        FirstRKStepT(tau, x_local, y_local, eta_s_local,
-                     arena_current, arena_future, arena_prev,
+        // the neighbourhood of the cell is read once for all the
+        // dissipative flux and gradient terms below
+        CellStencil stencil;
+        if (Config::viscous || Config::shear || Config::bulk || Config::diff) {
+            stencil.gather(arena_current, ix, iy, ieta, Config::n_directions);
+        }
+        if (Config::viscous && !precomputed_derivatives) {
+            stencil.gather_thermo(thermo_current, ix, iy, ieta,
+                                  Config::n_directions);
+        }
+
+        FirstRKStepT<Config>(tau, x_local, y_local, eta_s_local,
+                     arena_current, arena_future, arena_prev, stencil,
                      ix, iy, ieta, rk_flag);
 
-        if (DATA.viscosity_flag == 1) {
-            U_derivative u_derivative_helper(DATA, eos);
-            u_derivative_helper.MakedU(tau, arena_prev, arena_current,
-                                       ix, iy, ieta);
-            double theta_local = u_derivative_helper.calculate_expansion_rate(
-                                            tau, arena_current, ieta, ix, iy);
-            DumuVec a_local;
-            u_derivative_helper.calculate_Du_supmu(tau, arena_current,
-                                                   ieta, ix, iy, a_local);
-            VelocityShearVec sigma_local;
-            u_derivative_helper.calculate_velocity_shear_tensor(
-                        tau, arena_current, ieta, ix, iy, a_local, sigma_local);
-
-            DmuMuBoverTVec baryon_diffusion_vector;
-            u_derivative_helper.get_DmuMuBoverTVec(baryon_diffusion_vector);
-
-            FirstRKStepW(tau,  arena_prev, arena_current, arena_future, rk_flag,
-                         theta_local, a_local, sigma_local,
-                         baryon_diffusion_vector, ieta, ix, iy);
+        if (Config::viscous) {
+            DerivativeCell du;
+            if (precomputed_derivatives) {
+                du = derivatives(ix, iy, ieta);
+            } else {
+                U_derivative u_derivative_helper(DATA, eos);
+                u_derivative_helper.calculate_derivatives(
+                        tau, stencil, arena_prev(ix, iy, ieta),
+                        thermo_prev(ix, iy, ieta), du);
+            }
+            FirstRKStepW<Config>(tau, arena_prev, arena_current, arena_future,
+                                 stencil, rk_flag, du.theta, du.a, du.sigma,
+                                 du.DmuBoverT, ieta, ix, iy);
         }
+      });
     }
 }
 
 
 /* %%%%%%%%%%%%%%%%%%%%%% First steps begins here %%%%%%%%%%%%%%%%%% */
+template<class Config>
 void Advance::FirstRKStepT(const double tau, double x_local, double y_local,
-        double eta_s_local, SCGrid &arena_current, SCGrid &arena_future, SCGrid &arena_prev, int ix, int iy, int ieta, int rk_flag) {
+        double eta_s_local, SCGrid &arena_current, SCGrid &arena_future, SCGrid &arena_prev,
+        const CellStencil &stencil, int ix, int iy, int ieta, int rk_flag) {
   // this advances the ideal part
   double tau_rk = tau + rk_flag*(DATA.delta_tau);
   
@@ -85,12 +173,13 @@ void Advance::FirstRKStepT(const double tau, double x_local, double y_local,
   // It is the spatial derivative part of partial_a T^{a mu}
   // (including geometric terms)
   TJbVec qi = {0};
-  MakeDeltaQI(tau_rk, arena_current, ix, iy, ieta, qi, rk_flag);
+  MakeDeltaQI(tau_rk, arena_current, ix, iy, ieta, qi, rk_flag,
+              Config::n_directions);
   
   EnergyFlowVec j_mu = {0};
   
   double rhob_source = 0.0;
-  if (flag_add_hydro_source) {
+  if (Config::source) {
     FlowVec u_local = arena_current(ix,iy,ieta).u;
 
     hydro_source_terms.get_hydro_energy_source(
@@ -98,7 +187,7 @@ void Advance::FirstRKStepT(const double tau, double x_local, double y_local,
     for (int ii = 0; ii < 4; ii++) {
       j_mu[ii] *= tau_rk;
     }
-    if (DATA.turn_on_rhob == 1) {
+    if (Config::rhob) {
       rhob_source = tau_rk*hydro_source_terms.get_hydro_rhob_source(
                    tau_rk, x_local, y_local, eta_s_local, u_local);
     }
@@ -106,13 +195,17 @@ void Advance::FirstRKStepT(const double tau, double x_local, double y_local,
 
   for (int alpha = 0; alpha < 5; alpha++) {
     // now MakeWSource returns partial_a W^{a mu}
-    // (including geometric terms)
-    double dwmn = diss_helper.MakeWSource(
-                tau_rk, alpha, arena_current, arena_prev, ix, iy, ieta);
-    /* dwmn is the only one with the minus sign */
-    qi[alpha] -= dwmn*(DATA.delta_tau);
+    // (including geometric terms); it vanishes if the stresses that
+    // enter row alpha are switched off
+    if ((alpha < 4 && (Config::shear || Config::bulk))
+        || (alpha == 4 && Config::diff)) {
+      double dwmn = diss_helper.MakeWSource(
+                  tau_rk, alpha, stencil, arena_prev(ix, iy, ieta));
+      /* dwmn is the only one with the minus sign */
+      qi[alpha] -= dwmn*(DATA.delta_tau);
+    }
 
-    if (flag_add_hydro_source) {
+    if (Config::source) {
       // adding hydro_source terms
       if (alpha < 4) {
         qi[alpha] += j_mu[alpha]*DATA.delta_tau;
@@ -124,7 +217,7 @@ void Advance::FirstRKStepT(const double tau, double x_local, double y_local,
     // non-zero remove/modify if rho_b!=0
     // - this is only to remove the viscous correction that
     // can make rho_b negative which we do not want.
-    if (DATA.turn_on_rhob == 0) {
+    if (!Config::rhob) {
       if (alpha == 4 && fabs(qi[alpha]) > 1e-12)
         qi[alpha] = 0.;
     }
@@ -132,26 +225,30 @@ void Advance::FirstRKStepT(const double tau, double x_local, double y_local,
     /* if rk_flag > 0, we now have q0 + k1 + k2. 
      * So add q0 and multiply by 1/2 */
     if (rk_flag > 0) {
-      qi[alpha] += get_TJb(arena_prev(ix,iy,ieta), alpha, 0)*tau;
+      qi[alpha] += get_TJb(arena_prev(ix,iy,ieta),
+                           thermo_prev(ix,iy,ieta).p, alpha, 0)*tau;
       qi[alpha] *= 0.5;
     }
   }
   
   double tau_next = tau + DATA.delta_tau;
-  auto grid_rk_t = reconst_helper.ReconstIt_shell(tau_next, qi,
-                                                  arena_current(ix, iy, ieta)); 
+  auto grid_rk_t = reconst_helper.ReconstIt_shell(
+                tau_next, qi, primitive_variables(arena_current(ix, iy, ieta)));
   UpdateTJbRK(grid_rk_t, arena_future(ix, iy, ieta));
 }
 
 
+template<class Config>
 void Advance::FirstRKStepW(
     double tau, SCGrid &arena_prev, SCGrid &arena_current, SCGrid &arena_future,
-    int rk_flag, double theta_local, DumuVec &a_local,
+    const CellStencil &stencil, int rk_flag, double theta_local, DumuVec &a_local,
     VelocityShearVec &sigma_local, DmuMuBoverTVec &baryon_diffusion_vector,
     int ieta, int ix, int iy) {
-    auto grid_pt_prev = &(arena_prev(ix, iy, ieta));
-    auto grid_pt_c = &(arena_current(ix, iy, ieta));
-    auto grid_pt_f = &(arena_future(ix, iy, ieta));
+    SCGrid::const_reference grid_pt_prev = arena_prev(ix, iy, ieta);
+    SCGrid::const_reference grid_pt_c    = arena_current(ix, iy, ieta);
+    SCGrid::reference       grid_pt_f    = arena_future(ix, iy, ieta);
+    auto thermo_c    = &(thermo_current(ix, iy, ieta));
+    auto thermo_p    = &(thermo_prev(ix, iy, ieta));
 
     const double tau_now  = tau;
     const double tau_next = tau + (DATA.delta_tau);
@@ -171,15 +268,15 @@ void Advance::FirstRKStepW(
         for (int mu = 1; mu < 4; mu++) {
             for (int nu = mu; nu < 4; nu++) {
                 int idx_1d = map_2d_idx_to_1d(mu, nu);
-                diss_helper.Make_uWRHS(tau_now, arena_current, ix, iy, ieta,
+                diss_helper.Make_uWRHS(tau_now, stencil,
                                        mu, nu, w_rhs, theta_local, a_local);
-                tempf = ((grid_pt_c->Wmunu[idx_1d])*(grid_pt_c->u[0]));
+                tempf = ((grid_pt_c.Wmunu[idx_1d])*(grid_pt_c.u[0]));
                 temps = diss_helper.Make_uWSource(
-                        tau_now, grid_pt_c, grid_pt_prev, mu, nu, rk_flag,
-                        theta_local, a_local, sigma_local);
+                        tau_now, grid_pt_c, grid_pt_prev, thermo_c, thermo_p,
+                        mu, nu, rk_flag, theta_local, a_local, sigma_local);
                 tempf += temps*(DATA.delta_tau);
                 tempf += w_rhs;
-                grid_pt_f->Wmunu[idx_1d] = tempf/(grid_pt_f->u[0]);
+                grid_pt_f.Wmunu[idx_1d] = tempf/(grid_pt_f.u[0]);
             }
         }
     } else {
@@ -187,144 +284,148 @@ void Advance::FirstRKStepW(
             for (int nu = mu; nu < 4; nu++) {
                 int idx_1d = map_2d_idx_to_1d(mu, nu);
                 diss_helper.Make_uWRHS(
-                        tau_next, arena_current, ix, iy, ieta, mu, nu,
+                        tau_next, stencil, mu, nu,
                         w_rhs, theta_local, a_local);
-                tempf = (grid_pt_prev->Wmunu[idx_1d])*(grid_pt_prev->u[0]);
+                tempf = (grid_pt_prev.Wmunu[idx_1d])*(grid_pt_prev.u[0]);
                 temps = diss_helper.Make_uWSource(tau_next, grid_pt_c, grid_pt_prev,
+                                            thermo_c, thermo_p,
                                             mu, nu, rk_flag, theta_local,
                                             a_local, sigma_local);
                 tempf += temps*(DATA.delta_tau);
                 tempf += w_rhs;
-                tempf += ((grid_pt_c->Wmunu[idx_1d])*(grid_pt_c->u[0]));
+                tempf += ((grid_pt_c.Wmunu[idx_1d])*(grid_pt_c.u[0]));
                 tempf *= 0.5;
-                grid_pt_f->Wmunu[idx_1d] = tempf/(grid_pt_f->u[0]);
+                grid_pt_f.Wmunu[idx_1d] = tempf/(grid_pt_f.u[0]);
             }
         }
     }
 
-    if (DATA.turn_on_bulk == 1) {
+    if (Config::bulk) {
         /* calculate delta u pi */
         double p_rhs;
         if (rk_flag == 0) {
             /* calculate delta u^0 pi */
-            diss_helper.Make_uPRHS(tau_now, arena_current, ix, iy, ieta,
+            diss_helper.Make_uPRHS(tau_now, stencil,
                                    &p_rhs, theta_local);
-            tempf = (grid_pt_c->pi_b)*(grid_pt_c->u[0]);
+            tempf = (grid_pt_c.pi_b)*(grid_pt_c.u[0]);
             temps = diss_helper.Make_uPiSource(
-                    tau_now, grid_pt_c, grid_pt_prev, rk_flag,
-                    theta_local, sigma_local);
+                    tau_now, grid_pt_c, grid_pt_prev, thermo_c, thermo_p,
+                    rk_flag, theta_local, sigma_local);
             tempf += temps*(DATA.delta_tau);
             tempf += p_rhs;
-            grid_pt_f->pi_b = tempf/(grid_pt_f->u[0]);
+            grid_pt_f.pi_b = tempf/(grid_pt_f.u[0]);
         } else {
             /* calculate delta u^0 pi */
-            diss_helper.Make_uPRHS(tau_next, arena_current, ix, iy, ieta,
+            diss_helper.Make_uPRHS(tau_next, stencil,
                                    &p_rhs, theta_local);
-            tempf = (grid_pt_prev->pi_b)*(grid_pt_prev->u[0]);
+            tempf = (grid_pt_prev.pi_b)*(grid_pt_prev.u[0]);
             temps = diss_helper.Make_uPiSource(
-                    tau_next, grid_pt_c, grid_pt_prev, rk_flag,
-                    theta_local, sigma_local);
+                    tau_next, grid_pt_c, grid_pt_prev, thermo_c, thermo_p,
+                    rk_flag, theta_local, sigma_local);
             tempf += temps*(DATA.delta_tau);
             tempf += p_rhs;
-            tempf += (grid_pt_c->pi_b)*(grid_pt_c->u[0]);
+            tempf += (grid_pt_c.pi_b)*(grid_pt_c.u[0]);
             tempf *= 0.5;
-            grid_pt_f->pi_b = tempf/(grid_pt_f->u[0]);
+            grid_pt_f.pi_b = tempf/(grid_pt_f.u[0]);
         }
     } else {
-        grid_pt_f->pi_b = 0.0;
+        grid_pt_f.pi_b = 0.0;
     }
 
     // CShen: add source term for baryon diffusion
-    if (DATA.turn_on_diff == 1) {
+    if (Config::diff) {
         int mu = 4;
         if (rk_flag == 0) {
             for (int nu = 1; nu < 4; nu++) {
                 int idx_1d = map_2d_idx_to_1d(mu, nu);
                 w_rhs = diss_helper.Make_uqRHS(
-                                tau_now, arena_current, ix, iy, ieta, mu, nu);
-                tempf = ((grid_pt_c->Wmunu[idx_1d])*(grid_pt_c->u[0]));
+                                tau_now, stencil, mu, nu);
+                tempf = ((grid_pt_c.Wmunu[idx_1d])*(grid_pt_c.u[0]));
                 temps = diss_helper.Make_uqSource(
-                                tau_now, grid_pt_c, grid_pt_prev, nu, rk_flag,
+                                tau_now, grid_pt_c, grid_pt_prev,
+                                thermo_c, thermo_p, nu, rk_flag,
                                 theta_local, a_local, sigma_local,
                                 baryon_diffusion_vector);
                 tempf += temps*(DATA.delta_tau);
                 tempf += w_rhs;
 
-                grid_pt_f->Wmunu[idx_1d] = tempf/grid_pt_f->u[0];
+                grid_pt_f.Wmunu[idx_1d] = tempf/grid_pt_f.u[0];
             }
         } else {
             for (int nu = 1; nu < 4; nu++) {
                 int idx_1d = map_2d_idx_to_1d(mu, nu);
                 w_rhs = diss_helper.Make_uqRHS(
-                            tau_next, arena_current, ix, iy, ieta, mu, nu);
-                tempf = (grid_pt_prev->Wmunu[idx_1d])*(grid_pt_prev->u[0]);
+                            tau_next, stencil, mu, nu);
+                tempf = (grid_pt_prev.Wmunu[idx_1d])*(grid_pt_prev.u[0]);
                 temps = diss_helper.Make_uqSource(
-                            tau_next, grid_pt_c, grid_pt_prev, nu, rk_flag,
+                            tau_next, grid_pt_c, grid_pt_prev,
+                            thermo_c, thermo_p, nu, rk_flag,
                             theta_local, a_local, sigma_local,
                             baryon_diffusion_vector);
                 tempf += temps*(DATA.delta_tau);
                 tempf += w_rhs;
 
-                tempf += grid_pt_c->Wmunu[idx_1d]*grid_pt_c->u[0];
+                tempf += grid_pt_c.Wmunu[idx_1d]*grid_pt_c.u[0];
                 tempf *= 0.5;
 
-                grid_pt_f->Wmunu[idx_1d] = tempf/(grid_pt_f->u[0]);
+                grid_pt_f.Wmunu[idx_1d] = tempf/(grid_pt_f.u[0]);
             }
         }
     } else {
         for (int nu = 0; nu < 4; nu++) {
             int idx_1d = map_2d_idx_to_1d(4, nu);
-            grid_pt_f->Wmunu[idx_1d] = 0.0;
+            grid_pt_f.Wmunu[idx_1d] = 0.0;
         }
     }
 
     // re-make Wmunu[3][3] so that Wmunu[mu][nu] is traceless
-    grid_pt_f->Wmunu[9] = (
-        (2.*(  grid_pt_f->u[1]*grid_pt_f->u[2]*grid_pt_f->Wmunu[5]
-             + grid_pt_f->u[1]*grid_pt_f->u[3]*grid_pt_f->Wmunu[6]
-             + grid_pt_f->u[2]*grid_pt_f->u[3]*grid_pt_f->Wmunu[8])
-         - (grid_pt_f->u[0]*grid_pt_f->u[0] - grid_pt_f->u[1]*grid_pt_f->u[1])
-           *grid_pt_f->Wmunu[4]
-         - (grid_pt_f->u[0]*grid_pt_f->u[0] - grid_pt_f->u[2]*grid_pt_f->u[2])
-           *grid_pt_f->Wmunu[7])
-        /(grid_pt_f->u[0]*grid_pt_f->u[0] - grid_pt_f->u[3]*grid_pt_f->u[3]));
+    grid_pt_f.Wmunu[9] = (
+        (2.*(  grid_pt_f.u[1]*grid_pt_f.u[2]*grid_pt_f.Wmunu[5]
+             + grid_pt_f.u[1]*grid_pt_f.u[3]*grid_pt_f.Wmunu[6]
+             + grid_pt_f.u[2]*grid_pt_f.u[3]*grid_pt_f.Wmunu[8])
+         - (grid_pt_f.u[0]*grid_pt_f.u[0] - grid_pt_f.u[1]*grid_pt_f.u[1])
+           *grid_pt_f.Wmunu[4]
+         - (grid_pt_f.u[0]*grid_pt_f.u[0] - grid_pt_f.u[2]*grid_pt_f.u[2])
+           *grid_pt_f.Wmunu[7])
+        /(grid_pt_f.u[0]*grid_pt_f.u[0] - grid_pt_f.u[3]*grid_pt_f.u[3]));
 
     // make Wmunu[i][0] using the transversality
     for (int mu = 1; mu < 4; mu++) {
         tempf = 0.0;
         for (int nu = 1; nu < 4; nu++) {
             int idx_1d = map_2d_idx_to_1d(mu, nu);
-            tempf += grid_pt_f->Wmunu[idx_1d]*grid_pt_f->u[nu];
+            tempf += grid_pt_f.Wmunu[idx_1d]*grid_pt_f.u[nu];
         }
-        grid_pt_f->Wmunu[mu] = tempf/(grid_pt_f->u[0]);
+        grid_pt_f.Wmunu[mu] = tempf/(grid_pt_f.u[0]);
     }
 
     // make Wmunu[0][0]
     tempf = 0.0;
     for (int nu = 1; nu < 4; nu++)
-        tempf += grid_pt_f->Wmunu[nu]*grid_pt_f->u[nu];
-    grid_pt_f->Wmunu[0] = tempf/(grid_pt_f->u[0]);
+        tempf += grid_pt_f.Wmunu[nu]*grid_pt_f.u[nu];
+    grid_pt_f.Wmunu[0] = tempf/(grid_pt_f.u[0]);
 
     // make qmu[0] using transversality
     tempf = 0.0;
     for (int nu = 1; nu < 4; nu++) {
         int idx_1d = map_2d_idx_to_1d(4, nu);
-        tempf += grid_pt_f->Wmunu[idx_1d]*grid_pt_f->u[nu];
+        tempf += grid_pt_f.Wmunu[idx_1d]*grid_pt_f.u[nu];
     }
-    grid_pt_f->Wmunu[10] = DATA.turn_on_diff*tempf/(grid_pt_f->u[0]);
+    grid_pt_f.Wmunu[10] = Config::diff ? tempf/(grid_pt_f.u[0]) : 0.0;
 
     // If the energy density of the fluid element is smaller than 0.01GeV
     // reduce Wmunu using the QuestRevert algorithm
     if (DATA.Initial_profile != 0 && DATA.Initial_profile != 1) {
         QuestRevert(tau, grid_pt_f, ieta, ix, iy);
-        if (DATA.turn_on_diff == 1) {
+        if (Config::diff) {
             QuestRevert_qmu(tau, grid_pt_f, ieta, ix, iy);
         }
     }
 }
 
 // update results after RK evolution to grid_pt
-void Advance::UpdateTJbRK(const ReconstCell &grid_rk, Cell_small &grid_pt) {
+void Advance::UpdateTJbRK(const ReconstCell &grid_rk,
+                          SCGrid::reference grid_pt) {
     grid_pt.epsilon = grid_rk.e;
     grid_pt.rhob    = grid_rk.rhob;
     grid_pt.u       = grid_rk.u;
@@ -333,35 +434,35 @@ void Advance::UpdateTJbRK(const ReconstCell &grid_rk, Cell_small &grid_pt) {
 
 //! this function reduce the size of shear stress tensor and bulk pressure
 //! in the dilute region to stablize numerical simulations
-void Advance::QuestRevert(double tau, Cell_small *grid_pt,
+void Advance::QuestRevert(double tau, SCGrid::reference grid_pt,
                           int ieta, int ix, int iy) {
     double eps_scale = 0.5;   // 1/fm^4
-    double e_local   = grid_pt->epsilon;
-    double rhob      = grid_pt->rhob;
+    double e_local   = grid_pt.epsilon;
+    double rhob      = grid_pt.rhob;
 
     // regulation factor in the default MUSIC
-    // double factor = 300.*tanh(grid_pt->epsilon/eps_scale);
+    // double factor = 300.*tanh(grid_pt.epsilon/eps_scale);
     double xi = 0.05;
     double factor = 100.*(1./(exp(-(e_local - eps_scale)/xi) + 1.)
         - 1./(exp(eps_scale/xi) + 1.));
     double factor_bulk = factor;
 
-    double pi_00 = grid_pt->Wmunu[0];
-    double pi_01 = grid_pt->Wmunu[1];
-    double pi_02 = grid_pt->Wmunu[2];
-    double pi_03 = grid_pt->Wmunu[3];
-    double pi_11 = grid_pt->Wmunu[4];
-    double pi_12 = grid_pt->Wmunu[5];
-    double pi_13 = grid_pt->Wmunu[6];
-    double pi_22 = grid_pt->Wmunu[7];
-    double pi_23 = grid_pt->Wmunu[8];
-    double pi_33 = grid_pt->Wmunu[9];
+    double pi_00 = grid_pt.Wmunu[0];
+    double pi_01 = grid_pt.Wmunu[1];
+    double pi_02 = grid_pt.Wmunu[2];
+    double pi_03 = grid_pt.Wmunu[3];
+    double pi_11 = grid_pt.Wmunu[4];
+    double pi_12 = grid_pt.Wmunu[5];
+    double pi_13 = grid_pt.Wmunu[6];
+    double pi_22 = grid_pt.Wmunu[7];
+    double pi_23 = grid_pt.Wmunu[8];
+    double pi_33 = grid_pt.Wmunu[9];
 
     double pisize = (pi_00*pi_00 + pi_11*pi_11 + pi_22*pi_22 + pi_33*pi_33
          - 2.*(pi_01*pi_01 + pi_02*pi_02 + pi_03*pi_03)
          + 2.*(pi_12*pi_12 + pi_13*pi_13 + pi_23*pi_23));
 
-    double pi_local = grid_pt->pi_b;
+    double pi_local = grid_pt.pi_b;
     double bulksize = 3.*pi_local*pi_local;
 
     double p_local = eos.get_pressure(e_local, rhob);
@@ -383,7 +484,7 @@ void Advance::QuestRevert(double tau, Cell_small *grid_pt,
             music_message.flush("warning");
         }
         for (int mu = 0; mu < 10; mu++) {
-            grid_pt->Wmunu[mu] = (rho_shear_max/rho_shear)*grid_pt->Wmunu[mu];
+            grid_pt.Wmunu[mu] = (rho_shear_max/rho_shear)*grid_pt.Wmunu[mu];
         }
     }
 
@@ -398,25 +499,25 @@ void Advance::QuestRevert(double tau, Cell_small *grid_pt,
                           << rho_bulk;
             music_message.flush("warning");
         }
-        grid_pt->pi_b = (rho_bulk_max/rho_bulk)*grid_pt->pi_b;
+        grid_pt.pi_b = (rho_bulk_max/rho_bulk)*grid_pt.pi_b;
     }
 }
 
 
 //! this function reduce the size of net baryon diffusion current
 //! in the dilute region to stablize numerical simulations
-void Advance::QuestRevert_qmu(double tau, Cell_small *grid_pt,
+void Advance::QuestRevert_qmu(double tau, SCGrid::reference grid_pt,
                               int ieta, int ix, int iy) {
     double eps_scale = 0.5;   // in 1/fm^4
 
     double xi = 0.05;
-    double factor = 100.*(1./(exp(-(grid_pt->epsilon - eps_scale)/xi) + 1.)
+    double factor = 100.*(1./(exp(-(grid_pt.epsilon - eps_scale)/xi) + 1.)
                           - 1./(exp(eps_scale/xi) + 1.));
 
     double q_mu_local[4];
     for (int i = 0; i < 4; i++) {
         // copy the value from the grid
-        q_mu_local[i] = grid_pt->Wmunu[10+i];
+        q_mu_local[i] = grid_pt.Wmunu[10+i];
     }
 
     // calculate the size of q^\mu
@@ -436,13 +537,13 @@ void Advance::QuestRevert_qmu(double tau, Cell_small *grid_pt,
         music_message.flush("warning");
         for (int i = 0; i < 4; i++) {
             int idx_1d = map_2d_idx_to_1d(4, i);
-            grid_pt->Wmunu[idx_1d] = 0.0;
+            grid_pt.Wmunu[idx_1d] = 0.0;
         }
     }
 
     // reduce the size of q^mu according to rhoB
-    double e_local = grid_pt->epsilon;
-    double rhob_local = grid_pt->rhob;
+    double e_local = grid_pt.epsilon;
+    double rhob_local = grid_pt.rhob;
     double rho_q = sqrt(q_size/(rhob_local*rhob_local))/factor;
     double rho_q_max = 0.1;
     if (rho_q > rho_q_max) {
@@ -456,7 +557,91 @@ void Advance::QuestRevert_qmu(double tau, Cell_small *grid_pt,
             music_message.flush("warning");
         }
         for (int i = 0; i < 4; i++) {
-            grid_pt->Wmunu[10+i] = (rho_q_max/rho_q)*q_mu_local[i];
+            grid_pt.Wmunu[10+i] = (rho_q_max/rho_q)*q_mu_local[i];
+        }
+    }
+}
+
+
+//! evaluates the EOS for every interior cell of arena in the needed tiles
+void Advance::MakeThermoGrid(const SCGrid &arena, ThermoGrid &thermo,
+                             const ActiveTiles &active_tiles) {
+    const int nx   = arena.nX();
+    const int ny   = arena.nY();
+    const int neta = arena.nEta();
+    if (thermo.nX() != nx || thermo.nY() != ny || thermo.nEta() != neta) {
+        thermo = ThermoGrid(nx, ny, neta);
+    }
+
+    const GridTiles &tiles = active_tiles.get_tiles();
+    #pragma omp parallel for schedule(dynamic)
+    for (int itile = 0; itile < tiles.size(); itile++) {
+        if (!active_tiles.tile_needed(itile)) continue;
+        tiles.for_each_cell_in_tile(itile, [&](int ix, int iy, int ieta) {
+            const auto &c = arena(ix, iy, ieta);
+            thermo(ix, iy, ieta) = eos.get_thermo(c.epsilon, c.rhob);
+        });
+    }
+}
+
+
+//! evaluates the EOS for the ghost slices of arena at the cuts to the
+//! neighbouring ranks, which hold cells of the neighbours
+void Advance::MakeThermoHalo(const SCGrid &arena, ThermoGrid &thermo) {
+    const int NG   = SCGrid::NG;
+    const int nx   = arena.nX();
+    const int ny   = arena.nY();
+    const int neta = arena.nEta();
+    std::vector<int> ghost_slices;
+    for (int i = 1; i <= NG; i++) {
+        if (domain.has_lower_neighbour()) ghost_slices.push_back(-i);
+        if (domain.has_upper_neighbour()) ghost_slices.push_back(neta - 1 + i);
+    }
+    if (ghost_slices.empty()) return;
+
+    #pragma omp parallel for collapse(2)
+    for (unsigned int i = 0; i < ghost_slices.size(); i++)
+    for (int iy = -NG; iy < ny + NG; iy++) {
+        const int ieta = ghost_slices[i];
+        for (int ix = -NG; ix < nx + NG; ix++) {
+            const auto &c = arena.getHalo(ix, iy, ieta);
+            thermo.getHalo(ix, iy, ieta) = eos.get_thermo(c.epsilon, c.rhob);
+        }
+    }
+}
+
+
+//! evaluates the flow derivatives of the active cells of arena_current;
+//! needs thermo_current with valid ghost cells and thermo_prev
+void Advance::MakeDerivativeGrid(double tau, SCGrid &arena_prev,
+                                 SCGrid &arena_current,
+                                 const ActiveTiles &active_tiles,
+                                 int n_directions) {
+    const int nx   = arena_current.nX();
+    const int ny   = arena_current.nY();
+    const int neta = arena_current.nEta();
+    if (derivatives.nX() != nx || derivatives.nY() != ny
+            || derivatives.nEta() != neta) {
+        derivatives = DerivativeGrid(nx, ny, neta);
+    }
+
+    const GridTiles &tiles = active_tiles.get_tiles();
+    #pragma omp parallel
+    {
+        U_derivative u_derivative_helper(DATA, eos);
+        CellStencil stencil;
+        #pragma omp for schedule(dynamic)
+        for (int itile = 0; itile < tiles.size(); itile++) {
+            if (!active_tiles.tile_active(itile)) continue;
+            tiles.for_each_cell_in_tile(itile, [&](int ix, int iy, int ieta) {
+                stencil.gather_nearest(arena_current, ix, iy, ieta,
+                                       n_directions);
+                stencil.gather_thermo(thermo_current, ix, iy, ieta,
+                                      n_directions);
+                u_derivative_helper.calculate_derivatives(
+                        tau, stencil, arena_prev(ix, iy, ieta),
+                        thermo_prev(ix, iy, ieta), derivatives(ix, iy, ieta));
+            });
         }
     }
 }
@@ -464,82 +649,209 @@ void Advance::QuestRevert_qmu(double tau, Cell_small *grid_pt,
 
 //! This function computes the rhs array. It computes the spatial
 //! derivatives of T^\mu\nu using the KT algorithm
-void Advance::MakeDeltaQI(double tau, SCGrid &arena_current, int ix, int iy, int ieta, TJbVec &qi, int rk_flag) {
+//! computes the KT flux through every cell face of the grid that borders
+//! a needed cell, along the first n_directions directions. Returns the sum
+//! over the directions of the largest signal speed over the cell spacing
+//! [1/fm]; eta is left out of the sum for a single eta slice, whose eta
+//! fluxes cancel.
+double Advance::MakeFaceFluxes(double tau, SCGrid &arena_current,
+                               const ActiveTiles &active_tiles,
+                               int n_directions) {
+    const double delta[4] = {0.0, DATA.delta_x, DATA.delta_y, DATA.delta_eta};
+    double signal_rate = 0.;
+    const int nx   = arena_current.nX();
+    const int ny   = arena_current.nY();
+    const int neta = arena_current.nEta();
+    if (face_flux[0].nX() != nx || face_flux[0].nY() != ny
+            || face_flux[0].nEta() != neta) {
+        for (auto &flux_grid : face_flux) {
+            flux_grid = GridT<TJbVec>(nx, ny, neta);
+        }
+    }
+
+    const SCGrid &arena = arena_current;
+    for (int direction = 1; direction <= n_directions; direction++) {
+        const int dx   = (direction == 1 ? 1 : 0);
+        const int dy   = (direction == 2 ? 1 : 0);
+        const int deta = (direction == 3 ? 1 : 0);
+        // one more face than cells along the direction
+        const int nface_x   = nx   + dx;
+        const int nface_y   = ny   + dy;
+        const int nface_eta = neta + deta;
+        auto &flux_grid = face_flux[direction-1];
+        const GridTiles tiles(nface_x, nface_y, nface_eta,
+                              4*sizeof(Cell_small),
+                              DATA.tile_size_x, DATA.tile_size_y,
+                              DATA.tile_size_eta);
+        double max_speed = 0.;
+        #pragma omp parallel reduction(max:max_speed)
+        {
+            // left and right states of all faces of a tile, which are
+            // reconstructed together
+            std::vector<std::array<int, 3>> faces;
+            std::vector<TJbVec> q;
+            std::vector<ReconstCell> guess;
+            std::vector<ReconstCell> states;
+
+            #pragma omp for schedule(dynamic)
+            for (int itile = 0; itile < tiles.size(); itile++) {
+                faces.clear();
+                q.clear();
+                guess.clear();
+                tiles.for_each_cell_in_tile(itile,
+                                            [&](int ix, int iy, int ieta) {
+                    // the face behind the last cell belongs to that cell
+                    if (!active_tiles.cell_needed(std::min(ix, nx - 1),
+                                                  std::min(iy, ny - 1),
+                                                  std::min(ieta, neta - 1))) {
+                        return;
+                    }
+                    TJbVec qL, qR;
+                    MakeKTStates(tau, arena_current, ix, iy, ieta, direction,
+                                 qL, qR);
+                    faces.push_back({{ix, iy, ieta}});
+                    q.push_back(qL);
+                    q.push_back(qR);
+                    guess.push_back(primitive_variables(
+                            arena.getHalo(ix - dx, iy - dy, ieta - deta)));
+                    guess.push_back(primitive_variables(
+                            arena.getHalo(ix, iy, ieta)));
+                });
+
+                states.resize(q.size());
+                reconst_helper.ReconstIt_batch(q.size(), tau, q.data(),
+                                               guess.data(), states.data());
+
+                for (unsigned int i = 0; i < faces.size(); i++) {
+                    const double a = MakeKTFlux(
+                            tau, direction, q[2*i], q[2*i+1],
+                            states[2*i], states[2*i+1],
+                            flux_grid.getHalo(faces[i][0], faces[i][1],
+                                              faces[i][2]));
+                    max_speed = std::max(max_speed, a);
+                }
+            }
+        }
+        if (direction < 3 || neta > 1) {
+            signal_rate += max_speed/delta[direction];
+        }
+    }
+    return(signal_rate);
+}
+
+
+//! shortest relaxation time [fm] of the dissipative currents among the
+//! cells of the active tiles of thermo_current
+double Advance::MinRelaxationTime(const ActiveTiles &active_tiles) {
+    double relaxation_time = 10.;
+    const GridTiles &tiles = active_tiles.get_tiles();
+    #pragma omp parallel for schedule(dynamic) reduction(min:relaxation_time)
+    for (int itile = 0; itile < tiles.size(); itile++) {
+        if (!active_tiles.tile_active(itile)) continue;
+        tiles.for_each_cell_in_tile(itile, [&](int ix, int iy, int ieta) {
+            relaxation_time = std::min(relaxation_time,
+                diss_helper.get_shortest_relaxation_time(
+                                            thermo_current(ix, iy, ieta)));
+        });
+    }
+    return(relaxation_time);
+}
+
+
+//! conserved densities tau*T^{tau mu} and tau*J^tau on the left and
+//! right side of the face between the cell (ix, iy, ieta) and its left
+//! neighbour along direction (1: x, 2: y, 3: eta), each reconstructed
+//! from the cell on the same side
+void Advance::MakeKTStates(double tau, SCGrid &arena_current,
+                           int ix, int iy, int ieta, int direction,
+                           TJbVec &qL, TJbVec &qR) {
+    const int dx   = (direction == 1 ? 1 : 0);
+    const int dy   = (direction == 2 ? 1 : 0);
+    const int deta = (direction == 3 ? 1 : 0);
+    const SCGrid &arena = arena_current;
+    const auto &m2 = arena.getHalo(ix - 2*dx, iy - 2*dy, ieta - 2*deta);
+    const auto &m1 = arena.getHalo(ix -   dx, iy -   dy, ieta -   deta);
+    const auto &c  = arena.getHalo(ix,        iy,        ieta);
+    const auto &p1 = arena.getHalo(ix +   dx, iy +   dy, ieta +   deta);
+    const ThermoGrid &thermo = thermo_current;
+    const double P_m2 = thermo.getHalo(ix-2*dx, iy-2*dy, ieta-2*deta).p;
+    const double P_m1 = thermo.getHalo(ix-  dx, iy-  dy, ieta-  deta).p;
+    const double P_c  = thermo.getHalo(ix,      iy,      ieta       ).p;
+    const double P_p1 = thermo.getHalo(ix+  dx, iy+  dy, ieta+  deta).p;
+
+    for (int alpha = 0; alpha < 5; alpha++) {
+        const double q_m2 = tau*get_TJb(m2, P_m2, alpha, 0);
+        const double q_m1 = tau*get_TJb(m1, P_m1, alpha, 0);
+        const double q_c  = tau*get_TJb(c,  P_c,  alpha, 0);
+        const double q_p1 = tau*get_TJb(p1, P_p1, alpha, 0);
+        qL[alpha] = q_m1 + 0.5*minmod.minmod_dx(q_c, q_m1, q_m2);
+        qR[alpha] = q_c  - 0.5*minmod.minmod_dx(q_p1, q_c, q_m1);
+    }
+}
+
+
+//! KT flux through a face from the conserved densities qL, qR on its
+//! two sides and the primitive variables grid_L, grid_R solved from them;
+//! returns the local signal speed of the face
+double Advance::MakeKTFlux(double tau, int direction,
+                         const TJbVec &qL, const TJbVec &qR,
+                         const ReconstCell &grid_L, const ReconstCell &grid_R,
+                         TJbVec &flux) {
+    const double delta_tau_fac[4] = {0.0, tau, tau, 1.0};
+    const double tau_fac = delta_tau_fac[direction];
+
+    const double a_L = MaxSpeed(tau, direction, grid_L);
+    const double a_R = MaxSpeed(tau, direction, grid_R);
+    const double a   = std::max(a_L, a_R);
+
+    const double P_L = eos.get_pressure(grid_L.e, grid_L.rhob);
+    const double P_R = eos.get_pressure(grid_R.e, grid_R.rhob);
+    for (int alpha = 0; alpha < 5; alpha++) {
+        const double F_L = get_TJb(grid_L, P_L, alpha, direction)*tau_fac;
+        const double F_R = get_TJb(grid_R, P_R, alpha, direction)*tau_fac;
+        // KT: H_{j-1/2} = (f(u^+_{j-1/2}) + f(u^-_{j-1/2})/2
+        //                  - a_{j-1/2}(u_{j-1/2}^+ - u^-_{j-1/2})/2
+        flux[alpha] = 0.5*((F_L + F_R) - a*(qR[alpha] - qL[alpha]));
+    }
+    return(a);
+}
+
+
+void Advance::MakeDeltaQI(double tau, SCGrid &arena_current, int ix, int iy,
+                          int ieta, TJbVec &qi, int rk_flag,
+                          int n_directions) {
     double delta[4]   = {0.0, DATA.delta_x, DATA.delta_y, DATA.delta_eta};
-    double tau_fac[4] = {0.0, tau, tau, 1.0};
   
+    SCGrid::const_reference c = arena_current(ix, iy, ieta);
+    const double P_c    = thermo_current(ix, iy, ieta).p;
     double rhs[5];
     for (int alpha = 0; alpha < 5; alpha++) {
-        qi[alpha] = get_TJb(arena_current(ix, iy, ieta), alpha, 0)*tau;
+        qi[alpha] = get_TJb(c, P_c, alpha, 0)*tau;
         rhs[alpha] = 0.0; 
     }
-  
-    TJbVec qiphL = {0};
-    TJbVec qiphR = {0};
-    TJbVec qimhL = {0};
-    TJbVec qimhR = {0};
-  
-    Neighbourloop(arena_current, ix, iy, ieta, NLAMBDAS{
-        #pragma omp simd
-        for (int alpha = 0; alpha < 5; alpha++) {
-            const double gphL = qi[alpha];
-            const double gphR = tau*get_TJb(p1, alpha, 0);
-            const double gmhL = tau*get_TJb(m1, alpha, 0);
-            const double gmhR = qi[alpha];
-            const double fphL =  0.5*minmod.minmod_dx(gphR, qi[alpha], gmhL);
-            const double fphR = -0.5*minmod.minmod_dx(
-                                tau*get_TJb(p2, alpha, 0), gphR, qi[alpha]);
-            const double fmhL =  0.5*minmod.minmod_dx(
-                                qi[alpha], gmhL, tau*get_TJb(m2, alpha, 0));
-            const double fmhR = -fphL;
-            qiphL[alpha] = gphL + fphL;
-            qiphR[alpha] = gphR + fphR;
-            qimhL[alpha] = gmhL + fmhL;
-            qimhR[alpha] = gmhR + fmhR;
-        }
-
-        // for each direction, reconstruct half-way cells
-        // reconstruct e, rhob, and u[4] for half way cells
-        auto grid_phL = reconst_helper.ReconstIt_shell(tau, qiphL, c);
-        auto grid_phR = reconst_helper.ReconstIt_shell(tau, qiphR, c);
-        auto grid_mhL = reconst_helper.ReconstIt_shell(tau, qimhL, c);
-        auto grid_mhR = reconst_helper.ReconstIt_shell(tau, qimhR, c);
-
-        double aiphL = MaxSpeed(tau, direction, grid_phL);
-        double aiphR = MaxSpeed(tau, direction, grid_phR);
-        double aimhL = MaxSpeed(tau, direction, grid_mhL);
-        double aimhR = MaxSpeed(tau, direction, grid_mhR);
-
-        double aiph = std::max(aiphL, aiphR);
-        double aimh = std::max(aimhL, aimhR);
 
+    // divergence of the face fluxes from MakeFaceFluxes
+    for (int direction = 1; direction <= n_directions; direction++) {
+        const auto &flux_grid = face_flux[direction-1];
+        const auto &Fimh = flux_grid(ix, iy, ieta);
+        const auto &Fiph = flux_grid.getHalo(ix   + (direction == 1 ? 1 : 0),
+                                             iy   + (direction == 2 ? 1 : 0),
+                                             ieta + (direction == 3 ? 1 : 0));
         for (int alpha = 0; alpha < 5; alpha++) {
-            double FiphL = get_TJb(grid_phL, 0, alpha, direction)*tau_fac[direction];
-            double FiphR = get_TJb(grid_phR, 0, alpha, direction)*tau_fac[direction];
-            double FimhL = get_TJb(grid_mhL, 0, alpha, direction)*tau_fac[direction];
-            double FimhR = get_TJb(grid_mhR, 0, alpha, direction)*tau_fac[direction];
-
-            // KT: H_{j+1/2} = (f(u^+_{j+1/2}) + f(u^-_{j+1/2})/2
-            //                  - a_{j+1/2}(u_{j+1/2}^+ - u^-_{j+1/2})/2
-            double Fiph = 0.5*((FiphL + FiphR)
-                               - aiph*(qiphR[alpha] - qiphL[alpha]));
-            double Fimh = 0.5*((FimhL + FimhR)
-                               - aimh*(qimhR[alpha] - qimhL[alpha]));
-            double DFmmp = (Fimh - Fiph)/delta[direction];
+            double DFmmp = (Fimh[alpha] - Fiph[alpha])/delta[direction];
             rhs[alpha] += DFmmp*(DATA.delta_tau);
         }
-    });
+    }
 
     // geometric terms
-    rhs[0] -= get_TJb(arena_current(ix, iy, ieta), 3, 3)*DATA.delta_tau;
-    rhs[3] -= get_TJb(arena_current(ix, iy, ieta), 3, 0)*DATA.delta_tau;
+    rhs[0] -= get_TJb(c, P_c, 3, 3)*DATA.delta_tau;
+    rhs[3] -= get_TJb(c, P_c, 3, 0)*DATA.delta_tau;
 
     for (int i = 0; i < 5; i++) {
         qi[i] += rhs[i];
     }
 }
 
-// determine the maximum signal propagation speed at the given direction
 double Advance::MaxSpeed(double tau, int direc, const ReconstCell &grid_p) {  
     double g[] = {1., 1., 1./tau};
 
@@ -610,7 +922,8 @@ double Advance::MaxSpeed(double tau, int direc, const ReconstCell &grid_p) {
     return f;
 }
 
-double Advance::get_TJb(const ReconstCell &grid_p, const int rk_flag,
+//! T^{mu nu} (mu < 4) or J^nu (mu = 4) of a cell with the given pressure
+double Advance::get_TJb(const ReconstCell &grid_p, const double pressure,
                         const int mu, const int nu) {
     assert(mu < 5); assert(mu > -1);
     assert(nu < 4); assert(nu > -1);
@@ -631,12 +944,12 @@ double Advance::get_TJb(const ReconstCell &grid_p, const int rk_flag,
     } else {
         u_mu = grid_p.u[mu];
     }
-    const double pressure = eos.get_pressure(e, rhob);
     const double T_munu   = (e + pressure)*u_mu*u_nu + pressure*gfac;
     return(T_munu);
 }
 
-double Advance::get_TJb(const Cell_small &grid_p, const int mu, const int nu) {
+double Advance::get_TJb(SCGrid::const_reference grid_p,
+                        const double pressure, const int mu, const int nu) {
     assert(mu < 5); assert(mu > -1);
     assert(nu < 4); assert(nu > -1);
     double rhob = grid_p.rhob;
@@ -656,7 +969,6 @@ double Advance::get_TJb(const Cell_small &grid_p, const int mu, const int nu) {
     } else {
         u_mu = grid_p.u[mu];
     }
-    const double pressure = eos.get_pressure(e, rhob);
     const double T_munu   = (e + pressure)*u_mu*u_nu + pressure*gfac;
     return(T_munu);
 }
@@ -12,12 +12,34 @@
 #include "./reconst.h"
 #include "./hydro_source.h"
 #include "./pretty_ostream.h"
+#include "./grid_tiles.h"
+#include "./domain.h"
+
+//! Physics switches of a run as compile-time constants. The stage kernel
+//! is instantiated for every combination and Advance picks the one that
+//! matches InitData once, so terms that are switched off cost nothing in
+//! the loop over cells.
+template<bool Viscous, bool Shear, bool Bulk, bool Diff, bool Rhob,
+         bool Source, bool BoostInvariant>
+struct PhysicsConfig {
+    static const bool viscous = Viscous;    //!< Viscosity_Flag_Yes_1_No_0
+    static const bool shear   = Shear;
+    static const bool bulk    = Bulk;
+    static const bool diff    = Diff;
+    static const bool rhob    = Rhob;
+    static const bool source  = Source;     //!< hydro source terms
+    //! spatial directions with fluxes and gradients; a boost-invariant
+    //! run has a single eta slice, across which nothing changes
+    static const int n_directions = (BoostInvariant ? 2 : 3);
+};
+
 
 class Advance {
  private:
     const InitData &DATA;
     const EOS &eos;
     hydro_source &hydro_source_terms;
+    const Domain &domain;
 
     Diss diss_helper;
     Minmod minmod;
@@ -25,6 +47,41 @@ class Advance {
     pretty_ostream music_message;
 
     bool flag_add_hydro_source;
+    GridBoundary transverse_boundary;
+
+    //! KT fluxes of T^{mu nu} and J^mu through the face i-1/2 of every
+    //! cell i, one grid per direction. The face behind the last cell
+    //! is stored in the first ghost cell.
+    std::array<GridT<TJbVec>, 3> face_flux;
+
+    //! EOS output for every cell of arena_current (ghost cells included)
+    //! and of arena_prev, evaluated once at the start of each stage
+    ThermoGrid thermo_current;
+    ThermoGrid thermo_prev;
+
+    //! flow derivatives of every cell of arena_current, filled at the
+    //! start of each stage if DATA.precompute_flow_derivatives == 1
+    DerivativeGrid derivatives;
+
+    //! largest MakeFaceFluxes signal rate [1/fm] and shortest relaxation
+    //! time [fm] met in the stages of the current time step; the latter
+    //! is only tracked with DATA.adaptive_time_step == 1
+    double max_signal_rate = 0.;
+    double min_relaxation_time = 10.;
+
+    typedef void (Advance::*StageKernel)(double, SCGrid&, SCGrid&, SCGrid&,
+                                         int, const ActiveTiles&);
+    StageKernel stage_kernel;
+
+    template<bool... Set, class... Rest>
+    static StageKernel select_stage_kernel(bool flag, Rest... rest);
+    template<bool... Set>
+    static StageKernel select_stage_kernel();
+
+    template<class Config>
+    void AdvanceIt_stage(double tau, SCGrid &arena_prev,
+                         SCGrid &arena_current, SCGrid &arena_future,
+                         int rk_flag, const ActiveTiles &active_tiles);
 
     int map_2d_idx_to_1d(int a, int b) {
         static const int index_map[5][4] = {{0,   1,  2,  3},
@@ -37,30 +94,56 @@ class Advance {
 
  public:
     Advance(const EOS &eosIn, const InitData &DATA_in,
-            hydro_source &hydro_source_in);
+            hydro_source &hydro_source_in, const Domain &domain_in);
 
     void AdvanceIt(double tau_init,
                    SCGrid &arena_prev, SCGrid &arena_current, SCGrid &arena_future,
-                   int rk_flag);
+                   int rk_flag, const ActiveTiles &active_tiles);
+
+    double get_max_signal_rate() const {return max_signal_rate;}
+    double get_min_relaxation_time() const {return min_relaxation_time;}
 
+    template<class Config>
     void FirstRKStepT(const double tau, double x_local, double y_local,
-                      double eta_s_local,  SCGrid &arena_current, SCGrid &arena_future, SCGrid &arena_prev, int ix, int iy, int ieta,
+                      double eta_s_local,  SCGrid &arena_current, SCGrid &arena_future, SCGrid &arena_prev,
+                      const CellStencil &stencil, int ix, int iy, int ieta,
                       int rk_flag);
 
+    template<class Config>
     void FirstRKStepW(double tau_it, SCGrid &arena_prev, SCGrid &arena_current, SCGrid &arena_future,
-                      int rk_flag, double theta_local, DumuVec &a_local,
+                      const CellStencil &stencil, int rk_flag, double theta_local, DumuVec &a_local,
                       VelocityShearVec &sigma_local, DmuMuBoverTVec &baryon_diffusion_vector, int ieta, int ix, int iy);
 
-    void UpdateTJbRK(const ReconstCell &grid_rk, Cell_small &grid_pt);
-    void QuestRevert(double tau, Cell_small *grid_pt, int ieta, int ix, int iy);
-    void QuestRevert_qmu(double tau, Cell_small *grid_pt,
+    void UpdateTJbRK(const ReconstCell &grid_rk, SCGrid::reference grid_pt);
+    void QuestRevert(double tau, SCGrid::reference grid_pt,
+                     int ieta, int ix, int iy);
+    void QuestRevert_qmu(double tau, SCGrid::reference grid_pt,
                          int ieta, int ix, int iy);
 
+    void MakeThermoGrid(const SCGrid &arena, ThermoGrid &thermo,
+                        const ActiveTiles &active_tiles);
+    void MakeThermoHalo(const SCGrid &arena, ThermoGrid &thermo);
+    void MakeDerivativeGrid(double tau, SCGrid &arena_prev,
+                            SCGrid &arena_current,
+                            const ActiveTiles &active_tiles,
+                            int n_directions);
+    double MakeFaceFluxes(double tau, SCGrid &arena_current,
+                          const ActiveTiles &active_tiles, int n_directions);
+    double MinRelaxationTime(const ActiveTiles &active_tiles);
+    void MakeKTStates(double tau, SCGrid &arena_current, int ix, int iy,
+                      int ieta, int direction, TJbVec &qL, TJbVec &qR);
+    double MakeKTFlux(double tau, int direction,
+                      const TJbVec &qL, const TJbVec &qR,
+                      const ReconstCell &grid_L, const ReconstCell &grid_R,
+                      TJbVec &flux);
     void MakeDeltaQI(double tau, SCGrid &arena_current,
-                     int ix, int iy, int ieta, TJbVec &qi, int rk_flag);
+                     int ix, int iy, int ieta, TJbVec &qi, int rk_flag,
+                     int n_directions);
     double MaxSpeed(double tau, int direc, const ReconstCell &grid_p);
-    double get_TJb(const ReconstCell &grid_p, const int rk_flag, const int mu, const int nu);
-    double get_TJb(const Cell_small &grid_p, const int mu, const int nu);
+    double get_TJb(const ReconstCell &grid_p, const double pressure,
+                   const int mu, const int nu);
+    double get_TJb(SCGrid::const_reference grid_p, const double pressure,
+                   const int mu, const int nu);
 };
 
 #endif  // SRC_ADVANCE_H_
@@ -4,6 +4,7 @@
 
 #include "data_struct.h"
 #include <array>
+#include <cstddef>
 
 class Cell_small {
  public:
@@ -15,4 +16,127 @@ class Cell_small {
     double pi_b    = 0.;
 };
 
+
+//! N values of one cell that live in N different field arrays,
+//! i.e. value i sits at p[i*stride]. Used by the SoA grid layout.
+template<class V, int N>
+class StridedArray {
+ private:
+    V *p;
+    std::size_t stride;
+
+ public:
+    StridedArray(V *p_in, std::size_t stride_in) : p(p_in), stride(stride_in) {}
+
+    V& operator[](const int i) const {return p[i*stride];}
+    constexpr int size() const {return N;}
+
+    operator std::array<double, N>() const {
+        std::array<double, N> a;
+        for (int i = 0; i < N; i++) a[i] = p[i*stride];
+        return a;
+    }
+
+    const StridedArray& operator=(const std::array<double, N> &a) const {
+        for (int i = 0; i < N; i++) p[i*stride] = a[i];
+        return *this;
+    }
+
+    //! copies values, e.g. in grid_a(i).u = grid_b(i).u; it never
+    //! re-points the array
+    const StridedArray& operator=(const StridedArray &a) const {
+        for (int i = 0; i < N; i++) p[i*stride] = a[i];
+        return *this;
+    }
+
+    template<class W>
+    const StridedArray& operator=(const StridedArray<W, N> &a) const {
+        for (int i = 0; i < N; i++) p[i*stride] = a[i];
+        return *this;
+    }
+
+    void fill(const double value) const {
+        for (int i = 0; i < N; i++) p[i*stride] = value;
+    }
+};
+
+
+//! Reference to one cell of a structure-of-arrays grid.
+//! It exposes the same members as Cell_small, so stencil code reads the
+//! same for both layouts. V is double or const double.
+template<class V>
+class Cell_small_ref {
+ public:
+    static const int n_fields = 21;
+
+    V &epsilon;
+    V &rhob;
+    StridedArray<V, 4>  u;
+    StridedArray<V, 14> Wmunu;
+    V &pi_b;
+
+    Cell_small_ref(V *p, std::size_t stride) :
+        epsilon(p[0]), rhob(p[stride]),
+        u(p + 2*stride, stride), Wmunu(p + 6*stride, stride),
+        pi_b(p[20*stride]) {}
+
+    Cell_small_ref(const Cell_small_ref &c) = default;
+
+    //! a reference to a cell converts to a reference to the const cell
+    template<class W>
+    Cell_small_ref(const Cell_small_ref<W> &c) :
+        Cell_small_ref(&c.epsilon, &c.rhob - &c.epsilon) {}
+
+    operator Cell_small() const {
+        Cell_small c;
+        c.epsilon = epsilon;
+        c.rhob    = rhob;
+        c.u       = u;
+        c.Wmunu   = Wmunu;
+        c.pi_b    = pi_b;
+        return c;
+    }
+
+    //! assignment copies values, like assigning through a Cell_small&
+    const Cell_small_ref& operator=(const Cell_small &c) const {
+        epsilon = c.epsilon;
+        rhob    = c.rhob;
+        u       = c.u;
+        Wmunu   = c.Wmunu;
+        pi_b    = c.pi_b;
+        return *this;
+    }
+
+    const Cell_small_ref& operator=(const Cell_small_ref &c) const {
+        return *this = static_cast<Cell_small>(c);
+    }
+
+    template<class W>
+    const Cell_small_ref& operator=(const Cell_small_ref<W> &c) const {
+        return *this = static_cast<Cell_small>(c);
+    }
+};
+
+
+//! Thermodynamic quantities of one cell, derived from its epsilon and
+//! rhob by the equation of state
+class ThermoCell {
+ public:
+    double p   = 0.;
+    double T   = 0.;
+    double muB = 0.;
+    double cs2 = 0.;
+};
+
+
+//! Flow derivatives of one cell that enter the evolution of the
+//! dissipative quantities (see U_derivative)
+class DerivativeCell {
+ public:
+    double theta = 0.;          //!< expansion rate
+    DumuVec a;                  //!< Du^mu
+    VelocityShearVec sigma;     //!< velocity shear tensor sigma^{mu nu}
+    DmuMuBoverTVec DmuBoverT;   //!< D^mu (mu_B/T)
+};
+
 #endif  // SRC_GRID_H_
@@ -0,0 +1,175 @@
+#ifndef SRC_CELL_STENCIL_H_
+#define SRC_CELL_STENCIL_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include "cell.h"
+#include "grid.h"
+#include "minmod.h"
+
+//! The 13-point neighbourhood of one cell: the cell itself and the cells
+//! one and two steps away along x, y and eta, together with the EOS output
+//! of the cell and its nearest neighbours. The cells are located in the
+//! arena once per cell and RK stage and read from there by every KT flux
+//! and minmod gradient of the stage; the EOS output is copied. With the
+//! SoA layout a term only loads the fields it reads.
+//!
+//! Directions are numbered 1 (x), 2 (y) and 3 (eta) as in Neighbourloop.
+//! The gather functions take the number of directions to locate; with 2
+//! (boost-invariant runs) the eta neighbours are left as they were and
+//! must not be read. The arena must outlive the stencil and keep its
+//! content while the stencil is used.
+//! The field arguments are callables that return the advected or
+//! differentiated quantity of a cell, e.g.
+//!     [](SCGrid::const_reference cell) {return cell.pi_b;}
+class CellStencil {
+ public:
+    typedef SCGrid::const_reference cell_reference;
+
+ private:
+    const SCGrid *arena_ = nullptr;
+    int c;
+    //! storage positions of the neighbours of direction d at [d-1][k],
+    //! k = 0..3 for the offsets -2, -1, +1, +2
+    std::array<std::array<int, 4>, 3> neighbours;
+
+    ThermoCell thermo_c;
+    //! thermo_neighbours[d-1] holds the offsets -1 and +1
+    std::array<std::array<ThermoCell, 2>, 3> thermo_neighbours;
+
+    cell_reference at(int offset) const {return arena_->cell(offset);}
+
+ public:
+    void gather(const SCGrid &arena, int ix, int iy, int ieta,
+                int n_directions = 3) {
+        arena_ = &arena;
+        c = arena.offset(ix, iy, ieta);
+        for (int d = 0; d < n_directions; d++) {
+            const int sx   = (d == 0);
+            const int sy   = (d == 1);
+            const int seta = (d == 2);
+            neighbours[d][0] = arena.offset(ix - 2*sx, iy - 2*sy,
+                                            ieta - 2*seta);
+            neighbours[d][1] = arena.offset(ix - sx, iy - sy, ieta - seta);
+            neighbours[d][2] = arena.offset(ix + sx, iy + sy, ieta + seta);
+            neighbours[d][3] = arena.offset(ix + 2*sx, iy + 2*sy,
+                                            ieta + 2*seta);
+        }
+    }
+
+    //! gathers the cell and its nearest neighbours only; m2() and p2()
+    //! are left as they were
+    void gather_nearest(const SCGrid &arena, int ix, int iy, int ieta,
+                        int n_directions = 3) {
+        arena_ = &arena;
+        c = arena.offset(ix, iy, ieta);
+        for (int d = 0; d < n_directions; d++) {
+            const int sx   = (d == 0);
+            const int sy   = (d == 1);
+            const int seta = (d == 2);
+            neighbours[d][1] = arena.offset(ix - sx, iy - sy, ieta - seta);
+            neighbours[d][2] = arena.offset(ix + sx, iy + sy, ieta + seta);
+        }
+    }
+
+    //! thermo needs valid ghost cells
+    void gather_thermo(const ThermoGrid &thermo, int ix, int iy, int ieta,
+                       int n_directions = 3) {
+        thermo_c = thermo(ix, iy, ieta);
+        for (int d = 0; d < n_directions; d++) {
+            const int sx   = (d == 0);
+            const int sy   = (d == 1);
+            const int seta = (d == 2);
+            thermo_neighbours[d][0] = thermo.getHalo(ix - sx, iy - sy,
+                                                     ieta - seta);
+            thermo_neighbours[d][1] = thermo.getHalo(ix + sx, iy + sy,
+                                                     ieta + seta);
+        }
+    }
+
+    cell_reference centre()            const {return at(c);}
+    cell_reference m2(int direction)   const {return at(neighbours[direction-1][0]);}
+    cell_reference m1(int direction)   const {return at(neighbours[direction-1][1]);}
+    cell_reference p1(int direction)   const {return at(neighbours[direction-1][2]);}
+    cell_reference p2(int direction)   const {return at(neighbours[direction-1][3]);}
+    const ThermoCell& thermo_centre()     const {return thermo_c;}
+
+    //! minmod slope of field(cell) along direction, per cell spacing
+    template<class Field>
+    double minmod_slope(const Minmod &minmod, int direction,
+                        Field field) const {
+        return(minmod.minmod_dx(field(p1(direction)), field(centre()),
+                                field(m1(direction))));
+    }
+
+    //! minmod slope of field(thermo cell) along direction
+    template<class Field>
+    double thermo_minmod_slope(const Minmod &minmod, int direction,
+                               Field field) const {
+        return(minmod.minmod_dx(field(thermo_neighbours[direction-1][1]),
+                                field(thermo_c),
+                                field(thermo_neighbours[direction-1][0])));
+    }
+
+    //! H_{i+1/2} - H_{i-1/2} along direction for the Kurganov-Tadmor flux
+    //! of u^i X with X = field(cell), i.e. partial_i (u^i X) times the
+    //! cell spacing. The local speed is |u^i|/u^tau.
+    template<class Field>
+    double kt_flux_difference(const Minmod &minmod, int direction,
+                              Field field) const {
+        cell_reference c   = centre();
+        cell_reference cp1 = p1(direction);
+        cell_reference cp2 = p2(direction);
+        cell_reference cm1 = m1(direction);
+        cell_reference cm2 = m2(direction);
+
+        double g = field(c);
+        double f = g*c.u[direction];
+        g *= c.u[0];
+
+        double gp2 = field(cp2);
+        double fp2 = gp2*cp2.u[direction];
+        gp2 *= cp2.u[0];
+
+        double gp1 = field(cp1);
+        double fp1 = gp1*cp1.u[direction];
+        gp1 *= cp1.u[0];
+
+        double gm1 = field(cm1);
+        double fm1 = gm1*cm1.u[direction];
+        gm1 *= cm1.u[0];
+
+        double gm2 = field(cm2);
+        double fm2 = gm2*cm2.u[direction];
+        gm2 *= cm2.u[0];
+
+        // u^i X at the half-way points
+        double uXphR = fp1 - 0.5*minmod.minmod_dx(fp2, fp1, f);
+        double temp  = 0.5*minmod.minmod_dx(fp1, f, fm1);
+        double uXphL = f + temp;
+        double uXmhR = f - temp;
+        double uXmhL = fm1 + 0.5*minmod.minmod_dx(f, fm1, fm2);
+
+        // u^tau X at the half-way points
+        double XphR = gp1 - 0.5*minmod.minmod_dx(gp2, gp1, g);
+        temp        = 0.5*minmod.minmod_dx(gp1, g, gm1);
+        double XphL = g + temp;
+        double XmhR = g - temp;
+        double XmhL = gm1 + 0.5*minmod.minmod_dx(g, gm1, gm2);
+
+        double a   = std::abs(c.u[direction])/c.u[0];
+        double am1 = std::abs(cm1.u[direction])/cm1.u[0];
+        double ap1 = std::abs(cp1.u[direction])/cp1.u[0];
+
+        double ax = std::max(a, ap1);
+        double HXph = ((uXphR + uXphL) - ax*(XphR - XphL))*0.5;
+
+        ax = std::max(a, am1);
+        double HXmh = ((uXmhR + uXmhL) - ax*(XmhR - XmhL))*0.5;
+
+        return(HXph - HXmh);
+    }
+};
+
+#endif  // SRC_CELL_STENCIL_H_
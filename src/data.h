@@ -32,6 +32,8 @@ typedef struct init_data {
     std::string initName_rhob_TA;
     std::string initName_rhob_TB;
     std::string initName_AMPT;
+    //! directory of the hydro output files, empty or ending with '/'
+    std::string output_dir;
 
     //! random seed
     int seed;
@@ -62,6 +64,20 @@ typedef struct init_data {
     int neta;
     int nt;
 
+    //! extents of the cache tiles used to sweep the grid (0: automatic)
+    int tile_size_x;
+    int tile_size_y;
+    int tile_size_eta;
+
+    //! 1: the flow derivatives of all cells are evaluated in a pass of
+    //! their own at the start of each RK stage (uses 160 bytes per cell),
+    //! 0: they are evaluated cell by cell in the update loop
+    int precompute_flow_derivatives;
+
+    //! cells further than a few cells from any cell with epsilon above
+    //! this value [GeV/fm^3] are not evolved (0: evolve every cell)
+    double active_region_threshold;
+
     double x_size;      //!< in fermi -x_size/2 < x < x_size/2
     double y_size;      //!< in fermi, -y_size/2 < y < y_size/2
     double eta_size;    //!< -eta_size/2 < eta < eta_size/2
@@ -72,6 +88,15 @@ typedef struct init_data {
     double delta_y;
     double delta_eta;
     double delta_tau;
+    //! time between arena_prev and arena_current in the RK stage being
+    //! taken, used by the backward time derivatives; it differs from
+    //! delta_tau only with adaptive_time_step
+    double delta_tau_backward;
+
+    //! 1: the time step follows the signal speeds (see Evolve)
+    int adaptive_time_step;
+    double adaptive_CFL;
+    double adaptive_delta_tau_max;  //!< in fm
 
     int rk_order;
     double minmod_theta;
@@ -80,6 +105,9 @@ typedef struct init_data {
     int whichEOS;       //!< type of EoS
     //! flag for boost invariant simulations
     bool boost_invariant;
+    //! boundary condition in x and y
+    //! (0: zero gradient, 1: periodic, 2: reflective)
+    int transverse_boundary;
 
     //! flag to output initial density profile
     int output_initial_density_profiles;
@@ -153,6 +181,16 @@ typedef struct init_data {
     int freeze_eps_flag;
     std::string freeze_list_filename;
     bool freeze_surface_in_binary;
+    //! the binary surface holds doubles instead of floats
+    bool freeze_surface_double_precision;
+    bool freeze_surface_to_file;
+    //! the threshold whose surface Cooper-Frye uses, of several
+    int freeze_surface_index_for_spectra;
+    //! the 3+1D freeze-out search only visits the cubes within
+    //! freeze_out_band_margin cubes of the last surface (0: all cubes),
+    //! and all cubes every freeze_out_full_sweep_every freeze-out steps
+    int freeze_out_band_margin;
+    int freeze_out_full_sweep_every;
 
     // for calculation of spectra
     int pseudofreeze;    //! flag to compute spectra in pseudorapdity
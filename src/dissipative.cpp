@@ -10,7 +10,9 @@
 
 using namespace std;
 
-Diss::Diss(const EOS &eosIn, const InitData &Data_in) : DATA(Data_in), eos(eosIn), minmod(Data_in) {}
+Diss::Diss(const EOS &eosIn, const InitData &Data_in) :
+    DATA(Data_in), eos(eosIn), minmod(Data_in),
+    n_directions(Data_in.boost_invariant ? 2 : 3) {}
 
 /* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% */
 /* Dissipative parts */
@@ -19,10 +21,10 @@ Diss::Diss(const EOS &eosIn, const InitData &Data_in) : DATA(Data_in), eos(eosIn
 for everywhere else. also, this change is necessary
 to use Wmunu[rk_flag][4][mu] as the dissipative baryon current*/
 /* this is the only one that is being subtracted in the rhs */
-double Diss::MakeWSource(double tau, int alpha, SCGrid &arena_current, SCGrid &arena_prev, int ix, int iy, int ieta) {
+double Diss::MakeWSource(double tau, int alpha, const CellStencil &stencil,
+                         SCGrid::const_reference grid_pt_prev) {
     /* calculate d_m (tau W^{m,alpha}) + (geom source terms) */
-    const auto& grid_pt      = arena_current(ix, iy, ieta);
-    const auto& grid_pt_prev = arena_prev(ix, iy, ieta);
+    const auto& grid_pt = stencil.centre();
 
     double shear_on = DATA.turn_on_shear;
     double bulk_on  = DATA.turn_on_bulk;
@@ -43,8 +45,9 @@ double Diss::MakeWSource(double tau, int alpha, SCGrid &arena_current, SCGrid &a
     // dW/dtau
     // backward time derivative (first order is more stable)
     int idx_1d_alpha0 = map_2d_idx_to_1d(alpha, 0);
-    double dWdtau = (grid_pt.Wmunu[idx_1d_alpha0]
-                     - grid_pt_prev.Wmunu[idx_1d_alpha0])/DATA.delta_tau;
+    double dWdtau = ((grid_pt.Wmunu[idx_1d_alpha0]
+                      - grid_pt_prev.Wmunu[idx_1d_alpha0])
+                     /DATA.delta_tau_backward);
 
     /* bulk pressure term */
     double dPidtau = 0.0;
@@ -55,26 +58,27 @@ double Diss::MakeWSource(double tau, int alpha, SCGrid &arena_current, SCGrid &a
         dPidtau = ((Pi_alpha0 - grid_pt_prev.pi_b
                                 *(gfac + grid_pt_prev.u[alpha]
                                          *grid_pt_prev.u[0]))
-                   /DATA.delta_tau);
+                   /DATA.delta_tau_backward);
     }
 
     // use central difference to preserve conservation law exactly
     double dWdx  = 0.0;
     double dPidx = 0.0;
-    Neighbourloop(arena_current, ix, iy, ieta, NLAMBDAS{
-        int idx_1d  = map_2d_idx_to_1d(alpha, direction);
-        double sg   = c.Wmunu[idx_1d];
-        double sgp1 = p1.Wmunu[idx_1d];
-        double sgm1 = m1.Wmunu[idx_1d];
-        dWdx += minmod.minmod_dx(sgp1, sg, sgm1)/delta[direction];
+    for (int direction = 1; direction <= n_directions; direction++) {
+        int idx_1d = map_2d_idx_to_1d(alpha, direction);
+        dWdx += stencil.minmod_slope(minmod, direction,
+                    [idx_1d](SCGrid::const_reference cell) {
+                        return cell.Wmunu[idx_1d];
+                    })/delta[direction];
         if (alpha < 4 && DATA.turn_on_bulk == 1) {
             double gfac1 = (alpha == (direction) ? 1.0 : 0.0);
-            double bgp1  = p1.pi_b*(gfac1 + p1.u[alpha]*p1.u[direction]);
-            double bg    = c.pi_b *(gfac1 + c.u [alpha]*c.u [direction]);
-            double bgm1  = m1.pi_b*(gfac1 + m1.u[alpha]*m1.u[direction]);
-            dPidx += minmod.minmod_dx(bgp1, bg, bgm1)/delta[direction];
+            dPidx += stencil.minmod_slope(minmod, direction,
+                        [gfac1, alpha, direction](SCGrid::const_reference cell) {
+                            return cell.pi_b*(gfac1 + cell.u[alpha]
+                                                      *cell.u[direction]);
+                        })/delta[direction];
         }
-    });
+    }
 
     /* partial_m (tau W^mn) = W^0n + tau partial_m W^mn */
     double sf = (tau*(dWdtau + dWdx)
@@ -108,27 +112,30 @@ double Diss::MakeWSource(double tau, int alpha, SCGrid &arena_current, SCGrid &a
     return(result);
 }
 
-double Diss::Make_uWSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt_prev,
+double Diss::Make_uWSource(double tau, SCGrid::const_reference grid_pt,
+                           SCGrid::const_reference grid_pt_prev,
+                           const ThermoCell *thermo, const ThermoCell *thermo_prev,
                            int mu, int nu, int rk_flag, double theta_local,
                            DumuVec &a_local, VelocityShearVec &sigma_1d) {
     if (DATA.turn_on_shear == 0)
         return 0.0;
 
     double tempf;
-    double SW, shear, shear_to_s, T, epsilon, rhob;
+    double SW, shear, shear_to_s, T, epsilon;
     double NS_term;
 
     auto sigma = Util::UnpackVecToMatrix(sigma_1d);
-    auto Wmunu = Util::UnpackVecToMatrix(grid_pt->Wmunu);
+    auto Wmunu = Util::UnpackVecToMatrix(grid_pt.Wmunu);
 
+    const ThermoCell *thermo_local;
     if (rk_flag == 0) {
-        epsilon = grid_pt->epsilon;
-        rhob = grid_pt->rhob;
+        epsilon = grid_pt.epsilon;
+        thermo_local = thermo;
     } else {
-        epsilon = grid_pt_prev->epsilon;
-        rhob = grid_pt_prev->rhob;
+        epsilon = grid_pt_prev.epsilon;
+        thermo_local = thermo_prev;
     }
-    T = eos.get_temperature(epsilon, rhob);
+    T = thermo_local->T;
 
     if (DATA.T_dependent_shear_to_s == 1) {
         shear_to_s = get_temperature_dependent_eta_s(T);
@@ -149,7 +156,7 @@ double Diss::Make_uWSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt_
     //                Defining transport coefficients                     //
     ////////////////////////////////////////////////////////////////////////
     ////////////////////////////////////////////////////////////////////////
-    double pressure = eos.get_pressure(epsilon, rhob);
+    double pressure = thermo_local->p;
     shear = (shear_to_s)*(epsilon + pressure)/(T + 1e-15);
     double tau_pi = 5.0*shear/(epsilon + pressure + 1e-15);
 
@@ -204,23 +211,23 @@ double Diss::Make_uWSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt_
     //                           { 0., 1., 0., 0.},
     //                           { 0., 0., 1., 0.},
     //                           { 0., 0., 0., 1.}};
-    //     double gamma = grid_pt->u[0];
-    //     double ueta  = grid_pt->u[3];
+    //     double gamma = grid_pt.u[0];
+    //     double ueta  = grid_pt.u[3];
     //     for (int a = 0; a < 4; a++) {
     //         for (int b = 0; b < 4; b++) {
     //             omega[a][b] = (
-    //                 (grid_pt->dUsup[a][b]
-    //                  - grid_pt->dUsup[b][a])/2.
+    //                 (grid_pt.dUsup[a][b]
+    //                  - grid_pt.dUsup[b][a])/2.
     //                 + ueta/tau/2.*(  gmunu[a][0]*gmunu[b][3]
     //                                - gmunu[b][0]*gmunu[a][3])
     //                 - ueta*gamma/tau/2.
-    //                   *(  gmunu[a][3]*grid_pt->u[b]
-    //                     - gmunu[b][3]*grid_pt->u[a])
+    //                   *(  gmunu[a][3]*grid_pt.u[b]
+    //                     - gmunu[b][3]*grid_pt.u[a])
     //                 + ueta*ueta/tau/2.
-    //                   *(   gmunu[a][0]*grid_pt->u[b]
-    //                      - gmunu[b][0]*grid_pt->u[a])
-    //                 + (  grid_pt->u[a]*a_local[b]
-    //                    - grid_pt->u[b]*a_local[a])/2.);
+    //                   *(   gmunu[a][0]*grid_pt.u[b]
+    //                      - gmunu[b][0]*grid_pt.u[a])
+    //                 + (  grid_pt.u[a]*a_local[b]
+    //                    - grid_pt.u[b]*a_local[a])/2.);
     //         }
     //     }
     //     double term1_Vorticity = (- Wmunu[mu][0]*omega[nu][0]
@@ -268,8 +275,8 @@ double Diss::Make_uWSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt_
                                 + Wmunu[nu][3]*sigma[mu][3])/2.;
 
         double term2_Wsigma = (-(1./3.)*(DATA.gmunu[mu][nu]
-                                         + grid_pt->u[mu]
-                                           *grid_pt->u[nu])*Wsigma);
+                                         + grid_pt.u[mu]
+                                           *grid_pt.u[nu])*Wsigma);
         // multiply term by its respective transport coefficient
         term1_Wsigma = transport_coefficient3*term1_Wsigma;
         term2_Wsigma = transport_coefficient3*term2_Wsigma;
@@ -301,7 +308,7 @@ double Diss::Make_uWSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt_
                             + Wmunu[mu][2]*Wmunu[nu][2]
                             + Wmunu[mu][3]*Wmunu[nu][3]);
         double term2_WW = (-(1./3.)*(DATA.gmunu[mu][nu]
-                                     + grid_pt->u[mu]*grid_pt->u[nu])*Wsquare);
+                                     + grid_pt.u[mu]*grid_pt.u[nu])*Wsquare);
         
         // multiply term by its respective transport coefficient
         term1_WW = term1_WW*transport_coefficient;
@@ -321,8 +328,8 @@ double Diss::Make_uWSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt_
     //////////////////////////////////////////////////////////////////////////
     double Coupling_to_Bulk = 0.0;
     if (DATA.include_second_order_terms == 1) {
-        double Bulk_Sigma = grid_pt->pi_b*sigma[mu][nu];
-        double Bulk_W = grid_pt->pi_b*Wmunu[mu][nu];
+        double Bulk_Sigma = grid_pt.pi_b*sigma[mu][nu];
+        double Bulk_W = grid_pt.pi_b*Wmunu[mu][nu];
 
         // multiply term by its respective transport coefficient
         double Bulk_Sigma_term = Bulk_Sigma*transport_coefficient_b;
@@ -340,11 +347,11 @@ double Diss::Make_uWSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt_
 }
 
 
-int Diss::Make_uWRHS(double tau, SCGrid &arena, int ix, int iy, int ieta,
+int Diss::Make_uWRHS(double tau, const CellStencil &stencil,
                      std::array< std::array<double,4>, 5> &w_rhs,
                      double theta_local, DumuVec &a_local) {
     const InitData *const DATAaligned = assume_aligned(&DATA);
-    auto& grid_pt = arena(ix, iy, ieta);
+    const auto& grid_pt = stencil.centre();
 
     w_rhs = {0};
 
@@ -373,67 +380,20 @@ int Diss::Make_uWRHS(double tau, SCGrid &arena, int ix, int iy, int ieta,
     const double delta_tau = DATA.delta_tau;
 
     // pi^\mu\nu is symmetric
-    Neighbourloop(arena, ix, iy, ieta, NLAMBDAS{
+    for (int direction = 1; direction <= n_directions; direction++) {
       for (int mu = 1; mu < 4; mu++) {
-        #pragma omp simd
         for (int nu = 0; nu < 4; nu++) {
           int idx_1d = map_2d_idx_to_1d(mu, nu);
-          double sum = 0.0;
-          /* Get_uWmns */
-          double g = c.Wmunu[idx_1d];
-          double f = g*c.u[direction];
-          g *=   c.u[0];
-
-          double gp2 = p2.Wmunu[idx_1d];
-          double fp2 = gp2*p2.u[direction];
-          gp2 *= p2.u[0];
-
-          double gp1 = p1.Wmunu[idx_1d];
-          double fp1 = gp1*p1.u[direction];
-          gp1 *= p1.u[0];
-
-          double gm1 = m1.Wmunu[idx_1d];
-          double fm1 = gm1*m1.u[direction];
-          gm1 *= m1.u[0];
-
-          double gm2 = m2.Wmunu[idx_1d];
-          double fm2 = gm2*m2.u[direction];
-          gm2 *= m2.u[0];
-
-          /* MakeuWmnHalfs */
-          /* uWmn */
-          double uWphR = fp1 - 0.5*minmod.minmod_dx(fp2, fp1, f);
-          double temp  = 0.5*minmod.minmod_dx(fp1, f, fm1);
-          double uWphL = f + temp;
-          double uWmhR = f - temp;
-          double uWmhL = fm1 + 0.5*minmod.minmod_dx(f, fm1, fm2);
-
-          /* just Wmn */
-          double WphR = gp1 - 0.5*minmod.minmod_dx(gp2, gp1, g);
-          temp        = 0.5*minmod.minmod_dx(gp1, g, gm1);
-          double WphL = g + temp;
-          double WmhR = g - temp;
-          double WmhL = gm1 + 0.5*minmod.minmod_dx(g, gm1, gm2);
-
-          double a   = fabs(c.u[direction])/c.u[0];
-          double am1 = (fabs(m1.u[direction])/m1.u[0]);
-          double ap1 = (fabs(p1.u[direction])/p1.u[0]);
-
-          double ax = maxi(a, ap1);
-          double HWph = ((uWphR + uWphL) - ax*(WphR - WphL))*0.5;
-
-          ax = maxi(a, am1);
-          double HWmh = ((uWmhR + uWmhL) - ax*(WmhR - WmhL))*0.5;
-
-          double HW = (HWph - HWmh)/delta[direction];
+          double HW = stencil.kt_flux_difference(minmod, direction,
+                        [idx_1d](SCGrid::const_reference cell) {
+                            return cell.Wmunu[idx_1d];
+                        })/delta[direction];
 
           /* make partial_i (u^i Wmn) */
-          sum += -HW;
-
-          w_rhs[mu][nu] += sum*delta_tau;
+          w_rhs[mu][nu] += -HW*delta_tau;
         }  /* nu */
       }  /* mu */
-    });
+    }
 
   for (int mu = 1; mu < 4; mu++) {
     #pragma omp simd
@@ -491,11 +451,11 @@ int Diss::Make_uWRHS(double tau, SCGrid &arena, int ix, int iy, int ieta,
 }
 
 
-int Diss::Make_uWRHS(double tau, SCGrid &arena, int ix, int iy, int ieta,
+int Diss::Make_uWRHS(double tau, const CellStencil &stencil,
                      int mu, int nu, double &w_rhs,
                      double theta_local, DumuVec &a_local) {
     const InitData *const DATAaligned = assume_aligned(&DATA);
-    auto& grid_pt = arena(ix, iy, ieta);
+    const auto& grid_pt = stencil.centre();
 
     w_rhs = 0.;
 
@@ -524,62 +484,16 @@ int Diss::Make_uWRHS(double tau, SCGrid &arena, int ix, int iy, int ieta,
     const double delta_tau = DATA.delta_tau;
 
     // pi^\mu\nu is symmetric
-    Neighbourloop(arena, ix, iy, ieta, NLAMBDAS{
-        int idx_1d = map_2d_idx_to_1d(mu, nu);
-        double sum = 0.0;
-        /* Get_uWmns */
-        double g = c.Wmunu[idx_1d];
-        double f = g*c.u[direction];
-        g *=   c.u[0];
-
-        double gp2 = p2.Wmunu[idx_1d];
-        double fp2 = gp2*p2.u[direction];
-        gp2 *= p2.u[0];
-
-        double gp1 = p1.Wmunu[idx_1d];
-        double fp1 = gp1*p1.u[direction];
-        gp1 *= p1.u[0];
-
-        double gm1 = m1.Wmunu[idx_1d];
-        double fm1 = gm1*m1.u[direction];
-        gm1 *= m1.u[0];
-
-        double gm2 = m2.Wmunu[idx_1d];
-        double fm2 = gm2*m2.u[direction];
-        gm2 *= m2.u[0];
-
-        /* MakeuWmnHalfs */
-        /* uWmn */
-        double uWphR = fp1 - 0.5*minmod.minmod_dx(fp2, fp1, f);
-        double temp  = 0.5*minmod.minmod_dx(fp1, f, fm1);
-        double uWphL = f + temp;
-        double uWmhR = f - temp;
-        double uWmhL = fm1 + 0.5*minmod.minmod_dx(f, fm1, fm2);
-
-        /* just Wmn */
-        double WphR = gp1 - 0.5*minmod.minmod_dx(gp2, gp1, g);
-        temp        = 0.5*minmod.minmod_dx(gp1, g, gm1);
-        double WphL = g + temp;
-        double WmhR = g - temp;
-        double WmhL = gm1 + 0.5*minmod.minmod_dx(g, gm1, gm2);
-
-        double a   = fabs(c.u[direction])/c.u[0];
-        double am1 = (fabs(m1.u[direction])/m1.u[0]);
-        double ap1 = (fabs(p1.u[direction])/p1.u[0]);
-
-        double ax = maxi(a, ap1);
-        double HWph = ((uWphR + uWphL) - ax*(WphR - WphL))*0.5;
-
-        ax = maxi(a, am1);
-        double HWmh = ((uWmhR + uWmhL) - ax*(WmhR - WmhL))*0.5;
-
-        double HW = (HWph - HWmh)/delta[direction];
+    const int idx_1d = map_2d_idx_to_1d(mu, nu);
+    for (int direction = 1; direction <= n_directions; direction++) {
+        double HW = stencil.kt_flux_difference(minmod, direction,
+                        [idx_1d](SCGrid::const_reference cell) {
+                            return cell.Wmunu[idx_1d];
+                        })/delta[direction];
 
         /* make partial_i (u^i Wmn) */
-        sum += -HW;
-
-        w_rhs += sum*delta_tau;
-    });
+        w_rhs += -HW*delta_tau;
+    }
 
     /* add a source term -u^tau Wmn/tau
        due to the coordinate change to tau-eta */
@@ -624,9 +538,9 @@ int Diss::Make_uWRHS(double tau, SCGrid &arena, int ix, int iy, int ieta,
 }
 
 
-int Diss::Make_uPRHS(double tau, SCGrid &arena, int ix, int iy, int ieta,
+int Diss::Make_uPRHS(double tau, const CellStencil &stencil,
                      double *p_rhs, double theta_local) {
-    auto grid_pt = &(arena(ix, iy, ieta));
+    const auto &grid_pt = stencil.centre();
     double bulk_on = DATA.turn_on_bulk;
 
     /* Kurganov-Tadmor for Pi */
@@ -654,75 +568,27 @@ int Diss::Make_uPRHS(double tau, SCGrid &arena, int ix, int iy, int ieta,
     delta[3] = DATA.delta_eta*tau;
 
     double sum = 0.0;
-    Neighbourloop(arena, ix, iy, ieta, NLAMBDAS{
-        /* Get_uPis */
-        double g = c.pi_b;
-        double f = g*c.u[direction];
-        g *= c.u[0];
-
-        double gp2 = p2.pi_b;
-        double fp2 = gp2*p2.u[direction];
-        gp2 *= p2.u[0];
-
-        double gp1 = p1.pi_b;
-        double fp1 = gp1*p1.u[direction];
-        gp1 *= p1.u[0];
-
-        double gm1 = m1.pi_b;
-        double fm1 = gm1*m1.u[direction];
-        gm1 *= m1.u[0];
-
-        double gm2 = m2.pi_b;
-        double fm2 = gm2*m2.u[direction];
-        gm2 *= m2.u[0];
-
-        /*  Make upi Halfs */
-        /* uPi */
-        double uPiphR = fp1 - 0.5*minmod.minmod_dx(fp2, fp1, f);
-        double temp = 0.5*minmod.minmod_dx(fp1, f, fm1);
-        double uPiphL = f + temp;
-        double uPimhR = f - temp;
-        double uPimhL = fm1 + 0.5*minmod.minmod_dx(f, fm1, fm2);
-
-        /* just Pi */
-        double PiphR = gp1 - 0.5*minmod.minmod_dx(gp2, gp1, g);
-        temp = 0.5*minmod.minmod_dx(gp1, g, gm1);
-        double PiphL = g + temp;
-        double PimhR = g - temp;
-        double PimhL = gm1 + 0.5*minmod.minmod_dx(g, gm1, gm2);
-
-        /* MakePimnCurrents following Kurganov-Tadmor */
-        double a = fabs(c.u[direction]);
-        a /= c.u[0];
-
-        double am1 = fabs(m1.u[direction]);
-        am1 /= m1.u[0];
-
-        double ap1 = fabs(p1.u[direction]);
-        ap1 /= p1.u[0];
-
-        double ax = std::max(a, ap1);
-        double HPiph = ((uPiphR + uPiphL) - ax*(PiphR - PiphL))*0.5;
-
-        ax = std::max(a, am1);
-        double HPimh = ((uPimhR + uPimhL) - ax*(PimhR - PimhL))*0.5;
-
-        double HPi = (HPiph - HPimh)/delta[direction];
+    for (int direction = 1; direction <= n_directions; direction++) {
+        double HPi = stencil.kt_flux_difference(minmod, direction,
+                        [](SCGrid::const_reference cell) {return cell.pi_b;}
+                     )/delta[direction];
 
         /* make partial_i (u^i Pi) */
         sum += -HPi;
-    });
+    }
 
      /* add a source term due to the coordinate change to tau-eta */
-     sum -= (grid_pt->pi_b)*(grid_pt->u[0])/tau;
-     sum += (grid_pt->pi_b)*theta_local;
+     sum -= (grid_pt.pi_b)*(grid_pt.u[0])/tau;
+     sum += (grid_pt.pi_b)*theta_local;
      *p_rhs = sum*(DATA.delta_tau)*bulk_on;
 
      return 1;
 }
 
 
-double Diss::Make_uPiSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt_prev, 
+double Diss::Make_uPiSource(double tau, SCGrid::const_reference grid_pt,
+                        SCGrid::const_reference grid_pt_prev,
+                        const ThermoCell *thermo, const ThermoCell *thermo_prev,
                         int rk_flag, double theta_local, VelocityShearVec &sigma_1d) {
     if (DATA.turn_on_bulk == 0) return 0.0;
 
@@ -742,13 +608,14 @@ double Diss::Make_uPiSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt
         include_coupling_to_shear = 1;
     }
 
-    double epsilon, rhob;
+    double epsilon;
+    const ThermoCell *thermo_local;
     if (rk_flag == 0) {
-        epsilon = grid_pt->epsilon;
-        rhob = grid_pt->rhob;
+        epsilon = grid_pt.epsilon;
+        thermo_local = thermo;
     } else {
-        epsilon = grid_pt_prev->epsilon;
-        rhob = grid_pt_prev->rhob;
+        epsilon = grid_pt_prev.epsilon;
+        thermo_local = thermo_prev;
     }
 
     // defining bulk viscosity coefficient
@@ -757,11 +624,11 @@ double Diss::Make_uPiSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt
     //s_den = eos.get_entropy(epsilon, rhob);
     //shear = (DATA.shear_to_s)*s_den;   
     // shear viscosity = constant * (e + P)/T
-    double temperature = eos.get_temperature(epsilon, rhob);
+    double temperature = thermo_local->T;
 
     // cs2 is the velocity of sound squared
-    double cs2 = eos.get_cs2(epsilon, rhob);
-    double pressure = eos.get_pressure(epsilon, rhob);
+    double cs2 = thermo_local->cs2;
+    double pressure = thermo_local->p;
 
     // T dependent bulk viscosity from Gabriel
     bulk = get_temperature_dependent_zeta_s(temperature);
@@ -786,13 +653,13 @@ double Diss::Make_uPiSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt
 
     // Computing relaxation term and nonlinear term:
     // - Bulk - transport_coeff1*Bulk*theta
-    tempf = (-(grid_pt->pi_b)
-             - transport_coeff1*theta_local*(grid_pt->pi_b));
+    tempf = (-(grid_pt.pi_b)
+             - transport_coeff1*theta_local*(grid_pt.pi_b));
 
     // Computing nonlinear term: + transport_coeff2*Bulk*Bulk
     if (include_BBterm == 1) {
-        BB_term = (transport_coeff2*(grid_pt->pi_b)
-                   *(grid_pt->pi_b));
+        BB_term = (transport_coeff2*(grid_pt.pi_b)
+                   *(grid_pt.pi_b));
     } else {
         BB_term = 0.0;
     }
@@ -802,7 +669,7 @@ double Diss::Make_uPiSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt
 
     if (include_coupling_to_shear == 1) {
         auto sigma = Util::UnpackVecToMatrix(sigma_1d);
-	    auto Wmunu = Util::UnpackVecToMatrix(grid_pt->Wmunu);
+	    auto Wmunu = Util::UnpackVecToMatrix(grid_pt.Wmunu);
 
         Wsigma = (  Wmunu[0][0]*sigma[0][0]
                   + Wmunu[1][1]*sigma[1][1]
@@ -855,26 +722,31 @@ double Diss::Make_uPiSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt
     -u[a]u[b]g[b][e] Dq[e]
 */
 double Diss::Make_uqSource(
-    double tau, Cell_small *grid_pt, Cell_small *grid_pt_prev, int nu,
+    double tau, SCGrid::const_reference grid_pt,
+    SCGrid::const_reference grid_pt_prev,
+    const ThermoCell *thermo, const ThermoCell *thermo_prev, int nu,
     int rk_flag, double theta_local, DumuVec &a_local,
     VelocityShearVec &sigma_1d, DmuMuBoverTVec &baryon_diffusion_vec) {
     if (DATA.turn_on_diff == 0) return 0.0;
 
     double epsilon, rhob;
+    const ThermoCell *thermo_local;
     if (rk_flag == 0) {
-        epsilon = grid_pt->epsilon;
-        rhob = grid_pt->rhob;
+        epsilon = grid_pt.epsilon;
+        rhob = grid_pt.rhob;
+        thermo_local = thermo;
     } else {
-        epsilon = grid_pt_prev->epsilon;
-        rhob = grid_pt_prev->rhob;
+        epsilon = grid_pt_prev.epsilon;
+        rhob = grid_pt_prev.rhob;
+        thermo_local = thermo_prev;
     }
-    double pressure = eos.get_pressure(epsilon, rhob);
-    double T        = eos.get_temperature(epsilon, rhob);
+    double pressure = thermo_local->p;
+    double T        = thermo_local->T;
 
     double kappa_coefficient = DATA.kappa_coefficient;
     double tau_rho = kappa_coefficient/(T + 1e-15);
     tau_rho = std::max(3.*DATA.delta_tau, tau_rho);
-    double mub     = eos.get_mu(epsilon, rhob);
+    double mub     = thermo_local->muB;
     double alpha   = mub/T;
     double kappa   = kappa_coefficient*(rhob/(3.*T*tanh(alpha) + 1e-15)
                                       - rhob*rhob/(epsilon + pressure));
@@ -887,7 +759,7 @@ double Diss::Make_uqSource(
     // copy the value of \tilde{q^\mu}
     double q[4];
     for (int i = 0; i < 4; i++) {
-        q[i] = grid_pt->Wmunu[10+i];
+        q[i] = grid_pt.Wmunu[10+i];
     }
 
     /* -(1/tau_rho)(q[a] + kappa g[a][b]Dtildemu[b] 
@@ -905,7 +777,7 @@ double Diss::Make_uqSource(
     // -(1/tau_rho)(q[a] + kappa g[a][b]DmuB/T[b]
     // + kappa u[a] u[b]g[b][c]DmuB/T[c])
     // a = nu
-    double NS = kappa*(baryon_diffusion_vec[nu] + grid_pt->u[nu]*a_local[4]);
+    double NS = kappa*(baryon_diffusion_vec[nu] + grid_pt.u[nu]*a_local[4]);
 
     // add a new non-linear term (- q \theta)
     double transport_coeff = 1.0*tau_rho;   // from conformal kinetic theory
@@ -928,18 +800,18 @@ double Diss::Make_uqSource(
 
     // all other geometric terms....
     // + theta q[a] - q[a] u^\tau/tau
-    SW += (theta_local - grid_pt->u[0]/tau)*q[nu];
+    SW += (theta_local - grid_pt.u[0]/tau)*q[nu];
     // if (isnan(SW)) {
     //     cout << "theta term is nan! " << endl;
     // }
 
     // +Delta[a][tau] u[eta] q[eta]/tau
     double tempf = ((DATA.gmunu[nu][0]
-                    + grid_pt->u[nu]*grid_pt->u[0])
-                      *grid_pt->u[3]*q[3]/tau
+                    + grid_pt.u[nu]*grid_pt.u[0])
+                      *grid_pt.u[3]*q[3]/tau
                     - (DATA.gmunu[nu][3]
-                       + grid_pt->u[nu]*grid_pt->u[3])
-                      *grid_pt->u[3]*q[0]/tau);
+                       + grid_pt.u[nu]*grid_pt.u[3])
+                      *grid_pt.u[3]*q[0]/tau);
     SW += tempf;
     // if (isnan(tempf)) {
     //     cout << "Delta^{a \tau} and Delta^{a \eta} terms are nan!" << endl;
@@ -950,7 +822,7 @@ double Diss::Make_uqSource(
     for (int i = 0; i < 4; i++) {
         tempf += q[i]*gmn(i)*a_local[i];
     }
-    SW += (grid_pt->u[nu])*tempf;
+    SW += (grid_pt.u[nu])*tempf;
     // if (isnan(tempf)) {
     //     cout << "u^a q_b Du^b term is nan! " << endl;
     // }
@@ -958,7 +830,7 @@ double Diss::Make_uqSource(
 }
 
 
-double Diss::Make_uqRHS(double tau, SCGrid &arena, int ix, int iy, int ieta,
+double Diss::Make_uqRHS(double tau, const CellStencil &stencil,
                         int mu, int nu) {
     /* Kurganov-Tadmor for q */
     /* implement 
@@ -983,57 +855,14 @@ double Diss::Make_uqRHS(double tau, SCGrid &arena, int ix, int iy, int ieta,
     // we use the Wmunu[4][nu] = q[nu]
     int idx_1d = map_2d_idx_to_1d(mu, nu);
     double sum = 0.0;
-    Neighbourloop(arena, ix, iy, ieta, NLAMBDAS{
-        /* Get_uWmns */
-        double g = c.Wmunu[idx_1d];
-        double f = g*c.u[direction];
-        g *=   c.u[0];
-
-        double gp2 = p2.Wmunu[idx_1d];
-        double fp2 = gp2*p2.u[direction];
-        gp2 *=     p2.u[0];
-
-        double gp1 = p1.Wmunu[idx_1d];
-        double fp1 = gp1*p1.u[direction];
-        gp1 *=     p1.u[0];
-
-        double gm1 = m1.Wmunu[idx_1d];
-        double fm1 = gm1*m1.u[direction];
-        gm1 *=     m1.u[0];
-
-        double gm2 = m2.Wmunu[idx_1d];
-        double fm2 = gm2*m2.u[direction];
-        gm2 *=     m2.u[0];
-
-        /*  MakeuWmnHalfs */
-        /* uWmn */
-        double uWphR = fp1 - 0.5*minmod.minmod_dx(fp2, fp1, f);
-        double temp = 0.5*minmod.minmod_dx(fp1, f, fm1);
-        double uWphL = f + temp;
-        double uWmhR = f - temp;
-        double uWmhL = fm1 + 0.5*minmod.minmod_dx(f, fm1, fm2);
-
-        /* just Wmn */
-        double WphR = gp1 - 0.5*minmod.minmod_dx(gp2, gp1, g);
-        temp = 0.5*minmod.minmod_dx(gp1, g, gm1);
-        double WphL = g + temp;
-        double WmhR = g - temp;
-        double WmhL = gm1 + 0.5*minmod.minmod_dx(g, gm1, gm2);
-
-        double a = fabs(c.u[direction])/c.u[0];
-
-        double am1 = (fabs(m1.u[direction])/m1.u[0]);
-        double ap1 = (fabs(p1.u[direction])/p1.u[0]);
-        double ax = std::max(a, ap1);
-        double HWph = ((uWphR + uWphL) - ax*(WphR - WphL))*0.5;
-
-        ax = std::max(a, am1);
-        double HWmh = ((uWmhR + uWmhL) - ax*(WmhR - WmhL))*0.5;
-
-        double HW = (HWph - HWmh)/delta[direction];
+    for (int direction = 1; direction <= n_directions; direction++) {
+        double HW = stencil.kt_flux_difference(minmod, direction,
+                        [idx_1d](SCGrid::const_reference cell) {
+                            return cell.Wmunu[idx_1d];
+                        })/delta[direction];
         /* make partial_i (u^i Wmn) */
         sum += -HW;
-    });
+    }
 
     /* add a source term -u^tau Wmn/tau due to the coordinate 
      * change to tau-eta */
@@ -1041,8 +870,8 @@ double Diss::Make_uqRHS(double tau, SCGrid &arena, int ix, int iy, int ieta,
     /* this is from udW = d(uW) - Wdu = RHS */
     /* or d(uW) = udW + Wdu */
     /* 
-     * sum -= (grid_pt->u[rk_flag][0])*(grid_pt->Wmunu[rk_flag][mu][nu])/tau;
-     * sum += (grid_pt->theta_u[rk_flag])*(grid_pt->Wmunu[rk_flag][mu][nu]);
+     * sum -= (grid_pt.u[rk_flag][0])*(grid_pt.Wmunu[rk_flag][mu][nu])/tau;
+     * sum += (grid_pt.theta_u[rk_flag])*(grid_pt.Wmunu[rk_flag][mu][nu]);
     */  
     return(sum*(DATA.delta_tau));
 }
@@ -1142,11 +971,36 @@ double Diss::get_temperature_dependent_zeta_s(double temperature) {
     double zsw = 0.022/hbarc;
     double T0 = 0.183/hbarc; 
     double bulk = zsmax / (1 + pow((temperature - T0)/zsw,2));
- 
+
     return(bulk);
 }
 
 
+//! shortest relaxation time [fm] of the dissipative currents that are
+//! switched on, as in the source terms before their 3*delta_tau floor
+double Diss::get_shortest_relaxation_time(const ThermoCell &thermo) {
+    const double T = thermo.T + 1e-15;
+    double relaxation_time = 10.;
+    if (DATA.turn_on_shear == 1) {
+        double shear_to_s = DATA.shear_to_s;
+        if (DATA.T_dependent_shear_to_s == 1) {
+            shear_to_s = get_temperature_dependent_eta_s(thermo.T);
+        }
+        relaxation_time = std::min(relaxation_time, 5.*shear_to_s/T);
+    }
+    if (DATA.turn_on_bulk == 1) {
+        const double zeta_s = get_temperature_dependent_zeta_s(thermo.T);
+        const double conformal_breaking = 1./3. - thermo.cs2;
+        relaxation_time = std::min(relaxation_time,
+            zeta_s/(14.55*conformal_breaking*conformal_breaking*T));
+    }
+    if (DATA.turn_on_diff == 1) {
+        relaxation_time = std::min(relaxation_time, DATA.kappa_coefficient/T);
+    }
+    return(relaxation_time);
+}
+
+
 //! this function outputs the T and muB dependence of the baryon diffusion
 //! coefficient, kappa
 void Diss::output_kappa_T_and_muB_dependence() {
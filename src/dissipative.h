@@ -9,12 +9,15 @@
 #include "grid.h"
 #include "data.h"
 #include "minmod.h"
+#include "cell_stencil.h"
 
 class Diss {
  private:
     const InitData &DATA;
     const EOS &eos;
     const Minmod minmod;
+    //! 2 for boost-invariant runs, whose eta gradients vanish
+    const int n_directions;
     int map_2d_idx_to_1d(int a, int b) {
         static const int index_map[5][4] = {{0,   1,  2,  3},
                                             {1,   4,  5,  6},
@@ -26,35 +29,46 @@ class Diss {
 
  public:
     Diss(const EOS &eosIn, const InitData &DATA_in);
-    double MakeWSource(double tau, int alpha,
-                       SCGrid &arena_current, SCGrid &arena_prev,
-                       int ix, int iy, int ieta);
+    //! the stencil terms below read the neighbourhood of the cell from
+    //! stencil, gathered from arena_current
+    double MakeWSource(double tau, int alpha, const CellStencil &stencil,
+                       SCGrid::const_reference grid_pt_prev);
 
-    int Make_uWRHS(double tau, SCGrid &arena, int ix, int iy, int ieta,
+    int Make_uWRHS(double tau, const CellStencil &stencil,
                    std::array< std::array<double,4>, 5> &w_rhs,
                    double theta_local, DumuVec &a_local);
-    double Make_uWSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt_prev,
+    //! thermo and thermo_prev are the EOS output of grid_pt and
+    //! grid_pt_prev; the same holds for the other source terms
+    double Make_uWSource(double tau, SCGrid::const_reference grid_pt,
+                         SCGrid::const_reference grid_pt_prev,
+                         const ThermoCell *thermo, const ThermoCell *thermo_prev,
                          int mu, int nu, int rk_flag, double theta_local,
                          DumuVec &a_local, VelocityShearVec &sigma_1d);
 
-    int Make_uWRHS(double tau, SCGrid &arena, int ix, int iy, int ieta,
+    int Make_uWRHS(double tau, const CellStencil &stencil,
                    int mu, int nu, double &w_rhs,
                    double theta_local, DumuVec &a_local);
 
-    int Make_uPRHS(double tau, SCGrid &arena, int ix, int iy, int ieta,
+    int Make_uPRHS(double tau, const CellStencil &stencil,
                    double *p_rhs, double theta_local);
-    double Make_uPiSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt_prev,
+    double Make_uPiSource(double tau, SCGrid::const_reference grid_pt,
+                          SCGrid::const_reference grid_pt_prev,
+                          const ThermoCell *thermo, const ThermoCell *thermo_prev,
                           int rk_flag, double theta_local, VelocityShearVec &sigma_1d);
 
-    double Make_uqRHS(double tau, SCGrid &arena_current, int ix, int iy, int ieta,
+    double Make_uqRHS(double tau, const CellStencil &stencil,
                       int mu, int nu);
-    double Make_uqSource(double tau, Cell_small *grid_pt, Cell_small *grid_pt_prev, int nu,
+    double Make_uqSource(double tau, SCGrid::const_reference grid_pt,
+                         SCGrid::const_reference grid_pt_prev,
+                         const ThermoCell *thermo, const ThermoCell *thermo_prev,
+                         int nu,
                          int rk_flag, double theta_local, DumuVec &a_local,
                          VelocityShearVec &sigma_1d,
                          DmuMuBoverTVec &baryon_diffusion_vec);
 
     double get_temperature_dependent_eta_s(double T);
     double get_temperature_dependent_zeta_s(double temperature);
+    double get_shortest_relaxation_time(const ThermoCell &thermo);
 
     void output_kappa_T_and_muB_dependence();
     void output_kappa_along_const_sovernB();
@@ -0,0 +1,229 @@
+#include <cstdlib>
+#include <iostream>
+#ifdef MUSIC_MPI
+#include <mpi.h>
+#endif
+
+#include "domain.h"
+#include "pretty_ostream.h"
+
+#ifdef MUSIC_MPI
+struct Domain::PendingExchange {
+    MPI_Request requests[4];
+    int n_requests = 0;
+};
+#else
+struct Domain::PendingExchange {};
+#endif
+
+
+Domain::Domain() {
+#ifdef MUSIC_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank_);
+    MPI_Comm_size(MPI_COMM_WORLD, &n_ranks_);
+    pending.reset(new PendingExchange);
+#endif
+}
+
+
+Domain::~Domain() {}
+
+
+void Domain::initialize(int &argc, char **&argv) {
+#ifdef MUSIC_MPI
+    // MPI is only called from outside the OpenMP regions
+    int provided;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (rank != 0) std::cout.rdbuf(nullptr);
+#endif
+}
+
+
+void Domain::finalize() {
+#ifdef MUSIC_MPI
+    MPI_Finalize();
+#endif
+}
+
+
+int Domain::world_size() {
+    int n_ranks = 1;
+#ifdef MUSIC_MPI
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if (initialized) MPI_Comm_size(MPI_COMM_WORLD, &n_ranks);
+#endif
+    return(n_ranks);
+}
+
+
+void Domain::decompose(int neta_global) {
+    neta_global_ = neta_global;
+    if (n_ranks_ > 1 && neta_global < SCGrid::NG*n_ranks_) {
+        pretty_ostream music_message;
+        music_message << "Domain::decompose: " << neta_global
+                      << " eta slices can not be shared by " << n_ranks_
+                      << " ranks, every rank needs at least "
+                      << SCGrid::NG << ".";
+        music_message.flush("error");
+        exit(1);
+    }
+    const int base  = neta_global/n_ranks_;
+    const int extra = neta_global%n_ranks_;
+    neta_local_ = base + (rank_ < extra ? 1 : 0);
+    eta_begin_  = rank_*base + std::min(rank_, extra);
+}
+
+
+void Domain::post_exchange(char *send_lower, char *recv_lower,
+                           char *send_upper, char *recv_upper,
+                           std::size_t bytes, int n_blocks,
+                           std::size_t block_stride) const {
+#ifdef MUSIC_MPI
+    // one transfer of the n_blocks blocks, which the type describes
+    MPI_Datatype block_type;
+    MPI_Type_create_hvector(n_blocks, static_cast<int>(bytes), block_stride,
+                            MPI_BYTE, &block_type);
+    MPI_Type_commit(&block_type);
+    auto &p = *pending;
+    p.n_requests = 0;
+    if (has_lower_neighbour()) {
+        MPI_Irecv(recv_lower, 1, block_type, rank_ - 1, 1, MPI_COMM_WORLD,
+                  &p.requests[p.n_requests++]);
+        MPI_Isend(send_lower, 1, block_type, rank_ - 1, 0, MPI_COMM_WORLD,
+                  &p.requests[p.n_requests++]);
+    }
+    if (has_upper_neighbour()) {
+        MPI_Irecv(recv_upper, 1, block_type, rank_ + 1, 0, MPI_COMM_WORLD,
+                  &p.requests[p.n_requests++]);
+        MPI_Isend(send_upper, 1, block_type, rank_ + 1, 1, MPI_COMM_WORLD,
+                  &p.requests[p.n_requests++]);
+    }
+    // the pending transfers keep the type alive
+    MPI_Type_free(&block_type);
+#endif
+}
+
+
+void Domain::finish_halo_exchange() const {
+#ifdef MUSIC_MPI
+    if (n_ranks_ == 1) return;
+    MPI_Waitall(pending->n_requests, pending->requests, MPI_STATUSES_IGNORE);
+    pending->n_requests = 0;
+#endif
+}
+
+
+SCGrid Domain::local_slab(const SCGrid &global) const {
+    SCGrid local(global.nX(), global.nY(), neta_local_);
+    for (int ieta = 0; ieta < neta_local_; ieta++)
+    for (int iy = 0; iy < global.nY(); iy++)
+    for (int ix = 0; ix < global.nX(); ix++) {
+        local(ix, iy, ieta) = global(ix, iy, eta_begin_ + ieta);
+    }
+    return local;
+}
+
+
+void Domain::gather(const SCGrid &local, SCGrid &global) const {
+    if (n_ranks_ == 1) {
+        global = local;
+        return;
+    }
+#ifdef MUSIC_MPI
+    const int nx = local.nX();
+    const int ny = local.nY();
+    std::vector<Cell_small> send(local.size());
+    for (int i = 0; i < local.size(); i++) send[i] = local(i);
+
+    MPI_Datatype cell_type;
+    MPI_Type_contiguous(sizeof(Cell_small), MPI_BYTE, &cell_type);
+    MPI_Type_commit(&cell_type);
+
+    // slices of a rank are contiguous in the order of the ranks
+    std::vector<int> counts(n_ranks_), offsets(n_ranks_);
+    const int base  = neta_global_/n_ranks_;
+    const int extra = neta_global_%n_ranks_;
+    for (int r = 0; r < n_ranks_; r++) {
+        counts[r]  = (base + (r < extra ? 1 : 0))*nx*ny;
+        offsets[r] = (r*base + std::min(r, extra))*nx*ny;
+    }
+    std::vector<Cell_small> receive;
+    if (is_root()) receive.resize(nx*ny*neta_global_);
+    MPI_Gatherv(send.data(), local.size(), cell_type,
+                receive.data(), counts.data(), offsets.data(), cell_type,
+                0, MPI_COMM_WORLD);
+    MPI_Type_free(&cell_type);
+
+    if (is_root()) {
+        if (global.nX() != nx || global.nY() != ny
+                || global.nEta() != neta_global_) {
+            global = SCGrid(nx, ny, neta_global_);
+        }
+        for (int i = 0; i < global.size(); i++) global(i) = receive[i];
+    }
+#endif
+}
+
+
+double Domain::sum(double value) const {
+#ifdef MUSIC_MPI
+    if (n_ranks_ > 1) {
+        MPI_Allreduce(MPI_IN_PLACE, &value, 1, MPI_DOUBLE, MPI_SUM,
+                      MPI_COMM_WORLD);
+    }
+#endif
+    return(value);
+}
+
+
+void Domain::sum(std::vector<double> &values) const {
+#ifdef MUSIC_MPI
+    if (n_ranks_ > 1) {
+        MPI_Allreduce(MPI_IN_PLACE, values.data(), values.size(), MPI_DOUBLE,
+                      MPI_SUM, MPI_COMM_WORLD);
+    }
+#endif
+}
+
+
+int Domain::sum(int value) const {
+#ifdef MUSIC_MPI
+    if (n_ranks_ > 1) {
+        MPI_Allreduce(MPI_IN_PLACE, &value, 1, MPI_INT, MPI_SUM,
+                      MPI_COMM_WORLD);
+    }
+#endif
+    return(value);
+}
+
+
+double Domain::max(double value) const {
+#ifdef MUSIC_MPI
+    if (n_ranks_ > 1) {
+        MPI_Allreduce(MPI_IN_PLACE, &value, 1, MPI_DOUBLE, MPI_MAX,
+                      MPI_COMM_WORLD);
+    }
+#endif
+    return(value);
+}
+
+
+double Domain::min(double value) const {
+#ifdef MUSIC_MPI
+    if (n_ranks_ > 1) {
+        MPI_Allreduce(MPI_IN_PLACE, &value, 1, MPI_DOUBLE, MPI_MIN,
+                      MPI_COMM_WORLD);
+    }
+#endif
+    return(value);
+}
+
+
+void Domain::barrier() const {
+#ifdef MUSIC_MPI
+    if (n_ranks_ > 1) MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}
@@ -0,0 +1,110 @@
+#ifndef SRC_DOMAIN_H_
+#define SRC_DOMAIN_H_
+
+#include <memory>
+#include <vector>
+#include "grid.h"
+
+//! Slab decomposition of the eta axis of the hydro grid over MPI ranks
+//! (compiled in with MUSIC_MPI defined). Every rank evolves the eta slices
+//! [eta_begin(), eta_begin() + neta_local()) of the global grid in grids
+//! of its own, whose NG ghost slices at a cut between two ranks hold
+//! copies of the neighbouring rank's cells. Without MUSIC_MPI there is a
+//! single rank that owns the whole grid and the exchanges do nothing.
+class Domain {
+ private:
+    int rank_    = 0;
+    int n_ranks_ = 1;
+    int neta_global_ = 0;
+    int eta_begin_   = 0;
+    int neta_local_  = 0;
+
+    //! requests of the halo exchange in flight
+    struct PendingExchange;
+    std::unique_ptr<PendingExchange> pending;
+
+    //! posts the transfers of the first and last NG slices of a grid to
+    //! the neighbouring ranks. Every transfer is n_blocks blocks of bytes
+    //! bytes that start block_stride bytes apart.
+    void post_exchange(char *send_lower, char *recv_lower,
+                       char *send_upper, char *recv_upper,
+                       std::size_t bytes, int n_blocks = 1,
+                       std::size_t block_stride = 0) const;
+
+ public:
+    Domain();
+    ~Domain();
+
+    //! MPI_Init and MPI_Finalize; only the root rank writes to stdout
+    static void initialize(int &argc, char **&argv);
+    static void finalize();
+    //! number of MPI ranks of the run, 1 before initialize
+    static int world_size();
+
+    //! splits neta_global slices evenly, every rank needs at least NG
+    void decompose(int neta_global);
+
+    int  rank()        const {return rank_;}
+    int  n_ranks()     const {return n_ranks_;}
+    bool is_root()     const {return rank_ == 0;}
+    int  eta_begin()   const {return eta_begin_;}
+    int  neta_local()  const {return neta_local_;}
+    int  neta_global() const {return neta_global_;}
+    bool has_lower_neighbour() const {return rank_ > 0;}
+    bool has_upper_neighbour() const {return rank_ < n_ranks_ - 1;}
+    //! true if the last local slice is the last slice of the global grid
+    bool owns_last_slice() const {return !has_upper_neighbour();}
+
+    //! overwrites the ghost slices at the cuts with the cells of the
+    //! neighbouring ranks. The exchange can run while the caller works on
+    //! the interior: start, compute, finish. The other ghost cells of grid
+    //! have to be filled (update_halo) before the start, so that the
+    //! slices that are sent are complete. The eta slices are contiguous
+    //! in GridT, per field for the SoA layout.
+    template<class T, class Layout>
+    void start_halo_exchange(GridT<T, Layout> &grid) const {
+        if (n_ranks_ == 1) return;
+        const int NG = GridT<T, Layout>::NG;
+        const int neta = grid.nEta();
+        char *send_lower, *recv_lower, *send_upper, *recv_upper;
+        std::size_t bytes, block_stride;
+        int n_blocks;
+        grid.slices(0,         NG, send_lower, bytes, n_blocks, block_stride);
+        grid.slices(-NG,       NG, recv_lower, bytes, n_blocks, block_stride);
+        grid.slices(neta - NG, NG, send_upper, bytes, n_blocks, block_stride);
+        grid.slices(neta,      NG, recv_upper, bytes, n_blocks, block_stride);
+        post_exchange(send_lower, recv_lower, send_upper, recv_upper, bytes,
+                      n_blocks, block_stride);
+    }
+    void finish_halo_exchange() const;
+    //! sends the bytes at send_lower and send_upper to the lower and the
+    //! upper neighbouring rank and receives theirs in recv_lower and
+    //! recv_upper, which are left alone at the ends of the grid
+    void exchange_edges(char *send_lower, char *recv_lower,
+                        char *send_upper, char *recv_upper,
+                        std::size_t bytes) const {
+        if (n_ranks_ == 1 || bytes == 0) return;
+        post_exchange(send_lower, recv_lower, send_upper, recv_upper, bytes);
+        finish_halo_exchange();
+    }
+    template<class T, class Layout>
+    void exchange_halo(GridT<T, Layout> &grid) const {
+        start_halo_exchange(grid);
+        finish_halo_exchange();
+    }
+
+    //! the local slab of a grid that holds the whole domain
+    SCGrid local_slab(const SCGrid &global) const;
+    //! collects the slabs of all ranks in global on the root rank
+    void gather(const SCGrid &local, SCGrid &global) const;
+
+    //! reductions over all ranks
+    double sum(double value) const;
+    void   sum(std::vector<double> &values) const;
+    int    sum(int value) const;
+    double max(double value) const;
+    double min(double value) const;
+    void   barrier() const;
+};
+
+#endif  // SRC_DOMAIN_H_
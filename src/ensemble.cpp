@@ -0,0 +1,132 @@
+#include <omp.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ensemble.h"
+#include "evolve.h"
+#include "grid.h"
+#include "hydro_source.h"
+#include "init.h"
+#include "read_in_parameters.h"
+
+using std::string;
+
+Ensemble::Ensemble(const ParameterList &parameters) :
+    threads_per_event(std::max(
+                1, parameters.get<int>("ensemble_threads_per_event", 1))),
+    DATA(ReadInParameters::read_in_parameters(parameters)),
+    eos(DATA) {
+    const string list_file = parameters.get("ensemble_list", "");
+
+    Domain domain;
+    if (domain.n_ranks() > 1) {
+        music_message << "Ensemble runs use a single MPI rank, "
+                      << domain.n_ranks() << " were started.";
+        music_message.flush("error");
+        exit(1);
+    }
+
+    for (const auto &event_parameters : read_event_list(list_file,
+                                                        parameters)) {
+        events.push_back(
+                ReadInParameters::read_in_parameters(event_parameters));
+        const InitData &event = events.back();
+        if (event.mode != 2) {
+            music_message << "Ensemble runs do the hydro evolution only, "
+                          << "mode must be 2 for " << event.output_dir;
+            music_message.flush("error");
+            exit(1);
+        }
+        if (event.whichEOS != DATA.whichEOS) {
+            music_message << "All events of an ensemble share the EOS, "
+                          << "EOS_to_use can not be changed for "
+                          << event.output_dir;
+            music_message.flush("error");
+            exit(1);
+        }
+        // Domain calls MPI, which is only done outside the OpenMP regions
+        domains.emplace_back(new Domain);
+    }
+    music_message << "Ensemble of " << n_events() << " events from "
+                  << list_file << ", " << threads_per_event
+                  << " threads per event.";
+    music_message.flush("info");
+}
+
+
+std::vector<ParameterList> Ensemble::read_event_list(
+                const string &list_file, const ParameterList &base) {
+    pretty_ostream music_message;
+    std::ifstream list(list_file.c_str());
+    if (!list.is_open()) {
+        music_message << "Can not open the ensemble list " << list_file;
+        music_message.flush("error");
+        exit(1);
+    }
+    std::vector<ParameterList> event_list;
+    std::vector<string> output_dirs;
+    string line;
+    while (getline(list, line)) {
+        string entries;
+        std::stringstream line_ss(line);
+        getline(line_ss, entries, '#');  // remove the comments
+        std::stringstream entries_ss(entries);
+        string output_dir;
+        if (!(entries_ss >> output_dir)) continue;
+        if (std::find(output_dirs.begin(), output_dirs.end(), output_dir)
+                != output_dirs.end()) {
+            music_message << "Output directory " << output_dir
+                          << " is used by two events of the ensemble.";
+            music_message.flush("error");
+            exit(1);
+        }
+        output_dirs.push_back(output_dir);
+
+        ParameterList event_parameters = base;
+        event_parameters.set("output_dir", output_dir);
+        string name, value;
+        while (entries_ss >> name) {
+            if (!(entries_ss >> value)) {
+                music_message << "Parameter " << name << " of event "
+                              << output_dir << " has no value.";
+                music_message.flush("error");
+                exit(1);
+            }
+            event_parameters.set(name, value);
+        }
+        event_list.push_back(event_parameters);
+    }
+    return event_list;
+}
+
+
+void Ensemble::run_event(int i_event) {
+    InitData &event = events[i_event];
+    Domain &domain = *domains[i_event];
+    hydro_source hydro_source_terms(event);
+    SCGrid arena_prev, arena_current, arena_future;
+
+    Init init(eos, event, hydro_source_terms, domain);
+    init.InitArena(arena_prev, arena_current, arena_future);
+    domain.decompose(arena_current.nEta());
+
+    Evolve evolve(eos, event, hydro_source_terms, domain);
+    evolve.EvolveIt(arena_prev, arena_current, arena_future);
+}
+
+
+void Ensemble::run() {
+    // events are distributed over groups of threads_per_event threads
+    const int n_groups = std::max(1, omp_get_max_threads()/threads_per_event);
+    if (threads_per_event > 1) omp_set_max_active_levels(2);
+    #pragma omp parallel for schedule(dynamic) num_threads(n_groups)
+    for (int i_event = 0; i_event < n_events(); i_event++) {
+        omp_set_num_threads(threads_per_event);
+        run_event(i_event);
+    }
+    music_message << "Ensemble of " << n_events() << " events finished.";
+    music_message.flush("info");
+}
@@ -0,0 +1,51 @@
+#ifndef SRC_ENSEMBLE_H_
+#define SRC_ENSEMBLE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "data.h"
+#include "domain.h"
+#include "eos.h"
+#include "parameter_list.h"
+#include "pretty_ostream.h"
+
+//! Evolves a batch of independent hydro events in one process. The EOS
+//! tables are loaded once and shared by all events; the events run
+//! concurrently, ensemble_threads_per_event OpenMP threads each.
+//! The file given by ensemble_list has one line per event: the output
+//! directory of the event followed by "name value" pairs that override
+//! the parameters of the input file, e.g.
+//!     event_0  Initial_Distribution_input_filename initial/ed_0.dat
+//! '#' starts a comment. Only the hydro evolution (mode 2) is done, on
+//! a single MPI rank.
+class Ensemble {
+ private:
+    const int threads_per_event;
+    const InitData DATA;
+    const EOS eos;
+
+    //! parameters of the events, with output_dir set
+    std::vector<InitData> events;
+    //! every event evolves the whole grid on its own
+    std::vector<std::unique_ptr<Domain>> domains;
+
+    pretty_ostream music_message;
+
+    //! the parameters of the events listed in list_file
+    static std::vector<ParameterList> read_event_list(
+                const std::string &list_file, const ParameterList &base);
+
+    void run_event(int i_event);
+
+ public:
+    explicit Ensemble(const ParameterList &parameters);
+
+    int n_events() const {return static_cast<int>(events.size());}
+
+    //! initializes and evolves all events
+    void run();
+};
+
+#endif  // SRC_ENSEMBLE_H_
@@ -3,6 +3,9 @@
 #include <iomanip>
 #include <string>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
 
 #include "util.h"
 #include "eos.h"
@@ -11,6 +14,29 @@ using namespace std;
 
 #define ideal_cs2 (1.0/3.0)
 
+namespace {
+
+//! number of leading mantissa bits used by log2_key, i.e. bins per octave
+const int log2_key_bits = 4;
+
+//! monotonic integer key of a positive double: its exponent followed by
+//! the leading mantissa bits, a binned log2(x) that needs no libm call
+inline long long log2_key(double x) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return(static_cast<long long>(bits >> (52 - log2_key_bits)));
+}
+
+//! smallest positive double with the given log2_key
+inline double log2_key_lower_edge(long long key) {
+    std::uint64_t bits = static_cast<std::uint64_t>(key) << (52 - log2_key_bits);
+    double x;
+    std::memcpy(&x, &bits, sizeof(x));
+    return(x);
+}
+
+}  // namespace
+
 EOS::EOS(const InitData &para_in) : parameters_ptr(para_in)  {
     whichEOS = parameters_ptr.whichEOS;
     number_of_tables = 0;
@@ -18,82 +44,45 @@ EOS::EOS(const InitData &para_in) : parameters_ptr(para_in)  {
     initialize_eos();
 }
 
-// destructor
-EOS::~EOS() {
-    for (int itable = 0; itable < number_of_tables; itable++) {
-        Util::mtx_free(pressure_tb[itable],
-                       nb_length[itable], e_length[itable]);
-        Util::mtx_free(temperature_tb[itable],
-                       nb_length[itable], e_length[itable]);
-        if (parameters_ptr.whichEOS == 1 || parameters_ptr.whichEOS > 9) {
-            Util::mtx_free(mu_B_tb[itable],
-                           nb_length[itable], e_length[itable]);
-        }
-        if (parameters_ptr.whichEOS == 11) {
-            Util::mtx_free(mu_S_tb[itable],
-                           nb_length[itable], e_length[itable]);
-        }
-    }
-    delete [] pressure_tb;
-    delete [] temperature_tb;
-    if (parameters_ptr.whichEOS == 1 || parameters_ptr.whichEOS > 9) {
-        delete [] mu_B_tb;
-    }
-    if (parameters_ptr.whichEOS == 11) {
-        delete [] mu_S_tb;
-    }
-}
-
-
 void EOS::initialize_eos() {
     if (parameters_ptr.whichEOS == 0) {
         music_message.info("Using the ideal gas EOS");
         number_of_tables = 0;
     } else if (parameters_ptr.whichEOS == 1) {
         music_message.info("Using EOS-Q from AZHYDRO");
-        init_eos();
     } else if (parameters_ptr.whichEOS == 2) {
         music_message.info("Using lattice EOS from Huovinen/Petreczky");
-        init_eos_s95p(0);
     } else if (parameters_ptr.whichEOS == 3) {
         music_message << "Using lattice EOS from Huovinen/Petreczky with "
                       << "partial chemical equilibrium (PCE) "
                       << "chem. f.o. at 150 MeV";
         music_message.flush("info");
-        init_eos_s95p(1);
     } else if (parameters_ptr.whichEOS == 4) {
         music_message << "Using lattice EOS from Huovinen/Petreczky with "
                       << "partial chemical equilibrium (PCE) "
                       << "chem. f.o. at 155 MeV";
         music_message.flush("info");
-        init_eos_s95p(2);
     } else if (parameters_ptr.whichEOS == 5) {
         music_message << "Using lattice EOS from Huovinen/Petreczky with "
                       << "partial chemical equilibrium (PCE) "
                       << "chem. f.o. at 160 MeV";
         music_message.flush("info");
-        init_eos_s95p(3);
     } else if (parameters_ptr.whichEOS == 6) {
         music_message << "Using lattice EOS from Huovinen/Petreczky with "
                       << "partial chemical equilibrium (PCE) chem. f.o. "
                        << "at 165 MeV";
         music_message.flush("info");
-        init_eos_s95p(4);
     } else if (parameters_ptr.whichEOS == 7) {
         music_message.info(
             "Using lattice EOS from Huovinen/Petreczky s95p-v1.2 (for UrQMD)");
-        init_eos_s95p(5);
     } else if (parameters_ptr.whichEOS == 8) {
         music_message.info("Using lattice EOS parameterization from WB");
     } else if (parameters_ptr.whichEOS == 10) {
         music_message.info("Using lattice EOS from A. Monnai");
-        init_eos10();
     } else if (parameters_ptr.whichEOS == 11) {
         music_message.info("Using lattice EOS from Pasi");
-        init_eos11();
     } else if (parameters_ptr.whichEOS == 12) {
         music_message.info("Using lattice EOS from A. Monnai (up to mu_B^6)");
-        init_eos12();
     } else {
         music_message << "No EOS for whichEOS = " << parameters_ptr.whichEOS
              << ". Use EOS_to_use = 0 (ideal gas) 1 (AZHYDRO EOS-Q), "
@@ -108,6 +97,10 @@ void EOS::initialize_eos() {
         exit(1);
     }
 
+    if (whichEOS != 0 && whichEOS != 8) {
+        read_eos_tables();
+    }
+
     if (whichEOS >= 2 && whichEOS < 8) {
         eps_max = (e_bounds[6] + e_spacing[6]*e_length[6])/hbarc;  // [1/fm^4]
     } else if (whichEOS == 10) {
@@ -117,6 +110,135 @@ void EOS::initialize_eos() {
     } else if (whichEOS == 12) {
         eps_max = (e_bounds[6] + e_spacing[6]*e_length[6])/hbarc;  // [1/fm^4]
     }
+
+    if (whichEOS != 0) {
+        build_s2e_table();
+    }
+    if (whichEOS >= 10) {
+        build_mub2rhob_tables();
+    }
+}
+
+
+//! loads the tables of whichEOS. The ASCII tables are parsed and processed
+//! only if no binary cache for them exists yet, which is then written;
+//! otherwise the tables are mapped from the cache.
+void EOS::read_eos_tables() {
+    const std::string cache_file = (get_table_root() + "/EOS_"
+                                    + get_table_subdir() + ".cache");
+    const std::uint64_t source_stamp = EOSTableCache::source_stamp(
+                                                        get_table_dir());
+    if (table_cache.open(cache_file, whichEOS, n_table_quantities,
+                         source_stamp)) {
+        music_message << "reading EOS tables from " << cache_file;
+        music_message.flush("info");
+        number_of_tables = table_cache.size();
+        resize_table_info_arrays();
+        for (int itable = 0; itable < number_of_tables; itable++) {
+            const auto &info   = table_cache.info(itable);
+            nb_bounds[itable]  = info.nb_bounds;
+            e_bounds[itable]   = info.e_bounds;
+            nb_spacing[itable] = info.nb_spacing;
+            e_spacing[itable]  = info.e_spacing;
+            nb_length[itable]  = static_cast<int>(info.nb_length);
+            e_length[itable]   = static_cast<int>(info.e_length);
+            table_data[itable] = table_cache.table(itable);
+        }
+        build_table_idx_map();
+        return;
+    }
+
+    if (whichEOS == 1) {
+        init_eos();
+    } else if (whichEOS >= 2 && whichEOS < 8) {
+        init_eos_s95p(whichEOS - 2);
+    } else if (whichEOS == 10) {
+        init_eos10();
+    } else if (whichEOS == 11) {
+        init_eos11();
+    } else if (whichEOS == 12) {
+        init_eos12();
+    }
+    for (int itable = 0; itable < number_of_tables; itable++) {
+        table_data[itable] = tables[itable].data();
+    }
+    build_table_idx_map();
+    fill_derivative_tables();
+
+    std::vector<EOSTableCache::TableInfo> info(number_of_tables);
+    for (int itable = 0; itable < number_of_tables; itable++) {
+        info[itable] = {nb_bounds[itable], e_bounds[itable],
+                        nb_spacing[itable], e_spacing[itable],
+                        nb_length[itable], e_length[itable]};
+    }
+    if (source_stamp != 0
+        && !EOSTableCache::write(cache_file, whichEOS, n_table_quantities,
+                                 source_stamp, info, table_data)) {
+        music_message << "could not write the EOS table cache " << cache_file;
+        music_message.flush("warning");
+    }
+}
+
+
+//! directory of the ASCII tables of whichEOS below EOS/
+std::string EOS::get_table_subdir() const {
+    switch (whichEOS) {
+        case 1:  return("EOS-Q");
+        case 2:  return("s95p-v1");
+        case 3:  return("s95p-PCE-v1");
+        case 4:  return("s95p-PCE155");
+        case 5:  return("s95p-PCE160");
+        case 6:  return("s95p-PCE165-v0");
+        case 7:  return("s95p-v1.2");
+        case 10: return("neos_2");
+        case 11: return("s95p-finite_muB");
+        case 12: return("neos_3");
+        default: return("");
+    }
+}
+
+
+//! directory that contains EOS/
+std::string EOS::get_table_root() const {
+    if (whichEOS < 10) {
+        return(get_hydro_env_path());
+    } else {
+        return(".");
+    }
+}
+
+
+std::string EOS::get_table_dir() const {
+    return(get_table_root() + "/EOS/" + get_table_subdir() + "/");
+}
+
+
+//! tabulates dP/de, dP/drhob and cs^2 at every node of the tables with the
+//! finite differences of get_dpOverde3 and get_dpOverdrhob2, so that
+//! p_e_func, p_rho_func and get_cs2 need a single interpolation each.
+//! cs^2 is stored before it is limited to [0.01, 1/3].
+void EOS::fill_derivative_tables() {
+    for (int itable = 0; itable < number_of_tables; itable++) {
+        for (int i = 0; i < nb_length[itable]; i++) {
+            for (int j = 0; j < e_length[itable]; j++) {
+                // the finite difference in e is undefined at e = 0,
+                // use the next node there
+                const int j_e = (e_bounds[itable] + j*e_spacing[itable] > 0.
+                                 ? j : j + 1);
+                const double e    = (e_bounds[itable]
+                                     + j_e*e_spacing[itable])/hbarc;
+                const double rhob = nb_bounds[itable] + i*nb_spacing[itable];
+                const double dpde   = get_dpOverde3(e, rhob);
+                const double dpdrho = (tables_depend_on_rhob()
+                                       ? get_dpOverdrhob2(e, rhob) : 0.);
+                const double pressure = get_pressure(e, rhob);
+                const double cs2 = dpde + rhob/(e + pressure + 1e-15)*dpdrho;
+                table_entry(itable, i, j, dPde_tb)    = dpde;
+                table_entry(itable, i, j, dPdrhob_tb) = dpdrho;
+                table_entry(itable, i, j, cs2_tb)     = cs2;
+            }
+        }
+    }
 }
 
 
@@ -125,23 +247,20 @@ void EOS::init_eos() {
 // baryon chemical potential from file
     whichEOS = 1;
     music_message.info("reading EOS...");
-    auto envPath = get_hydro_env_path();
-    music_message << "from path " << envPath.c_str() << "/EOS";
+    const std::string path = get_table_dir();
+    music_message << "from path " << path;
     music_message.flush("info");
 
     number_of_tables = 2;
     resize_table_info_arrays();
 
     string eos_file_string_array[2] = {"1", "2"};
-    pressure_tb    = new double** [number_of_tables];
-    temperature_tb = new double** [number_of_tables];
-    mu_B_tb        = new double** [number_of_tables];
     for (int itable = 0; itable < number_of_tables; itable++) {
-        std::ifstream eos_p(envPath + "/EOS/EOS-Q/aa"
+        std::ifstream eos_p(path + "aa"
                             + eos_file_string_array[itable] + "_p.dat");
-        std::ifstream eos_T(envPath + "/EOS/EOS-Q/aa"
+        std::ifstream eos_T(path + "aa"
                             + eos_file_string_array[itable] + "_t.dat");
-        std::ifstream eos_mub(envPath + "/EOS/EOS-Q/aa"
+        std::ifstream eos_mub(path + "aa"
                               + eos_file_string_array[itable] + "_mb.dat");
 
         // read the first two lines:
@@ -161,20 +280,14 @@ void EOS::init_eos() {
         std::getline(eos_mub, dummy);
         std::getline(eos_mub, dummy);
 
-        // allocate memory for pressure arrays
-        pressure_tb[itable] = Util::mtx_malloc(nb_length[itable],
-                                               e_length[itable]);
-        temperature_tb[itable] = Util::mtx_malloc(nb_length[itable],
-                                                  e_length[itable]);
-        mu_B_tb[itable] = Util::mtx_malloc(nb_length[itable],
-                                           e_length[itable]);
+        allocate_table(itable);
 
         // read pressure, temperature and chemical potential values
         for (int j = 0; j < e_length[itable]; j++) {
             for (int i = 0; i < nb_length[itable]; i++) {
-                eos_p >> pressure_tb[itable][i][j];
-                eos_T >> temperature_tb[itable][i][j];
-                eos_mub >> mu_B_tb[itable][i][j];
+                eos_p >> table_entry(itable, i, j, P_tb);
+                eos_T >> table_entry(itable, i, j, T_tb);
+                eos_mub >> table_entry(itable, i, j, muB_tb);
             }
         }
     }
@@ -187,22 +300,8 @@ void EOS::init_eos_s95p(int selector) {
     // baryon chemical potential from file
     music_message.info("reading EOS s95p ...");
 
-    auto envPath = get_hydro_env_path();
     stringstream spath;
-    spath << envPath;
-    if (selector == 0) {
-        spath << "/EOS/s95p-v1/";
-    } else if (selector == 1) {
-        spath << "/EOS/s95p-PCE-v1/";
-    } else if (selector == 2) {
-        spath << "/EOS/s95p-PCE155/";
-    } else if (selector == 3) {
-        spath << "/EOS/s95p-PCE160/";
-    } else if (selector == 4) {
-        spath << "/EOS/s95p-PCE165-v0/";
-    } else if (selector == 5) {
-        spath << "/EOS/s95p-v1.2/";
-    }
+    spath << get_table_dir();
 
     music_message << "from path " << spath.str();
     music_message.flush("info");
@@ -217,8 +316,6 @@ void EOS::init_eos_s95p(int selector) {
     resize_table_info_arrays();
 
     string eos_file_string_array[7] = {"1", "2", "3", "4", "5", "6", "7"};
-    pressure_tb    = new double** [number_of_tables];
-    temperature_tb = new double** [number_of_tables];
     for (int itable = 0; itable < number_of_tables; itable++) {
         std::ifstream eos_d(spath.str() + "dens"
                             + eos_file_string_array[itable] + ".dat");
@@ -238,11 +335,7 @@ void EOS::init_eos_s95p(int selector) {
         // no rho_b dependence at the moment
         nb_length[itable] = 1;
 
-        // allocate memory for pressure arrays
-        pressure_tb[itable] = Util::mtx_malloc(nb_length[itable],
-                                               e_length[itable]);
-        temperature_tb[itable] = Util::mtx_malloc(nb_length[itable],
-                                                  e_length[itable]);
+        allocate_table(itable);
 
         // read pressure, temperature and chemical potential values
         // files have it backwards, so I start with maximum j and count down
@@ -250,9 +343,9 @@ void EOS::init_eos_s95p(int selector) {
         double d_dummy;
         for (int j = e_length[itable] - 1; j >= 0; j--) {
             eos_d >> d_dummy;
-            eos_d >> pressure_tb[itable][i][j];
+            eos_d >> table_entry(itable, i, j, P_tb);
             eos_d >> d_dummy >> dummy >> dummy;;
-            eos_T >> temperature_tb[itable][i][j] >> dummy >> dummy;
+            eos_T >> table_entry(itable, i, j, T_tb) >> dummy >> dummy;
         }
     }
     music_message.info("Done reading EOS.");
@@ -264,10 +357,7 @@ void EOS::init_eos10() {
     // pressure, temperature, and baryon chemical potential from file
     music_message.info("reading EOS...");
 
-    stringstream slocalpath;
-    slocalpath << "./EOS/neos_2/";
-
-    string path = slocalpath.str();
+    string path = get_table_dir();
     music_message << "from path " << path;
     music_message.flush("info");
 
@@ -275,9 +365,6 @@ void EOS::init_eos10() {
     resize_table_info_arrays();
 
     string eos_file_string_array[7] = {"0a", "0b", "0c", "1a", "2", "3", "4"};
-    pressure_tb    = new double** [number_of_tables];
-    temperature_tb = new double** [number_of_tables];
-    mu_B_tb        = new double** [number_of_tables];
 
     for (int itable = 0; itable < number_of_tables; itable++) {
         std::ifstream eos_p(path + "neos" + eos_file_string_array[itable]
@@ -305,20 +392,14 @@ void EOS::init_eos10() {
         std::getline(eos_mub, dummy);
         std::getline(eos_mub, dummy);
 
-        // allocate memory for EOS arrays
-        pressure_tb[itable] = Util::mtx_malloc(nb_length[itable],
-                                               e_length[itable]);
-        temperature_tb[itable] = Util::mtx_malloc(nb_length[itable],
-                                                  e_length[itable]);
-        mu_B_tb[itable] = Util::mtx_malloc(nb_length[itable],
-                                           e_length[itable]);
+        allocate_table(itable);
 
         // read pressure, temperature and chemical potential values
         for (int j = 0; j < e_length[itable]; j++) {
             for (int i = 0; i < nb_length[itable]; i++) {
-                eos_p >> pressure_tb[itable][i][j];
-                eos_T >> temperature_tb[itable][i][j];
-                eos_mub >> mu_B_tb[itable][i][j];
+                eos_p >> table_entry(itable, i, j, P_tb);
+                eos_T >> table_entry(itable, i, j, T_tb);
+                eos_mub >> table_entry(itable, i, j, muB_tb);
             }
         }
     }
@@ -331,9 +412,7 @@ void EOS::init_eos11() {
     // pressure, temperature, and baryon chemical potential from file
     music_message.info("reading EOS (Pasi) at finite mu_B ...");
 
-    stringstream slocalpath;
-    slocalpath << "./EOS/s95p-finite_muB/";
-    string path = slocalpath.str();
+    string path = get_table_dir();
 
     music_message << "from path " << path;
     music_message.flush("info");
@@ -342,10 +421,6 @@ void EOS::init_eos11() {
     resize_table_info_arrays();
 
     string eos_file_string_array[4] = {"1", "2", "3", "4"};
-    pressure_tb    = new double** [number_of_tables];
-    temperature_tb = new double** [number_of_tables];
-    mu_B_tb        = new double** [number_of_tables];
-    mu_S_tb        = new double** [number_of_tables];
 
     for (int itable = 0; itable < number_of_tables; itable++) {
         ifstream eos_p(path + "p" + eos_file_string_array[itable] + ".dat");
@@ -375,23 +450,15 @@ void EOS::init_eos11() {
         std::getline(eos_mus, dummy);
         std::getline(eos_mus, dummy);
 
-        // allocate memory for pressure arrays
-        pressure_tb[itable] = Util::mtx_malloc(nb_length[itable],
-                                               e_length[itable]);
-        temperature_tb[itable] = Util::mtx_malloc(nb_length[itable],
-                                                  e_length[itable]);
-        mu_B_tb[itable] = Util::mtx_malloc(nb_length[itable],
-                                           e_length[itable]);
-        mu_S_tb[itable] = Util::mtx_malloc(nb_length[itable],
-                                           e_length[itable]);
+        allocate_table(itable);
 
         // read pressure, temperature and chemical potential values
         for (int j = N_e; j >= 0; j--) {
             for (int i = 0; i < N_rhob; i++) {
-                eos_p >> pressure_tb[itable][i][j];
-                eos_T >> temperature_tb[itable][i][j];
-                eos_mub >> mu_B_tb[itable][i][j];
-                eos_mus >> mu_S_tb[itable][i][j];
+                eos_p >> table_entry(itable, i, j, P_tb);
+                eos_T >> table_entry(itable, i, j, T_tb);
+                eos_mub >> table_entry(itable, i, j, muB_tb);
+                eos_mus >> table_entry(itable, i, j, muS_tb);
             }
         }
     }
@@ -403,10 +470,7 @@ void EOS::init_eos12() {
     // pressure, temperature, and baryon chemical potential from file
     music_message.info("reading EOS ...");
 
-    stringstream slocalpath;
-    slocalpath << "./EOS/neos_3/";
-
-    string path = slocalpath.str();
+    string path = get_table_dir();
     music_message << "from path " << path;
     music_message.flush("info");
 
@@ -414,9 +478,6 @@ void EOS::init_eos12() {
     resize_table_info_arrays();
 
     string eos_file_string_array[7] = {"1", "2", "3", "4", "5", "6", "7"};
-    pressure_tb    = new double** [number_of_tables];
-    temperature_tb = new double** [number_of_tables];
-    mu_B_tb        = new double** [number_of_tables];
 
     for (int itable = 0; itable < number_of_tables; itable++) {
         std::ifstream eos_p(path + "neos"
@@ -445,20 +506,14 @@ void EOS::init_eos12() {
         std::getline(eos_muB, dummy);
         std::getline(eos_muB, dummy);
 
-        // allocate memory for EOS arrays
-        pressure_tb[itable] = Util::mtx_malloc(nb_length[itable],
-                                               e_length[itable]);
-        temperature_tb[itable] = Util::mtx_malloc(nb_length[itable],
-                                                  e_length[itable]);
-        mu_B_tb[itable] = Util::mtx_malloc(nb_length[itable],
-                                           e_length[itable]);
+        allocate_table(itable);
 
         // read pressure, temperature and chemical potential values
         for (int j = 0; j < e_length[itable]; j++) {
             for (int i = 0; i < nb_length[itable]; i++) {
-                eos_p >> pressure_tb[itable][i][j];
-                eos_T >> temperature_tb[itable][i][j];
-                eos_muB >> mu_B_tb[itable][i][j];
+                eos_p >> table_entry(itable, i, j, P_tb);
+                eos_T >> table_entry(itable, i, j, T_tb);
+                eos_muB >> table_entry(itable, i, j, muB_tb);
             }
         }
     }
@@ -502,13 +557,13 @@ double EOS::get_cs2(double e, double rhob) const {
 
 //! this function output the EoS matrix on the grid to files for checking
 //! purpose
-void EOS::output_eos_matrix(int ne, int nrhob, double** matrix_ptr,
+void EOS::output_eos_matrix(int itable, int quantity,
                             string filename) const {
     ofstream output_file(filename.c_str());
-    for (int i = 0; i < nrhob; i++) {
-        for (int j = 0; j < ne; j++) {
+    for (int i = 0; i < nb_length[itable]; i++) {
+        for (int j = 0; j < e_length[itable]; j++) {
             output_file << scientific << setw(18) << setprecision(8)
-                        << matrix_ptr[i][j] << "  ";
+                        << table_entry(itable, i, j, quantity) << "  ";
         }
         output_file << endl;
     }
@@ -519,10 +574,15 @@ void EOS::output_eos_matrix(int ne, int nrhob, double** matrix_ptr,
 double EOS::calculate_velocity_of_sound_sq(double e, double rhob) const {
     double v_min = 0.01;
     double v_max = 1./3;
-    double dpde = p_e_func(e, rhob);
-    double dpdrho = p_rho_func(e, rhob);
-    double pressure = get_pressure(e, rhob);
-    double v_sound = dpde + rhob/(e + pressure + 1e-15)*dpdrho;
+    double v_sound;
+    if (in_derivative_tables(e)) {
+        v_sound = interpolate(e, rhob, cs2_tb);
+    } else {
+        double dpde = p_e_func(e, rhob);
+        double dpdrho = p_rho_func(e, rhob);
+        double pressure = get_pressure(e, rhob);
+        v_sound = dpde + rhob/(e + pressure + 1e-15)*dpdrho;
+    }
     v_sound = std::max(v_min, std::min(v_max, v_sound));
     return(v_sound);
 }
@@ -536,18 +596,18 @@ double EOS::get_pressure(double e, double rhob) const {
         f = ideal_cs2*e;
     } else if (whichEOS == 1) {
         int table_idx = get_table_idx(e);
-        f = interpolate2D(e, std::abs(rhob), table_idx, pressure_tb);
+        f = interpolate2D(e, std::abs(rhob), table_idx, P_tb);
         f = f/hbarc;  // 1/fm^4
     } else if (whichEOS >= 2 && whichEOS < 8) {
         int table_idx = get_table_idx(e);
-        f = interpolate1D(e, table_idx, pressure_tb);
+        f = interpolate1D(e, table_idx, P_tb);
         f = f/hbarc;  // 1/fm^4
     } else if (whichEOS == 8) {
         f = get_pressure_WB(e);
     } else if (whichEOS >= 10) {
         // EOS is symmetric in rho_b for pressure
         int table_idx = get_table_idx(e);
-        f = interpolate2D(e, std::abs(rhob), table_idx, pressure_tb);
+        f = interpolate2D(e, std::abs(rhob), table_idx, P_tb);
         f = f/hbarc;  // 1/fm^4
     }
     return(f);
@@ -557,8 +617,14 @@ double EOS::get_pressure(double e, double rhob) const {
 double EOS::p_rho_func(double e, double rhob) const {
     // return dP/drho_b (in 1/fm)
     double f = 0.0;
-    if (whichEOS == 1 || whichEOS >= 10) {
-        f = get_dpOverdrhob2(e, rhob);
+    if (tables_depend_on_rhob()) {
+        // P is even in rho_b, so its derivative is odd
+        double sign = rhob/(std::abs(rhob) + 1e-15);
+        if (in_derivative_tables(e)) {
+            f = sign*interpolate(e, rhob, dPdrhob_tb);
+        } else {
+            f = get_dpOverdrhob2(e, rhob);
+        }
     }
     return(f);
 }
@@ -569,6 +635,8 @@ double EOS::p_e_func(double e, double rhob) const {
     double f;
     if (whichEOS == 8) {
         f = get_dpOverde_WB(e);
+    } else if (in_derivative_tables(e)) {
+        f = interpolate(e, rhob, dPde_tb);
     } else {
         f = get_dpOverde3(e, rhob);
     }
@@ -672,22 +740,51 @@ double EOS::get_temperature_WB(double e_local) const {
 }
 
 
+//! returns the last table whose lower bound is <= e, and table 0 below
+//! e_bounds[1]. The table is read off table_idx_map for the log2 bin of e;
+//! a bin holding a table bound needs one more comparison.
 int EOS::get_table_idx(double e) const {
     double local_ed = e*hbarc;  // [GeV/fm^3]
-    for (int itable = 1; itable < number_of_tables; itable++) {
-        if (local_ed < e_bounds[itable]) {
-            return(itable - 1);
+    if (number_of_tables < 2) return(number_of_tables - 1);
+    if (local_ed < e_bounds[1]) return(0);
+    if (!(local_ed < e_bounds[number_of_tables - 1])) {
+        return(number_of_tables - 1);
+    }
+    int itable = 0;
+    if (!table_idx_map.empty()) {
+        itable = table_idx_map[log2_key(local_ed) - table_idx_key_min];
+    }
+    while (local_ed >= e_bounds[itable + 1]) itable++;
+    return(itable);
+}
+
+
+//! fills table_idx_map for the log2 bins between e_bounds[1] and the
+//! lower bound of the last table, and the energy range of the tables
+void EOS::build_table_idx_map() {
+    e_min_tables = e_bounds[0];
+    e_max_tables = (e_bounds[number_of_tables - 1]
+                    + (e_length[number_of_tables - 1] - 1)
+                      *e_spacing[number_of_tables - 1]);
+    table_idx_map.clear();
+    if (number_of_tables < 2 || !(e_bounds[1] > 0.)) return;
+    table_idx_key_min = log2_key(e_bounds[1]);
+    const long long key_max = log2_key(e_bounds[number_of_tables - 1]);
+    table_idx_map.resize(key_max - table_idx_key_min + 1);
+    for (long long key = table_idx_key_min; key <= key_max; key++) {
+        const double e_low = log2_key_lower_edge(key);
+        int itable = 0;
+        while (itable + 1 < number_of_tables && e_low >= e_bounds[itable + 1]) {
+            itable++;
         }
+        table_idx_map[key - table_idx_key_min] = itable;
     }
-    return(number_of_tables - 1);
 }
 
-double EOS::interpolate2D(double e, double rhob, int table_idx, double ***table) const {
-// This is a generic bilinear interpolation routine for EOS at finite mu_B
-// it assumes the class has already read in
-//        P(e, rho_b), T(e, rho_b), s(e, rho_b), mu_b(e, rho_b)
-// as two-dimensional arrays on an equally spacing lattice grid
-// units: e is in 1/fm^4, rhob is in 1/fm^3
+//! index computation shared by all quantities of one table lookup;
+//! tables without rhob dependence get idx_nb = 0
+EOS::TableCell EOS::get_table_cell(double e, double rhob,
+                                   int table_idx) const {
     double local_ed = e*hbarc;  // [GeV/fm^3]
     double local_nb = rhob;     // [1/fm^3]
 
@@ -699,62 +796,113 @@ double EOS::interpolate2D(double e, double rhob, int table_idx, double ***table)
     int N_e  = e_length[table_idx];
     int N_nb = nb_length[table_idx];
 
+    TableCell cell;
     // compute the indices
-    int idx_e  = static_cast<int>((local_ed - e0)/delta_e);
-    int idx_nb = static_cast<int>((local_nb - nb0)/delta_nb);
-
     // treatment for overflow, use the last two points to do extrapolation
-    idx_e  = std::min(N_e - 2, idx_e);
-    idx_nb = std::min(N_nb - 2, idx_nb);
-
     // check underflow
-    idx_e  = std::max(0, idx_e);
-    idx_nb = std::max(0, idx_nb);
+    cell.idx_e  = static_cast<int>((local_ed - e0)/delta_e);
+    cell.idx_e  = std::max(0, std::min(N_e - 2, cell.idx_e));
+    cell.frac_e = (local_ed - (cell.idx_e*delta_e + e0))/delta_e;
+
+    cell.idx_nb  = 0;
+    cell.frac_nb = 0.;
+    if (N_nb > 1) {
+        cell.idx_nb  = static_cast<int>((local_nb - nb0)/delta_nb);
+        cell.idx_nb  = std::max(0, std::min(N_nb - 2, cell.idx_nb));
+        cell.frac_nb = (local_nb - (cell.idx_nb*delta_nb + nb0))/delta_nb;
+    }
+    return(cell);
+}
 
-    double frac_e    = (local_ed - (idx_e*delta_e + e0))/delta_e;
-    double frac_rhob = (local_nb - (idx_nb*delta_nb + nb0))/delta_nb;
+
+double EOS::interpolate2D(double e, double rhob, int table_idx,
+                          int quantity) const {
+// This is a generic bilinear interpolation routine for EOS at finite mu_B
+// it assumes the class has already read in
+//        P(e, rho_b), T(e, rho_b), s(e, rho_b), mu_b(e, rho_b)
+// as two-dimensional arrays on an equally spacing lattice grid
+// units: e is in 1/fm^4, rhob is in 1/fm^3
+    return(interpolate2D(get_table_cell(e, rhob, table_idx), table_idx,
+                         quantity));
+}
+
+
+double EOS::interpolate2D(const TableCell &cell, int table_idx,
+                          int quantity) const {
+    const int idx_e  = cell.idx_e;
+    const int idx_nb = cell.idx_nb;
+    const double frac_e    = cell.frac_e;
+    const double frac_rhob = cell.frac_nb;
+
+    // only the quantities read from file are clipped, the derived ones
+    // can be negative
+    const bool positive = quantity < dPde_tb;
+    auto node = [&](int i_nb, int i_e) {
+        const double f = table_entry(table_idx, i_nb, i_e, quantity);
+        return(positive ? std::max(f, 0.0) : f);
+    };
 
     double result;
-    double temp1 = std::max(table[table_idx][idx_nb][idx_e], 0.0);
-    double temp2 = std::max(table[table_idx][idx_nb][idx_e + 1], 0.0);
-    double temp3 = std::max(table[table_idx][idx_nb + 1][idx_e + 1], 0.0);
-    double temp4 = std::max(table[table_idx][idx_nb + 1][idx_e], 0.0);
+    double temp1 = node(idx_nb,     idx_e    );
+    double temp2 = node(idx_nb,     idx_e + 1);
+    double temp3 = node(idx_nb + 1, idx_e + 1);
+    double temp4 = node(idx_nb + 1, idx_e    );
     result = ((temp1*(1. - frac_e) + temp2*frac_e)*(1. - frac_rhob)
               + (temp3*frac_e + temp4*(1. - frac_e))*frac_rhob);
-    result = std::max(result, 1e-15);
+    if (positive) result = std::max(result, 1e-15);
     return(result);
 }
 
 
-double EOS::interpolate1D(double e, int table_idx, double ***table) const {
+double EOS::interpolate1D(double e, int table_idx, int quantity) const {
 // This is a generic linear interpolation routine for EOS at zero mu_B
 // it assumes the class has already read in
 //        P(e), T(e), s(e)
 // as one-dimensional arrays on an equally spacing lattice grid
 // units: e is in 1/fm^4
-    double local_ed = e*hbarc;  // [GeV/fm^3]
+    return(interpolate1D(get_table_cell(e, 0.0, table_idx), table_idx,
+                         quantity));
+}
 
-    double e0       = e_bounds[table_idx];
-    double delta_e  = e_spacing[table_idx];
-    int N_e  = e_length[table_idx];
 
-    // compute the indices
-    int idx_e  = static_cast<int>((local_ed - e0)/delta_e);
+double EOS::interpolate1D(const TableCell &cell, int table_idx,
+                          int quantity) const {
+    const int idx_e     = cell.idx_e;
+    const double frac_e = cell.frac_e;
 
-    // treatment for overflow, use the last two points to do extrapolation
-    idx_e  = std::min(N_e - 2, idx_e);
+    // only the quantities read from file are clipped
+    const bool positive = quantity < dPde_tb;
+    double temp1 = table_entry(table_idx, 0, idx_e,     quantity);
+    double temp2 = table_entry(table_idx, 0, idx_e + 1, quantity);
+    if (positive) {
+        temp1 = std::max(temp1, 0.0);
+        temp2 = std::max(temp2, 0.0);
+    }
 
-    // check underflow
-    idx_e  = std::max(0, idx_e);
+    double result = temp1*(1. - frac_e) + temp2*frac_e;
+    if (positive) result = std::max(1e-15, result);
+    return(result);
+}
 
-    double frac_e    = (local_ed - (idx_e*delta_e + e0))/delta_e;
 
-    double result;
-    double temp1 = std::max(table[table_idx][0][idx_e], 0.0);
-    double temp2 = std::max(table[table_idx][0][idx_e + 1], 0.0);
-    result = temp1*(1. - frac_e) + temp2*frac_e;
-    result = std::max(1e-15, result);
-    return(result);
+//! interpolates in the table of the cell, in 1D for the EOS without
+//! rho_b dependence
+double EOS::interpolate(const TableCell &cell, int table_idx,
+                        int quantity) const {
+    if (tables_depend_on_rhob()) {
+        return(interpolate2D(cell, table_idx, quantity));
+    } else {
+        return(interpolate1D(cell, table_idx, quantity));
+    }
+}
+
+
+//! table value of quantity at (e, |rhob|)
+double EOS::interpolate(double e, double rhob, int quantity) const {
+    const int table_idx = get_table_idx(e);
+    const double local_nb = tables_depend_on_rhob() ? std::abs(rhob) : 0.0;
+    return(interpolate(get_table_cell(e, local_nb, table_idx), table_idx,
+                       quantity));
 }
 
 
@@ -782,9 +930,8 @@ double EOS::s2e_ideal_gas(double s) const {
 //! This function returns entropy density in [1/fm^3]
 //! The input local energy density e [1/fm^4], rhob[1/fm^3]
 double EOS::get_entropy(double epsilon, double rhob) const {
-    double P = get_pressure(epsilon, rhob);
-    double T = get_temperature(epsilon, rhob);
-    double mu = get_mu(epsilon, rhob);
+    double P, T, mu;
+    get_pressure_temperature_mu(epsilon, rhob, P, T, mu);
     double f = (epsilon + P - mu*rhob)/(T + 1e-15);
     return(std::max(1e-16, f));
 }/* get_entropy */
@@ -798,16 +945,16 @@ double EOS::get_temperature(double eps, double rhob) const {
     } else if (whichEOS == 1) {
         int table_idx = get_table_idx(eps);
         T = interpolate2D(eps, std::abs(rhob), table_idx,
-                          temperature_tb)/hbarc;  // 1/fm
+                          T_tb)/hbarc;  // 1/fm
     } else if (whichEOS < 8) {
         int table_idx = get_table_idx(eps);
-        T = interpolate1D(eps, table_idx, temperature_tb)/hbarc;  // 1/fm
+        T = interpolate1D(eps, table_idx, T_tb)/hbarc;  // 1/fm
     } else if (whichEOS == 8) {
         T = get_temperature_WB(eps);
     } else if (whichEOS >= 10) {
         int table_idx = get_table_idx(eps);
         T = interpolate2D(eps, std::abs(rhob), table_idx,
-                          temperature_tb)/hbarc;  // 1/fm
+                          T_tb)/hbarc;  // 1/fm
     }
     return(std::max(1e-15, T));
 }
@@ -821,12 +968,69 @@ double EOS::get_mu(double eps, double rhob) const {
         int table_idx = get_table_idx(eps);
         double sign = rhob/(std::abs(rhob) + 1e-15);
         mu = sign*interpolate2D(eps, std::abs(rhob), table_idx,
-                                    mu_B_tb)/hbarc;  // 1/fm
+                                    muB_tb)/hbarc;  // 1/fm
     }
     return(mu);
 }
 
 
+//! This function returns P [1/fm^4], T [1/fm] and mu_B [1/fm] with the
+//! same values as get_pressure, get_temperature and get_mu, but looks up
+//! the tables only once
+void EOS::get_pressure_temperature_mu(double epsilon, double rhob, double &P,
+                                      double &T, double &mu) const {
+    if (number_of_tables == 0) {
+        P  = get_pressure(epsilon, rhob);
+        T  = get_temperature(epsilon, rhob);
+        mu = get_mu(epsilon, rhob);
+        return;
+    }
+
+    const int table_idx = get_table_idx(epsilon);
+    const TableCell cell = get_table_cell(
+        epsilon, tables_depend_on_rhob() ? std::abs(rhob) : 0.0, table_idx);
+    get_pressure_temperature_mu(cell, table_idx, rhob, P, T, mu);
+}
+
+
+void EOS::get_pressure_temperature_mu(const TableCell &cell, int table_idx,
+                                      double rhob, double &P, double &T,
+                                      double &mu) const {
+    P  = interpolate(cell, table_idx, P_tb)/hbarc;
+    T  = interpolate(cell, table_idx, T_tb)/hbarc;
+    mu = 0.0;
+    if (whichEOS >= 10) {
+        double sign = rhob/(std::abs(rhob) + 1e-15);
+        mu = sign*interpolate2D(cell, table_idx, muB_tb)/hbarc;
+    }
+    T = std::max(1e-15, T);
+}
+
+
+ThermoCell EOS::get_thermo(double epsilon, double rhob) const {
+    ThermoCell thermo;
+    if (number_of_tables == 0) {
+        get_pressure_temperature_mu(epsilon, rhob, thermo.p, thermo.T,
+                                    thermo.muB);
+        thermo.cs2 = get_cs2(epsilon, rhob);
+        return(thermo);
+    }
+
+    const int table_idx = get_table_idx(epsilon);
+    const TableCell cell = get_table_cell(
+        epsilon, tables_depend_on_rhob() ? std::abs(rhob) : 0.0, table_idx);
+    get_pressure_temperature_mu(cell, table_idx, rhob, thermo.p, thermo.T,
+                                thermo.muB);
+    if (in_derivative_tables(epsilon)) {
+        thermo.cs2 = std::max(0.01, std::min(1./3,
+                              interpolate(cell, table_idx, cs2_tb)));
+    } else {
+        thermo.cs2 = get_cs2(epsilon, rhob);
+    }
+    return(thermo);
+}
+
+
 double EOS::get_muS(double eps, double rhob) const {
     // return mu_S in [1/fm]
     double mu = 0.0;
@@ -834,7 +1038,7 @@ double EOS::get_muS(double eps, double rhob) const {
         int table_idx = get_table_idx(eps);
         double sign = rhob/(std::abs(rhob) + 1e-15);
         mu = sign*interpolate2D(eps, std::abs(rhob), table_idx,
-                                    mu_S_tb)/hbarc;  // 1/fm
+                                    muS_tb)/hbarc;  // 1/fm
     }
     return(mu);
 }
@@ -852,10 +1056,139 @@ double EOS::get_s2e(double s, double rhob) const {
 }
 
 
+//! fills s2e_log_e by tabulating s(e, rhob) on a logarithmic e lattice
+//! for every rhob column and inverting it
+void EOS::build_s2e_table() {
+    const int n_e = 2048;
+    const double log_e_max = log(eps_max);
+    const double log_e_min = log_e_max - 14.*log(10.);
+    const double dlog_e    = (log_e_max - log_e_min)/(n_e - 1);
+
+    s2e_rhob.assign(1, 0.);
+    if (tables_depend_on_rhob()) {
+        // columns from the finest to the largest rhob of the tables,
+        // 8 per decade
+        double rhob_min = nb_spacing[0];
+        double rhob_max = 0.;
+        for (int itable = 0; itable < number_of_tables; itable++) {
+            rhob_min = std::min(rhob_min, nb_spacing[itable]);
+            rhob_max = std::max(rhob_max, (nb_bounds[itable]
+                            + nb_spacing[itable]*(nb_length[itable] - 1)));
+        }
+        s2e_log_rhob_min = log(rhob_min);
+        s2e_dlog_rhob    = log(10.)/8.;
+        const int n_rhob = 2 + static_cast<int>(
+                    (log(rhob_max) - s2e_log_rhob_min)/s2e_dlog_rhob);
+        for (int j = 0; j < n_rhob; j++) {
+            s2e_rhob.push_back(exp(s2e_log_rhob_min + j*s2e_dlog_rhob));
+        }
+    }
+
+    s2e_n_s       = 1024;
+    s2e_log_s_min = log(get_entropy(exp(log_e_min), 0.));
+    s2e_dlog_s    = ((log(get_entropy(eps_max, 0.)) - s2e_log_s_min)
+                     /(s2e_n_s - 1));
+    s2e_log_e.resize(s2e_rhob.size()*s2e_n_s);
+
+    const int n_rhob = s2e_rhob.size();
+    #pragma omp parallel for
+    for (int j = 0; j < n_rhob; j++) {
+        std::vector<double> log_s(n_e);
+        for (int k = 0; k < n_e; k++) {
+            log_s[k] = log(get_entropy(exp(log_e_min + k*dlog_e),
+                                       s2e_rhob[j]));
+            if (k > 0) log_s[k] = std::max(log_s[k], log_s[k-1]);
+        }
+        int k = 0;
+        for (int i = 0; i < s2e_n_s; i++) {
+            const double log_s_i = s2e_log_s_min + i*s2e_dlog_s;
+            while (k < n_e - 2 && log_s[k+1] < log_s_i) k++;
+            double frac = 0.;
+            if (log_s[k+1] > log_s[k]) {
+                frac = (log_s_i - log_s[k])/(log_s[k+1] - log_s[k]);
+                frac = std::max(0., std::min(1., frac));
+            }
+            s2e_log_e[j*s2e_n_s + i] = log_e_min + (k + frac)*dlog_e;
+        }
+    }
+}
+
+
+//! e [1/fm^4] interpolated from the inverse table, bilinear in log(s)
+//! and in the position between the two nearest rhob columns
+double EOS::s2e_guess(double s, double rhob) const {
+    const double x_s = (log(s) - s2e_log_s_min)/s2e_dlog_s;
+    const int i_s = std::max(0, std::min(s2e_n_s - 2,
+                                         static_cast<int>(x_s)));
+    const double frac_s = std::max(0., std::min(1., x_s - i_s));
+
+    const int n_rhob = s2e_rhob.size();
+    const double abs_rhob = std::abs(rhob);
+    int j = 0;
+    double frac_rhob = 0.;
+    if (n_rhob > 1 && abs_rhob > 0.) {
+        if (abs_rhob < s2e_rhob[1]) {
+            frac_rhob = abs_rhob/s2e_rhob[1];
+        } else {
+            const double x_rhob = (1. + (log(abs_rhob) - s2e_log_rhob_min)
+                                        /s2e_dlog_rhob);
+            j = std::min(n_rhob - 2, static_cast<int>(x_rhob));
+            frac_rhob = std::min(1., x_rhob - j);
+        }
+    }
+    const double *col0 = &s2e_log_e[j*s2e_n_s + i_s];
+    double log_e = (1. - frac_s)*col0[0] + frac_s*col0[1];
+    if (frac_rhob > 0.) {
+        const double *col1 = col0 + s2e_n_s;
+        log_e = ((1. - frac_rhob)*log_e
+                 + frac_rhob*((1. - frac_s)*col1[0] + frac_s*col1[1]));
+    }
+    return(exp(log_e));
+}
+
+
 //! This function returns local energy density [1/fm^4] from
-//! a given entropy density [1/fm^3] and rhob [1/fm^3]
-//! using binary search
+//! a given entropy density [1/fm^3] and rhob [1/fm^3].
+//! Starting from the inverse table, it iterates
+//! e -> e + T (s - s(e, rhob)), i.e. Newton's method with ds/de = 1/T at
+//! fixed rhob, and falls back to a binary search if that does not
+//! converge inside the range of the EOS. Entropy densities outside of
+//! [s(1e-15, rhob), s(eps_max, rhob)] are handled as by the binary search.
 double EOS::get_s2e_finite_rhob(double s, double rhob) const {
+    if (   s2e_n_s == 0
+        || !(s >= get_entropy(1e-15, rhob) && s <= get_entropy(eps_max, rhob))) {
+        return(get_s2e_bisection(s, rhob));
+    }
+
+    const double rel_accuracy = 1e-10;
+    double e = s2e_guess(s, rhob);
+    for (int iter = 0; iter < 20; iter++) {
+        double P, T, mu;
+        get_pressure_temperature_mu(e, rhob, P, T, mu);
+        const double s_e = std::max(1e-16, (e + P - mu*rhob)/(T + 1e-15));
+        const double de  = T*(s - s_e);
+        e += de;
+        if (!(e > 1e-15 && e < eps_max)) break;
+        if (std::abs(de) <= rel_accuracy*e) return(e);
+    }
+    return(get_s2e_bisection(s, rhob));
+}
+
+
+void EOS::get_s2e(int n, const double *s, const double *rhob,
+                  double *e) const {
+    if (whichEOS == 0) {
+        for (int i = 0; i < n; i++) e[i] = s2e_ideal_gas(s[i]);
+        return;
+    }
+    for (int i = 0; i < n; i++) {
+        e[i] = get_s2e_finite_rhob(s[i], rhob[i]);
+    }
+}
+
+
+//! binary search for get_s2e_finite_rhob
+double EOS::get_s2e_bisection(double s, double rhob) const {
     double eps_lower = 1e-15;
     double eps_upper = eps_max;
     double eps_mid   = (eps_upper + eps_lower)/2.;
@@ -899,53 +1232,111 @@ double EOS::get_s2e_finite_rhob(double s, double rhob) const {
 //! This function returns local net baryon density rhob [1/fm^3]
 //! from given local energy density e [1/fm^4] and mu_b [1/fm]
 double EOS::get_rhob_from_mub(double e, double mub) const {
+    if (mub2rhob_tables.empty()) {
+        fprintf(stderr, "get_rhob_from_mub:: no mu_B tables for "
+                        "whichEOS = %d \n", whichEOS);
+        exit(1);
+    }
     double local_ed = e*hbarc;      // GeV/fm^3
     double local_mub = mub*hbarc;   // GeV
 
     int table_idx    = get_table_idx(e);
     int NEps         = e_length[table_idx];
-    int Nrhob        = nb_length[table_idx];
     double eps0      = e_bounds[table_idx];
     double deltaEps  = e_spacing[table_idx];
-    double rhob0     = nb_bounds[table_idx];
-    double deltaRhob = nb_spacing[table_idx];
 
     // compute the indices
     int idx_e = static_cast<int>((local_ed - eps0)/deltaEps);
-    double frac_e = (local_ed - (idx_e*deltaEps + eps0))/deltaEps;
-
     // check overflow and underflow
     idx_e = std::max(0, std::min(NEps - 2, idx_e));
+    double frac_e = (local_ed - (idx_e*deltaEps + eps0))/deltaEps;
+
+    if (   !mub_in_column(table_idx, idx_e,     local_mub)
+        || !mub_in_column(table_idx, idx_e + 1, local_mub)) {
+        fprintf(stderr, "get_rhob_from_mub:: mu_B = %e GeV is outside "
+                        "the table at e = %e GeV/fm^3, rhob is taken at "
+                        "the edge of the table \n", local_mub, local_ed);
+    }
+    double rhob = (  mub2rhob_at_node(table_idx, idx_e,     local_mub)
+                        *(1. - frac_e)
+                   + mub2rhob_at_node(table_idx, idx_e + 1, local_mub)
+                        *frac_e);   // 1/fm^3
+    return(rhob);
+}
 
-    double *array_left  = new double [Nrhob];
-    double *array_right = new double [Nrhob];
 
-    for (int i = 0; i < Nrhob; i++) {
-       array_left[i]  = mu_B_tb[table_idx][i][idx_e];
-       array_right[i] = mu_B_tb[table_idx][i][idx_e+1];
+//! rhob at mub on the piecewise linear mu_B(rhob) of the monotonic
+//! nodes mub_nodes, starting the search for the node interval at k.
+//! A mub outside the nodes gives the rhob of the first or last node.
+static double invert_mub_nodes(const double *mub_nodes, int N, int k,
+                               double mub, double rhob0, double delta_rhob) {
+    if (mub < mub_nodes[0]) return(rhob0);
+    if (mub > mub_nodes[N-1]) return(rhob0 + (N - 1)*delta_rhob);
+    // the last node below mub, as the binary search finds it
+    while (k > 0 && mub_nodes[k] >= mub) k--;
+    while (k < N - 2 && mub_nodes[k+1] < mub) k++;
+    double frac = 0.;
+    if (mub_nodes[k+1] > mub_nodes[k]) {
+        frac = (mub - mub_nodes[k])/(mub_nodes[k+1] - mub_nodes[k]);
     }
+    return(rhob0 + (k + frac)*delta_rhob);
+}
 
-    int idx_rhob_left    = Util::binary_search(array_left, Nrhob, local_mub);
-    int idx_rhob_right   = Util::binary_search(array_right, Nrhob, local_mub);
-    double rhob_left_1   = rhob0 + idx_rhob_left*deltaRhob;
-    double rhob_left_2   = rhob0 + (idx_rhob_left+1)*deltaRhob;
-    double mub_left_1    = array_left[idx_rhob_left];
-    double mub_left_2    = array_left[idx_rhob_left+1];
-    double frac_mub_left = (local_mub - mub_left_1)/(mub_left_2 - mub_left_1);
-    double rhob_left     = (rhob_left_1*(1. - frac_mub_left)
-                            + rhob_left_2*frac_mub_left);
-
-    double rhob_right_1   = rhob0 + idx_rhob_right*deltaRhob;
-    double rhob_right_2   = rhob0 + (idx_rhob_right+1)*deltaRhob;
-    double mub_right_1    = array_right[idx_rhob_right];
-    double mub_right_2    = array_right[idx_rhob_right+1];
-    double frac_mub_right = ((local_mub - mub_right_1)
-                             /(mub_right_2 - mub_right_1));
-    double rhob_right = (rhob_right_1*(1. - frac_mub_right)
-                         + rhob_right_2*frac_mub_right);
-
-    double rhob = rhob_left*(1. - frac_e) + rhob_right*frac_e;   // 1/fm^3
-    return(rhob);
+
+double EOS::mub2rhob_at_node(int table_idx, int idx_e, double mub) const {
+    const int N = nb_length[table_idx];
+    const double *node = &mub2rhob_tables[table_idx][idx_e*(N + 2)];
+    const int m = std::max(0, std::min(N - 1,
+                    static_cast<int>((mub - node[0])/node[1])));
+    return(invert_mub_nodes(node + 2, N,
+                            mub2rhob_guess[table_idx][idx_e*N + m], mub,
+                            nb_bounds[table_idx], nb_spacing[table_idx]));
+}
+
+
+//! true if mub [GeV] lies between the first and the last rhob node of
+//! the e node idx_e
+bool EOS::mub_in_column(int table_idx, int idx_e, double mub) const {
+    const int N = nb_length[table_idx];
+    const double *mub_nodes = &mub2rhob_tables[table_idx][idx_e*(N + 2) + 2];
+    return(mub >= mub_nodes[0] && mub <= mub_nodes[N-1]);
+}
+
+
+//! copies mu_B(rhob) of every e node of the tables, assuming it grows
+//! with rhob, and finds the rhob nodes below a uniform mu_B lattice
+void EOS::build_mub2rhob_tables() {
+    const EOS &eos = *this;     // read the tables through table_data
+    mub2rhob_tables.resize(number_of_tables);
+    mub2rhob_guess.resize(number_of_tables);
+    for (int itable = 0; itable < number_of_tables; itable++) {
+        const int N = nb_length[itable];
+        if (N < 2) {
+            mub2rhob_tables[itable].assign(e_length[itable]*(N + 2), 0.);
+            mub2rhob_guess[itable].assign(e_length[itable]*N, 0);
+            continue;
+        }
+        mub2rhob_tables[itable].resize(e_length[itable]*(N + 2));
+        mub2rhob_guess[itable].resize(e_length[itable]*N);
+        for (int i_e = 0; i_e < e_length[itable]; i_e++) {
+            double *node = &mub2rhob_tables[itable][i_e*(N + 2)];
+            double *mub = node + 2;
+            for (int i = 0; i < N; i++) {
+                mub[i] = eos.table_entry(itable, i, i_e, muB_tb);
+                if (i > 0) mub[i] = std::max(mub[i], mub[i-1]);
+            }
+            node[0] = mub[0];
+            node[1] = (mub[N-1] - mub[0])/(N - 1);
+            if (node[1] <= 0.) node[1] = 1.;
+            int *guess = &mub2rhob_guess[itable][i_e*N];
+            int k = 0;
+            for (int m = 0; m < N; m++) {
+                const double mub_m = node[0] + m*node[1];
+                while (k < N - 2 && mub[k+1] < mub_m) k++;
+                guess[m] = k;
+            }
+        }
+    }
 }
 
 
@@ -1077,10 +1468,8 @@ void EOS::check_eos_with_finite_muB() const {
     check_file1.close();
     check_file2.close();
 
-    output_eos_matrix(e_length[0], nb_length[0], temperature_tb[0],
-                      "check_EoS_T_table1.dat");
-    output_eos_matrix(e_length[0], nb_length[0], mu_B_tb[0],
-                      "check_EoS_muB_table1.dat");
+    output_eos_matrix(0, T_tb,   "check_EoS_T_table1.dat");
+    output_eos_matrix(0, muB_tb, "check_EoS_muB_table1.dat");
 
     double sovernB[] = {10.0, 20.0, 30.0, 51.0, 70.0, 94.0, 144.0, 420.0};
     int array_length = sizeof(sovernB)/sizeof(double);
@@ -1136,4 +1525,13 @@ void EOS::resize_table_info_arrays() {
     e_bounds.resize(number_of_tables, 0.0);
     e_spacing.resize(number_of_tables, 0.0);
     e_length.resize(number_of_tables, 0);
+    tables.resize(number_of_tables);
+    table_data.resize(number_of_tables, nullptr);
+}
+
+
+//! allocates the table itable once its lengths are known
+void EOS::allocate_table(int itable) {
+    tables[itable].assign(
+        nb_length[itable]*e_length[itable]*n_table_quantities, 0.0);
 }
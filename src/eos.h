@@ -8,6 +8,8 @@
 
 #include "util.h"
 #include "data.h"
+#include "cell.h"
+#include "eos_table_cache.h"
 #include "pretty_ostream.h"
 
 class EOS {
@@ -25,18 +27,90 @@ class EOS {
     std::vector<int> nb_length;
     std::vector<int> e_length;
 
-    double ***pressure_tb;
-    double ***temperature_tb;
-    double ***mu_B_tb;
-    double ***mu_S_tb;
+    //! quantities stored at every node of the EOS tables. P, T, mu_B and
+    //! mu_S are read from file (in GeV units); dP/de [1], dP/drhob [1/fm]
+    //! and cs^2 are derived from them once the tables are loaded.
+    enum TableQuantity {P_tb = 0, T_tb = 1, muB_tb = 2, muS_tb = 3,
+                        dPde_tb = 4, dPdrhob_tb = 5, cs2_tb = 6,
+                        n_table_quantities = 7};
+
+    //! one flat table per EOS region. The quantities of a (rhob, e) node
+    //! are next to each other and e runs fastest, so the four corners of a
+    //! bilinear interpolation sit in two short runs of memory.
+    std::vector<std::vector<double>> tables;
+
+    //! the tables used for lookups: either the ones above or the image
+    //! mapped from the binary cache (see read_eos_tables)
+    std::vector<const double*> table_data;
+    EOSTableCache table_cache;
+
+    //! lattice cell of table_idx that contains (e, rhob) and the
+    //! position of the point inside it
+    struct TableCell {
+        int idx_e, idx_nb;
+        double frac_e, frac_nb;
+    };
+
+    //! table index for bins of log2(e) (see get_table_idx), so that the
+    //! table of an energy density is found without scanning e_bounds
+    std::vector<int> table_idx_map;
+    long long table_idx_key_min = 0;
 
     int whichEOS;
     double eps_max;
 
+    void read_eos_tables();
+    std::string get_table_subdir() const;
+    std::string get_table_root() const;
+    std::string get_table_dir() const;
+    void build_table_idx_map();
+    void get_pressure_temperature_mu(const TableCell &cell, int table_idx,
+                                     double rhob, double &P, double &T,
+                                     double &mu) const;
+    void fill_derivative_tables();
+    bool tables_depend_on_rhob() const {
+        return(whichEOS == 1 || whichEOS >= 10);
+    }
+
+    //! range of e [GeV/fm^3] covered by the table nodes. Outside of it the
+    //! derivatives come from finite differences of the extrapolated
+    //! pressure, as the tabulated ones would not reproduce them.
+    double e_min_tables = 0.;
+    double e_max_tables = 0.;
+    bool in_derivative_tables(double e) const {
+        const double local_ed = e*hbarc;
+        return(local_ed >= e_min_tables && local_ed <= e_max_tables);
+    }
+
+    //! inverse of s(e, rhob): log(e) on a lattice uniform in log(s), with
+    //! one column for every rhob in s2e_rhob (0, then log spaced). It
+    //! gives the starting point that get_s2e_finite_rhob refines.
+    std::vector<double> s2e_log_e;
+    std::vector<double> s2e_rhob;   // [1/fm^3]
+    int s2e_n_s = 0;
+    double s2e_log_s_min = 0., s2e_dlog_s = 1.;
+    double s2e_log_rhob_min = 0., s2e_dlog_rhob = 1.;
+    void build_s2e_table();
+    double s2e_guess(double s, double rhob) const;
+    double get_s2e_bisection(double s, double rhob) const;
+
+    //! mu_B(rhob) [GeV] of every e node of the tables, made monotonic,
+    //! behind the first point and the spacing of a uniform mu_B lattice
+    //! with nb_length points. mub2rhob_guess holds for every lattice
+    //! point the last rhob node below it, where the search for the rhob
+    //! node interval of a mu_B starts.
+    std::vector<std::vector<double>> mub2rhob_tables;
+    std::vector<std::vector<int>> mub2rhob_guess;
+    void build_mub2rhob_tables();
+    double mub2rhob_at_node(int table_idx, int idx_e, double mub) const;
+    bool mub_in_column(int table_idx, int idx_e, double mub) const;
+
+    //! reads the tables in the unit tests (eos_test.cpp)
+    friend struct EOSTestAccess;
+
  public:
     EOS() = default;
     EOS(const InitData &para_in);  // constructor
-    ~EOS();  // destructor
     void initialize_eos();
     std::string get_hydro_env_path() const;
     void resize_table_info_arrays();
@@ -53,8 +127,32 @@ class EOS {
 
     // for EOS at finite mu_B
     int get_table_idx(double e) const;
-    double interpolate1D(double e, int table_idx, double ***table) const;
-    double interpolate2D(double e, double rhob, int table_idx, double ***table) const;
+    void allocate_table(int itable);
+    //! write access, only while the tables are read from file
+    double& table_entry(int itable, int i_nb, int i_e, int quantity) {
+        return tables[itable][(i_nb*e_length[itable] + i_e)*n_table_quantities
+                              + quantity];
+    }
+    double table_entry(int itable, int i_nb, int i_e, int quantity) const {
+        return table_data[itable][
+                    (i_nb*e_length[itable] + i_e)*n_table_quantities + quantity];
+    }
+    TableCell get_table_cell(double e, double rhob, int table_idx) const;
+    double interpolate1D(double e, int table_idx, int quantity) const;
+    double interpolate1D(const TableCell &cell, int table_idx,
+                         int quantity) const;
+    double interpolate2D(double e, double rhob, int table_idx, int quantity) const;
+    double interpolate2D(const TableCell &cell, int table_idx,
+                         int quantity) const;
+    double interpolate(const TableCell &cell, int table_idx,
+                       int quantity) const;
+    double interpolate(double e, double rhob, int quantity) const;
+
+    //! P [1/fm^4], T [1/fm] and mu_B [1/fm] from one table lookup
+    void get_pressure_temperature_mu(double epsilon, double rhob, double &P,
+                                     double &T, double &mu) const;
+    //! all thermodynamic quantities of a cell in one call
+    ThermoCell get_thermo(double epsilon, double rhob) const;
 
     double get_cs2(double e, double rhob) const;
     double calculate_velocity_of_sound_sq(double e, double rhob) const;
@@ -75,10 +173,13 @@ class EOS {
     double s2e_ideal_gas(double s) const;
     double get_s2e(double s, double rhob) const;
     double get_s2e_finite_rhob(double s, double rhob) const;
+    //! get_s2e for n cells, e.g. a whole slice of an initial condition
+    void get_s2e(int n, const double *s, const double *rhob,
+                 double *e) const;
     void check_eos() const;
     void check_eos_with_finite_muB() const;
     void check_eos_no_muB() const;
-    void output_eos_matrix(int ne, int nrhob, double** matrix_ptr,
+    void output_eos_matrix(int itable, int quantity,
                            std::string filename) const;
 };
 
@@ -0,0 +1,48 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "eos_table_cache.h"
+#include "doctest.h"
+
+TEST_CASE("EOSTableCache maps back what it wrote and rejects stale images") {
+    const std::string filename = "unittest_eos_table_cache.bin";
+    const int n_q = 3;
+    std::vector<EOSTableCache::TableInfo> info = {
+        {0.0, 0.1, 0.01, 0.2, 2, 3},
+        {0.0, 0.7, 0.02, 0.5, 1, 4}};
+    std::vector<double> t0(2*3*n_q), t1(1*4*n_q);
+    for (std::size_t i = 0; i < t0.size(); i++) t0[i] = 0.5*i;
+    for (std::size_t i = 0; i < t1.size(); i++) t1[i] = -1.0*i;
+    CHECK(EOSTableCache::write(filename, 10, n_q, 42, info,
+                               {t0.data(), t1.data()}));
+
+    EOSTableCache cache;
+    REQUIRE(cache.open(filename, 10, n_q, 42));
+    CHECK(cache.size() == 2);
+    CHECK(cache.info(1).e_bounds  == 0.7);
+    CHECK(cache.info(1).e_length  == 4);
+    CHECK(cache.table(0)[5]       == t0[5]);
+    CHECK(cache.table(1)[11]      == t1[11]);
+
+    // a copy keeps the image mapped after the original is gone
+    EOSTableCache copy = cache;
+    cache = EOSTableCache();
+    CHECK(copy.table(0)[t0.size() - 1] == t0.back());
+
+    CHECK(!cache.open(filename, 11, n_q, 42));
+    CHECK(!cache.open(filename, 10, n_q + 1, 42));
+    CHECK(!cache.open(filename, 10, n_q, 43));
+    CHECK(!cache.open("no_such_file.bin", 10, n_q, 42));
+
+    // flip one byte of the table data
+    FILE *f = fopen(filename.c_str(), "r+b");
+    REQUIRE(f != nullptr);
+    fseek(f, -3, SEEK_END);
+    const int c = fgetc(f);
+    fseek(f, -3, SEEK_END);
+    fputc(c ^ 1, f);
+    fclose(f);
+    CHECK(!cache.open(filename, 10, n_q, 42));
+    CHECK(cache.size() == 0);
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,229 @@
+#ifndef SRC_EOS_TABLE_CACHE_H_
+#define SRC_EOS_TABLE_CACHE_H_
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+//! Binary image of the processed EOS tables.
+//! The first run with a tabulated EOS writes the tables, after all
+//! derived quantities are filled, to one file; later runs mmap it
+//! read-only instead of parsing the ASCII tables, so all processes on a
+//! node share one physical copy. The image is only used if its format
+//! version, EOS, number of quantities, source stamp and checksum match.
+class EOSTableCache {
+ public:
+    //! lattice of one EOS table
+    struct TableInfo {
+        double nb_bounds, e_bounds;
+        double nb_spacing, e_spacing;
+        std::int64_t nb_length, e_length;
+    };
+
+    //! bump whenever the layout of the image or the content of the
+    //! tables (e.g. the derived quantities) changes
+    static const std::uint32_t version = 1;
+
+ private:
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::int32_t  which_eos;
+        std::int32_t  number_of_tables;
+        std::int32_t  n_quantities;
+        std::uint64_t source_stamp;
+        std::uint64_t payload_size;     // bytes following the header
+        std::uint64_t checksum;         // of the payload
+    };
+
+    std::shared_ptr<const char> image;  // unmapped with the last copy
+    const TableInfo *infos = nullptr;
+    std::vector<const double*> tables;
+
+    static const char* magic() {return "MUSICEOS";}
+    static std::uint64_t fnv_offset() {return 14695981039346656037ULL;}
+
+    //! FNV-1a on 8-byte words, continuing from hash h
+    static std::uint64_t fnv1a(const void *data, std::size_t size,
+                               std::uint64_t h = fnv_offset()) {
+        const std::uint64_t fnv_prime = 1099511628211ULL;
+        const char *p = static_cast<const char*>(data);
+        std::size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, p + i, 8);
+            h = (h ^ word)*fnv_prime;
+        }
+        for (; i < size; i++) {
+            h = (h ^ static_cast<unsigned char>(p[i]))*fnv_prime;
+        }
+        return h;
+    }
+
+ public:
+    //! maps filename and checks it against the expected contents;
+    //! returns false (and holds nothing) if it cannot be used
+    bool open(const std::string &filename, int which_eos, int n_quantities,
+              std::uint64_t source_stamp);
+
+    //! writes the image atomically (to a temporary file that is renamed),
+    //! so concurrent runs never see a partial file; returns false on
+    //! error
+    static bool write(const std::string &filename, int which_eos,
+                      int n_quantities, std::uint64_t source_stamp,
+                      const std::vector<TableInfo> &info,
+                      const std::vector<const double*> &data);
+
+    //! hash of the names, sizes and modification times of the regular
+    //! files in directory dir, to notice changed ASCII tables
+    static std::uint64_t source_stamp(const std::string &dir);
+
+    int size() const {return static_cast<int>(tables.size());}
+    const TableInfo& info(int itable) const {return infos[itable];}
+    const double* table(int itable) const {return tables[itable];}
+};
+
+
+inline bool EOSTableCache::open(const std::string &filename,
+                                const int which_eos, const int n_quantities,
+                                const std::uint64_t source_stamp) {
+    image.reset();
+    infos = nullptr;
+    tables.clear();
+
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+        close(fd);
+        return false;
+    }
+    const std::size_t size = static_cast<std::size_t>(st.st_size);
+    void *addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) return false;
+    std::shared_ptr<const char> mapped(
+        static_cast<const char*>(addr),
+        [size](const char *p) {munmap(const_cast<char*>(p), size);});
+
+    Header header;
+    std::memcpy(&header, mapped.get(), sizeof(Header));
+    if (   std::memcmp(header.magic, magic(), sizeof(header.magic)) != 0
+        || header.version          != version
+        || header.which_eos        != which_eos
+        || header.n_quantities     != n_quantities
+        || header.source_stamp     != source_stamp
+        || header.number_of_tables <= 0
+        || header.payload_size     != size - sizeof(Header)) {
+        return false;
+    }
+
+    const char *payload = mapped.get() + sizeof(Header);
+    const std::size_t info_size = header.number_of_tables*sizeof(TableInfo);
+    if (info_size > header.payload_size) return false;
+    const TableInfo *info = reinterpret_cast<const TableInfo*>(payload);
+    std::size_t n_doubles = 0;
+    for (int itable = 0; itable < header.number_of_tables; itable++) {
+        if (info[itable].nb_length <= 0 || info[itable].e_length <= 0) {
+            return false;
+        }
+        n_doubles += (info[itable].nb_length*info[itable].e_length
+                      *n_quantities);
+    }
+    if (info_size + n_doubles*sizeof(double) != header.payload_size) {
+        return false;
+    }
+    if (fnv1a(payload, header.payload_size) != header.checksum) {
+        return false;
+    }
+
+    const double *data = reinterpret_cast<const double*>(payload + info_size);
+    for (int itable = 0; itable < header.number_of_tables; itable++) {
+        tables.push_back(data);
+        data += info[itable].nb_length*info[itable].e_length*n_quantities;
+    }
+    infos = info;
+    image = mapped;
+    return true;
+}
+
+
+inline bool EOSTableCache::write(const std::string &filename,
+                                 const int which_eos, const int n_quantities,
+                                 const std::uint64_t source_stamp,
+                                 const std::vector<TableInfo> &info,
+                                 const std::vector<const double*> &data) {
+    Header header;
+    std::memcpy(header.magic, magic(), sizeof(header.magic));
+    header.version          = version;
+    header.which_eos        = which_eos;
+    header.number_of_tables = static_cast<std::int32_t>(info.size());
+    header.n_quantities     = n_quantities;
+    header.source_stamp     = source_stamp;
+
+    std::vector<std::size_t> table_size(info.size());
+    header.payload_size = info.size()*sizeof(TableInfo);
+    header.checksum = fnv1a(info.data(), info.size()*sizeof(TableInfo));
+    for (std::size_t itable = 0; itable < info.size(); itable++) {
+        table_size[itable] = (info[itable].nb_length*info[itable].e_length
+                              *n_quantities*sizeof(double));
+        header.payload_size += table_size[itable];
+        header.checksum = fnv1a(data[itable], table_size[itable],
+                                header.checksum);
+    }
+
+    const std::string tmp_name = (filename + ".tmp."
+                                  + std::to_string(getpid()));
+    FILE *f = fopen(tmp_name.c_str(), "wb");
+    if (f == nullptr) return false;
+    bool ok = fwrite(&header, sizeof(Header), 1, f) == 1;
+    ok = ok && (info.empty()
+                || fwrite(info.data(), sizeof(TableInfo), info.size(), f)
+                   == info.size());
+    for (std::size_t itable = 0; itable < info.size() && ok; itable++) {
+        ok = fwrite(data[itable], 1, table_size[itable], f)
+             == table_size[itable];
+    }
+    ok = (fclose(f) == 0) && ok;
+    ok = ok && std::rename(tmp_name.c_str(), filename.c_str()) == 0;
+    if (!ok) std::remove(tmp_name.c_str());
+    return ok;
+}
+
+
+inline std::uint64_t EOSTableCache::source_stamp(const std::string &dir) {
+    DIR *d = opendir(dir.c_str());
+    if (d == nullptr) return 0;
+    std::vector<std::string> names;
+    while (struct dirent *entry = readdir(d)) {
+        names.push_back(entry->d_name);
+    }
+    closedir(d);
+    std::sort(names.begin(), names.end());
+
+    std::uint64_t h = fnv_offset();
+    for (const auto &name : names) {
+        struct stat st;
+        if (stat((dir + "/" + name).c_str(), &st) != 0
+            || !S_ISREG(st.st_mode)) {
+            continue;
+        }
+        const std::int64_t size  = st.st_size;
+        const std::int64_t mtime = st.st_mtime;
+        h = fnv1a(name.data(), name.size(), h);
+        h = fnv1a(&size,  sizeof(size),  h);
+        h = fnv1a(&mtime, sizeof(mtime), h);
+    }
+    return h;
+}
+
+#endif  // SRC_EOS_TABLE_CACHE_H_
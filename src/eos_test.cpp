@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "eos.h"
+#include "doctest.h"
+
+//! reads the table layout of an EOS for the checks below
+struct EOSTestAccess {
+    const EOS &eos;
+    int table_idx, idx_e;
+    double frac_e;
+
+    EOSTestAccess(const EOS &eos_in, double e) : eos(eos_in) {
+        const double local_ed = e*hbarc;
+        table_idx = eos.get_table_idx(e);
+        idx_e = std::max(0, std::min(eos.e_length[table_idx] - 2,
+            static_cast<int>((local_ed - eos.e_bounds[table_idx])
+                             /eos.e_spacing[table_idx])));
+        frac_e = ((local_ed - (idx_e*eos.e_spacing[table_idx]
+                               + eos.e_bounds[table_idx]))
+                  /eos.e_spacing[table_idx]);
+    }
+
+    int n_rhob() const {return(eos.nb_length[table_idx]);}
+    double rhob_node(int i) const {
+        return(eos.nb_bounds[table_idx] + i*eos.nb_spacing[table_idx]);
+    }
+
+    //! mu_B [GeV] at the rhob nodes of e node idx_e + j, made monotonic
+    std::vector<double> mub_column(int j) const {
+        std::vector<double> mub(n_rhob());
+        for (int i = 0; i < n_rhob(); i++) {
+            mub[i] = eos.table_entry(table_idx, i, idx_e + j, EOS::muB_tb);
+            if (i > 0) mub[i] = std::max(mub[i], mub[i-1]);
+        }
+        return(mub);
+    }
+
+    bool in_table(double mub) const {
+        for (int j = 0; j < 2; j++) {
+            const std::vector<double> col = mub_column(j);
+            if (mub < col.front() || mub > col.back()) return(false);
+        }
+        return(true);
+    }
+
+    //! rhob [1/fm^3] at mub [GeV] from a binary search over the rhob nodes
+    double rhob_binary_search(double mub) const {
+        double rhob = 0.;
+        for (int j = 0; j < 2; j++) {
+            const std::vector<double> col = mub_column(j);
+            int k = static_cast<int>(
+                std::lower_bound(col.begin(), col.end(), mub) - col.begin()) - 1;
+            k = std::max(0, std::min(n_rhob() - 2, k));
+            double frac = 0.;
+            if (col[k+1] > col[k]) frac = (mub - col[k])/(col[k+1] - col[k]);
+            rhob += ((j == 0 ? 1. - frac_e : frac_e)
+                     *(rhob_node(k) + frac*(rhob_node(k+1) - rhob_node(k))));
+        }
+        return(rhob);
+    }
+};
+
+
+TEST_CASE("get_rhob_from_mub agrees with a binary search on the nodes") {
+    InitData DATA;
+    DATA.whichEOS   = 10;
+    DATA.echo_level = 0;
+    EOS eos(DATA);
+    // small mu_B, where rhob(mu_B) is most nonlinear, and up to 0.8 GeV
+    std::vector<double> mub_list;
+    for (int k = 0; k < 12; k++) mub_list.push_back(1e-6*std::pow(2., k));
+    for (int k = 0; k <= 80; k++) mub_list.push_back(0.01*k);
+    int n_checked = 0;
+    for (int ie = 0; ie < 60; ie++) {
+        // e from 1e-4 to about 100 GeV/fm^3
+        const double e = 1e-4*std::pow(10., 0.1*ie)/hbarc;
+        const EOSTestAccess table(eos, e);
+        for (const double mub_GeV : mub_list) {
+            if (!table.in_table(mub_GeV)) continue;
+            CHECK(eos.get_rhob_from_mub(e, mub_GeV/hbarc) == doctest::Approx(
+                    table.rhob_binary_search(mub_GeV)).epsilon(1e-12));
+            n_checked++;
+        }
+    }
+    CHECK(n_checked > 1000);
+}
+
+
+TEST_CASE("get_rhob_from_mub stops at the edge of the table") {
+    InitData DATA;
+    DATA.whichEOS   = 10;
+    DATA.echo_level = 0;
+    EOS eos(DATA);
+    const double e = 1./hbarc;
+    const EOSTestAccess table(eos, e);
+    const double mub_max = std::max(table.mub_column(0).back(),
+                                    table.mub_column(1).back());
+    REQUIRE(!table.in_table(2.*mub_max));
+    // the edge value is returned with a warning instead of extrapolating
+    CHECK(eos.get_rhob_from_mub(e, 2.*mub_max/hbarc) == doctest::Approx(
+            table.rhob_node(table.n_rhob() - 1)));
+}
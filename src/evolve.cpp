@@ -2,13 +2,16 @@
 #include <omp.h>
 #include <algorithm>
 #include <memory>
+#include <limits>
 #include <cmath>
+#include <vector>
 
 #include "./evolve.h"
 #include "./util.h"
 #include "./data.h"
 #include "./cell.h"
 #include "./grid.h"
+#include "./grid_tiles.h"
 #include "./eos.h"
 #include "./advance.h"
 #include "./cornelius.h"
@@ -20,14 +23,59 @@
 using namespace std;
 
 Evolve::Evolve(const EOS &eosIn, const InitData &DATA_in,
-               hydro_source &hydro_source_in) :
+               hydro_source &hydro_source_in, const Domain &domain_in) :
     eos(eosIn), DATA(DATA_in), hydro_source_terms(hydro_source_in),
-    grid_info(DATA_in, eosIn), advance(eosIn, DATA_in, hydro_source_in),
+    domain(domain_in), step_data(DATA_in),
+    grid_info(DATA_in, eosIn, domain_in),
+    advance(eosIn, step_data, hydro_source_in, domain_in),
     u_derivative(DATA_in, eosIn) {
     rk_order  = DATA_in.rk_order;
+    if (domain.n_ranks() > 1 && (DATA.boost_invariant == 1
+            || DATA.Initial_profile == 13 || DATA.Initial_profile == 30)) {
+        music_message << "The hydro grid can only be shared by several MPI "
+                      << "ranks for 3+1D runs without hydro source terms.";
+        music_message.flush("error");
+        exit(1);
+    }
     if (DATA.freezeOutMethod == 4) {
         initialize_freezeout_surface_info();
     }
+    initialize_active_region();
+}
+
+//! the active region can not follow the periodic wrap of the grid nor
+//! energy deposited by the source terms, and must contain the
+//! freeze-out surfaces
+void Evolve::initialize_active_region() {
+    active_e_threshold = std::max(0., DATA.active_region_threshold/hbarc);
+    if (active_e_threshold == 0.) return;
+    if (domain.n_ranks() > 1) {
+        music_message << "active_region_threshold is not supported with "
+                      << "several MPI ranks, every cell will be evolved.";
+        music_message.flush("warning");
+        active_e_threshold = 0.;
+        return;
+    }
+    if (DATA.transverse_boundary == 1
+            || DATA.Initial_profile == 13 || DATA.Initial_profile == 30) {
+        music_message << "active_region_threshold is not supported with "
+                      << "periodic boundaries or hydro source terms, "
+                      << "every cell will be evolved.";
+        music_message.flush("warning");
+        active_e_threshold = 0.;
+        return;
+    }
+    if (DATA.doFreezeOut == 1) {
+        for (const auto epsFO : epsFO_list) {
+            if (epsFO/hbarc < active_e_threshold) {
+                music_message << "active_region_threshold is lowered to "
+                              << "the freeze-out energy density "
+                              << epsFO << " GeV/fm^3.";
+                music_message.flush("warning");
+                active_e_threshold = epsFO/hbarc;
+            }
+        }
+    }
 }
 
 // master control function for hydrodynamic evolution
@@ -41,7 +89,8 @@ int Evolve::EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
 
     // Output information about the hydro parameters
     // in the format of a C header file
-    if (DATA.output_hydro_params_header || DATA.outputEvolutionData == 1)
+    if ((DATA.output_hydro_params_header || DATA.outputEvolutionData == 1)
+            && domain.is_root())
         grid_info.Output_hydro_information_header();
 
     // main loop starts ...
@@ -49,7 +98,36 @@ int Evolve::EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
     double tau0  = DATA.tau0;
     double dt    = DATA.delta_tau;
 
-    double tau;
+    // with an adaptive time step the evolution outputs and freeze-out
+    // surfaces keep (as nearly as the steps allow) the spacing in tau that
+    // they have for Delta_Tau. The steps land on the output and check
+    // times; the step that the CFL condition allows (dt_cfl) is kept apart
+    // from these shortened ones.
+    const bool adaptive_time_step = (step_data.adaptive_time_step == 1);
+    const bool evolution_output = (DATA.outputEvolutionData != 0
+                                   || DATA.output_movie_flag == 1);
+    const double tau_end = tau0 + itmax*dt;
+    const double output_dtau = Nskip_timestep*DATA.delta_tau;
+    const double freezeout_dtau = facTau*DATA.delta_tau;
+    double tau_output    = tau0;    // time of the next evolution output
+    double tau_freezeout = tau0;    // time of arena_freezeout
+    double dt_prev       = dt;
+    double dt_cfl        = dt;
+
+    // times of the Gubser and 1+1D checks
+    std::vector<double> check_times;
+    if (DATA.Initial_profile == 0) {
+        check_times = {1.0, 1.2, 1.5, 2.0, 3.0};
+    } else if (DATA.Initial_profile == 1) {
+        check_times = {1.0, 2.0, 5.0, 10.0, 20.0};
+    }
+    const auto is_check_time = [&check_times](double t) {
+        for (const double t_check : check_times)
+            if (fabs(t - t_check) < 1e-8) return(true);
+        return(false);
+    };
+
+    double tau = tau0;
     int it_start = 0;
     double source_tau_max = 0.0;
     if (DATA.Initial_profile == 13 || DATA.Initial_profile == 30) {
@@ -65,20 +143,57 @@ int Evolve::EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
                            arena_current.nY(),
                            arena_current.nEta());
 
+    // a cell can be reached by the 2-cell stencils of all RK stages of
+    // one step, so the tiles stay active that far around the hot cells
+    ActiveTiles active_tiles(
+            GridTiles(arena_current.nX(), arena_current.nY(),
+                      arena_current.nEta(), 3*sizeof(Cell_small),
+                      DATA.tile_size_x, DATA.tile_size_y,
+                      DATA.tile_size_eta),
+            2*rk_order, 2);
+
     int maxthreads = omp_get_max_threads();
-    // Clean up any existing surface files
-    if (DATA.boost_invariant == 0)
-    {
-	for(int nth = 0; nth < maxthreads; nth++)
-	{
-	    ostringstream filename;
-	    filename << "surface" << nth << ".dat";
-	    remove(filename.str().c_str());
-	}
+    // the surface of every threshold goes to its file through a sink that
+    // stays open; with several ranks every rank writes its piece
+    // surface<rank>.dat, merged at the end
+    surface_sinks.clear();
+    freeze_out_workspaces.clear();
+    for (int i_freezesurf = 0; i_freezesurf < n_freeze_surf; i_freezesurf++) {
+        if (domain.is_root())
+            remove(surface_file_name(i_freezesurf, -1).c_str());
+        surface_sinks.emplace_back(new SurfaceSink(DATA, surface_in_memory));
+        if (DATA.freeze_surface_to_file) {
+            const bool pieces = (domain.n_ranks() > 1);
+            surface_sinks.back()->open(
+                surface_file_name(i_freezesurf, pieces ? domain.rank() : -1),
+                epsFO_list[i_freezesurf], !pieces);
+        }
     }
-    remove("surface.dat");
-    for (int it = 0; it <= itmax; it++) {
-        tau = tau0 + dt*it;
+    for (int nth = 0; nth < maxthreads; nth++)
+        freeze_out_workspaces.emplace_back(new FreezeOutWorkspace);
+    for (int it = 0; ; it++) {
+        if (adaptive_time_step) {
+            if (tau > tau_end + 1e-8) break;
+            double tau_stop = std::numeric_limits<double>::max();
+            if (evolution_output) {
+                tau_stop = tau_output;
+                while (tau_stop < tau + 1e-8) tau_stop += output_dtau;
+            }
+            for (const double t_check : check_times) {
+                if (t_check > tau + 1e-8) {
+                    tau_stop = std::min(tau_stop, t_check);
+                    break;
+                }
+            }
+            // the last two steps before tau_stop share the remaining
+            // interval, so that no step is much shorter than dt_cfl
+            dt = dt_cfl;
+            const double n_steps = std::ceil((tau_stop - tau)/dt_cfl - 1e-8);
+            if (n_steps <= 2.) dt = (tau_stop - tau)/std::max(n_steps, 1.);
+        } else {
+            if (it > itmax) break;
+            tau = tau0 + dt*it;
+        }
 
         if (DATA.Initial_profile == 13 || DATA.Initial_profile == 30) {
             hydro_source_terms.prepare_list_for_current_tau_frame(tau);
@@ -89,16 +204,14 @@ int Evolve::EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
         }
 
         if (DATA.Initial_profile == 0) {
-            if (   fabs(tau - 1.0) < 1e-8 || fabs(tau - 1.2) < 1e-8
-                || fabs(tau - 1.5) < 1e-8 || fabs(tau - 2.0) < 1e-8
-                || fabs(tau - 3.0) < 1e-8) {
-                grid_info.Gubser_flow_check_file(*ap_current, tau);
+            if (is_check_time(tau)) {
+                if (auto whole = whole_grid(*ap_current))
+                    grid_info.Gubser_flow_check_file(*whole, tau);
             }
         } else if (DATA.Initial_profile == 1) {
-            if (   fabs(tau -  1.0) < 1e-8 || fabs(tau -  2.0) < 1e-8
-                || fabs(tau -  5.0) < 1e-8 || fabs(tau - 10.0) < 1e-8
-                || fabs(tau - 20.0) < 1e-8) {
-                grid_info.output_1p1D_check_file(*ap_current, tau);
+            if (is_check_time(tau)) {
+                if (auto whole = whole_grid(*ap_current))
+                    grid_info.output_1p1D_check_file(*whole, tau);
             }
         }
 
@@ -110,16 +223,23 @@ int Evolve::EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
             }
         }
 
-        if (it % Nskip_timestep == 0) {
+        bool output_step = (it % Nskip_timestep == 0);
+        if (adaptive_time_step) {
+            output_step = (tau > tau_output - 1e-8);
+            while (tau_output < tau + 1e-8) tau_output += output_dtau;
+        }
+        SCGrid *whole = nullptr;
+        if (output_step && evolution_output) whole = whole_grid(*ap_current);
+        if (whole != nullptr) {
             if (DATA.outputEvolutionData == 1) {
-                grid_info.OutputEvolutionDataXYEta(*ap_current, tau);
+                grid_info.OutputEvolutionDataXYEta(*whole, tau);
             } else if (DATA.outputEvolutionData == 2) {
-                grid_info.OutputEvolutionDataXYEta_chun(*ap_current, tau);
+                grid_info.OutputEvolutionDataXYEta_chun(*whole, tau);
             } else if (DATA.outputEvolutionData == 3) {
-                grid_info.OutputEvolutionDataXYEta_photon(*ap_current, tau);
+                grid_info.OutputEvolutionDataXYEta_photon(*whole, tau);
             }
             if (DATA.output_movie_flag == 1) {
-                grid_info.output_evolution_for_movie(*ap_current, tau);
+                grid_info.output_evolution_for_movie(*whole, tau);
             }
         }
 
@@ -138,18 +258,26 @@ int Evolve::EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
                                             tau, 4.0, 5.0, *ap_current);
         }
 
+        if (active_e_threshold > 0.) {
+            active_tiles.update(*ap_current, active_e_threshold);
+        }
+
         // check energy conservation
         if (DATA.boost_invariant == 0)
-            grid_info.check_conservation_law(*ap_current, *ap_prev, tau);
-        grid_info.get_maximum_energy_density(*ap_current);
+            grid_info.check_conservation_law(*ap_current, *ap_prev, tau,
+                                             active_tiles);
+        grid_info.get_maximum_energy_density(*ap_current, active_tiles);
 
         if (DATA.output_hydro_debug_info == 1) {
-            grid_info.monitor_fluid_cell(*ap_current, 100, 100, 0, tau);
+            if (auto whole = whole_grid(*ap_current))
+                grid_info.monitor_fluid_cell(*whole, 100, 100, 0, tau);
         }
 
         /* execute rk steps */
         // all the evolution are at here !!!
-        AdvanceRK(tau, ap_prev, ap_current, ap_future);
+        step_data.delta_tau = dt;
+        step_data.delta_tau_backward = dt_prev;
+        AdvanceRK(tau, ap_prev, ap_current, ap_future, active_tiles);
 
         //determine freeze-out surface
         int frozen = 0;
@@ -158,61 +286,162 @@ int Evolve::EvolveIt(SCGrid &arena_prev, SCGrid &arena_current,
                 frozen = FreezeOut_equal_tau_Surface(tau, *ap_current);
             }
             // avoid freeze-out at the first time step
-            if ((it - it_start)%facTau == 0 && it > it_start) {
+            bool freezeout_step = ((it - it_start)%facTau == 0);
+            double DTAU = freezeout_dtau;
+            if (adaptive_time_step) {
+                freezeout_step = (tau - tau_freezeout
+                                  > freezeout_dtau - 0.5*dt);
+                DTAU = tau - tau_freezeout;
+            }
+            if (freezeout_step && it > it_start) {
                 if (DATA.boost_invariant == 0) {
                     frozen = FindFreezeOutSurface_Cornelius(
-                                tau, *ap_current, arena_freezeout);
+                                tau, DTAU, *ap_current, arena_freezeout);
                 } else {
                     frozen = FindFreezeOutSurface_boostinvariant_Cornelius(
-                                tau, *ap_current, arena_freezeout);
+                                tau, DTAU, *ap_current, arena_freezeout);
                 }
                 store_previous_step_for_freezeout(*ap_current,
                                                   arena_freezeout);
+                tau_freezeout = tau;
             }
         }
         music_message << "Done time step " << it << "/" << itmax
                       << " tau = " << tau << " fm/c";
+        if (adaptive_time_step) {
+            music_message << ", dtau = " << dt << " fm/c";
+            tau += dt;
+            dt_prev = dt;
+            dt_cfl = next_time_step(dt_cfl);
+        }
+        if (active_e_threshold > 0.) {
+            music_message << ", " << active_tiles.n_active() << "/"
+                          << active_tiles.get_tiles().size()
+                          << " tiles active";
+        }
         music_message.flush("info");
         if (frozen == 1) break;
     }
-    if (DATA.boost_invariant == 0)
-    {
-	ofstream FinalSurfaceFile("surface.dat", std::ios_base::binary | ios::out | ios::app);
-//	cout << "Thread number is " << maxthreads << endl;
-	for(int nth = 0; nth < maxthreads; nth++)
-	{
-	    ostringstream filename;
-	    filename << "surface" << nth << ".dat";
-	    ifstream surfacefile;
-	    surfacefile.open(filename.str().c_str(), std::ios_base::binary);
-	    FinalSurfaceFile << surfacefile.rdbuf();
-	    remove(filename.str().c_str());
-	}
+    for (auto &sink : surface_sinks) sink->close();
+    // the surface pieces of all ranks are merged once every rank is done
+    domain.barrier();
+    if (domain.n_ranks() > 1 && DATA.freeze_surface_to_file
+            && domain.is_root()) {
+        for (int i_freezesurf = 0; i_freezesurf < n_freeze_surf;
+             i_freezesurf++) {
+            ofstream FinalSurfaceFile(surface_file_name(i_freezesurf, -1),
+                                      std::ios_base::binary | ios::out
+                                      | ios::app);
+            if (DATA.freeze_surface_in_binary) {
+                // the pieces have no header, the merged file gets one
+                SurfaceFileHeader header = surface_file_header(
+                                        DATA, epsFO_list[i_freezesurf]);
+                for (int rank = 0; rank < domain.n_ranks(); rank++) {
+                    ifstream piece(surface_file_name(i_freezesurf, rank),
+                                   std::ios_base::binary | ios::ate);
+                    header.n_elements += (
+                        static_cast<int64_t>(piece.tellg())
+                        /header.record_bytes());
+                }
+                FinalSurfaceFile.write(reinterpret_cast<const char*>(&header),
+                                       sizeof(header));
+            }
+            for (int rank = 0; rank < domain.n_ranks(); rank++) {
+                const string filename = surface_file_name(i_freezesurf, rank);
+                ifstream surfacefile(filename.c_str(), std::ios_base::binary);
+                // an empty piece would leave the merged file failed
+                if (surfacefile.peek() != EOF)
+                    FinalSurfaceFile << surfacefile.rdbuf();
+                remove(filename.c_str());
+            }
+        }
     }
 
     music_message.info("Finished.");
     return 1;
 }
 
+//! time step that follows the step dtau (before it was shortened to land
+//! on an output time): the largest one allowed by adaptive_CFL for the
+//! signal speeds of the last step and by the relaxation times (where the
+//! floor of 3*delta_tau in Diss is already met for Delta_Tau it is kept),
+//! growing by at most 20% per step so that the backward time derivatives
+//! see similar intervals
+double Evolve::next_time_step(double dtau) const {
+    const double signal_rate = std::max(
+                domain.max(advance.get_max_signal_rate()), 1e-15);
+    double dtau_next = step_data.adaptive_CFL/signal_rate;
+    if (DATA.viscosity_flag == 1) {
+        dtau_next = std::min(dtau_next,
+            std::max(DATA.delta_tau,
+                     domain.min(advance.get_min_relaxation_time())/3.));
+    }
+    dtau_next = std::min(dtau_next, 1.2*dtau);
+    return(std::min(dtau_next, DATA.adaptive_delta_tau_max));
+}
+
+//! the whole grid in arena on the root rank, nullptr on the others;
+//! collective when the grid is shared by several ranks
+SCGrid* Evolve::whole_grid(SCGrid &arena) {
+    if (domain.n_ranks() == 1) return(&arena);
+    domain.gather(arena, arena_whole);
+    return(domain.is_root() ? &arena_whole : nullptr);
+}
+
+void Evolve::keep_surface_in_memory() {
+    if (domain.n_ranks() > 1) {
+        music_message << "The freeze-out surface is split among "
+                      << domain.n_ranks() << " ranks, Cooper-Frye reads "
+                      << "it back from the surface file";
+        music_message.flush("warning");
+        return;
+    }
+    if (DATA.freeze_surface_index_for_spectra >= n_freeze_surf) {
+        music_message << "freeze_surface_index_for_spectra = "
+                      << DATA.freeze_surface_index_for_spectra
+                      << " but there are only " << n_freeze_surf
+                      << " freeze-out thresholds.";
+        music_message.flush("error");
+        exit(1);
+    }
+    surface_in_memory = true;
+}
+
+std::vector<SurfaceElement> Evolve::take_surface() {
+    return(surface_sinks[DATA.freeze_surface_index_for_spectra]
+                                                        ->take_cells());
+}
+
+
+FreezeOutWorkspace::FreezeOutWorkspace() {
+    for (int i = 0; i < 16; i++) corners[i] = 0.0;
+    for (int i = 0; i < 8; i++) lines[i] = &corners[2*i];
+    for (int i = 0; i < 4; i++) squares[i] = &lines[2*i];
+    for (int i = 0; i < 2; i++) cubes[i] = &squares[2*i];
+}
+
 void Evolve::store_previous_step_for_freezeout(SCGrid &arena_current,
                                                SCGrid &arena_freezeout) {
     const int nx   = arena_current.nX();
     const int ny   = arena_current.nY();
     const int neta = arena_current.nEta();
-    #pragma omp parallel for collapse(3)
-    for (int ieta = 0; ieta < neta; ieta++)
-    for (int ix = 0;   ix   < nx;   ix++)
-    for (int iy = 0;   iy   < ny;   iy++) {
+    const GridTiles tiles(nx, ny, neta, 2*sizeof(Cell_small),
+                          DATA.tile_size_x, DATA.tile_size_y,
+                          DATA.tile_size_eta);
+    tiles.for_each_cell([&](int ix, int iy, int ieta) {
         arena_freezeout(ix, iy, ieta) = arena_current(ix, iy, ieta);
-    }
+    });
 }
 
-void Evolve::AdvanceRK(double tau, GridPointer &arena_prev, GridPointer &arena_current, GridPointer &arena_future) {
+void Evolve::AdvanceRK(double tau, GridPointer &arena_prev, GridPointer &arena_current, GridPointer &arena_future,
+                       const ActiveTiles &active_tiles) {
     // control function for Runge-Kutta evolution in tau
     // loop over Runge-Kutta steps
     for (int rk_flag = 0; rk_flag < rk_order; rk_flag++) {
         advance.AdvanceIt(tau, *arena_prev, *arena_current, *arena_future,
-                          rk_flag);
+                          rk_flag, active_tiles);
+        // the later stages see the start of this step as arena_prev
+        step_data.delta_tau_backward = step_data.delta_tau;
         if (rk_flag == 0) {
             auto temp     = std::move(arena_prev);
             arena_prev    = std::move(arena_current);
@@ -225,21 +454,82 @@ void Evolve::AdvanceRK(double tau, GridPointer &arena_prev, GridPointer &arena_c
 }
 
 // Cornelius freeze out  (C. Shen, 11/2014)
-int Evolve::FindFreezeOutSurface_Cornelius(double tau,
+int Evolve::FindFreezeOutSurface_Cornelius(double tau, double DTAU,
                                            SCGrid &arena_current,
                                            SCGrid &arena_freezeout) {
     const int neta = arena_current.nEta();
     const int fac_eta = 1;
+    // the cubes of the last local slice reach into the ghost slice that
+    // holds the first slice of the next rank
+    const int neta_cubes = (domain.owns_last_slice() ? neta - fac_eta : neta);
+    domain.exchange_halo(arena_current);
+    domain.exchange_halo(arena_freezeout);
+
+    const int margin = DATA.freeze_out_band_margin;
+    n_cubes_x = (arena_current.nX() - 1)/DATA.fac_x;
+    n_cubes_y = (arena_current.nY() - 1)/DATA.fac_y;
+    const int n_cubes = n_cubes_x*n_cubes_y*neta_cubes;
+    if (margin > 0 && static_cast<int>(freeze_out_hits.size()) != n_cubes) {
+        freeze_out_hits.assign(n_cubes, 0);
+        freeze_out_band.assign(n_cubes, 0);
+        freeze_out_band_empty = true;
+    }
+    // the band is left for a sweep over all cubes from time to time, so
+    // that surfaces which appear away from the last one are found. All
+    // ranks take the same choice, since a band sweep may be repeated
+    // below with another reduction over the ranks
+    bool band_sweep = (margin > 0 && !freeze_out_band_empty
+                       && (freeze_out_steps_since_sweep
+                           < DATA.freeze_out_full_sweep_every));
+    band_sweep = (domain.min(band_sweep ? 1. : 0.) > 0.5);
+
+    // the cubes are searched in tasks of a slice and a block of columns
+    // in x, enough for every thread to get several of them; the central
+    // slices hold most of the surface, so the threads take the tasks one
+    // by one as they finish
+    const int n_blocks_x = std::min(n_cubes_x, std::max(1,
+            (8*omp_get_max_threads() + neta_cubes - 1)/neta_cubes));
+    const int n_tasks = neta_cubes*n_blocks_x;
+
+    // one sweep over the cubes finds the surfaces of all the thresholds
     int intersections = 0;
-    for (int i_freezesurf = 0; i_freezesurf < n_freeze_surf; i_freezesurf++) {
-        const double epsFO = epsFO_list[i_freezesurf]/hbarc;   // 1/fm^4
-
-        #pragma omp parallel for reduction(+:intersections)
-        for (int ieta = 0; ieta < (neta-fac_eta); ieta += fac_eta) {
-            int thread_id = omp_get_thread_num();
+    for (;;) {
+        if (margin > 0)
+            std::fill(freeze_out_hits.begin(), freeze_out_hits.end(), 0);
+        std::vector<std::vector<std::unique_ptr<SurfaceSink>>> tasks(
+                                                                n_tasks);
+        #pragma omp parallel for schedule(dynamic) reduction(+:intersections)
+        for (int i_task = 0; i_task < n_tasks; i_task++) {
+            const int ieta = (i_task/n_blocks_x)*fac_eta;
+            const int i_block = i_task%n_blocks_x;
+            const int ix_begin = (i_block*n_cubes_x/n_blocks_x)*DATA.fac_x;
+            const int ix_end = ((i_block + 1)*n_cubes_x/n_blocks_x)*DATA.fac_x;
+            for (int i_freezesurf = 0; i_freezesurf < n_freeze_surf;
+                 i_freezesurf++) {
+                tasks[i_task].emplace_back(
+                            new SurfaceSink(DATA, surface_in_memory));
+            }
             intersections += FindFreezeOutSurface_Cornelius_XY(
-                tau, ieta, arena_current, arena_freezeout, thread_id, epsFO);
+                tau, DTAU, ieta, ix_begin, ix_end, arena_current,
+                arena_freezeout, band_sweep, tasks[i_task]);
         }
+        // the tasks are merged in the order of the cubes, so the surface
+        // files do not depend on the number of threads
+        for (auto &task : tasks) {
+            for (int i_freezesurf = 0; i_freezesurf < n_freeze_surf;
+                 i_freezesurf++) {
+                surface_sinks[i_freezesurf]->append(*task[i_freezesurf]);
+            }
+        }
+        intersections = domain.sum(intersections);
+        // a band without any surface is no proof that all cells froze out
+        if (!band_sweep || intersections > 0) break;
+        band_sweep = false;
+    }
+    if (margin > 0) {
+        freeze_out_steps_since_sweep = (
+                        band_sweep ? freeze_out_steps_since_sweep + 1 : 0);
+        update_freeze_out_band(neta_cubes);
     }
 
     if (intersections == 0) {
@@ -248,702 +538,701 @@ int Evolve::FindFreezeOutSurface_Cornelius(double tau,
     return(intersections + 1);
 }
 
-int Evolve::FindFreezeOutSurface_Cornelius_XY(double tau, int ieta,
-                                              SCGrid &arena_current,
-                                              SCGrid &arena_freezeout,
-                                              int thread_id, double epsFO) {
-    const bool surface_in_binary = DATA.freeze_surface_in_binary;
+//! dst[i*stride] = 1 for the entries i of the line that are at most
+//! margin entries away from a 1 in src
+static void dilate_line(const char *src, char *dst, int n, int stride,
+                        int margin) {
+    int last = -margin - 1;
+    for (int i = 0; i < n; i++) {
+        if (src[i*stride]) last = i;
+        dst[i*stride] = (i - last <= margin);
+    }
+    last = n + margin;
+    for (int i = n - 1; i >= 0; i--) {
+        if (src[i*stride]) last = i;
+        if (last - i <= margin) dst[i*stride] = 1;
+    }
+}
+
+//! the band of the next freeze-out step: all cubes within
+//! freeze_out_band_margin cubes of the ones the surface crossed, found
+//! by dilating freeze_out_hits along y, x and eta in turn. The hits of
+//! the slices next to the cuts are exchanged with the neighbouring
+//! ranks first, so that the band follows the surface across the cuts.
+//! Collective when the grid is shared by several ranks.
+void Evolve::update_freeze_out_band(int neta_cubes) {
+    const int margin = DATA.freeze_out_band_margin;
+    const int n_plane = n_cubes_x*n_cubes_y;
+    // the hits in the local slab with n_edge slices of the neighbours on
+    // either side (no hits where there is no neighbour)
+    const int n_edge = static_cast<int>(
+                domain.min(static_cast<double>(std::min(margin, neta_cubes))));
+    const int n_slices = neta_cubes + 2*n_edge;
+    std::vector<char> hits(n_slices*n_plane, 0);
+    std::copy(freeze_out_hits.begin(), freeze_out_hits.end(),
+              hits.begin() + n_edge*n_plane);
+    domain.exchange_edges(&hits[n_edge*n_plane], &hits[0],
+                          &hits[neta_cubes*n_plane],
+                          &hits[(neta_cubes + n_edge)*n_plane],
+                          n_edge*n_plane);
+
+    std::vector<char> dilated_y(hits.size());
+    std::vector<char> dilated_xy(hits.size());
+    #pragma omp parallel for
+    for (int ieta = 0; ieta < n_slices; ieta++) {
+        const char *slice_hits = &hits[ieta*n_plane];
+        char *slice_y  = &dilated_y[ieta*n_plane];
+        char *slice_xy = &dilated_xy[ieta*n_plane];
+        for (int cx = 0; cx < n_cubes_x; cx++) {
+            dilate_line(slice_hits + cx*n_cubes_y, slice_y + cx*n_cubes_y,
+                        n_cubes_y, 1, margin);
+        }
+        for (int cy = 0; cy < n_cubes_y; cy++) {
+            dilate_line(slice_y + cy, slice_xy + cy, n_cubes_x, n_cubes_y,
+                        margin);
+        }
+    }
+    // dilated_y is reused for the dilation along eta
+    #pragma omp parallel for
+    for (int i = 0; i < n_plane; i++) {
+        dilate_line(&dilated_xy[i], &dilated_y[i], n_slices, n_plane,
+                    margin);
+    }
+    std::copy(dilated_y.begin() + n_edge*n_plane,
+              dilated_y.begin() + (n_edge + neta_cubes)*n_plane,
+              freeze_out_band.begin());
+
+    const bool local_empty = (
+        std::find(freeze_out_band.begin(), freeze_out_band.end(), 1)
+        == freeze_out_band.end());
+    freeze_out_band_empty = (domain.max(local_empty ? 0. : 1.) < 0.5);
+}
+
+//! surface elements of the cubes between ix_begin and ix_end in the
+//! slice ieta, added to sinks[i_freezesurf] for every threshold; returns
+//! the number of intersected cubes
+int Evolve::FindFreezeOutSurface_Cornelius_XY(
+                double tau, double DTAU, int ieta, int ix_begin, int ix_end,
+                SCGrid &arena_current, SCGrid &arena_freezeout,
+                bool band_sweep,
+                std::vector<std::unique_ptr<SurfaceSink>> &sinks) {
     const int nx = arena_current.nX();
     const int ny = arena_current.nY();
 
-    stringstream strs_name;
-    //strs_name << "surface_eps_" << setprecision(4) << epsFO*hbarc
-    //          << "_" << thread_id << ".dat";
-    strs_name << "surface" << thread_id << ".dat";
-    ofstream s_file;
-    if (surface_in_binary) {
-        s_file.open(strs_name.str().c_str(),
-                    ios::out | ios::app | ios::binary);
-    } else {
-        s_file.open(strs_name.str().c_str(), ios::out | ios::app);
-    }
     const int dim = 4;
     int intersections = 0;
 
-    facTau      = DATA.facTau;   // step to skip in tau direction
     int fac_x   = DATA.fac_x;
     int fac_y   = DATA.fac_y;
     int fac_eta = 1;
 
-    const double DTAU = facTau*DATA.delta_tau;
     const double DX   = fac_x*DATA.delta_x;
     const double DY   = fac_y*DATA.delta_y;
     const double DETA = fac_eta*DATA.delta_eta;
 
     // initialize Cornelius
     double lattice_spacing[4] = {DTAU, DX, DY, DETA};
-    std::shared_ptr<Cornelius> cornelius_ptr(new Cornelius());
-    cornelius_ptr->init(dim, epsFO, lattice_spacing);
-
-    // initialize the hyper-cube for Cornelius
-    double ****cube = new double*** [2];
-    for (int i = 0; i < 2; i++) {
-        cube[i] = new double** [2];
-        for (int j = 0; j < 2; j++) {
-            cube[i][j] = new double* [2];
-            for (int k = 0; k < 2; k++) {
-                cube[i][j][k] = new double[2];
-                for (int l = 0; l < 2; l++)
-                    cube[i][j][k][l] = 0.0;
-            }
-        }
-    }
+    FreezeOutWorkspace &workspace = (
+                    *freeze_out_workspaces[omp_get_thread_num()]);
+    Cornelius *cornelius_ptr = &workspace.cornelius;
+    double ****cube = workspace.hypercube();
 
     double x_fraction[2][4];
-    double eta = (DATA.delta_eta)*ieta - (DATA.eta_size)/2.0;
-    for (int ix = 0; ix < nx - fac_x; ix += fac_x) {
+    double eta = ((DATA.delta_eta)*(domain.eta_begin() + ieta)
+                  - (DATA.eta_size)/2.0);
+    for (int ix = ix_begin; ix < ix_end; ix += fac_x) {
         double x = ix*(DATA.delta_x) - (DATA.x_size/2.0);
         for (int iy = 0; iy < ny - fac_y; iy += fac_y) {
             double y = iy*(DATA.delta_y) - (DATA.y_size/2.0);
 
-	    if((ix==0 || iy == 0)
-		    && (arena_freezeout(ix,iy,0).epsilon >= epsFO))
-	    {
-		music_message << "Freeze out surface hitting boundary at (x,y) = " << x << ", " << y;
-		music_message.flush("warning");
-	    }
-	    if((ix > nx - 2*fac_x || iy > nx - 2*fac_x)
-		    && (arena_freezeout(ix+fac_x,iy+fac_y,0).epsilon >= epsFO))
-	    {
-		music_message << "Freeze out surface hitting boundary at (x,y) = " << x << ", " << y;
-		music_message.flush("warning");
-	    }
-
-            // judge intersection (from Bjoern)
-            int intersect = 1;
-            if ((arena_current(ix+fac_x,iy+fac_y,ieta+fac_eta).epsilon-epsFO)
-                *(arena_freezeout(ix,iy,ieta).epsilon-epsFO)>0.)
-                if((arena_current(ix+fac_x,iy,ieta).epsilon-epsFO)
-                    *(arena_freezeout(ix,iy+fac_y,ieta+fac_eta).epsilon-epsFO)>0.)
-                    if((arena_current(ix,iy+fac_y,ieta).epsilon-epsFO)
-                        *(arena_freezeout(ix+fac_x,iy,ieta+fac_eta).epsilon-epsFO)>0.)
-                        if((arena_current(ix,iy,ieta+fac_eta).epsilon-epsFO)
-                            *(arena_freezeout(ix+fac_x,iy+fac_y,ieta).epsilon-epsFO)>0.)
-                            if((arena_current(ix+fac_x,iy+fac_y,ieta).epsilon-epsFO)
-                                *(arena_freezeout(ix,iy,ieta+fac_eta).epsilon-epsFO)>0.)
-                                if((arena_current(ix+fac_x,iy,ieta+fac_eta).epsilon-epsFO)
-                                    *(arena_freezeout(ix,iy+fac_y,ieta).epsilon-epsFO)>0.)
-                                    if((arena_current(ix,iy+fac_y,ieta+fac_eta).epsilon-epsFO)
-                                        *(arena_freezeout(ix+fac_x,iy,ieta).epsilon-epsFO)>0.)
-                                        if((arena_current(ix,iy,ieta).epsilon-epsFO)
-                                            *(arena_freezeout(ix+fac_x,iy+fac_y,ieta+fac_eta).epsilon-epsFO)>0.)
-                                                intersect=0;
-
-            if (intersect==0) continue;
-
-            // if intersect, prepare for the hyper-cube
-            intersections++;
-            cube[0][0][0][0] = arena_freezeout(ix      , iy      , ieta        ).epsilon;
-            cube[0][0][1][0] = arena_freezeout(ix      , iy+fac_y, ieta        ).epsilon;
-            cube[0][1][0][0] = arena_freezeout(ix+fac_x, iy      , ieta        ).epsilon;
-            cube[0][1][1][0] = arena_freezeout(ix+fac_x, iy+fac_y, ieta        ).epsilon;
-            cube[1][0][0][0] = arena_current  (ix      , iy      , ieta        ).epsilon;
-            cube[1][0][1][0] = arena_current  (ix      , iy+fac_y, ieta        ).epsilon;
-            cube[1][1][0][0] = arena_current  (ix+fac_x, iy      , ieta        ).epsilon;
-            cube[1][1][1][0] = arena_current  (ix+fac_x, iy+fac_y, ieta        ).epsilon;
-            cube[0][0][0][1] = arena_freezeout(ix      , iy      , ieta+fac_eta).epsilon;
-            cube[0][0][1][1] = arena_freezeout(ix      , iy+fac_y, ieta+fac_eta).epsilon;
-            cube[0][1][0][1] = arena_freezeout(ix+fac_x, iy      , ieta+fac_eta).epsilon;
-            cube[0][1][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, ieta+fac_eta).epsilon;
-            cube[1][0][0][1] = arena_current  (ix      , iy      , ieta+fac_eta).epsilon;
-            cube[1][0][1][1] = arena_current  (ix      , iy+fac_y, ieta+fac_eta).epsilon;
-            cube[1][1][0][1] = arena_current  (ix+fac_x, iy      , ieta+fac_eta).epsilon;
-            cube[1][1][1][1] = arena_current  (ix+fac_x, iy+fac_y, ieta+fac_eta).epsilon;
-
-
-            // Now, the magic will happen in the Cornelius ...
-            cornelius_ptr->find_surface_4d(cube);
-
-            // get positions of the freeze-out surface
-            // and interpolating results
-            for (int isurf = 0; isurf < cornelius_ptr->get_Nelements();
-                 isurf++) {
-                // surface normal vector d^3 \sigma_\mu
-                double FULLSU[4];
-                for (int ii = 0; ii < 4; ii++)
-                    FULLSU[ii] = cornelius_ptr->get_normal_elem(isurf, ii);
-
-                // check the size of the surface normal vector
-                if (std::abs(FULLSU[0]) > (DX*DY*DETA+0.01)) {
-                    music_message << "problem: volume in tau direction "
-                                  << std::abs(FULLSU[0]) << "  > DX*DY*DETA = "
-                                  << DX*DY*DETA;
-                    music_message.flush("warning");
-                }
-                if (std::abs(FULLSU[1]) > (DTAU*DY*DETA+0.01)) {
-                    music_message << "problem: volume in x direction "
-                                  << std::abs(FULLSU[1])
-                                  << "  > DTAU*DY*DETA = " << DTAU*DY*DETA;
-                    music_message.flush("warning");
-                }
-                if (std::abs(FULLSU[2]) > (DX*DTAU*DETA+0.01)) {
-                    music_message << "problem: volume in y direction "
-                                  << std::abs(FULLSU[2])
-                                  << "  > DX*DTAU*DETA = " << DX*DTAU*DETA;
+            for (int i_freezesurf = 0; i_freezesurf < n_freeze_surf;
+                 i_freezesurf++) {
+                const double epsFO = epsFO_list[i_freezesurf]/hbarc;
+                if ((ix == 0 || iy == 0)
+                        && (arena_freezeout(ix,iy,0).epsilon >= epsFO)) {
+                    music_message << "Freeze out surface hitting boundary at (x,y) = " << x << ", " << y;
                     music_message.flush("warning");
                 }
-                if (std::abs(FULLSU[3]) > (DX*DY*DTAU+0.01)) {
-                    music_message << "problem: volume in eta direction "
-                                  << std::abs(FULLSU[3]) << "  > DX*DY*DTAU = "
-                                  << DX*DY*DTAU;
+                if ((ix > nx - 2*fac_x || iy > nx - 2*fac_x)
+                        && (arena_freezeout(ix+fac_x,iy+fac_y,0).epsilon >= epsFO)) {
+                    music_message << "Freeze out surface hitting boundary at (x,y) = " << x << ", " << y;
                     music_message.flush("warning");
                 }
+            }
 
-                // position of the freeze-out fluid cell
-                for (int ii = 0; ii < 4; ii++) {
-                    x_fraction[1][ii] =
-                        cornelius_ptr->get_centroid_elem(isurf, ii);
-                    x_fraction[0][ii] =
-                        lattice_spacing[ii] - x_fraction[1][ii];
+            const int i_cube = freeze_out_cube_index(ix, iy, ieta);
+            if (band_sweep && !freeze_out_band[i_cube]) continue;
+
+            // epsilon at the corners of the hyper-cube, loaded once for
+            // all the thresholds
+            cube[0][0][0][0] = arena_freezeout.getHalo(ix      , iy      , ieta        ).epsilon;
+            cube[0][0][1][0] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta        ).epsilon;
+            cube[0][1][0][0] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta        ).epsilon;
+            cube[0][1][1][0] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta        ).epsilon;
+            cube[1][0][0][0] = arena_current  .getHalo(ix      , iy      , ieta        ).epsilon;
+            cube[1][0][1][0] = arena_current  .getHalo(ix      , iy+fac_y, ieta        ).epsilon;
+            cube[1][1][0][0] = arena_current  .getHalo(ix+fac_x, iy      , ieta        ).epsilon;
+            cube[1][1][1][0] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta        ).epsilon;
+            cube[0][0][0][1] = arena_freezeout.getHalo(ix      , iy      , ieta+fac_eta).epsilon;
+            cube[0][0][1][1] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta+fac_eta).epsilon;
+            cube[0][1][0][1] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta+fac_eta).epsilon;
+            cube[0][1][1][1] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).epsilon;
+            cube[1][0][0][1] = arena_current  .getHalo(ix      , iy      , ieta+fac_eta).epsilon;
+            cube[1][0][1][1] = arena_current  .getHalo(ix      , iy+fac_y, ieta+fac_eta).epsilon;
+            cube[1][1][0][1] = arena_current  .getHalo(ix+fac_x, iy      , ieta+fac_eta).epsilon;
+            cube[1][1][1][1] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).epsilon;
+            double eps_corners[16];
+            std::copy(workspace.corners, workspace.corners + 16, eps_corners);
+            const auto eps_range = std::minmax_element(eps_corners,
+                                                       eps_corners + 16);
+
+            for (int i_freezesurf = 0; i_freezesurf < n_freeze_surf;
+                 i_freezesurf++) {
+                const double epsFO = epsFO_list[i_freezesurf]/hbarc;
+                // only the thresholds between the smallest and the
+                // largest corner can cross the hyper-cube
+                if (epsFO < *eps_range.first || epsFO > *eps_range.second)
+                    continue;
+
+                // judge intersection (from Bjoern): the diagonals of the
+                // hyper-cube join corner n to corner 15 - n
+                int intersect = 0;
+                for (int n = 0; n < 8; n++) {
+                    if (!((eps_corners[n] - epsFO)
+                          *(eps_corners[15 - n] - epsFO) > 0.))
+                        intersect = 1;
                 }
-                const double tau_center = tau - DTAU + x_fraction[1][0];
-                const double x_center = x + x_fraction[1][1];
-                const double y_center = y + x_fraction[1][2];
-                const double eta_center = eta + x_fraction[1][3];
+                if (intersect == 0) continue;
+                intersections++;
+                if (DATA.freeze_out_band_margin > 0)
+                    freeze_out_hits[i_cube] = 1;
 
-                // perform 4-d linear interpolation for all fluid
-                // quantities
+                // Now, the magic will happen in the Cornelius ...
+                std::copy(eps_corners, eps_corners + 16, workspace.corners);
+                cornelius_ptr->init(dim, epsFO, lattice_spacing);
+                cornelius_ptr->find_surface_4d(cube);
+                SurfaceSink &surface_sink = *sinks[i_freezesurf];
 
-                // flow velocity u^x
-                cube[0][0][0][0] = arena_freezeout(ix      , iy      , ieta        ).u[1];
-                cube[0][0][1][0] = arena_freezeout(ix      , iy+fac_y, ieta        ).u[1];
-                cube[0][1][0][0] = arena_freezeout(ix+fac_x, iy      , ieta        ).u[1];
-                cube[0][1][1][0] = arena_freezeout(ix+fac_x, iy+fac_y, ieta        ).u[1];
-                cube[1][0][0][0] = arena_current  (ix      , iy      , ieta        ).u[1];
-                cube[1][0][1][0] = arena_current  (ix      , iy+fac_y, ieta        ).u[1];
-                cube[1][1][0][0] = arena_current  (ix+fac_x, iy      , ieta        ).u[1];
-                cube[1][1][1][0] = arena_current  (ix+fac_x, iy+fac_y, ieta        ).u[1];
-                cube[0][0][0][1] = arena_freezeout(ix      , iy      , ieta+fac_eta).u[1];
-                cube[0][0][1][1] = arena_freezeout(ix      , iy+fac_y, ieta+fac_eta).u[1];
-                cube[0][1][0][1] = arena_freezeout(ix+fac_x, iy      , ieta+fac_eta).u[1];
-                cube[0][1][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, ieta+fac_eta).u[1];
-                cube[1][0][0][1] = arena_current  (ix      , iy      , ieta+fac_eta).u[1];
-                cube[1][0][1][1] = arena_current  (ix      , iy+fac_y, ieta+fac_eta).u[1];
-                cube[1][1][0][1] = arena_current  (ix+fac_x, iy      , ieta+fac_eta).u[1];
-                cube[1][1][1][1] = arena_current  (ix+fac_x, iy+fac_y, ieta+fac_eta).u[1];
-                const double ux_center =
-                    Util::four_dimension_linear_interpolation(
-                                lattice_spacing, x_fraction, cube);
+                // get positions of the freeze-out surface
+                // and interpolating results
+                for (int isurf = 0; isurf < cornelius_ptr->get_Nelements();
+                     isurf++) {
+                    // surface normal vector d^3 \sigma_\mu
+                    double FULLSU[4];
+                    for (int ii = 0; ii < 4; ii++)
+                        FULLSU[ii] = cornelius_ptr->get_normal_elem(isurf, ii);
 
-                // flow velocity u^y
-                cube[0][0][0][0] = arena_freezeout(ix      , iy      , ieta        ).u[2];
-                cube[0][0][1][0] = arena_freezeout(ix      , iy+fac_y, ieta        ).u[2];
-                cube[0][1][0][0] = arena_freezeout(ix+fac_x, iy      , ieta        ).u[2];
-                cube[0][1][1][0] = arena_freezeout(ix+fac_x, iy+fac_y, ieta        ).u[2];
-                cube[1][0][0][0] = arena_current  (ix      , iy      , ieta        ).u[2];
-                cube[1][0][1][0] = arena_current  (ix      , iy+fac_y, ieta        ).u[2];
-                cube[1][1][0][0] = arena_current  (ix+fac_x, iy      , ieta        ).u[2];
-                cube[1][1][1][0] = arena_current  (ix+fac_x, iy+fac_y, ieta        ).u[2];
-                cube[0][0][0][1] = arena_freezeout(ix      , iy      , ieta+fac_eta).u[2];
-                cube[0][0][1][1] = arena_freezeout(ix      , iy+fac_y, ieta+fac_eta).u[2];
-                cube[0][1][0][1] = arena_freezeout(ix+fac_x, iy      , ieta+fac_eta).u[2];
-                cube[0][1][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, ieta+fac_eta).u[2];
-                cube[1][0][0][1] = arena_current  (ix      , iy      , ieta+fac_eta).u[2];
-                cube[1][0][1][1] = arena_current  (ix      , iy+fac_y, ieta+fac_eta).u[2];
-                cube[1][1][0][1] = arena_current  (ix+fac_x, iy      , ieta+fac_eta).u[2];
-                cube[1][1][1][1] = arena_current  (ix+fac_x, iy+fac_y, ieta+fac_eta).u[2];
-                const double uy_center =
-                    Util::four_dimension_linear_interpolation(
-                                lattice_spacing, x_fraction, cube);
+                    // check the size of the surface normal vector
+                    if (std::abs(FULLSU[0]) > (DX*DY*DETA+0.01)) {
+                        music_message << "problem: volume in tau direction "
+                                      << std::abs(FULLSU[0]) << "  > DX*DY*DETA = "
+                                      << DX*DY*DETA;
+                        music_message.flush("warning");
+                    }
+                    if (std::abs(FULLSU[1]) > (DTAU*DY*DETA+0.01)) {
+                        music_message << "problem: volume in x direction "
+                                      << std::abs(FULLSU[1])
+                                      << "  > DTAU*DY*DETA = " << DTAU*DY*DETA;
+                        music_message.flush("warning");
+                    }
+                    if (std::abs(FULLSU[2]) > (DX*DTAU*DETA+0.01)) {
+                        music_message << "problem: volume in y direction "
+                                      << std::abs(FULLSU[2])
+                                      << "  > DX*DTAU*DETA = " << DX*DTAU*DETA;
+                        music_message.flush("warning");
+                    }
+                    if (std::abs(FULLSU[3]) > (DX*DY*DTAU+0.01)) {
+                        music_message << "problem: volume in eta direction "
+                                      << std::abs(FULLSU[3]) << "  > DX*DY*DTAU = "
+                                      << DX*DY*DTAU;
+                        music_message.flush("warning");
+                    }
 
-                // flow velocity u^eta
-                cube[0][0][0][0] = arena_freezeout(ix      , iy      , ieta        ).u[3];
-                cube[0][0][1][0] = arena_freezeout(ix      , iy+fac_y, ieta        ).u[3];
-                cube[0][1][0][0] = arena_freezeout(ix+fac_x, iy      , ieta        ).u[3];
-                cube[0][1][1][0] = arena_freezeout(ix+fac_x, iy+fac_y, ieta        ).u[3];
-                cube[1][0][0][0] = arena_current  (ix      , iy      , ieta        ).u[3];
-                cube[1][0][1][0] = arena_current  (ix      , iy+fac_y, ieta        ).u[3];
-                cube[1][1][0][0] = arena_current  (ix+fac_x, iy      , ieta        ).u[3];
-                cube[1][1][1][0] = arena_current  (ix+fac_x, iy+fac_y, ieta        ).u[3];
-                cube[0][0][0][1] = arena_freezeout(ix      , iy      , ieta+fac_eta).u[3];
-                cube[0][0][1][1] = arena_freezeout(ix      , iy+fac_y, ieta+fac_eta).u[3];
-                cube[0][1][0][1] = arena_freezeout(ix+fac_x, iy      , ieta+fac_eta).u[3];
-                cube[0][1][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, ieta+fac_eta).u[3];
-                cube[1][0][0][1] = arena_current  (ix      , iy      , ieta+fac_eta).u[3];
-                cube[1][0][1][1] = arena_current  (ix      , iy+fac_y, ieta+fac_eta).u[3];
-                cube[1][1][0][1] = arena_current  (ix+fac_x, iy      , ieta+fac_eta).u[3];
-                cube[1][1][1][1] = arena_current  (ix+fac_x, iy+fac_y, ieta+fac_eta).u[3];
-                const double ueta_center =
-                    Util::four_dimension_linear_interpolation(
-                                lattice_spacing, x_fraction, cube);
+                    // position of the freeze-out fluid cell
+                    for (int ii = 0; ii < 4; ii++) {
+                        x_fraction[1][ii] =
+                            cornelius_ptr->get_centroid_elem(isurf, ii);
+                        x_fraction[0][ii] =
+                            lattice_spacing[ii] - x_fraction[1][ii];
+                    }
+                    const double tau_center = tau - DTAU + x_fraction[1][0];
+                    const double x_center = x + x_fraction[1][1];
+                    const double y_center = y + x_fraction[1][2];
+                    const double eta_center = eta + x_fraction[1][3];
 
-                // reconstruct u^tau from u^i
-                const double utau_center = sqrt(1. + ux_center*ux_center
-                                   + uy_center*uy_center
-                                   + ueta_center*ueta_center);
+                    // perform 4-d linear interpolation for all fluid
+                    // quantities
 
-                // baryon density rho_b
-                cube[0][0][0][0] = arena_freezeout(ix      , iy      , ieta        ).rhob;
-                cube[0][0][1][0] = arena_freezeout(ix      , iy+fac_y, ieta        ).rhob;
-                cube[0][1][0][0] = arena_freezeout(ix+fac_x, iy      , ieta        ).rhob;
-                cube[0][1][1][0] = arena_freezeout(ix+fac_x, iy+fac_y, ieta        ).rhob;
-                cube[1][0][0][0] = arena_current  (ix      , iy      , ieta        ).rhob;
-                cube[1][0][1][0] = arena_current  (ix      , iy+fac_y, ieta        ).rhob;
-                cube[1][1][0][0] = arena_current  (ix+fac_x, iy      , ieta        ).rhob;
-                cube[1][1][1][0] = arena_current  (ix+fac_x, iy+fac_y, ieta        ).rhob;
-                cube[0][0][0][1] = arena_freezeout(ix      , iy      , ieta+fac_eta).rhob;
-                cube[0][0][1][1] = arena_freezeout(ix      , iy+fac_y, ieta+fac_eta).rhob;
-                cube[0][1][0][1] = arena_freezeout(ix+fac_x, iy      , ieta+fac_eta).rhob;
-                cube[0][1][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, ieta+fac_eta).rhob;
-                cube[1][0][0][1] = arena_current  (ix      , iy      , ieta+fac_eta).rhob;
-                cube[1][0][1][1] = arena_current  (ix      , iy+fac_y, ieta+fac_eta).rhob;
-                cube[1][1][0][1] = arena_current  (ix+fac_x, iy      , ieta+fac_eta).rhob;
-                cube[1][1][1][1] = arena_current  (ix+fac_x, iy+fac_y, ieta+fac_eta).rhob;
-                const double rhob_center =
-                    Util::four_dimension_linear_interpolation(
-                                lattice_spacing, x_fraction, cube);
+                    // flow velocity u^x
+                    cube[0][0][0][0] = arena_freezeout.getHalo(ix      , iy      , ieta        ).u[1];
+                    cube[0][0][1][0] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta        ).u[1];
+                    cube[0][1][0][0] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta        ).u[1];
+                    cube[0][1][1][0] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta        ).u[1];
+                    cube[1][0][0][0] = arena_current  .getHalo(ix      , iy      , ieta        ).u[1];
+                    cube[1][0][1][0] = arena_current  .getHalo(ix      , iy+fac_y, ieta        ).u[1];
+                    cube[1][1][0][0] = arena_current  .getHalo(ix+fac_x, iy      , ieta        ).u[1];
+                    cube[1][1][1][0] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta        ).u[1];
+                    cube[0][0][0][1] = arena_freezeout.getHalo(ix      , iy      , ieta+fac_eta).u[1];
+                    cube[0][0][1][1] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta+fac_eta).u[1];
+                    cube[0][1][0][1] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta+fac_eta).u[1];
+                    cube[0][1][1][1] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).u[1];
+                    cube[1][0][0][1] = arena_current  .getHalo(ix      , iy      , ieta+fac_eta).u[1];
+                    cube[1][0][1][1] = arena_current  .getHalo(ix      , iy+fac_y, ieta+fac_eta).u[1];
+                    cube[1][1][0][1] = arena_current  .getHalo(ix+fac_x, iy      , ieta+fac_eta).u[1];
+                    cube[1][1][1][1] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).u[1];
+                    const double ux_center =
+                        Util::four_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube);
 
-                // baryon diffusion current q^tau
-                cube[0][0][0][0] = arena_freezeout(ix      , iy      , ieta        ).Wmunu[10];
-                cube[0][0][1][0] = arena_freezeout(ix      , iy+fac_y, ieta        ).Wmunu[10];
-                cube[0][1][0][0] = arena_freezeout(ix+fac_x, iy      , ieta        ).Wmunu[10];
-                cube[0][1][1][0] = arena_freezeout(ix+fac_x, iy+fac_y, ieta        ).Wmunu[10];
-                cube[1][0][0][0] = arena_current  (ix      , iy      , ieta        ).Wmunu[10];
-                cube[1][0][1][0] = arena_current  (ix      , iy+fac_y, ieta        ).Wmunu[10];
-                cube[1][1][0][0] = arena_current  (ix+fac_x, iy      , ieta        ).Wmunu[10];
-                cube[1][1][1][0] = arena_current  (ix+fac_x, iy+fac_y, ieta        ).Wmunu[10];
-                cube[0][0][0][1] = arena_freezeout(ix      , iy      , ieta+fac_eta).Wmunu[10];
-                cube[0][0][1][1] = arena_freezeout(ix      , iy+fac_y, ieta+fac_eta).Wmunu[10];
-                cube[0][1][0][1] = arena_freezeout(ix+fac_x, iy      , ieta+fac_eta).Wmunu[10];
-                cube[0][1][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[10];
-                cube[1][0][0][1] = arena_current  (ix      , iy      , ieta+fac_eta).Wmunu[10];
-                cube[1][0][1][1] = arena_current  (ix      , iy+fac_y, ieta+fac_eta).Wmunu[10];
-                cube[1][1][0][1] = arena_current  (ix+fac_x, iy      , ieta+fac_eta).Wmunu[10];
-                cube[1][1][1][1] = arena_current  (ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[10];
-                double qtau_center =
-                    Util::four_dimension_linear_interpolation(
-                                lattice_spacing, x_fraction, cube);
+                    // flow velocity u^y
+                    cube[0][0][0][0] = arena_freezeout.getHalo(ix      , iy      , ieta        ).u[2];
+                    cube[0][0][1][0] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta        ).u[2];
+                    cube[0][1][0][0] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta        ).u[2];
+                    cube[0][1][1][0] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta        ).u[2];
+                    cube[1][0][0][0] = arena_current  .getHalo(ix      , iy      , ieta        ).u[2];
+                    cube[1][0][1][0] = arena_current  .getHalo(ix      , iy+fac_y, ieta        ).u[2];
+                    cube[1][1][0][0] = arena_current  .getHalo(ix+fac_x, iy      , ieta        ).u[2];
+                    cube[1][1][1][0] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta        ).u[2];
+                    cube[0][0][0][1] = arena_freezeout.getHalo(ix      , iy      , ieta+fac_eta).u[2];
+                    cube[0][0][1][1] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta+fac_eta).u[2];
+                    cube[0][1][0][1] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta+fac_eta).u[2];
+                    cube[0][1][1][1] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).u[2];
+                    cube[1][0][0][1] = arena_current  .getHalo(ix      , iy      , ieta+fac_eta).u[2];
+                    cube[1][0][1][1] = arena_current  .getHalo(ix      , iy+fac_y, ieta+fac_eta).u[2];
+                    cube[1][1][0][1] = arena_current  .getHalo(ix+fac_x, iy      , ieta+fac_eta).u[2];
+                    cube[1][1][1][1] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).u[2];
+                    const double uy_center =
+                        Util::four_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube);
 
-                // baryon diffusion current q^x
-                cube[0][0][0][0] = arena_freezeout(ix      , iy      , ieta        ).Wmunu[11];
-                cube[0][0][1][0] = arena_freezeout(ix      , iy+fac_y, ieta        ).Wmunu[11];
-                cube[0][1][0][0] = arena_freezeout(ix+fac_x, iy      , ieta        ).Wmunu[11];
-                cube[0][1][1][0] = arena_freezeout(ix+fac_x, iy+fac_y, ieta        ).Wmunu[11];
-                cube[1][0][0][0] = arena_current  (ix      , iy      , ieta        ).Wmunu[11];
-                cube[1][0][1][0] = arena_current  (ix      , iy+fac_y, ieta        ).Wmunu[11];
-                cube[1][1][0][0] = arena_current  (ix+fac_x, iy      , ieta        ).Wmunu[11];
-                cube[1][1][1][0] = arena_current  (ix+fac_x, iy+fac_y, ieta        ).Wmunu[11];
-                cube[0][0][0][1] = arena_freezeout(ix      , iy      , ieta+fac_eta).Wmunu[11];
-                cube[0][0][1][1] = arena_freezeout(ix      , iy+fac_y, ieta+fac_eta).Wmunu[11];
-                cube[0][1][0][1] = arena_freezeout(ix+fac_x, iy      , ieta+fac_eta).Wmunu[11];
-                cube[0][1][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[11];
-                cube[1][0][0][1] = arena_current  (ix      , iy      , ieta+fac_eta).Wmunu[11];
-                cube[1][0][1][1] = arena_current  (ix      , iy+fac_y, ieta+fac_eta).Wmunu[11];
-                cube[1][1][0][1] = arena_current  (ix+fac_x, iy      , ieta+fac_eta).Wmunu[11];
-                cube[1][1][1][1] = arena_current  (ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[11];
-                double qx_center =
-                    Util::four_dimension_linear_interpolation(
-                                lattice_spacing, x_fraction, cube);
+                    // flow velocity u^eta
+                    cube[0][0][0][0] = arena_freezeout.getHalo(ix      , iy      , ieta        ).u[3];
+                    cube[0][0][1][0] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta        ).u[3];
+                    cube[0][1][0][0] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta        ).u[3];
+                    cube[0][1][1][0] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta        ).u[3];
+                    cube[1][0][0][0] = arena_current  .getHalo(ix      , iy      , ieta        ).u[3];
+                    cube[1][0][1][0] = arena_current  .getHalo(ix      , iy+fac_y, ieta        ).u[3];
+                    cube[1][1][0][0] = arena_current  .getHalo(ix+fac_x, iy      , ieta        ).u[3];
+                    cube[1][1][1][0] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta        ).u[3];
+                    cube[0][0][0][1] = arena_freezeout.getHalo(ix      , iy      , ieta+fac_eta).u[3];
+                    cube[0][0][1][1] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta+fac_eta).u[3];
+                    cube[0][1][0][1] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta+fac_eta).u[3];
+                    cube[0][1][1][1] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).u[3];
+                    cube[1][0][0][1] = arena_current  .getHalo(ix      , iy      , ieta+fac_eta).u[3];
+                    cube[1][0][1][1] = arena_current  .getHalo(ix      , iy+fac_y, ieta+fac_eta).u[3];
+                    cube[1][1][0][1] = arena_current  .getHalo(ix+fac_x, iy      , ieta+fac_eta).u[3];
+                    cube[1][1][1][1] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).u[3];
+                    const double ueta_center =
+                        Util::four_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube);
+
+                    // reconstruct u^tau from u^i
+                    const double utau_center = sqrt(1. + ux_center*ux_center
+                                       + uy_center*uy_center
+                                       + ueta_center*ueta_center);
 
-                // baryon diffusion current q^y
-                cube[0][0][0][0] = arena_freezeout(ix      , iy      , ieta        ).Wmunu[12];
-                cube[0][0][1][0] = arena_freezeout(ix      , iy+fac_y, ieta        ).Wmunu[12];
-                cube[0][1][0][0] = arena_freezeout(ix+fac_x, iy      , ieta        ).Wmunu[12];
-                cube[0][1][1][0] = arena_freezeout(ix+fac_x, iy+fac_y, ieta        ).Wmunu[12];
-                cube[1][0][0][0] = arena_current  (ix      , iy      , ieta        ).Wmunu[12];
-                cube[1][0][1][0] = arena_current  (ix      , iy+fac_y, ieta        ).Wmunu[12];
-                cube[1][1][0][0] = arena_current  (ix+fac_x, iy      , ieta        ).Wmunu[12];
-                cube[1][1][1][0] = arena_current  (ix+fac_x, iy+fac_y, ieta        ).Wmunu[12];
-                cube[0][0][0][1] = arena_freezeout(ix      , iy      , ieta+fac_eta).Wmunu[12];
-                cube[0][0][1][1] = arena_freezeout(ix      , iy+fac_y, ieta+fac_eta).Wmunu[12];
-                cube[0][1][0][1] = arena_freezeout(ix+fac_x, iy      , ieta+fac_eta).Wmunu[12];
-                cube[0][1][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[12];
-                cube[1][0][0][1] = arena_current  (ix      , iy      , ieta+fac_eta).Wmunu[12];
-                cube[1][0][1][1] = arena_current  (ix      , iy+fac_y, ieta+fac_eta).Wmunu[12];
-                cube[1][1][0][1] = arena_current  (ix+fac_x, iy      , ieta+fac_eta).Wmunu[12];
-                cube[1][1][1][1] = arena_current  (ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[12];
-                double qy_center =
-                    Util::four_dimension_linear_interpolation(
-                            lattice_spacing, x_fraction, cube);
+                    // baryon density rho_b
+                    cube[0][0][0][0] = arena_freezeout.getHalo(ix      , iy      , ieta        ).rhob;
+                    cube[0][0][1][0] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta        ).rhob;
+                    cube[0][1][0][0] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta        ).rhob;
+                    cube[0][1][1][0] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta        ).rhob;
+                    cube[1][0][0][0] = arena_current  .getHalo(ix      , iy      , ieta        ).rhob;
+                    cube[1][0][1][0] = arena_current  .getHalo(ix      , iy+fac_y, ieta        ).rhob;
+                    cube[1][1][0][0] = arena_current  .getHalo(ix+fac_x, iy      , ieta        ).rhob;
+                    cube[1][1][1][0] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta        ).rhob;
+                    cube[0][0][0][1] = arena_freezeout.getHalo(ix      , iy      , ieta+fac_eta).rhob;
+                    cube[0][0][1][1] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta+fac_eta).rhob;
+                    cube[0][1][0][1] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta+fac_eta).rhob;
+                    cube[0][1][1][1] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).rhob;
+                    cube[1][0][0][1] = arena_current  .getHalo(ix      , iy      , ieta+fac_eta).rhob;
+                    cube[1][0][1][1] = arena_current  .getHalo(ix      , iy+fac_y, ieta+fac_eta).rhob;
+                    cube[1][1][0][1] = arena_current  .getHalo(ix+fac_x, iy      , ieta+fac_eta).rhob;
+                    cube[1][1][1][1] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).rhob;
+                    const double rhob_center =
+                        Util::four_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube);
+
+                    // baryon diffusion current q^tau
+                    cube[0][0][0][0] = arena_freezeout.getHalo(ix      , iy      , ieta        ).Wmunu[10];
+                    cube[0][0][1][0] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta        ).Wmunu[10];
+                    cube[0][1][0][0] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta        ).Wmunu[10];
+                    cube[0][1][1][0] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[10];
+                    cube[1][0][0][0] = arena_current  .getHalo(ix      , iy      , ieta        ).Wmunu[10];
+                    cube[1][0][1][0] = arena_current  .getHalo(ix      , iy+fac_y, ieta        ).Wmunu[10];
+                    cube[1][1][0][0] = arena_current  .getHalo(ix+fac_x, iy      , ieta        ).Wmunu[10];
+                    cube[1][1][1][0] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[10];
+                    cube[0][0][0][1] = arena_freezeout.getHalo(ix      , iy      , ieta+fac_eta).Wmunu[10];
+                    cube[0][0][1][1] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[10];
+                    cube[0][1][0][1] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[10];
+                    cube[0][1][1][1] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[10];
+                    cube[1][0][0][1] = arena_current  .getHalo(ix      , iy      , ieta+fac_eta).Wmunu[10];
+                    cube[1][0][1][1] = arena_current  .getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[10];
+                    cube[1][1][0][1] = arena_current  .getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[10];
+                    cube[1][1][1][1] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[10];
+                    double qtau_center =
+                        Util::four_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube);
 
-                // baryon diffusion current q^eta
-                cube[0][0][0][0] = arena_freezeout(ix      , iy      , ieta        ).Wmunu[13];
-                cube[0][0][1][0] = arena_freezeout(ix      , iy+fac_y, ieta        ).Wmunu[13];
-                cube[0][1][0][0] = arena_freezeout(ix+fac_x, iy      , ieta        ).Wmunu[13];
-                cube[0][1][1][0] = arena_freezeout(ix+fac_x, iy+fac_y, ieta        ).Wmunu[13];
-                cube[1][0][0][0] = arena_current  (ix      , iy      , ieta        ).Wmunu[13];
-                cube[1][0][1][0] = arena_current  (ix      , iy+fac_y, ieta        ).Wmunu[13];
-                cube[1][1][0][0] = arena_current  (ix+fac_x, iy      , ieta        ).Wmunu[13];
-                cube[1][1][1][0] = arena_current  (ix+fac_x, iy+fac_y, ieta        ).Wmunu[13];
-                cube[0][0][0][1] = arena_freezeout(ix      , iy      , ieta+fac_eta).Wmunu[13];
-                cube[0][0][1][1] = arena_freezeout(ix      , iy+fac_y, ieta+fac_eta).Wmunu[13];
-                cube[0][1][0][1] = arena_freezeout(ix+fac_x, iy      , ieta+fac_eta).Wmunu[13];
-                cube[0][1][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[13];
-                cube[1][0][0][1] = arena_current  (ix      , iy      , ieta+fac_eta).Wmunu[13];
-                cube[1][0][1][1] = arena_current  (ix      , iy+fac_y, ieta+fac_eta).Wmunu[13];
-                cube[1][1][0][1] = arena_current  (ix+fac_x, iy      , ieta+fac_eta).Wmunu[13];
-                cube[1][1][1][1] = arena_current  (ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[13];
-                double qeta_center =
-                    Util::four_dimension_linear_interpolation(
-                                lattice_spacing, x_fraction, cube);
+                    // baryon diffusion current q^x
+                    cube[0][0][0][0] = arena_freezeout.getHalo(ix      , iy      , ieta        ).Wmunu[11];
+                    cube[0][0][1][0] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta        ).Wmunu[11];
+                    cube[0][1][0][0] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta        ).Wmunu[11];
+                    cube[0][1][1][0] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[11];
+                    cube[1][0][0][0] = arena_current  .getHalo(ix      , iy      , ieta        ).Wmunu[11];
+                    cube[1][0][1][0] = arena_current  .getHalo(ix      , iy+fac_y, ieta        ).Wmunu[11];
+                    cube[1][1][0][0] = arena_current  .getHalo(ix+fac_x, iy      , ieta        ).Wmunu[11];
+                    cube[1][1][1][0] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[11];
+                    cube[0][0][0][1] = arena_freezeout.getHalo(ix      , iy      , ieta+fac_eta).Wmunu[11];
+                    cube[0][0][1][1] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[11];
+                    cube[0][1][0][1] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[11];
+                    cube[0][1][1][1] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[11];
+                    cube[1][0][0][1] = arena_current  .getHalo(ix      , iy      , ieta+fac_eta).Wmunu[11];
+                    cube[1][0][1][1] = arena_current  .getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[11];
+                    cube[1][1][0][1] = arena_current  .getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[11];
+                    cube[1][1][1][1] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[11];
+                    double qx_center =
+                        Util::four_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube);
 
-                // reconstruct q^\tau from the transverality criteria
-                double u_flow[4] = {utau_center, ux_center, uy_center, ueta_center};
-                double q_mu[4]   = {qtau_center, qx_center, qy_center, qeta_center};
-                double q_regulated[4] = {0.0, 0.0, 0.0, 0.0};
+                    // baryon diffusion current q^y
+                    cube[0][0][0][0] = arena_freezeout.getHalo(ix      , iy      , ieta        ).Wmunu[12];
+                    cube[0][0][1][0] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta        ).Wmunu[12];
+                    cube[0][1][0][0] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta        ).Wmunu[12];
+                    cube[0][1][1][0] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[12];
+                    cube[1][0][0][0] = arena_current  .getHalo(ix      , iy      , ieta        ).Wmunu[12];
+                    cube[1][0][1][0] = arena_current  .getHalo(ix      , iy+fac_y, ieta        ).Wmunu[12];
+                    cube[1][1][0][0] = arena_current  .getHalo(ix+fac_x, iy      , ieta        ).Wmunu[12];
+                    cube[1][1][1][0] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[12];
+                    cube[0][0][0][1] = arena_freezeout.getHalo(ix      , iy      , ieta+fac_eta).Wmunu[12];
+                    cube[0][0][1][1] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[12];
+                    cube[0][1][0][1] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[12];
+                    cube[0][1][1][1] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[12];
+                    cube[1][0][0][1] = arena_current  .getHalo(ix      , iy      , ieta+fac_eta).Wmunu[12];
+                    cube[1][0][1][1] = arena_current  .getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[12];
+                    cube[1][1][0][1] = arena_current  .getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[12];
+                    cube[1][1][1][1] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[12];
+                    double qy_center =
+                        Util::four_dimension_linear_interpolation(
+                                lattice_spacing, x_fraction, cube);
 
-                regulate_qmu(u_flow, q_mu, q_regulated);
+                    // baryon diffusion current q^eta
+                    cube[0][0][0][0] = arena_freezeout.getHalo(ix      , iy      , ieta        ).Wmunu[13];
+                    cube[0][0][1][0] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta        ).Wmunu[13];
+                    cube[0][1][0][0] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta        ).Wmunu[13];
+                    cube[0][1][1][0] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[13];
+                    cube[1][0][0][0] = arena_current  .getHalo(ix      , iy      , ieta        ).Wmunu[13];
+                    cube[1][0][1][0] = arena_current  .getHalo(ix      , iy+fac_y, ieta        ).Wmunu[13];
+                    cube[1][1][0][0] = arena_current  .getHalo(ix+fac_x, iy      , ieta        ).Wmunu[13];
+                    cube[1][1][1][0] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[13];
+                    cube[0][0][0][1] = arena_freezeout.getHalo(ix      , iy      , ieta+fac_eta).Wmunu[13];
+                    cube[0][0][1][1] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[13];
+                    cube[0][1][0][1] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[13];
+                    cube[0][1][1][1] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[13];
+                    cube[1][0][0][1] = arena_current  .getHalo(ix      , iy      , ieta+fac_eta).Wmunu[13];
+                    cube[1][0][1][1] = arena_current  .getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[13];
+                    cube[1][1][0][1] = arena_current  .getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[13];
+                    cube[1][1][1][1] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[13];
+                    double qeta_center =
+                        Util::four_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube);
 
-                qtau_center = q_regulated[0];
-                qx_center = q_regulated[1];
-                qy_center = q_regulated[2];
-                qeta_center = q_regulated[3];
+                    // reconstruct q^\tau from the transverality criteria
+                    double u_flow[4] = {utau_center, ux_center, uy_center, ueta_center};
+                    double q_mu[4]   = {qtau_center, qx_center, qy_center, qeta_center};
+                    double q_regulated[4] = {0.0, 0.0, 0.0, 0.0};
 
-                // bulk viscous pressure pi_b
-                cube[0][0][0][0] = arena_freezeout(ix      , iy      , ieta        ).pi_b;
-                cube[0][0][1][0] = arena_freezeout(ix      , iy+fac_y, ieta        ).pi_b;
-                cube[0][1][0][0] = arena_freezeout(ix+fac_x, iy      , ieta        ).pi_b;
-                cube[0][1][1][0] = arena_freezeout(ix+fac_x, iy+fac_y, ieta        ).pi_b;
-                cube[1][0][0][0] = arena_current  (ix      , iy      , ieta        ).pi_b;
-                cube[1][0][1][0] = arena_current  (ix      , iy+fac_y, ieta        ).pi_b;
-                cube[1][1][0][0] = arena_current  (ix+fac_x, iy      , ieta        ).pi_b;
-                cube[1][1][1][0] = arena_current  (ix+fac_x, iy+fac_y, ieta        ).pi_b;
-                cube[0][0][0][1] = arena_freezeout(ix      , iy      , ieta+fac_eta).pi_b;
-                cube[0][0][1][1] = arena_freezeout(ix      , iy+fac_y, ieta+fac_eta).pi_b;
-                cube[0][1][0][1] = arena_freezeout(ix+fac_x, iy      , ieta+fac_eta).pi_b;
-                cube[0][1][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, ieta+fac_eta).pi_b;
-                cube[1][0][0][1] = arena_current  (ix      , iy      , ieta+fac_eta).pi_b;
-                cube[1][0][1][1] = arena_current  (ix      , iy+fac_y, ieta+fac_eta).pi_b;
-                cube[1][1][0][1] = arena_current  (ix+fac_x, iy      , ieta+fac_eta).pi_b;
-                cube[1][1][1][1] = arena_current  (ix+fac_x, iy+fac_y, ieta+fac_eta).pi_b;
-                const double pi_b_center =
-                    Util::four_dimension_linear_interpolation(
-                                lattice_spacing, x_fraction, cube);
+                    regulate_qmu(u_flow, q_mu, q_regulated);
 
-                // shear viscous tensor W^\tau\tau
-                cube[0][0][0][0] = arena_freezeout(ix      , iy      , ieta        ).Wmunu[0];
-                cube[0][0][1][0] = arena_freezeout(ix      , iy+fac_y, ieta        ).Wmunu[0];
-                cube[0][1][0][0] = arena_freezeout(ix+fac_x, iy      , ieta        ).Wmunu[0];
-                cube[0][1][1][0] = arena_freezeout(ix+fac_x, iy+fac_y, ieta        ).Wmunu[0];
-                cube[1][0][0][0] = arena_current  (ix      , iy      , ieta        ).Wmunu[0];
-                cube[1][0][1][0] = arena_current  (ix      , iy+fac_y, ieta        ).Wmunu[0];
-                cube[1][1][0][0] = arena_current  (ix+fac_x, iy      , ieta        ).Wmunu[0];
-                cube[1][1][1][0] = arena_current  (ix+fac_x, iy+fac_y, ieta        ).Wmunu[0];
-                cube[0][0][0][1] = arena_freezeout(ix      , iy      , ieta+fac_eta).Wmunu[0];
-                cube[0][0][1][1] = arena_freezeout(ix      , iy+fac_y, ieta+fac_eta).Wmunu[0];
-                cube[0][1][0][1] = arena_freezeout(ix+fac_x, iy      , ieta+fac_eta).Wmunu[0];
-                cube[0][1][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[0];
-                cube[1][0][0][1] = arena_current  (ix      , iy      , ieta+fac_eta).Wmunu[0];
-                cube[1][0][1][1] = arena_current  (ix      , iy+fac_y, ieta+fac_eta).Wmunu[0];
-                cube[1][1][0][1] = arena_current  (ix+fac_x, iy      , ieta+fac_eta).Wmunu[0];
-                cube[1][1][1][1] = arena_current  (ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[0];
-                double Wtautau_center =
-                    Util::four_dimension_linear_interpolation(
-                                lattice_spacing, x_fraction, cube);
+                    qtau_center = q_regulated[0];
+                    qx_center = q_regulated[1];
+                    qy_center = q_regulated[2];
+                    qeta_center = q_regulated[3];
 
-                // shear viscous tensor W^{\tau x}
-                cube[0][0][0][0] = arena_freezeout(ix      , iy      , ieta        ).Wmunu[1];
-                cube[0][0][1][0] = arena_freezeout(ix      , iy+fac_y, ieta        ).Wmunu[1];
-                cube[0][1][0][0] = arena_freezeout(ix+fac_x, iy      , ieta        ).Wmunu[1];
-                cube[0][1][1][0] = arena_freezeout(ix+fac_x, iy+fac_y, ieta        ).Wmunu[1];
-                cube[1][0][0][0] = arena_current  (ix      , iy      , ieta        ).Wmunu[1];
-                cube[1][0][1][0] = arena_current  (ix      , iy+fac_y, ieta        ).Wmunu[1];
-                cube[1][1][0][0] = arena_current  (ix+fac_x, iy      , ieta        ).Wmunu[1];
-                cube[1][1][1][0] = arena_current  (ix+fac_x, iy+fac_y, ieta        ).Wmunu[1];
-                cube[0][0][0][1] = arena_freezeout(ix      , iy      , ieta+fac_eta).Wmunu[1];
-                cube[0][0][1][1] = arena_freezeout(ix      , iy+fac_y, ieta+fac_eta).Wmunu[1];
-                cube[0][1][0][1] = arena_freezeout(ix+fac_x, iy      , ieta+fac_eta).Wmunu[1];
-                cube[0][1][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[1];
-                cube[1][0][0][1] = arena_current  (ix      , iy      , ieta+fac_eta).Wmunu[1];
-                cube[1][0][1][1] = arena_current  (ix      , iy+fac_y, ieta+fac_eta).Wmunu[1];
-                cube[1][1][0][1] = arena_current  (ix+fac_x, iy      , ieta+fac_eta).Wmunu[1];
-                cube[1][1][1][1] = arena_current  (ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[1];
-                double Wtaux_center =
-                    Util::four_dimension_linear_interpolation(
-                                lattice_spacing, x_fraction, cube);
+                    // bulk viscous pressure pi_b
+                    cube[0][0][0][0] = arena_freezeout.getHalo(ix      , iy      , ieta        ).pi_b;
+                    cube[0][0][1][0] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta        ).pi_b;
+                    cube[0][1][0][0] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta        ).pi_b;
+                    cube[0][1][1][0] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta        ).pi_b;
+                    cube[1][0][0][0] = arena_current  .getHalo(ix      , iy      , ieta        ).pi_b;
+                    cube[1][0][1][0] = arena_current  .getHalo(ix      , iy+fac_y, ieta        ).pi_b;
+                    cube[1][1][0][0] = arena_current  .getHalo(ix+fac_x, iy      , ieta        ).pi_b;
+                    cube[1][1][1][0] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta        ).pi_b;
+                    cube[0][0][0][1] = arena_freezeout.getHalo(ix      , iy      , ieta+fac_eta).pi_b;
+                    cube[0][0][1][1] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta+fac_eta).pi_b;
+                    cube[0][1][0][1] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta+fac_eta).pi_b;
+                    cube[0][1][1][1] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).pi_b;
+                    cube[1][0][0][1] = arena_current  .getHalo(ix      , iy      , ieta+fac_eta).pi_b;
+                    cube[1][0][1][1] = arena_current  .getHalo(ix      , iy+fac_y, ieta+fac_eta).pi_b;
+                    cube[1][1][0][1] = arena_current  .getHalo(ix+fac_x, iy      , ieta+fac_eta).pi_b;
+                    cube[1][1][1][1] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).pi_b;
+                    const double pi_b_center =
+                        Util::four_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube);
 
-                // shear viscous tensor W^{\tau y}
-                cube[0][0][0][0] = arena_freezeout(ix      , iy      , ieta        ).Wmunu[2];
-                cube[0][0][1][0] = arena_freezeout(ix      , iy+fac_y, ieta        ).Wmunu[2];
-                cube[0][1][0][0] = arena_freezeout(ix+fac_x, iy      , ieta        ).Wmunu[2];
-                cube[0][1][1][0] = arena_freezeout(ix+fac_x, iy+fac_y, ieta        ).Wmunu[2];
-                cube[1][0][0][0] = arena_current  (ix      , iy      , ieta        ).Wmunu[2];
-                cube[1][0][1][0] = arena_current  (ix      , iy+fac_y, ieta        ).Wmunu[2];
-                cube[1][1][0][0] = arena_current  (ix+fac_x, iy      , ieta        ).Wmunu[2];
-                cube[1][1][1][0] = arena_current  (ix+fac_x, iy+fac_y, ieta        ).Wmunu[2];
-                cube[0][0][0][1] = arena_freezeout(ix      , iy      , ieta+fac_eta).Wmunu[2];
-                cube[0][0][1][1] = arena_freezeout(ix      , iy+fac_y, ieta+fac_eta).Wmunu[2];
-                cube[0][1][0][1] = arena_freezeout(ix+fac_x, iy      , ieta+fac_eta).Wmunu[2];
-                cube[0][1][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[2];
-                cube[1][0][0][1] = arena_current  (ix      , iy      , ieta+fac_eta).Wmunu[2];
-                cube[1][0][1][1] = arena_current  (ix      , iy+fac_y, ieta+fac_eta).Wmunu[2];
-                cube[1][1][0][1] = arena_current  (ix+fac_x, iy      , ieta+fac_eta).Wmunu[2];
-                cube[1][1][1][1] = arena_current  (ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[2];
-                double Wtauy_center = Util::four_dimension_linear_interpolation(
-                                lattice_spacing, x_fraction, cube);
+                    // shear viscous tensor W^\tau\tau
+                    cube[0][0][0][0] = arena_freezeout.getHalo(ix      , iy      , ieta        ).Wmunu[0];
+                    cube[0][0][1][0] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta        ).Wmunu[0];
+                    cube[0][1][0][0] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta        ).Wmunu[0];
+                    cube[0][1][1][0] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[0];
+                    cube[1][0][0][0] = arena_current  .getHalo(ix      , iy      , ieta        ).Wmunu[0];
+                    cube[1][0][1][0] = arena_current  .getHalo(ix      , iy+fac_y, ieta        ).Wmunu[0];
+                    cube[1][1][0][0] = arena_current  .getHalo(ix+fac_x, iy      , ieta        ).Wmunu[0];
+                    cube[1][1][1][0] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[0];
+                    cube[0][0][0][1] = arena_freezeout.getHalo(ix      , iy      , ieta+fac_eta).Wmunu[0];
+                    cube[0][0][1][1] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[0];
+                    cube[0][1][0][1] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[0];
+                    cube[0][1][1][1] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[0];
+                    cube[1][0][0][1] = arena_current  .getHalo(ix      , iy      , ieta+fac_eta).Wmunu[0];
+                    cube[1][0][1][1] = arena_current  .getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[0];
+                    cube[1][1][0][1] = arena_current  .getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[0];
+                    cube[1][1][1][1] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[0];
+                    double Wtautau_center =
+                        Util::four_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube);
 
-                // shear viscous tensor W^{\tau \eta}
-                cube[0][0][0][0] = arena_freezeout(ix      , iy      , ieta        ).Wmunu[3];
-                cube[0][0][1][0] = arena_freezeout(ix      , iy+fac_y, ieta        ).Wmunu[3];
-                cube[0][1][0][0] = arena_freezeout(ix+fac_x, iy      , ieta        ).Wmunu[3];
-                cube[0][1][1][0] = arena_freezeout(ix+fac_x, iy+fac_y, ieta        ).Wmunu[3];
-                cube[1][0][0][0] = arena_current  (ix      , iy      , ieta        ).Wmunu[3];
-                cube[1][0][1][0] = arena_current  (ix      , iy+fac_y, ieta        ).Wmunu[3];
-                cube[1][1][0][0] = arena_current  (ix+fac_x, iy      , ieta        ).Wmunu[3];
-                cube[1][1][1][0] = arena_current  (ix+fac_x, iy+fac_y, ieta        ).Wmunu[3];
-                cube[0][0][0][1] = arena_freezeout(ix      , iy      , ieta+fac_eta).Wmunu[3];
-                cube[0][0][1][1] = arena_freezeout(ix      , iy+fac_y, ieta+fac_eta).Wmunu[3];
-                cube[0][1][0][1] = arena_freezeout(ix+fac_x, iy      , ieta+fac_eta).Wmunu[3];
-                cube[0][1][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[3];
-                cube[1][0][0][1] = arena_current  (ix      , iy      , ieta+fac_eta).Wmunu[3];
-                cube[1][0][1][1] = arena_current  (ix      , iy+fac_y, ieta+fac_eta).Wmunu[3];
-                cube[1][1][0][1] = arena_current  (ix+fac_x, iy      , ieta+fac_eta).Wmunu[3];
-                cube[1][1][1][1] = arena_current  (ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[3];
-                double Wtaueta_center =
-                    Util::four_dimension_linear_interpolation(
-                                lattice_spacing, x_fraction, cube);
+                    // shear viscous tensor W^{\tau x}
+                    cube[0][0][0][0] = arena_freezeout.getHalo(ix      , iy      , ieta        ).Wmunu[1];
+                    cube[0][0][1][0] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta        ).Wmunu[1];
+                    cube[0][1][0][0] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta        ).Wmunu[1];
+                    cube[0][1][1][0] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[1];
+                    cube[1][0][0][0] = arena_current  .getHalo(ix      , iy      , ieta        ).Wmunu[1];
+                    cube[1][0][1][0] = arena_current  .getHalo(ix      , iy+fac_y, ieta        ).Wmunu[1];
+                    cube[1][1][0][0] = arena_current  .getHalo(ix+fac_x, iy      , ieta        ).Wmunu[1];
+                    cube[1][1][1][0] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[1];
+                    cube[0][0][0][1] = arena_freezeout.getHalo(ix      , iy      , ieta+fac_eta).Wmunu[1];
+                    cube[0][0][1][1] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[1];
+                    cube[0][1][0][1] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[1];
+                    cube[0][1][1][1] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[1];
+                    cube[1][0][0][1] = arena_current  .getHalo(ix      , iy      , ieta+fac_eta).Wmunu[1];
+                    cube[1][0][1][1] = arena_current  .getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[1];
+                    cube[1][1][0][1] = arena_current  .getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[1];
+                    cube[1][1][1][1] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[1];
+                    double Wtaux_center =
+                        Util::four_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube);
 
-                // shear viscous tensor W^{xx}
-                cube[0][0][0][0] = arena_freezeout(ix      , iy      , ieta        ).Wmunu[4];
-                cube[0][0][1][0] = arena_freezeout(ix      , iy+fac_y, ieta        ).Wmunu[4];
-                cube[0][1][0][0] = arena_freezeout(ix+fac_x, iy      , ieta        ).Wmunu[4];
-                cube[0][1][1][0] = arena_freezeout(ix+fac_x, iy+fac_y, ieta        ).Wmunu[4];
-                cube[1][0][0][0] = arena_current  (ix      , iy      , ieta        ).Wmunu[4];
-                cube[1][0][1][0] = arena_current  (ix      , iy+fac_y, ieta        ).Wmunu[4];
-                cube[1][1][0][0] = arena_current  (ix+fac_x, iy      , ieta        ).Wmunu[4];
-                cube[1][1][1][0] = arena_current  (ix+fac_x, iy+fac_y, ieta        ).Wmunu[4];
-                cube[0][0][0][1] = arena_freezeout(ix      , iy      , ieta+fac_eta).Wmunu[4];
-                cube[0][0][1][1] = arena_freezeout(ix      , iy+fac_y, ieta+fac_eta).Wmunu[4];
-                cube[0][1][0][1] = arena_freezeout(ix+fac_x, iy      , ieta+fac_eta).Wmunu[4];
-                cube[0][1][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[4];
-                cube[1][0][0][1] = arena_current  (ix      , iy      , ieta+fac_eta).Wmunu[4];
-                cube[1][0][1][1] = arena_current  (ix      , iy+fac_y, ieta+fac_eta).Wmunu[4];
-                cube[1][1][0][1] = arena_current  (ix+fac_x, iy      , ieta+fac_eta).Wmunu[4];
-                cube[1][1][1][1] = arena_current  (ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[4];
-                double Wxx_center =
-                    Util::four_dimension_linear_interpolation(
-                                lattice_spacing, x_fraction, cube);
+                    // shear viscous tensor W^{\tau y}
+                    cube[0][0][0][0] = arena_freezeout.getHalo(ix      , iy      , ieta        ).Wmunu[2];
+                    cube[0][0][1][0] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta        ).Wmunu[2];
+                    cube[0][1][0][0] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta        ).Wmunu[2];
+                    cube[0][1][1][0] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[2];
+                    cube[1][0][0][0] = arena_current  .getHalo(ix      , iy      , ieta        ).Wmunu[2];
+                    cube[1][0][1][0] = arena_current  .getHalo(ix      , iy+fac_y, ieta        ).Wmunu[2];
+                    cube[1][1][0][0] = arena_current  .getHalo(ix+fac_x, iy      , ieta        ).Wmunu[2];
+                    cube[1][1][1][0] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[2];
+                    cube[0][0][0][1] = arena_freezeout.getHalo(ix      , iy      , ieta+fac_eta).Wmunu[2];
+                    cube[0][0][1][1] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[2];
+                    cube[0][1][0][1] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[2];
+                    cube[0][1][1][1] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[2];
+                    cube[1][0][0][1] = arena_current  .getHalo(ix      , iy      , ieta+fac_eta).Wmunu[2];
+                    cube[1][0][1][1] = arena_current  .getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[2];
+                    cube[1][1][0][1] = arena_current  .getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[2];
+                    cube[1][1][1][1] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[2];
+                    double Wtauy_center = Util::four_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube);
 
-                // shear viscous tensor W^{xy}
-                cube[0][0][0][0] = arena_freezeout(ix      , iy      , ieta        ).Wmunu[5];
-                cube[0][0][1][0] = arena_freezeout(ix      , iy+fac_y, ieta        ).Wmunu[5];
-                cube[0][1][0][0] = arena_freezeout(ix+fac_x, iy      , ieta        ).Wmunu[5];
-                cube[0][1][1][0] = arena_freezeout(ix+fac_x, iy+fac_y, ieta        ).Wmunu[5];
-                cube[1][0][0][0] = arena_current  (ix      , iy      , ieta        ).Wmunu[5];
-                cube[1][0][1][0] = arena_current  (ix      , iy+fac_y, ieta        ).Wmunu[5];
-                cube[1][1][0][0] = arena_current  (ix+fac_x, iy      , ieta        ).Wmunu[5];
-                cube[1][1][1][0] = arena_current  (ix+fac_x, iy+fac_y, ieta        ).Wmunu[5];
-                cube[0][0][0][1] = arena_freezeout(ix      , iy      , ieta+fac_eta).Wmunu[5];
-                cube[0][0][1][1] = arena_freezeout(ix      , iy+fac_y, ieta+fac_eta).Wmunu[5];
-                cube[0][1][0][1] = arena_freezeout(ix+fac_x, iy      , ieta+fac_eta).Wmunu[5];
-                cube[0][1][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[5];
-                cube[1][0][0][1] = arena_current  (ix      , iy      , ieta+fac_eta).Wmunu[5];
-                cube[1][0][1][1] = arena_current  (ix      , iy+fac_y, ieta+fac_eta).Wmunu[5];
-                cube[1][1][0][1] = arena_current  (ix+fac_x, iy      , ieta+fac_eta).Wmunu[5];
-                cube[1][1][1][1] = arena_current  (ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[5];
-                double Wxy_center =
-                    Util::four_dimension_linear_interpolation(
-                                lattice_spacing, x_fraction, cube);
+                    // shear viscous tensor W^{\tau \eta}
+                    cube[0][0][0][0] = arena_freezeout.getHalo(ix      , iy      , ieta        ).Wmunu[3];
+                    cube[0][0][1][0] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta        ).Wmunu[3];
+                    cube[0][1][0][0] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta        ).Wmunu[3];
+                    cube[0][1][1][0] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[3];
+                    cube[1][0][0][0] = arena_current  .getHalo(ix      , iy      , ieta        ).Wmunu[3];
+                    cube[1][0][1][0] = arena_current  .getHalo(ix      , iy+fac_y, ieta        ).Wmunu[3];
+                    cube[1][1][0][0] = arena_current  .getHalo(ix+fac_x, iy      , ieta        ).Wmunu[3];
+                    cube[1][1][1][0] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[3];
+                    cube[0][0][0][1] = arena_freezeout.getHalo(ix      , iy      , ieta+fac_eta).Wmunu[3];
+                    cube[0][0][1][1] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[3];
+                    cube[0][1][0][1] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[3];
+                    cube[0][1][1][1] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[3];
+                    cube[1][0][0][1] = arena_current  .getHalo(ix      , iy      , ieta+fac_eta).Wmunu[3];
+                    cube[1][0][1][1] = arena_current  .getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[3];
+                    cube[1][1][0][1] = arena_current  .getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[3];
+                    cube[1][1][1][1] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[3];
+                    double Wtaueta_center =
+                        Util::four_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube);
 
-                // shear viscous tensor W^{x\eta}
-                cube[0][0][0][0] = arena_freezeout(ix      , iy      , ieta        ).Wmunu[6];
-                cube[0][0][1][0] = arena_freezeout(ix      , iy+fac_y, ieta        ).Wmunu[6];
-                cube[0][1][0][0] = arena_freezeout(ix+fac_x, iy      , ieta        ).Wmunu[6];
-                cube[0][1][1][0] = arena_freezeout(ix+fac_x, iy+fac_y, ieta        ).Wmunu[6];
-                cube[1][0][0][0] = arena_current  (ix      , iy      , ieta        ).Wmunu[6];
-                cube[1][0][1][0] = arena_current  (ix      , iy+fac_y, ieta        ).Wmunu[6];
-                cube[1][1][0][0] = arena_current  (ix+fac_x, iy      , ieta        ).Wmunu[6];
-                cube[1][1][1][0] = arena_current  (ix+fac_x, iy+fac_y, ieta        ).Wmunu[6];
-                cube[0][0][0][1] = arena_freezeout(ix      , iy      , ieta+fac_eta).Wmunu[6];
-                cube[0][0][1][1] = arena_freezeout(ix      , iy+fac_y, ieta+fac_eta).Wmunu[6];
-                cube[0][1][0][1] = arena_freezeout(ix+fac_x, iy      , ieta+fac_eta).Wmunu[6];
-                cube[0][1][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[6];
-                cube[1][0][0][1] = arena_current  (ix      , iy      , ieta+fac_eta).Wmunu[6];
-                cube[1][0][1][1] = arena_current  (ix      , iy+fac_y, ieta+fac_eta).Wmunu[6];
-                cube[1][1][0][1] = arena_current  (ix+fac_x, iy      , ieta+fac_eta).Wmunu[6];
-                cube[1][1][1][1] = arena_current  (ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[6];
-                double Wxeta_center =
-                    Util::four_dimension_linear_interpolation(
-                                lattice_spacing, x_fraction, cube);
+                    // shear viscous tensor W^{xx}
+                    cube[0][0][0][0] = arena_freezeout.getHalo(ix      , iy      , ieta        ).Wmunu[4];
+                    cube[0][0][1][0] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta        ).Wmunu[4];
+                    cube[0][1][0][0] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta        ).Wmunu[4];
+                    cube[0][1][1][0] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[4];
+                    cube[1][0][0][0] = arena_current  .getHalo(ix      , iy      , ieta        ).Wmunu[4];
+                    cube[1][0][1][0] = arena_current  .getHalo(ix      , iy+fac_y, ieta        ).Wmunu[4];
+                    cube[1][1][0][0] = arena_current  .getHalo(ix+fac_x, iy      , ieta        ).Wmunu[4];
+                    cube[1][1][1][0] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[4];
+                    cube[0][0][0][1] = arena_freezeout.getHalo(ix      , iy      , ieta+fac_eta).Wmunu[4];
+                    cube[0][0][1][1] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[4];
+                    cube[0][1][0][1] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[4];
+                    cube[0][1][1][1] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[4];
+                    cube[1][0][0][1] = arena_current  .getHalo(ix      , iy      , ieta+fac_eta).Wmunu[4];
+                    cube[1][0][1][1] = arena_current  .getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[4];
+                    cube[1][1][0][1] = arena_current  .getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[4];
+                    cube[1][1][1][1] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[4];
+                    double Wxx_center =
+                        Util::four_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube);
 
-                // shear viscous tensor W^{yy}
-                cube[0][0][0][0] = arena_freezeout(ix      , iy      , ieta        ).Wmunu[7];
-                cube[0][0][1][0] = arena_freezeout(ix      , iy+fac_y, ieta        ).Wmunu[7];
-                cube[0][1][0][0] = arena_freezeout(ix+fac_x, iy      , ieta        ).Wmunu[7];
-                cube[0][1][1][0] = arena_freezeout(ix+fac_x, iy+fac_y, ieta        ).Wmunu[7];
-                cube[1][0][0][0] = arena_current  (ix      , iy      , ieta        ).Wmunu[7];
-                cube[1][0][1][0] = arena_current  (ix      , iy+fac_y, ieta        ).Wmunu[7];
-                cube[1][1][0][0] = arena_current  (ix+fac_x, iy      , ieta        ).Wmunu[7];
-                cube[1][1][1][0] = arena_current  (ix+fac_x, iy+fac_y, ieta        ).Wmunu[7];
-                cube[0][0][0][1] = arena_freezeout(ix      , iy      , ieta+fac_eta).Wmunu[7];
-                cube[0][0][1][1] = arena_freezeout(ix      , iy+fac_y, ieta+fac_eta).Wmunu[7];
-                cube[0][1][0][1] = arena_freezeout(ix+fac_x, iy      , ieta+fac_eta).Wmunu[7];
-                cube[0][1][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[7];
-                cube[1][0][0][1] = arena_current  (ix      , iy      , ieta+fac_eta).Wmunu[7];
-                cube[1][0][1][1] = arena_current  (ix      , iy+fac_y, ieta+fac_eta).Wmunu[7];
-                cube[1][1][0][1] = arena_current  (ix+fac_x, iy      , ieta+fac_eta).Wmunu[7];
-                cube[1][1][1][1] = arena_current  (ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[7];
-                double Wyy_center =
-                    Util::four_dimension_linear_interpolation(
-                                lattice_spacing, x_fraction, cube);
+                    // shear viscous tensor W^{xy}
+                    cube[0][0][0][0] = arena_freezeout.getHalo(ix      , iy      , ieta        ).Wmunu[5];
+                    cube[0][0][1][0] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta        ).Wmunu[5];
+                    cube[0][1][0][0] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta        ).Wmunu[5];
+                    cube[0][1][1][0] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[5];
+                    cube[1][0][0][0] = arena_current  .getHalo(ix      , iy      , ieta        ).Wmunu[5];
+                    cube[1][0][1][0] = arena_current  .getHalo(ix      , iy+fac_y, ieta        ).Wmunu[5];
+                    cube[1][1][0][0] = arena_current  .getHalo(ix+fac_x, iy      , ieta        ).Wmunu[5];
+                    cube[1][1][1][0] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[5];
+                    cube[0][0][0][1] = arena_freezeout.getHalo(ix      , iy      , ieta+fac_eta).Wmunu[5];
+                    cube[0][0][1][1] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[5];
+                    cube[0][1][0][1] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[5];
+                    cube[0][1][1][1] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[5];
+                    cube[1][0][0][1] = arena_current  .getHalo(ix      , iy      , ieta+fac_eta).Wmunu[5];
+                    cube[1][0][1][1] = arena_current  .getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[5];
+                    cube[1][1][0][1] = arena_current  .getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[5];
+                    cube[1][1][1][1] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[5];
+                    double Wxy_center =
+                        Util::four_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube);
+
+                    // shear viscous tensor W^{x\eta}
+                    cube[0][0][0][0] = arena_freezeout.getHalo(ix      , iy      , ieta        ).Wmunu[6];
+                    cube[0][0][1][0] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta        ).Wmunu[6];
+                    cube[0][1][0][0] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta        ).Wmunu[6];
+                    cube[0][1][1][0] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[6];
+                    cube[1][0][0][0] = arena_current  .getHalo(ix      , iy      , ieta        ).Wmunu[6];
+                    cube[1][0][1][0] = arena_current  .getHalo(ix      , iy+fac_y, ieta        ).Wmunu[6];
+                    cube[1][1][0][0] = arena_current  .getHalo(ix+fac_x, iy      , ieta        ).Wmunu[6];
+                    cube[1][1][1][0] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[6];
+                    cube[0][0][0][1] = arena_freezeout.getHalo(ix      , iy      , ieta+fac_eta).Wmunu[6];
+                    cube[0][0][1][1] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[6];
+                    cube[0][1][0][1] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[6];
+                    cube[0][1][1][1] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[6];
+                    cube[1][0][0][1] = arena_current  .getHalo(ix      , iy      , ieta+fac_eta).Wmunu[6];
+                    cube[1][0][1][1] = arena_current  .getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[6];
+                    cube[1][1][0][1] = arena_current  .getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[6];
+                    cube[1][1][1][1] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[6];
+                    double Wxeta_center =
+                        Util::four_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube);
 
-                // shear viscous tensor W^{y\eta}
-                cube[0][0][0][0] = arena_freezeout(ix      , iy      , ieta        ).Wmunu[8];
-                cube[0][0][1][0] = arena_freezeout(ix      , iy+fac_y, ieta        ).Wmunu[8];
-                cube[0][1][0][0] = arena_freezeout(ix+fac_x, iy      , ieta        ).Wmunu[8];
-                cube[0][1][1][0] = arena_freezeout(ix+fac_x, iy+fac_y, ieta        ).Wmunu[8];
-                cube[1][0][0][0] = arena_current  (ix      , iy      , ieta        ).Wmunu[8];
-                cube[1][0][1][0] = arena_current  (ix      , iy+fac_y, ieta        ).Wmunu[8];
-                cube[1][1][0][0] = arena_current  (ix+fac_x, iy      , ieta        ).Wmunu[8];
-                cube[1][1][1][0] = arena_current  (ix+fac_x, iy+fac_y, ieta        ).Wmunu[8];
-                cube[0][0][0][1] = arena_freezeout(ix      , iy      , ieta+fac_eta).Wmunu[8];
-                cube[0][0][1][1] = arena_freezeout(ix      , iy+fac_y, ieta+fac_eta).Wmunu[8];
-                cube[0][1][0][1] = arena_freezeout(ix+fac_x, iy      , ieta+fac_eta).Wmunu[8];
-                cube[0][1][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[8];
-                cube[1][0][0][1] = arena_current  (ix      , iy      , ieta+fac_eta).Wmunu[8];
-                cube[1][0][1][1] = arena_current  (ix      , iy+fac_y, ieta+fac_eta).Wmunu[8];
-                cube[1][1][0][1] = arena_current  (ix+fac_x, iy      , ieta+fac_eta).Wmunu[8];
-                cube[1][1][1][1] = arena_current  (ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[8];
-                double Wyeta_center =
-                    Util::four_dimension_linear_interpolation(
-                                lattice_spacing, x_fraction, cube);
+                    // shear viscous tensor W^{yy}
+                    cube[0][0][0][0] = arena_freezeout.getHalo(ix      , iy      , ieta        ).Wmunu[7];
+                    cube[0][0][1][0] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta        ).Wmunu[7];
+                    cube[0][1][0][0] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta        ).Wmunu[7];
+                    cube[0][1][1][0] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[7];
+                    cube[1][0][0][0] = arena_current  .getHalo(ix      , iy      , ieta        ).Wmunu[7];
+                    cube[1][0][1][0] = arena_current  .getHalo(ix      , iy+fac_y, ieta        ).Wmunu[7];
+                    cube[1][1][0][0] = arena_current  .getHalo(ix+fac_x, iy      , ieta        ).Wmunu[7];
+                    cube[1][1][1][0] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[7];
+                    cube[0][0][0][1] = arena_freezeout.getHalo(ix      , iy      , ieta+fac_eta).Wmunu[7];
+                    cube[0][0][1][1] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[7];
+                    cube[0][1][0][1] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[7];
+                    cube[0][1][1][1] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[7];
+                    cube[1][0][0][1] = arena_current  .getHalo(ix      , iy      , ieta+fac_eta).Wmunu[7];
+                    cube[1][0][1][1] = arena_current  .getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[7];
+                    cube[1][1][0][1] = arena_current  .getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[7];
+                    cube[1][1][1][1] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[7];
+                    double Wyy_center =
+                        Util::four_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube);
+
+                    // shear viscous tensor W^{y\eta}
+                    cube[0][0][0][0] = arena_freezeout.getHalo(ix      , iy      , ieta        ).Wmunu[8];
+                    cube[0][0][1][0] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta        ).Wmunu[8];
+                    cube[0][1][0][0] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta        ).Wmunu[8];
+                    cube[0][1][1][0] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[8];
+                    cube[1][0][0][0] = arena_current  .getHalo(ix      , iy      , ieta        ).Wmunu[8];
+                    cube[1][0][1][0] = arena_current  .getHalo(ix      , iy+fac_y, ieta        ).Wmunu[8];
+                    cube[1][1][0][0] = arena_current  .getHalo(ix+fac_x, iy      , ieta        ).Wmunu[8];
+                    cube[1][1][1][0] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[8];
+                    cube[0][0][0][1] = arena_freezeout.getHalo(ix      , iy      , ieta+fac_eta).Wmunu[8];
+                    cube[0][0][1][1] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[8];
+                    cube[0][1][0][1] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[8];
+                    cube[0][1][1][1] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[8];
+                    cube[1][0][0][1] = arena_current  .getHalo(ix      , iy      , ieta+fac_eta).Wmunu[8];
+                    cube[1][0][1][1] = arena_current  .getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[8];
+                    cube[1][1][0][1] = arena_current  .getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[8];
+                    cube[1][1][1][1] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[8];
+                    double Wyeta_center =
+                        Util::four_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube);
 
-                // shear viscous tensor W^{\eta\eta}
-                cube[0][0][0][0] = arena_freezeout(ix      , iy      , ieta        ).Wmunu[9];
-                cube[0][0][1][0] = arena_freezeout(ix      , iy+fac_y, ieta        ).Wmunu[9];
-                cube[0][1][0][0] = arena_freezeout(ix+fac_x, iy      , ieta        ).Wmunu[9];
-                cube[0][1][1][0] = arena_freezeout(ix+fac_x, iy+fac_y, ieta        ).Wmunu[9];
-                cube[1][0][0][0] = arena_current  (ix      , iy      , ieta        ).Wmunu[9];
-                cube[1][0][1][0] = arena_current  (ix      , iy+fac_y, ieta        ).Wmunu[9];
-                cube[1][1][0][0] = arena_current  (ix+fac_x, iy      , ieta        ).Wmunu[9];
-                cube[1][1][1][0] = arena_current  (ix+fac_x, iy+fac_y, ieta        ).Wmunu[9];
-                cube[0][0][0][1] = arena_freezeout(ix      , iy      , ieta+fac_eta).Wmunu[9];
-                cube[0][0][1][1] = arena_freezeout(ix      , iy+fac_y, ieta+fac_eta).Wmunu[9];
-                cube[0][1][0][1] = arena_freezeout(ix+fac_x, iy      , ieta+fac_eta).Wmunu[9];
-                cube[0][1][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[9];
-                cube[1][0][0][1] = arena_current  (ix      , iy      , ieta+fac_eta).Wmunu[9];
-                cube[1][0][1][1] = arena_current  (ix      , iy+fac_y, ieta+fac_eta).Wmunu[9];
-                cube[1][1][0][1] = arena_current  (ix+fac_x, iy      , ieta+fac_eta).Wmunu[9];
-                cube[1][1][1][1] = arena_current  (ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[9];
-                double Wetaeta_center =
-                    Util::four_dimension_linear_interpolation(
-                                lattice_spacing, x_fraction, cube);
+                    // shear viscous tensor W^{\eta\eta}
+                    cube[0][0][0][0] = arena_freezeout.getHalo(ix      , iy      , ieta        ).Wmunu[9];
+                    cube[0][0][1][0] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta        ).Wmunu[9];
+                    cube[0][1][0][0] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta        ).Wmunu[9];
+                    cube[0][1][1][0] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[9];
+                    cube[1][0][0][0] = arena_current  .getHalo(ix      , iy      , ieta        ).Wmunu[9];
+                    cube[1][0][1][0] = arena_current  .getHalo(ix      , iy+fac_y, ieta        ).Wmunu[9];
+                    cube[1][1][0][0] = arena_current  .getHalo(ix+fac_x, iy      , ieta        ).Wmunu[9];
+                    cube[1][1][1][0] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta        ).Wmunu[9];
+                    cube[0][0][0][1] = arena_freezeout.getHalo(ix      , iy      , ieta+fac_eta).Wmunu[9];
+                    cube[0][0][1][1] = arena_freezeout.getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[9];
+                    cube[0][1][0][1] = arena_freezeout.getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[9];
+                    cube[0][1][1][1] = arena_freezeout.getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[9];
+                    cube[1][0][0][1] = arena_current  .getHalo(ix      , iy      , ieta+fac_eta).Wmunu[9];
+                    cube[1][0][1][1] = arena_current  .getHalo(ix      , iy+fac_y, ieta+fac_eta).Wmunu[9];
+                    cube[1][1][0][1] = arena_current  .getHalo(ix+fac_x, iy      , ieta+fac_eta).Wmunu[9];
+                    cube[1][1][1][1] = arena_current  .getHalo(ix+fac_x, iy+fac_y, ieta+fac_eta).Wmunu[9];
+                    double Wetaeta_center =
+                        Util::four_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube);
 
-                // regulate Wmunu according to transversality and traceless
-                double Wmunu_input[4][4];
-                double Wmunu_regulated[4][4];
-                Wmunu_input[0][0] = Wtautau_center;
-                Wmunu_input[0][1] = Wmunu_input[1][0] = Wtaux_center;
-                Wmunu_input[0][2] = Wmunu_input[2][0] = Wtauy_center;
-                Wmunu_input[0][3] = Wmunu_input[3][0] = Wtaueta_center;
-                Wmunu_input[1][1] = Wxx_center;
-                Wmunu_input[1][2] = Wmunu_input[2][1] = Wxy_center;
-                Wmunu_input[1][3] = Wmunu_input[3][1] = Wxeta_center;
-                Wmunu_input[2][2] = Wyy_center;
-                Wmunu_input[2][3] = Wmunu_input[3][2] = Wyeta_center;
-                Wmunu_input[3][3] = Wetaeta_center;
-                regulate_Wmunu(u_flow, Wmunu_input, Wmunu_regulated);
-                Wtautau_center = Wmunu_regulated[0][0];
-                Wtaux_center   = Wmunu_regulated[0][1];
-                Wtauy_center   = Wmunu_regulated[0][2];
-                Wtaueta_center = Wmunu_regulated[0][3];
-                Wxx_center     = Wmunu_regulated[1][1];
-                Wxy_center     = Wmunu_regulated[1][2];
-                Wxeta_center   = Wmunu_regulated[1][3];
-                Wyy_center     = Wmunu_regulated[2][2];
-                Wyeta_center   = Wmunu_regulated[2][3];
-                Wetaeta_center = Wmunu_regulated[3][3];
+                    // regulate Wmunu according to transversality and traceless
+                    double Wmunu_input[4][4];
+                    double Wmunu_regulated[4][4];
+                    Wmunu_input[0][0] = Wtautau_center;
+                    Wmunu_input[0][1] = Wmunu_input[1][0] = Wtaux_center;
+                    Wmunu_input[0][2] = Wmunu_input[2][0] = Wtauy_center;
+                    Wmunu_input[0][3] = Wmunu_input[3][0] = Wtaueta_center;
+                    Wmunu_input[1][1] = Wxx_center;
+                    Wmunu_input[1][2] = Wmunu_input[2][1] = Wxy_center;
+                    Wmunu_input[1][3] = Wmunu_input[3][1] = Wxeta_center;
+                    Wmunu_input[2][2] = Wyy_center;
+                    Wmunu_input[2][3] = Wmunu_input[3][2] = Wyeta_center;
+                    Wmunu_input[3][3] = Wetaeta_center;
+                    regulate_Wmunu(u_flow, Wmunu_input, Wmunu_regulated);
+                    Wtautau_center = Wmunu_regulated[0][0];
+                    Wtaux_center   = Wmunu_regulated[0][1];
+                    Wtauy_center   = Wmunu_regulated[0][2];
+                    Wtaueta_center = Wmunu_regulated[0][3];
+                    Wxx_center     = Wmunu_regulated[1][1];
+                    Wxy_center     = Wmunu_regulated[1][2];
+                    Wxeta_center   = Wmunu_regulated[1][3];
+                    Wyy_center     = Wmunu_regulated[2][2];
+                    Wyeta_center   = Wmunu_regulated[2][3];
+                    Wetaeta_center = Wmunu_regulated[3][3];
 
-                // 4-dimension interpolation done
-                const double TFO = eos.get_temperature(epsFO, rhob_center);
-                const double muB = eos.get_mu(epsFO, rhob_center);
-                if (TFO < 0) {
-                    music_message << "TFO=" << TFO
-                                  << "<0. ERROR. exiting.";
-                    music_message.flush("error");
-                    exit(1);
-                }
-                //music_message << "TFO=" << TFO;
-                const double pressure = eos.get_pressure(epsFO, rhob_center);
-                const double eps_plus_p_over_T_FO = (epsFO + pressure)/TFO;
-
-                // finally output results !!!!
-                if (surface_in_binary) {
-                    float array[] = {static_cast<float>(tau_center),
-                                     static_cast<float>(x_center),
-                                     static_cast<float>(y_center),
-                                     static_cast<float>(eta_center),
-                                     static_cast<float>(FULLSU[0]),
-                                     static_cast<float>(FULLSU[1]),
-                                     static_cast<float>(FULLSU[2]),
-                                     static_cast<float>(FULLSU[3]),
-                                     static_cast<float>(utau_center),
-                                     static_cast<float>(ux_center),
-                                     static_cast<float>(uy_center),
-                                     static_cast<float>(ueta_center),
-                                     static_cast<float>(epsFO),
-                                     static_cast<float>(TFO),
-                                     static_cast<float>(muB),
-                                     static_cast<float>(eps_plus_p_over_T_FO),
-                                     static_cast<float>(Wtautau_center),
-                                     static_cast<float>(Wtaux_center),
-                                     static_cast<float>(Wtauy_center),
-                                     static_cast<float>(Wtaueta_center),
-                                     static_cast<float>(Wxx_center),
-                                     static_cast<float>(Wxy_center),
-                                     static_cast<float>(Wxeta_center),
-                                     static_cast<float>(Wyy_center),
-                                     static_cast<float>(Wyeta_center),
-                                     static_cast<float>(Wetaeta_center),
-                                     static_cast<float>(pi_b_center),
-                                     static_cast<float>(rhob_center),
-                                     static_cast<float>(qtau_center),
-                                     static_cast<float>(qx_center),
-                                     static_cast<float>(qy_center),
-                                     static_cast<float>(qeta_center)};
-                    for (int i = 0; i < 32; i++) {
-                        s_file.write((char*) &(array[i]), sizeof(float));
+                    // 4-dimension interpolation done
+                    const double TFO = eos.get_temperature(epsFO, rhob_center);
+                    const double muB = eos.get_mu(epsFO, rhob_center);
+                    if (TFO < 0) {
+                        music_message << "TFO=" << TFO
+                                      << "<0. ERROR. exiting.";
+                        music_message.flush("error");
+                        exit(1);
                     }
-                } else {
-                    s_file << scientific << setprecision(10)
-                           << tau_center << " " << x_center << " "
-                           << y_center << " " << eta_center << " "
-                           << FULLSU[0] << " " << FULLSU[1] << " "
-                           << FULLSU[2] << " " << FULLSU[3] << " "
-                           << utau_center << " " << ux_center << " "
-                           << uy_center << " " << ueta_center << " "
-                           << epsFO << " " << TFO << " " << muB << " "
-                           << eps_plus_p_over_T_FO << " "
-                           << Wtautau_center << " " << Wtaux_center << " "
-                           << Wtauy_center << " " << Wtaueta_center << " "
-                           << Wxx_center << " " << Wxy_center << " "
-                           << Wxeta_center << " "
-                           << Wyy_center << " " << Wyeta_center << " "
-                           << Wetaeta_center << " ";
-                    if (DATA.turn_on_bulk)
-                        s_file << pi_b_center << " ";
-                    if (DATA.turn_on_rhob)
-                        s_file << rhob_center << " ";
-                    if (DATA.turn_on_diff)
-                        s_file << qtau_center << " " << qx_center << " "
-                               << qy_center << " " << qeta_center << " ";
-                    s_file << endl;
+                    //music_message << "TFO=" << TFO;
+                    const double pressure = eos.get_pressure(epsFO, rhob_center);
+                    const double eps_plus_p_over_T_FO = (epsFO + pressure)/TFO;
+
+                    // finally output results
+                    const SurfaceElement cell = {
+                        {tau_center, x_center, y_center, eta_center}, 0., 0.,
+                        {FULLSU[0], FULLSU[1], FULLSU[2], FULLSU[3]},
+                        {utau_center, ux_center, uy_center, ueta_center},
+                        {{Wtautau_center, Wtaux_center, Wtauy_center, Wtaueta_center},
+                         {Wtaux_center, Wxx_center, Wxy_center, Wxeta_center},
+                         {Wtauy_center, Wxy_center, Wyy_center, Wyeta_center},
+                         {Wtaueta_center, Wxeta_center, Wyeta_center, Wetaeta_center}},
+                        {qtau_center, qx_center, qy_center, qeta_center},
+                        pi_b_center, rhob_center,
+                        epsFO, TFO, muB, eps_plus_p_over_T_FO};
+                    surface_sink.add(cell);
                 }
             }
         }
     }
-    s_file.close();
-
-    // clean up
-    for (int i = 0; i < 2; i++) {
-        for (int j = 0; j < 2; j++) {
-            for (int k = 0; k < 2; k++)
-                delete [] cube[i][j][k];
-            delete [] cube[i][j];
-        }
-        delete [] cube[i];
-    }
-    delete [] cube;
     return(intersections);
 }
 
@@ -955,18 +1244,24 @@ int Evolve::FreezeOut_equal_tau_Surface(double tau,
     // this function will be trigged if freezeout_lowtemp_flag == 1
     const int neta = arena_current.nEta();
     const int fac_eta = 1;
+    // the last slice of the global grid is left out
+    const int neta_cells = (domain.owns_last_slice() ? neta - fac_eta : neta);
 
     for (int i_freezesurf = 0; i_freezesurf < n_freeze_surf; i_freezesurf++) {
-        double epsFO = epsFO_list[i_freezesurf]/hbarc;
+        SurfaceSink &surface_sink = *surface_sinks[i_freezesurf];
         if (DATA.boost_invariant == 0) {
-            #pragma omp parallel for
-            for (int ieta = 0; ieta < neta - fac_eta; ieta += fac_eta) {
-                int thread_id = omp_get_thread_num();
+            // the slices are merged in order, whatever thread did them
+            std::vector<std::unique_ptr<SurfaceSink>> slices(neta_cells);
+            #pragma omp parallel for schedule(dynamic)
+            for (int ieta = 0; ieta < neta_cells; ieta += fac_eta) {
+                slices[ieta].reset(new SurfaceSink(DATA, surface_in_memory));
                 FreezeOut_equal_tau_Surface_XY(tau,  ieta, arena_current,
-                                               thread_id, epsFO);
+                                               i_freezesurf, *slices[ieta]);
             }
+            for (auto &slice : slices) surface_sink.append(*slice);
         } else {
-            FreezeOut_equal_tau_Surface_XY(tau, 0, arena_current, 0, epsFO);
+            FreezeOut_equal_tau_Surface_XY(tau, 0, arena_current,
+                                           i_freezesurf, surface_sink);
         }
     }
     return(0);
@@ -975,31 +1270,14 @@ int Evolve::FreezeOut_equal_tau_Surface(double tau,
 
 void Evolve::FreezeOut_equal_tau_Surface_XY(double tau, int ieta,
                                             SCGrid &arena_current,
-                                            int thread_id, double epsFO) {
-    const bool surface_in_binary = DATA.freeze_surface_in_binary;
+                                            int i_freezesurf,
+                                            SurfaceSink &surface_sink) {
+    const double epsFO = epsFO_list[i_freezesurf]/hbarc;
     double epsFO_low = 0.05/hbarc;        // 1/fm^4
 
     const int nx = arena_current.nX();
     const int ny = arena_current.nY();
 
-    stringstream strs_name;
-    if (DATA.boost_invariant == 0) {
-//        strs_name << "surface_eps_" << setprecision(4) << epsFO*hbarc
-//                  << "_" << thread_id << ".dat";
-	strs_name << "surface" << thread_id << ".dat";
-    } else {
-//        strs_name << "surface_eps_" << setprecision(4) << epsFO*hbarc
-//                  << ".dat";
-	strs_name << "surface.dat";
-    }
-    ofstream s_file;
-    if (surface_in_binary) {
-        s_file.open(strs_name.str().c_str(),
-                    ios::out | ios::app | ios::binary);
-    } else {
-        s_file.open(strs_name.str().c_str(), ios::out | ios::app);
-    }
-
     const int fac_x   = DATA.fac_x;
     const int fac_y   = DATA.fac_y;
     const int fac_eta = 1;
@@ -1008,7 +1286,8 @@ void Evolve::FreezeOut_equal_tau_Surface_XY(double tau, int ieta,
     const double DY   = fac_y*DATA.delta_y;
     const double DETA = fac_eta*DATA.delta_eta;
 
-    double eta = (DATA.delta_eta)*ieta - (DATA.eta_size)/2.0;
+    double eta = ((DATA.delta_eta)*(domain.eta_begin() + ieta)
+                  - (DATA.eta_size)/2.0);
     for (int ix = 0; ix < nx - fac_x; ix += fac_x) {
         double x = ix*(DATA.delta_x) - (DATA.x_size/2.0);
         for (int iy = 0; iy < ny - fac_y; iy += fac_y) {
@@ -1110,618 +1389,515 @@ void Evolve::FreezeOut_equal_tau_Surface_XY(double tau, int ieta,
             double eps_plus_p_over_T = (e_local + pressure)/T_local;
 
             // finally output results
-            if (surface_in_binary) {
-                float array[] = {static_cast<float>(tau_center),
-                                 static_cast<float>(x_center),
-                                 static_cast<float>(y_center),
-                                 static_cast<float>(eta_center),
-                                 static_cast<float>(FULLSU[0]),
-                                 static_cast<float>(FULLSU[1]),
-                                 static_cast<float>(FULLSU[2]),
-                                 static_cast<float>(FULLSU[3]),
-                                 static_cast<float>(utau_center),
-                                 static_cast<float>(ux_center),
-                                 static_cast<float>(uy_center),
-                                 static_cast<float>(ueta_center),
-                                 static_cast<float>(e_local),
-                                 static_cast<float>(T_local),
-                                 static_cast<float>(muB_local),
-                                 static_cast<float>(eps_plus_p_over_T),
-                                 static_cast<float>(Wtautau_center),
-                                 static_cast<float>(Wtaux_center),
-                                 static_cast<float>(Wtauy_center),
-                                 static_cast<float>(Wtaueta_center),
-                                 static_cast<float>(Wxx_center),
-                                 static_cast<float>(Wxy_center),
-                                 static_cast<float>(Wxeta_center),
-                                 static_cast<float>(Wyy_center),
-                                 static_cast<float>(Wyeta_center),
-                                 static_cast<float>(Wetaeta_center),
-                                 static_cast<float>(pi_b_center),
-                                 static_cast<float>(rhob_center),
-                                 static_cast<float>(qtau_center),
-                                 static_cast<float>(qx_center),
-                                 static_cast<float>(qy_center),
-                                 static_cast<float>(qeta_center)};
-                for (int i = 0; i < 32; i++) {
-                    s_file.write((char*) &(array[i]), sizeof(float));
-                }
-            } else {
-                s_file << scientific << setprecision(10)
-                       << tau_center     << " " << x_center          << " "
-                       << y_center       << " " << eta_center        << " "
-                       << FULLSU[0]      << " " << FULLSU[1]         << " "
-                       << FULLSU[2]      << " " << FULLSU[3]         << " "
-                       << utau_center    << " " << ux_center         << " "
-                       << uy_center      << " " << ueta_center       << " "
-                       << e_local        << " " << T_local           << " "
-                       << muB_local      << " " << eps_plus_p_over_T << " "
-                       << Wtautau_center << " " << Wtaux_center      << " "
-                       << Wtauy_center   << " " << Wtaueta_center    << " "
-                       << Wxx_center     << " " << Wxy_center        << " "
-                       << Wxeta_center   << " " << Wyy_center        << " "
-                       << Wyeta_center   << " " << Wetaeta_center    << " " ;
-                if (DATA.turn_on_bulk)
-                    s_file << pi_b_center << " " ;
-                if (DATA.turn_on_rhob)
-                    s_file << rhob_center << " " ;
-                if (DATA.turn_on_diff)
-                    s_file << qtau_center << " " << qx_center << " "
-                           << qy_center << " " << qeta_center << " " ;
-                s_file << endl;
-            }
+            const SurfaceElement cell = {
+                {tau_center, x_center, y_center, eta_center}, 0., 0.,
+                {FULLSU[0], FULLSU[1], FULLSU[2], FULLSU[3]},
+                {utau_center, ux_center, uy_center, ueta_center},
+                {{Wtautau_center, Wtaux_center, Wtauy_center, Wtaueta_center},
+                 {Wtaux_center, Wxx_center, Wxy_center, Wxeta_center},
+                 {Wtauy_center, Wxy_center, Wyy_center, Wyeta_center},
+                 {Wtaueta_center, Wxeta_center, Wyeta_center, Wetaeta_center}},
+                {qtau_center, qx_center, qy_center, qeta_center},
+                pi_b_center, rhob_center,
+                e_local, T_local, muB_local, eps_plus_p_over_T};
+            surface_sink.add(cell);
         }
     }
-    s_file.close();
 }
 
 
 int Evolve::FindFreezeOutSurface_boostinvariant_Cornelius(
-                double tau, SCGrid &arena_current, SCGrid &arena_freezeout) {
-    const bool surface_in_binary = DATA.freeze_surface_in_binary;
+                double tau, double DTAU, SCGrid &arena_current,
+                SCGrid &arena_freezeout) {
     // find boost-invariant hyper-surfaces
-    int *all_frozen = new int[n_freeze_surf];
-    for (int i_freezesurf = 0; i_freezesurf < n_freeze_surf; i_freezesurf++) {
-        double epsFO = epsFO_list[i_freezesurf]/hbarc;
-
-        stringstream strs_name;
-//        strs_name << "surface_eps_" << setprecision(4) << epsFO*hbarc
-//                  << ".dat";
-        strs_name << "surface.dat";
+    const int nx    = arena_current.nX();
+    const int fac_x = DATA.fac_x;
+    int intersections = 0;
 
-        ofstream s_file;
-        if (surface_in_binary) {
-            s_file.open(strs_name.str().c_str(),
-                        ios::out | ios::app | ios::binary);
-        } else {
-            s_file.open(strs_name.str().c_str(), ios::out | ios::app);
+    // the rows in x are searched in parallel for all the thresholds and
+    // passed on in order to the sinks of the surface files
+    #pragma omp parallel for ordered schedule(dynamic) reduction(+:intersections)
+    for (int ix = 0; ix < nx - fac_x; ix += fac_x) {
+        std::vector<std::unique_ptr<SurfaceSink>> rows;
+        for (int i_freezesurf = 0; i_freezesurf < n_freeze_surf;
+             i_freezesurf++) {
+            rows.emplace_back(new SurfaceSink(DATA, surface_in_memory));
         }
-
-        const int nx = arena_current.nX();
-        const int ny = arena_current.nY();
-        double FULLSU[4];  // d^3 \sigma_\mu
-
-        int intersect;
-        int intersections = 0;
-
-        facTau    = DATA.facTau;   // step to skip in tau direction
-        int fac_x = DATA.fac_x;
-        int fac_y = DATA.fac_y;
-
-        const double DX   = fac_x*DATA.delta_x;
-        const double DY   = fac_y*DATA.delta_y;
-        const double DETA = 1.0;
-        const double DTAU = facTau*DATA.delta_tau;
-
-        double lattice_spacing[3] = {DTAU, DX, DY};
-        double x_fraction[2][3];
-
-        // initialize Cornelius
-        const int dim = 3;
-        std::shared_ptr<Cornelius> cornelius_ptr(new Cornelius());
-        cornelius_ptr->init(dim, epsFO, lattice_spacing);
-
-        // initialize the hyper-cube for Cornelius
-        double ***cube = new double ** [2];
-        for (int i = 0; i < 2; i++) {
-            cube[i] = new double * [2];
-            for (int j = 0; j < 2; j++) {
-                cube[i][j] = new double[2];
-                for (int k = 0; k < 2; k++)
-                    cube[i][j][k] = 0.0;
-            }
+        intersections += FindFreezeOutSurface_boostinvariant_Cornelius_Y(
+                tau, DTAU, ix, arena_current, arena_freezeout, rows);
+        #pragma omp ordered
+        for (int i_freezesurf = 0; i_freezesurf < n_freeze_surf;
+             i_freezesurf++) {
+            surface_sinks[i_freezesurf]->append(*rows[i_freezesurf]);
         }
+    }
 
-        for (int ix=0; ix < nx - fac_x; ix += fac_x) {
-            double x = ix*(DATA.delta_x) - (DATA.x_size/2.0);
-            for (int iy=0; iy < ny - fac_y; iy += fac_y) {
-                double y = iy*(DATA.delta_y) - (DATA.y_size/2.0);
-
-		if((ix==0 || iy == 0)
-			&& (arena_freezeout(ix,iy,0).epsilon >= epsFO))
-		{
-	            music_message << "Freeze out surface hitting boundary at (x,y) = " << x << ", " << y;
-	            music_message.flush("warning");
-		}
-		if((ix > nx - 2*fac_x || iy > nx - 2*fac_x)
-			&& (arena_freezeout(ix+fac_x,iy+fac_y,0).epsilon >= epsFO))
-		{
-	            music_message << "Freeze out surface hitting boundary at (x,y) = " << x << ", " << y;
-	            music_message.flush("warning");
-		}
-
-                // judge intersection (from Bjoern)
-                intersect=1;
-                if ((arena_current(ix+fac_x,iy+fac_y,0).epsilon-epsFO)
-                    *(arena_freezeout(ix,iy,0).epsilon-epsFO) > 0.)
-                    if ((arena_current(ix+fac_x,iy,0).epsilon-epsFO)
-                        *(arena_freezeout(ix,iy+fac_y,0).epsilon-epsFO) > 0.)
-                        if ((arena_current(ix,iy+fac_y,0).epsilon-epsFO)
-                            *(arena_freezeout(ix+fac_x,iy,0).epsilon-epsFO) > 0.)
-                            if ((arena_current(ix,iy,0).epsilon-epsFO)
-                                *(arena_freezeout(ix+fac_x,iy+fac_y,0).epsilon-epsFO) > 0.)
-                                    intersect = 0;
-                if (intersect == 0) continue;
+    // judge whether the entire fireball is freeze-out
+    int all_frozen_flag = 0;
+    if (intersections == 0) {
+        all_frozen_flag = 1;
+        music_message.info("All cells frozen out. Exiting.");
+    }
+    return(all_frozen_flag);
+}
 
-                // if intersect, prepare for the hyper-cube
-                intersections++;
-                cube[0][0][0] = arena_freezeout(ix      , iy      , 0).epsilon;
-                cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).epsilon;
-                cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).epsilon;
-                cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).epsilon;
-                cube[1][0][0] = arena_current  (ix      , iy      , 0).epsilon;
-                cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).epsilon;
-                cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).epsilon;
-                cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).epsilon;
+//! boost-invariant surface elements in the row of cubes between ix and
+//! ix + fac_x, added to rows[i_freezesurf] for every threshold; returns
+//! the number of intersected cubes
+int Evolve::FindFreezeOutSurface_boostinvariant_Cornelius_Y(
+                double tau, double DTAU, int ix, SCGrid &arena_current,
+                SCGrid &arena_freezeout,
+                std::vector<std::unique_ptr<SurfaceSink>> &rows) {
+    const int nx = arena_current.nX();
+    const int ny = arena_current.nY();
+    double FULLSU[4];  // d^3 \sigma_\mu
 
-                // Now, the magic will happen in the Cornelius ...
-                cornelius_ptr->find_surface_3d(cube);
+    int intersect;
+    int intersections = 0;
 
-                // get positions of the freeze-out surface
-                // and interpolating results
-                for (int isurf = 0; isurf < cornelius_ptr->get_Nelements();
-                     isurf++) {
-                    // surface normal vector d^3 \sigma_\mu
-                    for (int ii = 0; ii < dim; ii++)
-                        FULLSU[ii] = cornelius_ptr->get_normal_elem(isurf, ii);
+    int fac_x = DATA.fac_x;
+    int fac_y = DATA.fac_y;
 
-                    FULLSU[3] = 0.0; // rapidity direction is set to 0
+    const double DX   = fac_x*DATA.delta_x;
+    const double DY   = fac_y*DATA.delta_y;
+    const double DETA = 1.0;
+    double lattice_spacing[3] = {DTAU, DX, DY};
+    double x_fraction[2][3];
 
-                    // check the size of the surface normal vector
-                    if (fabs(FULLSU[0]) > (DX*DY*DETA + 0.01)) {
-                       music_message << "problem: volume in tau direction "
-                                     << fabs(FULLSU[0]) << "  > DX*DY*DETA = "
-                                     << DX*DY*DETA;
-                        music_message.flush("warning");
-                    }
-                    if (fabs(FULLSU[1]) > (DTAU*DY*DETA + 0.01)) {
-                        music_message << "problem: volume in x direction "
-                                      << fabs(FULLSU[1])
-                                      << "  > DTAU*DY*DETA = " << DTAU*DY*DETA;
-                        music_message.flush("warning");
-                    }
-                    if (fabs(FULLSU[2]) > (DX*DTAU*DETA+0.01)) {
-                        music_message << "problem: volume in y direction "
-                                      << fabs(FULLSU[2])
-                                      << "  > DX*DTAU*DETA = " << DX*DTAU*DETA;
-                        music_message.flush("warning");
-                    }
+    // initialize Cornelius
+    const int dim = 3;
+    FreezeOutWorkspace &workspace = (
+                    *freeze_out_workspaces[omp_get_thread_num()]);
+    Cornelius *cornelius_ptr = &workspace.cornelius;
+    double ***cube = workspace.cube();
+
+    double x = ix*(DATA.delta_x) - (DATA.x_size/2.0);
+    for (int iy=0; iy < ny - fac_y; iy += fac_y) {
+        double y = iy*(DATA.delta_y) - (DATA.y_size/2.0);
+
+        for (int i_freezesurf = 0; i_freezesurf < n_freeze_surf;
+             i_freezesurf++) {
+            const double epsFO = epsFO_list[i_freezesurf]/hbarc;
+            if ((ix == 0 || iy == 0)
+                    && (arena_freezeout(ix,iy,0).epsilon >= epsFO)) {
+                music_message << "Freeze out surface hitting boundary at (x,y) = " << x << ", " << y;
+                music_message.flush("warning");
+            }
+            if ((ix > nx - 2*fac_x || iy > nx - 2*fac_x)
+                    && (arena_freezeout(ix+fac_x,iy+fac_y,0).epsilon >= epsFO)) {
+                music_message << "Freeze out surface hitting boundary at (x,y) = " << x << ", " << y;
+                music_message.flush("warning");
+            }
+        }
 
-                    // position of the freeze-out fluid cell
-                    for (int ii = 0; ii < dim; ii++) {
-                        x_fraction[1][ii] = (
-                            cornelius_ptr->get_centroid_elem(isurf, ii));
-                        x_fraction[0][ii] = (
-                            lattice_spacing[ii] - x_fraction[1][ii]);
-                    }
-                    const double tau_center = tau - DTAU + x_fraction[1][0];
-                    const double x_center = x + x_fraction[1][1];
-                    const double y_center = y + x_fraction[1][2];
-                    const double eta_center = 0.0;
-
-                    // perform 3-d linear interpolation for all fluid quantities
-
-                    // flow velocity u^\tau
-                    cube[0][0][0] = arena_freezeout(ix      , iy      , 0).u[0];
-                    cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).u[0];
-                    cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).u[0];
-                    cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).u[0];
-                    cube[1][0][0] = arena_current  (ix      , iy      , 0).u[0];
-                    cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).u[0];
-                    cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).u[0];
-                    cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).u[0];
-                    double utau_center = (
-                        Util::three_dimension_linear_interpolation(
-                                        lattice_spacing, x_fraction, cube));
+        // epsilon at the corners of the cube, loaded once for all the
+        // thresholds
+        cube[0][0][0] = arena_freezeout(ix      , iy      , 0).epsilon;
+        cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).epsilon;
+        cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).epsilon;
+        cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).epsilon;
+        cube[1][0][0] = arena_current  (ix      , iy      , 0).epsilon;
+        cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).epsilon;
+        cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).epsilon;
+        cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).epsilon;
+        double eps_corners[8];
+        std::copy(workspace.corners, workspace.corners + 8, eps_corners);
+        const auto eps_range = std::minmax_element(eps_corners,
+                                                   eps_corners + 8);
+
+        for (int i_freezesurf = 0; i_freezesurf < n_freeze_surf;
+             i_freezesurf++) {
+            const double epsFO = epsFO_list[i_freezesurf]/hbarc;
+            if (epsFO < *eps_range.first || epsFO > *eps_range.second)
+                continue;
+
+            // judge intersection (from Bjoern): the diagonals of the
+            // cube join corner n to corner 7 - n
+            intersect = 0;
+            for (int n = 0; n < 4; n++) {
+                if (!((eps_corners[n] - epsFO)
+                      *(eps_corners[7 - n] - epsFO) > 0.))
+                    intersect = 1;
+            }
+            if (intersect == 0) continue;
+            intersections++;
 
-                    // flow velocity u^x
-                    cube[0][0][0] = arena_freezeout(ix      , iy      , 0).u[1];
-                    cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).u[1];
-                    cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).u[1];
-                    cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).u[1];
-                    cube[1][0][0] = arena_current  (ix      , iy      , 0).u[1];
-                    cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).u[1];
-                    cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).u[1];
-                    cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).u[1];
-                    double ux_center = (
-                        Util::three_dimension_linear_interpolation(
-                                        lattice_spacing, x_fraction, cube));
+            // Now, the magic will happen in the Cornelius ...
+            std::copy(eps_corners, eps_corners + 8, workspace.corners);
+            cornelius_ptr->init(dim, epsFO, lattice_spacing);
+            cornelius_ptr->find_surface_3d(cube);
 
-                    // flow velocity u^y
-                    cube[0][0][0] = arena_freezeout(ix      , iy      , 0).u[2];
-                    cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).u[2];
-                    cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).u[2];
-                    cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).u[2];
-                    cube[1][0][0] = arena_current  (ix      , iy      , 0).u[2];
-                    cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).u[2];
-                    cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).u[2];
-                    cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).u[2];
-                    double uy_center = (
-                        Util::three_dimension_linear_interpolation(
-                                        lattice_spacing, x_fraction, cube));
+            // get positions of the freeze-out surface
+            // and interpolating results
+            for (int isurf = 0; isurf < cornelius_ptr->get_Nelements();
+                 isurf++) {
+                // surface normal vector d^3 \sigma_\mu
+                for (int ii = 0; ii < dim; ii++)
+                    FULLSU[ii] = cornelius_ptr->get_normal_elem(isurf, ii);
 
-                    // flow velocity u^eta
-                    cube[0][0][0] = arena_freezeout(ix      , iy      , 0).u[3];
-                    cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).u[3];
-                    cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).u[3];
-                    cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).u[3];
-                    cube[1][0][0] = arena_current  (ix      , iy      , 0).u[3];
-                    cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).u[3];
-                    cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).u[3];
-                    cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).u[3];
-                    double ueta_center = (
-                        Util::three_dimension_linear_interpolation(
-                                        lattice_spacing, x_fraction, cube));
+                FULLSU[3] = 0.0; // rapidity direction is set to 0
 
-                    // baryon density rho_b
-                    cube[0][0][0] = arena_freezeout(ix      , iy      , 0).rhob;
-                    cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).rhob;
-                    cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).rhob;
-                    cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).rhob;
-                    cube[1][0][0] = arena_current  (ix      , iy      , 0).rhob;
-                    cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).rhob;
-                    cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).rhob;
-                    cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).rhob;
-                    double rhob_center = (
-                        Util::three_dimension_linear_interpolation(
-                                        lattice_spacing, x_fraction, cube));
+                // check the size of the surface normal vector
+                if (fabs(FULLSU[0]) > (DX*DY*DETA + 0.01)) {
+                   music_message << "problem: volume in tau direction "
+                                 << fabs(FULLSU[0]) << "  > DX*DY*DETA = "
+                                 << DX*DY*DETA;
+                    music_message.flush("warning");
+                }
+                if (fabs(FULLSU[1]) > (DTAU*DY*DETA + 0.01)) {
+                    music_message << "problem: volume in x direction "
+                                  << fabs(FULLSU[1])
+                                  << "  > DTAU*DY*DETA = " << DTAU*DY*DETA;
+                    music_message.flush("warning");
+                }
+                if (fabs(FULLSU[2]) > (DX*DTAU*DETA+0.01)) {
+                    music_message << "problem: volume in y direction "
+                                  << fabs(FULLSU[2])
+                                  << "  > DX*DTAU*DETA = " << DX*DTAU*DETA;
+                    music_message.flush("warning");
+                }
 
-                    // bulk viscous pressure pi_b
-                    cube[0][0][0] = arena_freezeout(ix      , iy      , 0).pi_b;
-                    cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).pi_b;
-                    cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).pi_b;
-                    cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).pi_b;
-                    cube[1][0][0] = arena_current  (ix      , iy      , 0).pi_b;
-                    cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).pi_b;
-                    cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).pi_b;
-                    cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).pi_b;
-                    double pi_b_center = (
-                        Util::three_dimension_linear_interpolation(
-                                        lattice_spacing, x_fraction, cube));
-
-                    // baryon diffusion current q^\tau
-                    cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[10];
-                    cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[10];
-                    cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[10];
-                    cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[10];
-                    cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[10];
-                    cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[10];
-                    cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[10];
-                    cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[10];
-                    double qtau_center = (
-                        Util::three_dimension_linear_interpolation(
-                                        lattice_spacing, x_fraction, cube));
+                // position of the freeze-out fluid cell
+                for (int ii = 0; ii < dim; ii++) {
+                    x_fraction[1][ii] = (
+                        cornelius_ptr->get_centroid_elem(isurf, ii));
+                    x_fraction[0][ii] = (
+                        lattice_spacing[ii] - x_fraction[1][ii]);
+                }
+                const double tau_center = tau - DTAU + x_fraction[1][0];
+                const double x_center = x + x_fraction[1][1];
+                const double y_center = y + x_fraction[1][2];
+                const double eta_center = 0.0;
+
+                // perform 3-d linear interpolation for all fluid quantities
+
+                // flow velocity u^\tau
+                cube[0][0][0] = arena_freezeout(ix      , iy      , 0).u[0];
+                cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).u[0];
+                cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).u[0];
+                cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).u[0];
+                cube[1][0][0] = arena_current  (ix      , iy      , 0).u[0];
+                cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).u[0];
+                cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).u[0];
+                cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).u[0];
+                double utau_center = (
+                    Util::three_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube));
 
-                    // baryon diffusion current q^x
-                    cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[11];
-                    cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[11];
-                    cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[11];
-                    cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[11];
-                    cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[11];
-                    cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[11];
-                    cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[11];
-                    cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[11];
-                    double qx_center = (
-                        Util::three_dimension_linear_interpolation(
-                                        lattice_spacing, x_fraction, cube));
+                // flow velocity u^x
+                cube[0][0][0] = arena_freezeout(ix      , iy      , 0).u[1];
+                cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).u[1];
+                cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).u[1];
+                cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).u[1];
+                cube[1][0][0] = arena_current  (ix      , iy      , 0).u[1];
+                cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).u[1];
+                cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).u[1];
+                cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).u[1];
+                double ux_center = (
+                    Util::three_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube));
 
-                    // baryon diffusion current q^y
-                    cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[12];
-                    cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[12];
-                    cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[12];
-                    cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[12];
-                    cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[12];
-                    cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[12];
-                    cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[12];
-                    cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[12];
-                    double qy_center = (
-                        Util::three_dimension_linear_interpolation(
-                                        lattice_spacing, x_fraction, cube));
+                // flow velocity u^y
+                cube[0][0][0] = arena_freezeout(ix      , iy      , 0).u[2];
+                cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).u[2];
+                cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).u[2];
+                cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).u[2];
+                cube[1][0][0] = arena_current  (ix      , iy      , 0).u[2];
+                cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).u[2];
+                cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).u[2];
+                cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).u[2];
+                double uy_center = (
+                    Util::three_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube));
 
-                    // baryon diffusion current q^eta
-                    cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[13];
-                    cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[13];
-                    cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[13];
-                    cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[13];
-                    cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[13];
-                    cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[13];
-                    cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[13];
-                    cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[13];
-                    double qeta_center = (
-                        Util::three_dimension_linear_interpolation(
-                                        lattice_spacing, x_fraction, cube));
+                // flow velocity u^eta
+                cube[0][0][0] = arena_freezeout(ix      , iy      , 0).u[3];
+                cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).u[3];
+                cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).u[3];
+                cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).u[3];
+                cube[1][0][0] = arena_current  (ix      , iy      , 0).u[3];
+                cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).u[3];
+                cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).u[3];
+                cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).u[3];
+                double ueta_center = (
+                    Util::three_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube));
 
-                    // reconstruct q^\tau from the transverality criteria
-                    double u_flow[4] = {utau_center, ux_center, uy_center, ueta_center};
-                    double q_mu[4]   = {qtau_center, qx_center, qy_center, qeta_center};
-                    double q_regulated[4] = {0.0, 0.0, 0.0, 0.0};
-                    regulate_qmu(u_flow, q_mu, q_regulated);
-                    qtau_center = q_regulated[0];
-                    qx_center = q_regulated[1];
-                    qy_center = q_regulated[2];
-                    qeta_center = q_regulated[3];
+                // baryon density rho_b
+                cube[0][0][0] = arena_freezeout(ix      , iy      , 0).rhob;
+                cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).rhob;
+                cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).rhob;
+                cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).rhob;
+                cube[1][0][0] = arena_current  (ix      , iy      , 0).rhob;
+                cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).rhob;
+                cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).rhob;
+                cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).rhob;
+                double rhob_center = (
+                    Util::three_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube));
 
-                    // shear viscous tensor W^\tau\tau
-                    cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[0];
-                    cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[0];
-                    cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[0];
-                    cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[0];
-                    cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[0];
-                    cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[0];
-                    cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[0];
-                    cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[0];
-                    double Wtautau_center = (
-                        Util::three_dimension_linear_interpolation(
-                                        lattice_spacing, x_fraction, cube));
+                // bulk viscous pressure pi_b
+                cube[0][0][0] = arena_freezeout(ix      , iy      , 0).pi_b;
+                cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).pi_b;
+                cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).pi_b;
+                cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).pi_b;
+                cube[1][0][0] = arena_current  (ix      , iy      , 0).pi_b;
+                cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).pi_b;
+                cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).pi_b;
+                cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).pi_b;
+                double pi_b_center = (
+                    Util::three_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube));
+
+                // baryon diffusion current q^\tau
+                cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[10];
+                cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[10];
+                cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[10];
+                cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[10];
+                cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[10];
+                cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[10];
+                cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[10];
+                cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[10];
+                double qtau_center = (
+                    Util::three_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube));
 
-                    // shear viscous tensor W^{\tau x}
-                    cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[1];
-                    cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[1];
-                    cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[1];
-                    cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[1];
-                    cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[1];
-                    cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[1];
-                    cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[1];
-                    cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[1];
-                    double Wtaux_center = (
-                        Util::three_dimension_linear_interpolation(
-                                        lattice_spacing, x_fraction, cube));
+                // baryon diffusion current q^x
+                cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[11];
+                cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[11];
+                cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[11];
+                cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[11];
+                cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[11];
+                cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[11];
+                cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[11];
+                cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[11];
+                double qx_center = (
+                    Util::three_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube));
 
-                    // shear viscous tensor W^{\tau y}
-                    cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[2];
-                    cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[2];
-                    cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[2];
-                    cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[2];
-                    cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[2];
-                    cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[2];
-                    cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[2];
-                    cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[2];
-                    double Wtauy_center = (
-                        Util::three_dimension_linear_interpolation(
-                                        lattice_spacing, x_fraction, cube));
+                // baryon diffusion current q^y
+                cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[12];
+                cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[12];
+                cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[12];
+                cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[12];
+                cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[12];
+                cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[12];
+                cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[12];
+                cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[12];
+                double qy_center = (
+                    Util::three_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube));
 
-                    // shear viscous tensor W^{\tau \eta}
-                    cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[3];
-                    cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[3];
-                    cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[3];
-                    cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[3];
-                    cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[3];
-                    cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[3];
-                    cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[3];
-                    cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[3];
-                    double Wtaueta_center = (
-                        Util::three_dimension_linear_interpolation(
-                                        lattice_spacing, x_fraction, cube));
+                // baryon diffusion current q^eta
+                cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[13];
+                cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[13];
+                cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[13];
+                cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[13];
+                cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[13];
+                cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[13];
+                cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[13];
+                cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[13];
+                double qeta_center = (
+                    Util::three_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube));
 
-                    // shear viscous tensor W^{xx}
-                    cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[4];
-                    cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[4];
-                    cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[4];
-                    cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[4];
-                    cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[4];
-                    cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[4];
-                    cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[4];
-                    cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[4];
-                    double Wxx_center = (
-                        Util::three_dimension_linear_interpolation(
-                                        lattice_spacing, x_fraction, cube));
+                // reconstruct q^\tau from the transverality criteria
+                double u_flow[4] = {utau_center, ux_center, uy_center, ueta_center};
+                double q_mu[4]   = {qtau_center, qx_center, qy_center, qeta_center};
+                double q_regulated[4] = {0.0, 0.0, 0.0, 0.0};
+                regulate_qmu(u_flow, q_mu, q_regulated);
+                qtau_center = q_regulated[0];
+                qx_center = q_regulated[1];
+                qy_center = q_regulated[2];
+                qeta_center = q_regulated[3];
 
-                    // shear viscous tensor W^{xy}
-                    cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[5];
-                    cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[5];
-                    cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[5];
-                    cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[5];
-                    cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[5];
-                    cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[5];
-                    cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[5];
-                    cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[5];
-                    double Wxy_center = (
-                        Util::three_dimension_linear_interpolation(
-                                        lattice_spacing, x_fraction, cube));
-
-                    // shear viscous tensor W^{x \eta}
-                    cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[6];
-                    cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[6];
-                    cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[6];
-                    cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[6];
-                    cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[6];
-                    cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[6];
-                    cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[6];
-                    cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[6];
-                    double Wxeta_center = (
-                        Util::three_dimension_linear_interpolation(
-                                        lattice_spacing, x_fraction, cube));
+                // shear viscous tensor W^\tau\tau
+                cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[0];
+                cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[0];
+                cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[0];
+                cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[0];
+                cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[0];
+                cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[0];
+                cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[0];
+                cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[0];
+                double Wtautau_center = (
+                    Util::three_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube));
 
-                    // shear viscous tensor W^{yy}
-                    cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[7];
-                    cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[7];
-                    cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[7];
-                    cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[7];
-                    cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[7];
-                    cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[7];
-                    cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[7];
-                    cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[7];
-                    double Wyy_center = (
-                        Util::three_dimension_linear_interpolation(
-                                        lattice_spacing, x_fraction, cube));
-
-                    // shear viscous tensor W^{yeta}
-                    cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[8];
-                    cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[8];
-                    cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[8];
-                    cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[8];
-                    cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[8];
-                    cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[8];
-                    cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[8];
-                    cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[8];
-                    double Wyeta_center = (
-                        Util::three_dimension_linear_interpolation(
-                                        lattice_spacing, x_fraction, cube));
+                // shear viscous tensor W^{\tau x}
+                cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[1];
+                cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[1];
+                cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[1];
+                cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[1];
+                cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[1];
+                cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[1];
+                cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[1];
+                cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[1];
+                double Wtaux_center = (
+                    Util::three_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube));
 
-                    // shear viscous tensor W^{\eta\eta}
-                    cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[9];
-                    cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[9];
-                    cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[9];
-                    cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[9];
-                    cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[9];
-                    cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[9];
-                    cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[9];
-                    cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[9];
-                    double Wetaeta_center = (
-                        Util::three_dimension_linear_interpolation(
-                                        lattice_spacing, x_fraction, cube));
+                // shear viscous tensor W^{\tau y}
+                cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[2];
+                cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[2];
+                cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[2];
+                cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[2];
+                cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[2];
+                cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[2];
+                cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[2];
+                cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[2];
+                double Wtauy_center = (
+                    Util::three_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube));
 
-                    // regulate Wmunu according to transversality and traceless
-                    double Wmunu_input[4][4];
-                    double Wmunu_regulated[4][4];
-                    Wmunu_input[0][0] = Wtautau_center;
-                    Wmunu_input[0][1] = Wmunu_input[1][0] = Wtaux_center;
-                    Wmunu_input[0][2] = Wmunu_input[2][0] = Wtauy_center;
-                    Wmunu_input[0][3] = Wmunu_input[3][0] = Wtaueta_center;
-                    Wmunu_input[1][1] = Wxx_center;
-                    Wmunu_input[1][2] = Wmunu_input[2][1] = Wxy_center;
-                    Wmunu_input[1][3] = Wmunu_input[3][1] = Wxeta_center;
-                    Wmunu_input[2][2] = Wyy_center;
-                    Wmunu_input[2][3] = Wmunu_input[3][2] = Wyeta_center;
-                    Wmunu_input[3][3] = Wetaeta_center;
-                    regulate_Wmunu(u_flow, Wmunu_input, Wmunu_regulated);
-                    Wtautau_center = Wmunu_regulated[0][0];
-                    Wtaux_center   = Wmunu_regulated[0][1];
-                    Wtauy_center   = Wmunu_regulated[0][2];
-                    Wtaueta_center = Wmunu_regulated[0][3];
-                    Wxx_center     = Wmunu_regulated[1][1];
-                    Wxy_center     = Wmunu_regulated[1][2];
-                    Wxeta_center   = Wmunu_regulated[1][3];
-                    Wyy_center     = Wmunu_regulated[2][2];
-                    Wyeta_center   = Wmunu_regulated[2][3];
-                    Wetaeta_center = Wmunu_regulated[3][3];
+                // shear viscous tensor W^{\tau \eta}
+                cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[3];
+                cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[3];
+                cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[3];
+                cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[3];
+                cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[3];
+                cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[3];
+                cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[3];
+                cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[3];
+                double Wtaueta_center = (
+                    Util::three_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube));
 
-                    // 3-dimension interpolation done
-                    double TFO = eos.get_temperature(epsFO, rhob_center);
-                    double muB = eos.get_mu(epsFO, rhob_center);
-                    if (TFO < 0) {
-                        music_message << "TFO=" << TFO
-                                      << "<0. ERROR. exiting.";
-                        music_message.flush("error");
-                        exit(1);
-                    }
-                    //music_message << "TFO=" << TFO;
+                // shear viscous tensor W^{xx}
+                cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[4];
+                cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[4];
+                cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[4];
+                cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[4];
+                cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[4];
+                cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[4];
+                cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[4];
+                cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[4];
+                double Wxx_center = (
+                    Util::three_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube));
 
-                    double pressure = eos.get_pressure(epsFO, rhob_center);
-                    double eps_plus_p_over_T_FO = (epsFO + pressure)/TFO;
-
-                    // finally output results !!!!
-                    if (surface_in_binary) {
-                        float array[] = {static_cast<float>(tau_center),
-                                         static_cast<float>(x_center),
-                                         static_cast<float>(y_center),
-                                         static_cast<float>(eta_center),
-                                         static_cast<float>(FULLSU[0]),
-                                         static_cast<float>(FULLSU[1]),
-                                         static_cast<float>(FULLSU[2]),
-                                         static_cast<float>(FULLSU[3]),
-                                         static_cast<float>(utau_center),
-                                         static_cast<float>(ux_center),
-                                         static_cast<float>(uy_center),
-                                         static_cast<float>(ueta_center),
-                                         static_cast<float>(epsFO),
-                                         static_cast<float>(TFO),
-                                         static_cast<float>(muB),
-                                         static_cast<float>(eps_plus_p_over_T_FO),
-                                         static_cast<float>(Wtautau_center),
-                                         static_cast<float>(Wtaux_center),
-                                         static_cast<float>(Wtauy_center),
-                                         static_cast<float>(Wtaueta_center),
-                                         static_cast<float>(Wxx_center),
-                                         static_cast<float>(Wxy_center),
-                                         static_cast<float>(Wxeta_center),
-                                         static_cast<float>(Wyy_center),
-                                         static_cast<float>(Wyeta_center),
-                                         static_cast<float>(Wetaeta_center),
-                                         static_cast<float>(pi_b_center),
-                                         static_cast<float>(rhob_center),
-                                         static_cast<float>(qtau_center),
-                                         static_cast<float>(qx_center),
-                                         static_cast<float>(qy_center),
-                                         static_cast<float>(qeta_center)};
-                        for (int i = 0; i < 32; i++) {
-                            s_file.write((char*) &(array[i]), sizeof(float));
-                        }
-                    } else {
-                        s_file << scientific << setprecision(10)
-                               << tau_center << " " << x_center << " "
-                               << y_center << " " << eta_center << " "
-                               << FULLSU[0] << " " << FULLSU[1] << " "
-                               << FULLSU[2] << " " << FULLSU[3] << " "
-                               << utau_center << " " << ux_center << " "
-                               << uy_center << " " << ueta_center << " "
-                               << epsFO << " " << TFO << " " << muB << " "
-                               << eps_plus_p_over_T_FO << " "
-                               << Wtautau_center << " " << Wtaux_center << " "
-                               << Wtauy_center << " " << Wtaueta_center << " "
-                               << Wxx_center << " " << Wxy_center << " "
-                               << Wxeta_center << " "
-                               << Wyy_center << " " << Wyeta_center << " "
-                               << Wetaeta_center << " " ;
-                        if(DATA.turn_on_bulk)   // 27th column
-                            s_file << pi_b_center << " " ;
-                        if(DATA.turn_on_rhob)   // 28th column
-                            s_file << rhob_center << " " ;
-                        if(DATA.turn_on_diff)   // 29-32th column
-                            s_file << qtau_center << " " << qx_center << " "
-                                   << qy_center << " " << qeta_center << " " ;
-                        s_file << endl;
-                    }
-                }
-            }
-        }
+                // shear viscous tensor W^{xy}
+                cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[5];
+                cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[5];
+                cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[5];
+                cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[5];
+                cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[5];
+                cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[5];
+                cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[5];
+                cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[5];
+                double Wxy_center = (
+                    Util::three_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube));
+
+                // shear viscous tensor W^{x \eta}
+                cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[6];
+                cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[6];
+                cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[6];
+                cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[6];
+                cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[6];
+                cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[6];
+                cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[6];
+                cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[6];
+                double Wxeta_center = (
+                    Util::three_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube));
 
-        s_file.close();
+                // shear viscous tensor W^{yy}
+                cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[7];
+                cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[7];
+                cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[7];
+                cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[7];
+                cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[7];
+                cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[7];
+                cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[7];
+                cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[7];
+                double Wyy_center = (
+                    Util::three_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube));
+
+                // shear viscous tensor W^{yeta}
+                cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[8];
+                cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[8];
+                cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[8];
+                cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[8];
+                cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[8];
+                cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[8];
+                cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[8];
+                cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[8];
+                double Wyeta_center = (
+                    Util::three_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube));
 
-        // clean up
-        for (int i = 0; i < 2; i++) {
-            for (int j = 0; j < 2; j++)
-                delete [] cube[i][j];
-            delete [] cube[i];
-        }
-        delete [] cube;
+                // shear viscous tensor W^{\eta\eta}
+                cube[0][0][0] = arena_freezeout(ix      , iy      , 0).Wmunu[9];
+                cube[0][0][1] = arena_freezeout(ix      , iy+fac_y, 0).Wmunu[9];
+                cube[0][1][0] = arena_freezeout(ix+fac_x, iy      , 0).Wmunu[9];
+                cube[0][1][1] = arena_freezeout(ix+fac_x, iy+fac_y, 0).Wmunu[9];
+                cube[1][0][0] = arena_current  (ix      , iy      , 0).Wmunu[9];
+                cube[1][0][1] = arena_current  (ix      , iy+fac_y, 0).Wmunu[9];
+                cube[1][1][0] = arena_current  (ix+fac_x, iy      , 0).Wmunu[9];
+                cube[1][1][1] = arena_current  (ix+fac_x, iy+fac_y, 0).Wmunu[9];
+                double Wetaeta_center = (
+                    Util::three_dimension_linear_interpolation(
+                                    lattice_spacing, x_fraction, cube));
 
-        // judge whether the entire fireball is freeze-out
-        all_frozen[i_freezesurf] = 0;
-        if (intersections == 0)
-            all_frozen[i_freezesurf] = 1;
-    }
+                // regulate Wmunu according to transversality and traceless
+                double Wmunu_input[4][4];
+                double Wmunu_regulated[4][4];
+                Wmunu_input[0][0] = Wtautau_center;
+                Wmunu_input[0][1] = Wmunu_input[1][0] = Wtaux_center;
+                Wmunu_input[0][2] = Wmunu_input[2][0] = Wtauy_center;
+                Wmunu_input[0][3] = Wmunu_input[3][0] = Wtaueta_center;
+                Wmunu_input[1][1] = Wxx_center;
+                Wmunu_input[1][2] = Wmunu_input[2][1] = Wxy_center;
+                Wmunu_input[1][3] = Wmunu_input[3][1] = Wxeta_center;
+                Wmunu_input[2][2] = Wyy_center;
+                Wmunu_input[2][3] = Wmunu_input[3][2] = Wyeta_center;
+                Wmunu_input[3][3] = Wetaeta_center;
+                regulate_Wmunu(u_flow, Wmunu_input, Wmunu_regulated);
+                Wtautau_center = Wmunu_regulated[0][0];
+                Wtaux_center   = Wmunu_regulated[0][1];
+                Wtauy_center   = Wmunu_regulated[0][2];
+                Wtaueta_center = Wmunu_regulated[0][3];
+                Wxx_center     = Wmunu_regulated[1][1];
+                Wxy_center     = Wmunu_regulated[1][2];
+                Wxeta_center   = Wmunu_regulated[1][3];
+                Wyy_center     = Wmunu_regulated[2][2];
+                Wyeta_center   = Wmunu_regulated[2][3];
+                Wetaeta_center = Wmunu_regulated[3][3];
 
-    int all_frozen_flag = 1;
-    for (int ii = 0; ii < n_freeze_surf; ii++) {
-        all_frozen_flag *= all_frozen[ii];
-    }
-    if (all_frozen_flag == 1) {
-        music_message.info("All cells frozen out. Exiting.");
+                // 3-dimension interpolation done
+                double TFO = eos.get_temperature(epsFO, rhob_center);
+                double muB = eos.get_mu(epsFO, rhob_center);
+                if (TFO < 0) {
+                    music_message << "TFO=" << TFO
+                                  << "<0. ERROR. exiting.";
+                    music_message.flush("error");
+                    exit(1);
+                }
+                //music_message << "TFO=" << TFO;
+
+                double pressure = eos.get_pressure(epsFO, rhob_center);
+                double eps_plus_p_over_T_FO = (epsFO + pressure)/TFO;
+
+                // finally output results
+                const SurfaceElement cell = {
+                    {tau_center, x_center, y_center, eta_center}, 0., 0.,
+                    {FULLSU[0], FULLSU[1], FULLSU[2], FULLSU[3]},
+                    {utau_center, ux_center, uy_center, ueta_center},
+                    {{Wtautau_center, Wtaux_center, Wtauy_center, Wtaueta_center},
+                     {Wtaux_center, Wxx_center, Wxy_center, Wxeta_center},
+                     {Wtauy_center, Wxy_center, Wyy_center, Wyeta_center},
+                     {Wtaueta_center, Wxeta_center, Wyeta_center, Wetaeta_center}},
+                    {qtau_center, qx_center, qy_center, qeta_center},
+                    pi_b_center, rhob_center,
+                    epsFO, TFO, muB, eps_plus_p_over_T_FO};
+                rows[i_freezesurf]->add(cell);
+            }
+        }
     }
 
-    delete [] all_frozen;
-    return(all_frozen_flag);
+    return(intersections);
 }
 
 void Evolve::regulate_qmu(const double u[], const double q[],
@@ -1763,56 +1939,16 @@ void Evolve::regulate_Wmunu(const double u[], const double Wmunu[4][4],
 }
 
 void Evolve::initialize_freezeout_surface_info() {
-    int freeze_eps_flag = DATA.freeze_eps_flag;
-    if (freeze_eps_flag == 0) {
-        // constant spacing the energy density
-        n_freeze_surf = DATA.N_freeze_out;
-        double freeze_max_ed = DATA.eps_freeze_max;
-        double freeze_min_ed = DATA.eps_freeze_min;
-        double d_epsFO = ((freeze_max_ed - freeze_min_ed)
-                          /(n_freeze_surf - 1 + 1e-15));
-        for(int isurf = 0; isurf < n_freeze_surf; isurf++)
-        {
-            double temp_epsFO = freeze_min_ed + isurf*d_epsFO;
-            epsFO_list.push_back(temp_epsFO);
-        }
-    } else if(freeze_eps_flag == 1) {
-        // read in from a file
-        string eps_freeze_list_filename = DATA.freeze_list_filename;
+    if (DATA.freeze_eps_flag == 1) {
         music_message << "read in freeze out surface information from "
-                      << eps_freeze_list_filename;
+                      << DATA.freeze_list_filename;
         music_message.flush("info");
-        ifstream freeze_list_file(eps_freeze_list_filename.c_str());
-        if (!freeze_list_file) {
-            music_message << "Evolve::initialize_freezeout_surface_info: "
-                          << "can not open freeze-out list file: "
-                          << eps_freeze_list_filename;
-            music_message.flush("error");
-            exit(1);
-        }
-        int temp_n_surf = 0;
-        string dummy;
-        double temp_epsFO, dummyd;
-        getline(freeze_list_file, dummy);  // get rid of the comment
-        while(1) {
-            freeze_list_file >> temp_epsFO >> dummyd >> dummyd
-                             >> dummyd >> dummyd >> dummyd >> dummyd;
-            if (!freeze_list_file.eof()) {
-                epsFO_list.push_back(temp_epsFO);
-                temp_n_surf++;
-            } else {
-                break;
-            }
-        }
-        freeze_list_file.close();
-        n_freeze_surf = temp_n_surf;
+    }
+    epsFO_list = freeze_out_thresholds(DATA);
+    n_freeze_surf = epsFO_list.size();
+    if (DATA.freeze_eps_flag == 1) {
         music_message << "totally " << n_freeze_surf
                       << " freeze-out surface will be generated ...";
         music_message.flush("info");
-    } else {
-        music_message << "Evolve::initialize_freezeout_surface_info: "
-                      << "unrecoginze freeze_eps_flag = " << freeze_eps_flag;
-        music_message.flush("error");
-        exit(1);
     }
 }
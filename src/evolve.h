@@ -3,6 +3,7 @@
 #define SRC_EVOLVE_H_
 
 #include <memory>
+#include <string>
 #include <time.h>
 #include <vector>
 #include <iostream>
@@ -14,18 +15,44 @@
 #include "cell.h"
 #include "grid.h"
 #include "grid_info.h"
+#include "grid_tiles.h"
+#include "domain.h"
 #include "eos.h"
 #include "advance.h"
 #include "hydro_source.h"
 #include "u_derivative.h"
+#include "surface_element.h"
+#include "cornelius.h"
 #include "pretty_ostream.h"
 
+//! Cornelius and the corners of one cube for the freeze-out search of one
+//! thread. The 16 corner values lie in a single array behind the nested
+//! pointers that Cornelius and Util take.
+struct FreezeOutWorkspace {
+    Cornelius cornelius;
+    double corners[16];
+    double *lines[8];
+    double **squares[4];
+    double ***cubes[2];
+
+    FreezeOutWorkspace();
+    //! cube[i][j][k][l] at the corners in (tau, x, y, eta)
+    double ****hypercube() {return cubes;}
+    //! cube[i][j][k] at the corners in (tau, x, y)
+    double ***cube() {return squares;}
+};
+
 // this is a control class for the hydrodynamic evolution
 class Evolve {
  private:
     const EOS &eos;        // declare EOS object
     const InitData &DATA;
     hydro_source &hydro_source_terms;
+    const Domain &domain;
+
+    //! copy of DATA handed to Advance, whose delta_tau and
+    //! delta_tau_backward follow the adaptive time step
+    InitData step_data;
 
     Cell_info grid_info;
     Advance advance;
@@ -38,33 +65,72 @@ class Evolve {
 
     int facTau;
 
+    //! epsilon [1/fm^4] that keeps a tile active, 0 if every tile is
+    //! evolved (see ActiveTiles)
+    double active_e_threshold;
+
     // information about freeze-out surface
     // (only used when freezeout_method == 4)
     int n_freeze_surf;
     std::vector<double> epsFO_list;
 
+    //! the whole grid gathered on the root rank for the outputs
+    SCGrid arena_whole;
+
+    //! the freeze-out surface is kept in memory for the Cooper-Frye of
+    //! the same run
+    bool surface_in_memory = false;
+    //! where the surface elements of every threshold go
+    std::vector<std::unique_ptr<SurfaceSink>> surface_sinks;
+    //! narrow band of the 3+1D freeze-out search (freeze_out_band_margin
+    //! > 0): the cubes the surface crossed at the last freeze-out step and
+    //! the cubes searched at the next one, see freeze_out_cube_index
+    std::vector<char> freeze_out_hits;
+    std::vector<char> freeze_out_band;
+    bool freeze_out_band_empty = true;
+    int freeze_out_steps_since_sweep = 0;
+    int n_cubes_x = 0;
+    int n_cubes_y = 0;
+
+    //! Cornelius and hypercube of every thread, kept between the steps
+    std::vector<std::unique_ptr<FreezeOutWorkspace>> freeze_out_workspaces;
+
     typedef std::unique_ptr<SCGrid, void(*)(SCGrid*)> GridPointer;
 
  public:
     Evolve(const EOS &eos, const InitData &DATA_in,
-           hydro_source &hydro_source_in);
+           hydro_source &hydro_source_in, const Domain &domain_in);
     int EvolveIt(SCGrid &arena_prev, SCGrid &arena_current, SCGrid &arena_future);
 
-    void AdvanceRK(double tau, GridPointer &arena_prev, GridPointer &arena_current, GridPointer &arena_future);
+    void AdvanceRK(double tau, GridPointer &arena_prev, GridPointer &arena_current, GridPointer &arena_future,
+                   const ActiveTiles &active_tiles);
 
     int FreezeOut_equal_tau_Surface(double tau, SCGrid &arena_current);
     void FreezeOut_equal_tau_Surface_XY(double tau,
                                         int ieta, SCGrid &arena_current,
-                                        int thread_id, double epsFO);
-    int FindFreezeOutSurface_Cornelius(double tau,
+                                        int i_freezesurf,
+                                        SurfaceSink &surface_sink);
+    //! DTAU is the time between arena_freezeout and arena_current; every
+    //! cube is visited once for all the thresholds in epsFO_list
+    int FindFreezeOutSurface_Cornelius(double tau, double DTAU,
                                        SCGrid &arena_current,
                                        SCGrid &arena_freezeout);
-    int FindFreezeOutSurface_Cornelius_XY(double tau, int ieta,
-                                          SCGrid &arena_current,
-                                          SCGrid &arena_freezeout,
-                                          int thread_id, double epsFO);
+    int FindFreezeOutSurface_Cornelius_XY(
+                double tau, double DTAU, int ieta, int ix_begin, int ix_end,
+                SCGrid &arena_current, SCGrid &arena_freezeout,
+                bool band_sweep,
+                std::vector<std::unique_ptr<SurfaceSink>> &sinks);
+    void update_freeze_out_band(int neta_cubes);
+    int freeze_out_cube_index(int ix, int iy, int ieta) const {
+        return((ieta*n_cubes_x + ix/DATA.fac_x)*n_cubes_y + iy/DATA.fac_y);
+    }
     int FindFreezeOutSurface_boostinvariant_Cornelius(
-                double tau, SCGrid &arena_current, SCGrid &arena_freezeout);
+                double tau, double DTAU, SCGrid &arena_current,
+                SCGrid &arena_freezeout);
+    int FindFreezeOutSurface_boostinvariant_Cornelius_Y(
+                double tau, double DTAU, int ix, SCGrid &arena_current,
+                SCGrid &arena_freezeout,
+                std::vector<std::unique_ptr<SurfaceSink>> &rows);
 
     void store_previous_step_for_freezeout(SCGrid &arena_current,
                                            SCGrid &arena_freezeout);
@@ -72,6 +138,19 @@ class Evolve {
     void regulate_Wmunu(const double u[], const double Wmunu[4][4], double Wmunu_regulated[4][4]) const;
 
     void initialize_freezeout_surface_info();
+    void initialize_active_region();
+    double next_time_step(double dtau) const;
+    SCGrid* whole_grid(SCGrid &arena);
+    std::string surface_file_name(int i_freezesurf, int file_id) const {
+        return(::surface_file_name(DATA, epsFO_list, i_freezesurf, file_id));
+    }
+
+    //! keeps the freeze-out surface in memory besides (or instead of, see
+    //! freeze_surface_to_file) writing it, single rank runs only
+    void keep_surface_in_memory();
+    //! the surface kept in memory of the threshold that Cooper-Frye uses
+    //! (freeze_surface_index_for_spectra), in the order of its file
+    std::vector<SurfaceElement> take_surface();
 };
 
 #endif  // SRC_EVOLVE_H_
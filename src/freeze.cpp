@@ -478,162 +478,127 @@ void Freeze::ReadParticleData(InitData *DATA, EOS *eos) {
 
 
 void Freeze::ReadFreezeOutSurface(InitData *DATA) {
-    music_message.info("reading freeze-out surface");
-
-    ostringstream surfdat_stream;
-    surfdat_stream << "./surface.dat";
-
-    // new counting, mac compatible ...
-    if (surface_in_binary) {
-        NCells = get_number_of_lines_of_binary_surface_file(
-                                                    surfdat_stream.str());
-    } else {
-        NCells = get_number_of_lines_of_text_surface_file(
-                                                    surfdat_stream.str());
+    if (surface_in_memory) {
+        music_message << "using the freeze-out surface of the hydro run, "
+                      << "NCells = " << NCells;
+        music_message.flush("info");
+        return;
     }
-    music_message << "NCells = " << NCells;
+    // with several thresholds, the one chosen by
+    // freeze_surface_index_for_spectra
+    const std::vector<double> epsFO_list = freeze_out_thresholds(*DATA);
+    const int i_freezesurf = DATA->freeze_surface_index_for_spectra;
+    if (i_freezesurf >= static_cast<int>(epsFO_list.size())) {
+        music_message << "freeze_surface_index_for_spectra = "
+                      << i_freezesurf << " but there are only "
+                      << epsFO_list.size() << " freeze-out thresholds.";
+        music_message.flush("error");
+        exit(1);
+    }
+    ostringstream surfdat_stream;
+    surfdat_stream << surface_file_name(*DATA, epsFO_list, i_freezesurf);
+    music_message << "reading freeze-out surface " << surfdat_stream.str();
     music_message.flush("info");
 
-    ifstream surfdat;
+    surface.clear();
     if (surface_in_binary) {
-        surfdat.open(surfdat_stream.str().c_str(), std::ios::binary);
-    } else {
-        surfdat.open(surfdat_stream.str().c_str());
-    }
-    // Now allocate memory: array of surfaceElements with length NCells
-    //surface = (SurfaceElement *) malloc((NCells)*sizeof(SurfaceElement));
-    int i = 0;
-    while (i < NCells) {
-        SurfaceElement temp_cell;
-        if (surface_in_binary) {
-            float array[32];
-            for (int ii = 0; ii < 32; ii++) {
-                float temp = 0.;
-                surfdat.read((char*)&temp, sizeof(float));
-                array[ii] = temp;
-            }
-            temp_cell.x[0] = array[0];
-            temp_cell.x[1] = array[1];
-            temp_cell.x[2] = array[2];
-            temp_cell.x[3] = array[3];
+        surface = read_binary_surface_file(surfdat_stream.str());
+        for (auto &cell : surface) {
             if (boost_invariant) {
-                temp_cell.x[3] = 0.0;
+                cell.x[3] = 0.0;
             }
+            complete_surface_element(cell);
+        }
+        NCells = surface.size();
+        music_message << "NCells = " << NCells;
+        music_message.flush("info");
+        return;
+    }
 
-            temp_cell.s[0] = array[4];
-            temp_cell.s[1] = array[5];
-            temp_cell.s[2] = array[6];
-            temp_cell.s[3] = array[7];
-
-            temp_cell.u[0] = array[8];
-            temp_cell.u[1] = array[9];
-            temp_cell.u[2] = array[10];
-            temp_cell.u[3] = array[11];
-
-            temp_cell.epsilon_f            = array[12];
-            temp_cell.T_f                  = array[13];
-            temp_cell.mu_B                 = array[14];
-            temp_cell.eps_plus_p_over_T_FO = array[15];
-
-            temp_cell.W[0][0] = array[16];
-            temp_cell.W[0][1] = array[17];
-            temp_cell.W[0][2] = array[18];
-            temp_cell.W[0][3] = array[19];
-            temp_cell.W[1][1] = array[20];
-            temp_cell.W[1][2] = array[21];
-            temp_cell.W[1][3] = array[22];
-            temp_cell.W[2][2] = array[23];
-            temp_cell.W[2][3] = array[24];
-            temp_cell.W[3][3] = array[25];
-
-            temp_cell.pi_b  = array[26];
-            temp_cell.rho_B = array[27];
-
-            temp_cell.q[0] = array[28];
-            temp_cell.q[1] = array[29];
-            temp_cell.q[2] = array[30];
-            temp_cell.q[3] = array[31];
+    ifstream surfdat(surfdat_stream.str().c_str());
+    if (!surfdat) {
+        music_message << "Can not open the surface file "
+                      << surfdat_stream.str();
+        music_message.flush("error");
+        exit(1);
+    }
+    // the file is read in a single pass, up to the first incomplete element
+    while (surfdat) {
+        SurfaceElement temp_cell;
+        // position in (tau, x, y, eta)
+        surfdat >> temp_cell.x[0] >> temp_cell.x[1]
+                >> temp_cell.x[2] >> temp_cell.x[3];
+
+        // hypersurface vector in (tau, x, y, eta)
+        surfdat >> temp_cell.s[0] >> temp_cell.s[1]
+                >> temp_cell.s[2] >> temp_cell.s[3];
+
+        // flow velocity in (tau, x, y, eta)
+        surfdat >> temp_cell.u[0] >> temp_cell.u[1]
+                >> temp_cell.u[2] >> temp_cell.u[3];
+
+        surfdat >> temp_cell.epsilon_f >> temp_cell.T_f
+                >> temp_cell.mu_B >> temp_cell.eps_plus_p_over_T_FO;
+
+        // freeze-out Wmunu
+        surfdat >> temp_cell.W[0][0] >> temp_cell.W[0][1]
+                >> temp_cell.W[0][2] >> temp_cell.W[0][3]
+                >> temp_cell.W[1][1] >> temp_cell.W[1][2]
+                >> temp_cell.W[1][3] >> temp_cell.W[2][2]
+                >> temp_cell.W[2][3] >> temp_cell.W[3][3];
+        if (DATA->turn_on_bulk) {
+            surfdat >> temp_cell.pi_b;
         } else {
-            // position in (tau, x, y, eta)
-            surfdat >> temp_cell.x[0] >> temp_cell.x[1]
-                    >> temp_cell.x[2] >> temp_cell.x[3];
-
-            // hypersurface vector in (tau, x, y, eta)
-            surfdat >> temp_cell.s[0] >> temp_cell.s[1]
-                    >> temp_cell.s[2] >> temp_cell.s[3];
-
-            // flow velocity in (tau, x, y, eta)
-            surfdat >> temp_cell.u[0] >> temp_cell.u[1]
-                    >> temp_cell.u[2] >> temp_cell.u[3];
-
-            surfdat >> temp_cell.epsilon_f >> temp_cell.T_f
-                    >> temp_cell.mu_B >> temp_cell.eps_plus_p_over_T_FO;
-
-            // freeze-out Wmunu
-            surfdat >> temp_cell.W[0][0] >> temp_cell.W[0][1]
-                    >> temp_cell.W[0][2] >> temp_cell.W[0][3]
-                    >> temp_cell.W[1][1] >> temp_cell.W[1][2]
-                    >> temp_cell.W[1][3] >> temp_cell.W[2][2]
-                    >> temp_cell.W[2][3] >> temp_cell.W[3][3];
-            if (DATA->turn_on_bulk) {
-                surfdat >> temp_cell.pi_b;
-            } else {
-                temp_cell.pi_b = 0.;
-            }
-            if (DATA->turn_on_rhob) {
-                surfdat >> temp_cell.rho_B;
-            } else {
-                temp_cell.rho_B = 0.;
-            }
-            if (DATA->turn_on_diff) {
-                surfdat >> temp_cell.q[0] >> temp_cell.q[1]
-                        >> temp_cell.q[2] >> temp_cell.q[3];
-            } else {
-                temp_cell.q[0] = 0.;
-                temp_cell.q[1] = 0.;
-                temp_cell.q[2] = 0.;
-                temp_cell.q[3] = 0.;
-            }
+            temp_cell.pi_b = 0.;
         }
-        temp_cell.sinh_eta_s = sinh(temp_cell.x[3]);
-        temp_cell.cosh_eta_s = cosh(temp_cell.x[3]);
-
-        if (temp_cell.epsilon_f < 0)  {
-            music_message.error("epsilon_f < 0.!");
-            exit(1);
+        if (DATA->turn_on_rhob) {
+            surfdat >> temp_cell.rho_B;
+        } else {
+            temp_cell.rho_B = 0.;
         }
-        if (temp_cell.T_f < 0) {
-            music_message.error("T_f < 0.!");
-            exit(1);
+        if (DATA->turn_on_diff) {
+            surfdat >> temp_cell.q[0] >> temp_cell.q[1]
+                    >> temp_cell.q[2] >> temp_cell.q[3];
+        } else {
+            temp_cell.q[0] = 0.;
+            temp_cell.q[1] = 0.;
+            temp_cell.q[2] = 0.;
+            temp_cell.q[3] = 0.;
         }
+        if (!surfdat) break;
+        complete_surface_element(temp_cell);
         surface.push_back(temp_cell);
-        i++;
     }
     surfdat.close();
+    NCells = surface.size();
+    music_message << "NCells = " << NCells;
+    music_message.flush("info");
 }
 
 
-int Freeze::get_number_of_lines_of_binary_surface_file(string filename) {
-    std::ifstream surface_file(filename.c_str(), std::ios::binary);
-    int count = 0;
-    float temp = 0.;
-    while(surface_file) {
-        surface_file.read((char*) &temp, sizeof(float));
-        count++;
+void Freeze::set_freeze_out_surface(std::vector<SurfaceElement> &&surface_in) {
+    surface = std::move(surface_in);
+    for (auto &cell : surface) {
+        if (boost_invariant) {
+            cell.x[3] = 0.0;
+        }
+        complete_surface_element(cell);
     }
-    int counted_line = count/32;
-    surface_file.close();
-    return(counted_line);
+    NCells = surface.size();
+    surface_in_memory = true;
 }
 
 
-int Freeze::get_number_of_lines_of_text_surface_file(string filename) {
-    std::ifstream surface_file(filename.c_str(), std::ios::binary);
-    int counted_lines = 0;
-    std::string temp_line;
-    while (std::getline(surface_file, temp_line)) {
-        ++counted_lines;
+void Freeze::complete_surface_element(SurfaceElement &cell) {
+    cell.sinh_eta_s = sinh(cell.x[3]);
+    cell.cosh_eta_s = cosh(cell.x[3]);
+
+    if (cell.epsilon_f < 0)  {
+        music_message.error("epsilon_f < 0.!");
+        exit(1);
+    }
+    if (cell.T_f < 0) {
+        music_message.error("T_f < 0.!");
+        exit(1);
     }
-    surface_file.close();
-    return(counted_lines);
 }
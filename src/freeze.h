@@ -36,6 +36,7 @@
 #include "data.h"
 #include "util.h"
 #include "eos.h"
+#include "surface_element.h"
 #include "pretty_ostream.h"
 
 const int nharmonics = 8;   // calculate up to maximum harmonic (n-1)
@@ -97,24 +98,6 @@ typedef struct nblock {
 } nblock;         // for normalisation integral of 3-body decays
 
 
-typedef struct surfaceElement {
-    double x[4];            // position in (tau, x, y, eta)
-    double sinh_eta_s;      // caching the sinh and cosh of eta_s
-    double cosh_eta_s;
-    double s[4];            // hypersurface vector in (tau, x, y, eta)
-    double u[4];            // flow velocity in (tau, x, y, eta)
-    double W[4][4];         // W^{\mu\nu}
-    double q[4];            // baryon diffusion current
-    double pi_b;            // bulk pressure
-    double rho_B;           // net baryon density
-    
-    double epsilon_f;
-    double T_f;
-    double mu_B; 
-    double eps_plus_p_over_T_FO;  // (energy_density+pressure)/temperature
-} SurfaceElement;
-
-
 //! This class perform Cooper-Fyre freeze-out and resonance decays
 class Freeze{
  private:
@@ -126,6 +109,8 @@ class Freeze{
 
     pretty_ostream music_message;
     std::vector<SurfaceElement> surface;
+    //! true if the surface was handed over by set_freeze_out_surface
+    bool surface_in_memory = false;
     Particle *particleList;
     int NCells;
     int decayMax, particleMax;
@@ -168,10 +153,14 @@ class Freeze{
     double gauss(int n, double (Freeze::*f)(double, void *), double xlo,
                  double xhi, void *optvec);
     void read_particle_PCE_mu(InitData* DATA, EOS* eos);
-    int get_number_of_lines_of_binary_surface_file(std::string filename);
-    int get_number_of_lines_of_text_surface_file(std::string filename);
     void ReadParticleData(InitData *DATA, EOS *eos);
     void ReadFreezeOutSurface(InitData *DATA);
+    //! uses the surface of the hydro run in this process instead of
+    //! reading surface.dat
+    void set_freeze_out_surface(std::vector<SurfaceElement> &&surface_in);
+    //! caches sinh and cosh of eta_s and checks the thermodynamic
+    //! quantities of a surface element
+    void complete_surface_element(SurfaceElement &cell);
     void ReadSpectra_pseudo(InitData* DATA, int full, int verbose);
     void compute_thermal_spectra(int particleSpectrumNumber, InitData* DATA);
     void perform_resonance_decays(InitData *DATA);
@@ -13,6 +13,7 @@ TEST_CASE("Does grid copy work"){
 TEST_CASE("check neighbourloop1") {
     SCGrid grid(1, 1, 1);
     grid(0,0,0).epsilon = 3;
+    grid.update_halo();
     Neighbourloop(grid, 0, 0, 0, NLAMBDAS {
         CHECK(c.epsilon == p1.epsilon);
         CHECK(c.epsilon == p2.epsilon);
@@ -26,6 +27,7 @@ TEST_CASE("check neighbourloop2") {
     for (int i = 0; i < 5; i++) {
         grid1(i, 0, 0).epsilon = i + 1;
     }
+    grid1.update_halo();
     Neighbourloop(grid1, 2, 0, 0, NLAMBDAS {
         if (direction == 1) {
             CHECK(p1.epsilon == 4);
@@ -48,6 +50,7 @@ TEST_CASE("check neighbourloop3") {
     for (int k = 0; k < 3; k++) {
         grid2(i, j, k).epsilon = 1;
     }
+    grid2.update_halo();
 
     Neighbourloop(grid2, 1, 1, 1, NLAMBDAS {
         int sum = 0;
@@ -63,6 +66,7 @@ TEST_CASE("check neighbourloop3") {
 TEST_CASE("check neighbourloop4"){
     SCGrid grid(1, 1, 1);
     grid(0, 0, 0).epsilon = 1;
+    grid.update_halo();
 
     int sum = 0;
     Neighbourloop(grid, 0, 0, 0, NLAMBDAS {
@@ -83,3 +87,87 @@ TEST_CASE("check dimension"){
     CHECK(grid.nEta() == 3);
 }
 
+
+TEST_CASE("check halo boundary conditions") {
+    SCGrid grid(4, 3, 1);
+    for (int j = 0; j < 3; j++)
+    for (int i = 0; i < 4; i++) {
+        grid(i, j, 0).epsilon = 10*j + i;
+        grid(i, j, 0).u = {1., 0.1*i, 0.2*j, 0.};
+        grid(i, j, 0).Wmunu.fill(0.);
+        grid(i, j, 0).Wmunu[5] = 1.;
+        grid(i, j, 0).Wmunu[7] = 2.;
+    }
+
+    grid.update_halo();
+    CHECK(grid.getHalo(-2,  1,  0).epsilon == 10);
+    CHECK(grid.getHalo( 5,  1,  0).epsilon == 13);
+    CHECK(grid.getHalo( 2, -1,  1).epsilon ==  2);
+    CHECK(grid.getHalo( 5,  4, -2).epsilon == 23);
+
+    grid.update_halo(GridBoundary::periodic, GridBoundary::periodic);
+    CHECK(grid.getHalo(-1,  1,  0).epsilon == 13);
+    CHECK(grid.getHalo(-2,  1,  0).epsilon == 12);
+    CHECK(grid.getHalo( 4,  2,  0).epsilon == 20);
+    CHECK(grid.getHalo( 1,  4,  0).epsilon == 11);
+    CHECK(grid.getHalo( 1,  1, -1).epsilon == 11);
+
+    grid.update_halo(GridBoundary::reflective, GridBoundary::reflective);
+    CHECK(grid.getHalo(-1,  1,  0).epsilon == 10);
+    CHECK(grid.getHalo(-2,  1,  0).epsilon == 11);
+    CHECK(grid.getHalo( 5,  1,  0).epsilon == 12);
+    CHECK(grid.getHalo(-2,  1,  0).u[1] == doctest::Approx(-0.1));
+    CHECK(grid.getHalo(-2,  1,  0).u[2] == doctest::Approx( 0.2));
+    CHECK(grid.getHalo(-2,  1,  0).Wmunu[5] == -1.);
+    CHECK(grid.getHalo(-2,  1,  0).Wmunu[7] ==  2.);
+    CHECK(grid.getHalo( 1,  3,  0).u[2] == doctest::Approx(-0.4));
+    CHECK(grid.getHalo( 1,  3,  0).u[1] == doctest::Approx( 0.1));
+}
+
+
+TEST_CASE("SoA grid reads and writes like the AoS grid") {
+    GridT<Cell_small, AoS> grid_aos(4, 3, 2);
+    GridT<Cell_small, SoA> grid_soa(4, 3, 2);
+    for (int i = 0; i < grid_aos.size(); i++) {
+        Cell_small cell;
+        cell.epsilon = i;
+        cell.rhob    = 2*i;
+        cell.u       = {1., 0.1*i, 0.2*i, 0.};
+        for (int k = 0; k < 14; k++) cell.Wmunu[k] = 100*i + k;
+        cell.pi_b    = -i;
+        grid_aos(i) = cell;
+        grid_soa(i) = cell;
+    }
+    grid_aos(1, 2, 1).u[3] = 7.;
+    grid_soa(1, 2, 1).u[3] = 7.;
+
+    grid_aos.update_halo(GridBoundary::reflective, GridBoundary::periodic);
+    grid_soa.update_halo(GridBoundary::reflective, GridBoundary::periodic);
+    for (int k = -2; k < 4; k++)
+    for (int j = -2; j < 5; j++)
+    for (int i = -2; i < 6; i++) {
+        const Cell_small cell = grid_soa.getHalo(i, j, k);
+        CHECK(cell.epsilon == grid_aos.getHalo(i, j, k).epsilon);
+        CHECK(cell.rhob    == grid_aos.getHalo(i, j, k).rhob);
+        CHECK(cell.u       == grid_aos.getHalo(i, j, k).u);
+        CHECK(cell.Wmunu   == grid_aos.getHalo(i, j, k).Wmunu);
+        CHECK(cell.pi_b    == grid_aos.getHalo(i, j, k).pi_b);
+    }
+
+    // every field is one contiguous array in the SoA layout
+    CHECK(&grid_soa(1, 0, 0).u[2] - &grid_soa(0, 0, 0).u[2] == 1);
+    CHECK(&grid_soa.cell(grid_soa.offset(3, 2, 1)).pi_b
+          == &grid_soa(3, 2, 1).pi_b);
+
+    auto grid_soa2 = grid_soa;
+    grid_soa2(0, 0, 0).epsilon = -1.;
+    CHECK(grid_soa(0, 0, 0).epsilon == 0.);
+
+    // assigning a field of one cell to another copies the values
+    grid_soa2(2, 1, 0).Wmunu = grid_soa(3, 2, 1).Wmunu;
+    grid_soa2(2, 1, 0).u     = grid_soa2(1, 2, 1).u;
+    CHECK(static_cast<ViscousVec>(grid_soa2(2, 1, 0).Wmunu)
+          == grid_aos(3, 2, 1).Wmunu);
+    CHECK(static_cast<FlowVec>(grid_soa2(2, 1, 0).u) == grid_aos(1, 2, 1).u);
+    CHECK(grid_soa(2, 1, 0).Wmunu[0] == grid_aos(2, 1, 0).Wmunu[0]);
+}
@@ -2,30 +2,222 @@
 #define _SRC_GRID_H_
 
 #include <cassert>
+#include <cstdlib>
+#include <new>
 #include <vector>
 #include "cell.h"
-#include "grid.h"
+
+//! Boundary conditions used to fill the ghost cells of GridT
+enum class GridBoundary {zero_gradient, periodic, reflective};
+
+//! Hook for reflective boundaries: flips the components of a cell that are
+//! odd under x^dir -> -x^dir (dir = 1, 2, 3). Cells of scalars need nothing.
+template<class T>
+struct HaloTraits {
+    template<class Ref>
+    static void reflect(Ref&&, const int) {}
+};
+
+template<>
+struct HaloTraits<Cell_small> {
+    //! c is a Cell_small& or a Cell_small_ref of the SoA layout
+    template<class Ref>
+    static void reflect(Ref &&c, const int dir) {
+        // components of Wmunu with an odd number of indices equal to dir
+        static const int odd[3][4] = {{1, 5, 6, 11},
+                                      {2, 5, 8, 12},
+                                      {3, 6, 8, 13}};
+        c.u[dir] = -c.u[dir];
+        for (int i = 0; i < 4; i++) {
+            const int idx = odd[dir-1][i];
+            c.Wmunu[idx] = -c.Wmunu[idx];
+        }
+    }
+};
+
+
+//! Storage layouts of GridT, chosen at compile time.
+//! AoS stores whole cells one after the other.
+//! SoA stores one contiguous, 64-byte aligned array per field of the cell.
+struct AoS {};
+struct SoA {};
+
+//! SoA storage needs to know how many doubles make up one cell and which
+//! proxy type references a cell; specialise this for every cell type.
+template<class T> struct SoATraits;
+
+template<> struct SoATraits<Cell_small> {
+    static const int n_fields = Cell_small_ref<double>::n_fields;
+    typedef Cell_small_ref<double>       reference;
+    typedef Cell_small_ref<const double> const_reference;
+};
+
+
+template<class V, std::size_t Align = 64>
+struct AlignedAllocator {
+    typedef V value_type;
+    template<class U> struct rebind {typedef AlignedAllocator<U, Align> other;};
+
+    AlignedAllocator() = default;
+    template<class U>
+    AlignedAllocator(const AlignedAllocator<U, Align>&) {}
+
+    V* allocate(std::size_t n) {
+        void *p = nullptr;
+        if (posix_memalign(&p, Align, n*sizeof(V)) != 0) throw std::bad_alloc();
+        return static_cast<V*>(p);
+    }
+    void deallocate(V *p, std::size_t) {free(p);}
+
+    template<class U>
+    bool operator==(const AlignedAllocator<U, Align>&) const {return true; }
+    template<class U>
+    bool operator!=(const AlignedAllocator<U, Align>&) const {return false;}
+};
+
+
+//! the cells of GridT at storage positions 0..n-1. The memory of a run of
+//! positions is n_blocks() blocks, block_stride() bytes apart, of
+//! value_bytes per position (see GridT::slices).
+template<class T, class Layout> class GridStorage;
 
 template<class T>
+class GridStorage<T, AoS> {
+ private:
+    std::vector<T> data;
+
+ public:
+    typedef T&       reference;
+    typedef const T& const_reference;
+    static const std::size_t value_bytes = sizeof(T);
+
+    void resize(int n) {data.resize(n);}
+    reference       at(int i)       {return data[i];}
+    const_reference at(int i) const {return data[i];}
+
+    char* address(int i) {return reinterpret_cast<char*>(&data[i]);}
+    int n_blocks() const {return 1;}
+    std::size_t block_stride() const {return 0;}
+
+    void clear() {
+        data.clear();
+        data.shrink_to_fit();
+    }
+};
+
+template<class T>
+class GridStorage<T, SoA> {
+ private:
+    typedef SoATraits<T> Traits;
+    std::vector<double, AlignedAllocator<double>> data;
+    int stride = 0;     // padded length of one field array
+
+ public:
+    typedef typename Traits::reference       reference;
+    typedef typename Traits::const_reference const_reference;
+    static const std::size_t value_bytes = sizeof(double);
+
+    void resize(int n) {
+        stride = (n + 7)/8*8;
+        data.assign(Traits::n_fields*stride, 0.);
+    }
+    reference       at(int i)       {return reference(&data[i], stride);}
+    const_reference at(int i) const {return const_reference(&data[i], stride);}
+
+    char* address(int i) {return reinterpret_cast<char*>(&data[i]);}
+    int n_blocks() const {return Traits::n_fields;}
+    std::size_t block_stride() const {return stride*sizeof(double);}
+
+    void clear() {
+        data.clear();
+        data.shrink_to_fit();
+        stride = 0;
+    }
+};
+
+
+//! 3D grid of cells with a layer of NG ghost cells on every side.
+//! getHalo() reads neighbours up to NG cells outside the domain with a
+//! plain offset load; the ghost cells only hold valid data after
+//! update_halo() has been called on the current content of the grid.
+//! With the SoA layout operator() and getHalo() hand out proxies that
+//! read and write the field arrays; reference and const_reference name
+//! what they return for either layout.
+template<class T, class Layout = AoS>
 class GridT {
+ public:
+    static const int NG = 2;    //!< width of the ghost layer
+
+    typedef typename GridStorage<T, Layout>::reference       reference;
+    typedef typename GridStorage<T, Layout>::const_reference const_reference;
+
  private:
-    std::vector<T> grid;
+    GridStorage<T, Layout> grid;
 
     int Nx   = 0;
     int Ny   = 0;
     int Neta = 0;
-  
-    T& get(int x, int y, int eta) {
-        return grid[Nx*(Ny*eta+y)+x];
+    int Nxp  = 0;               // padded extents
+    int Nyp  = 0;
+
+    int index(int x, int y, int eta) const {
+        return Nxp*(Nyp*(eta+NG)+(y+NG))+(x+NG);
+    }
+
+    int index(int i) const {
+        const int x   = i%Nx;
+        const int y   = (i/Nx)%Ny;
+        const int eta = i/(Nx*Ny);
+        return index(x, y, eta);
+    }
+
+    reference get(int x, int y, int eta) {
+        return grid.at(index(x, y, eta));
+    }
+
+    const_reference get(int x, int y, int eta) const {
+        return grid.at(index(x, y, eta));
+    }
+
+    //! interior cell providing the ghost cell at position i along an axis
+    //! of n cells; reflected is set if the cell has to be mirrored
+    static int halo_source(int i, int n, GridBoundary type, bool &reflected) {
+        reflected = false;
+        if (i >= 0 && i < n) return i;
+        switch (type) {
+            case GridBoundary::periodic:
+                return ((i%n) + n)%n;
+            case GridBoundary::reflective:
+                reflected = true;
+                i = i < 0 ? -1 - i : 2*n - 1 - i;
+                break;
+            default:
+                break;
+        }
+        if (i < 0) i = 0; else if (i >= n) i = n - 1;
+        return i;
     }
-  
+
+    void fill_ghost(int x, int y, int eta, const GridBoundary type[3]) {
+        bool refl[3];
+        const int sx   = halo_source(x,   Nx,   type[0], refl[0]);
+        const int sy   = halo_source(y,   Ny,   type[1], refl[1]);
+        const int seta = halo_source(eta, Neta, type[2], refl[2]);
+        get(x, y, eta) = get(sx, sy, seta);
+        for (int dir = 0; dir < 3; dir++) {
+            if (refl[dir]) HaloTraits<T>::reflect(get(x, y, eta), dir + 1);
+        }
+    }
+
  public:
     GridT() = default;
     GridT(int Nx0, int Ny0, int Neta0) {
         Nx   = Nx0  ;
         Ny   = Ny0  ;
         Neta = Neta0;
-        grid.resize(Nx*Ny*Neta);
+        Nxp  = Nx + 2*NG;
+        Nyp  = Ny + 2*NG;
+        grid.resize(Nxp*Nyp*(Neta + 2*NG));
     }
 
     int nX()   const {return(Nx );  }
@@ -33,54 +225,104 @@ class GridT {
     int nEta() const {return(Neta );}
     int size() const {return Nx*Ny*Neta;}
 
-    T& getHalo(int x, int y, int eta){
-        assert(-2<=x  ); assert(x  <Nx  +2);
-        assert(-2<=y  ); assert(y  <Ny  +2);
-        assert(-2<=eta); assert(eta<Neta+2);
-        if(x  <0)   x  =0;  else if(x  >=Nx)   x  = Nx   - 1;
-        if(y  <0)   y  =0;  else if(y  >=Ny)   y  = Ny   - 1;
-        if(eta<0)   eta=0;  else if(eta>=Neta) eta= Neta - 1;
+    //! fills the ghost layer from the interior cells, once per stage
+    void update_halo(GridBoundary bx   = GridBoundary::zero_gradient,
+                     GridBoundary by   = GridBoundary::zero_gradient,
+                     GridBoundary beta = GridBoundary::zero_gradient) {
+        const GridBoundary type[3] = {bx, by, beta};
+        #pragma omp parallel for collapse(2)
+        for (int eta = -NG; eta < Neta + NG; eta++)
+        for (int y   = -NG; y   < Ny   + NG; y++  ) {
+            const bool interior_row = (   eta >= 0 && eta < Neta
+                                       && y   >= 0 && y   < Ny);
+            for (int x = -NG; x < Nx + NG; x++) {
+                if (interior_row && x == 0) x = Nx;
+                fill_ghost(x, y, eta, type);
+            }
+        }
+    }
+
+    reference getHalo(int x, int y, int eta){
+        assert(-NG<=x  ); assert(x  <Nx  +NG);
+        assert(-NG<=y  ); assert(y  <Ny  +NG);
+        assert(-NG<=eta); assert(eta<Neta+NG);
         return get(x,y,eta);
     }
 
-    const T& getHalo(int x, int y, int eta) const {
-        return getHalo(x, y, eta);
+    const_reference getHalo(int x, int y, int eta) const {
+        assert(-NG<=x  ); assert(x  <Nx  +NG);
+        assert(-NG<=y  ); assert(y  <Ny  +NG);
+        assert(-NG<=eta); assert(eta<Neta+NG);
+        return get(x,y,eta);
     }
 
-    T& operator()(const int x, const int y, const int eta) {
+    reference operator()(const int x, const int y, const int eta) {
         assert(0<=x  ); assert(x  <Nx);
         assert(0<=y  ); assert(y  <Ny);
         assert(0<=eta); assert(eta<Neta);
         return get(x, y, eta);
     }
 
-    const T& operator()(int x, int y, int eta) const {
+    const_reference operator()(int x, int y, int eta) const {
         assert(0<=x  ); assert(x  <Nx);
         assert(0<=y  ); assert(y  <Ny);
         assert(0<=eta); assert(eta<Neta);
         return get(x, y, eta);
     }
 
-    T& operator()(const int i) {
+    reference operator()(const int i) {
         assert(0<=i  ); assert(i<Nx*Ny*Neta);
-        return grid[i];
+        return grid.at(index(i));
     }
 
-    const T& operator()(const int i) const {
+    const_reference operator()(const int i) const {
         assert(0<=i  ); assert(i<Nx*Ny*Neta);
-        return grid[i];
+        return grid.at(index(i));
+    }
+
+    //! storage position of a cell, ghost cells included; a stencil can
+    //! find its cells once and read them through cell()
+    int offset(int x, int y, int eta) const {
+        assert(-NG<=x  ); assert(x  <Nx  +NG);
+        assert(-NG<=y  ); assert(y  <Ny  +NG);
+        assert(-NG<=eta); assert(eta<Neta+NG);
+        return index(x, y, eta);
+    }
+
+    const_reference cell(int offset) const {return grid.at(offset);}
+
+    //! memory of the n_slices whole eta slices (ghost cells in x and y
+    //! included) from eta on: n_blocks blocks of bytes bytes that start
+    //! block_stride bytes apart, one block per field for SoA
+    void slices(int eta, int n_slices, char *&start, std::size_t &bytes,
+                int &n_blocks, std::size_t &block_stride) {
+        start        = grid.address(index(-NG, -NG, eta));
+        bytes        = (GridStorage<T, Layout>::value_bytes
+                        *n_slices*Nxp*Nyp);
+        n_blocks     = grid.n_blocks();
+        block_stride = grid.block_stride();
     }
 
     void clear() {
         grid.clear();
-        grid.shrink_to_fit();
     }
 };
 
-typedef GridT<Cell_small> SCGrid;
+//! the layout of the hydro grid is fixed at compile time, SoA with
+//! MUSIC_GRID_SOA defined (cmake -DSOA=ON, make SOA=1)
+#ifdef MUSIC_GRID_SOA
+typedef GridT<Cell_small, SoA> SCGrid;
+#else
+typedef GridT<Cell_small, AoS> SCGrid;
+#endif
+typedef GridT<ThermoCell>      ThermoGrid;
+typedef GridT<DerivativeCell>  DerivativeGrid;
 
-template<class T, class Func>
-void Neighbourloop(GridT<T> &arena, int cx, int cy, int ceta, Func func) {
+template<class T, class Layout, class Func>
+void Neighbourloop(GridT<T, Layout> &arena, int cx, int cy, int ceta,
+                   Func func) {
+    typedef GridT<T, Layout> Grid;
+    const Grid &arena_c = arena;
     const std::array<int, 6> dx   = {-1, 1,  0, 0,  0, 0};
     const std::array<int, 6> dy   = { 0, 0, -1, 1,  0, 0};
     const std::array<int, 6> deta = { 0, 0,  0, 0, -1, 1};
@@ -91,21 +333,25 @@ void Neighbourloop(GridT<T> &arena, int cx, int cy, int ceta, Func func) {
         const int p1nx   = dx  [2*dir+1];
         const int p1ny   = dy  [2*dir+1];
         const int p1neta = deta[2*dir+1];
-        const int m2nx   = 2*m1nx;  
-        const int m2ny   = 2*m1ny;  
+        const int m2nx   = 2*m1nx;
+        const int m2ny   = 2*m1ny;
         const int m2neta = 2*m1neta;
-        const int p2nx   = 2*p1nx;  
-        const int p2ny   = 2*p1ny;  
+        const int p2nx   = 2*p1nx;
+        const int p2ny   = 2*p1ny;
         const int p2neta = 2*p1neta;
-              auto&  c   = arena        (cx,      cy,      ceta       );
-        const auto& p1   = arena.getHalo(cx+p1nx, cy+p1ny, ceta+p1neta);
-        const auto& p2   = arena.getHalo(cx+p2nx, cy+p2ny, ceta+p2neta);
-        const auto& m1   = arena.getHalo(cx+m1nx, cy+m1ny, ceta+m1neta);
-        const auto& m2   = arena.getHalo(cx+m2nx, cy+m2ny, ceta+m2neta);
+        typename Grid::reference c = arena(cx, cy, ceta);
+        typename Grid::const_reference p1
+                = arena_c.getHalo(cx+p1nx, cy+p1ny, ceta+p1neta);
+        typename Grid::const_reference p2
+                = arena_c.getHalo(cx+p2nx, cy+p2ny, ceta+p2neta);
+        typename Grid::const_reference m1
+                = arena_c.getHalo(cx+m1nx, cy+m1ny, ceta+m1neta);
+        typename Grid::const_reference m2
+                = arena_c.getHalo(cx+m2nx, cy+m2ny, ceta+m2neta);
         func(c,p1,p2,m1,m2,dir+1);
     }
 }
 
-#define NLAMBDAS [&](Cell_small& c, const Cell_small& p1, const Cell_small& p2, const Cell_small& m1, const Cell_small& m2, const int direction) 
+#define NLAMBDAS [&](SCGrid::reference c, SCGrid::const_reference p1, SCGrid::const_reference p2, SCGrid::const_reference m1, SCGrid::const_reference m2, const int direction)
 
 #endif
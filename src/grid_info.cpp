@@ -4,12 +4,15 @@
 
 #include "./util.h"
 #include "./grid_info.h"
+#include "./grid_tiles.h"
 
 using namespace std;
 
-Cell_info::Cell_info(const InitData &DATA_in, const EOS &eos_in) :
+Cell_info::Cell_info(const InitData &DATA_in, const EOS &eos_in,
+                     const Domain &domain_in) :
     DATA(DATA_in),
-    eos(eos_in) {
+    eos(eos_in),
+    domain(domain_in) {
 
     // read in tables for delta f coefficients
     if (DATA.turn_on_diff == 1) {
@@ -54,7 +57,7 @@ Cell_info::~Cell_info() {
 
 //! This function outputs a header files for JF and Gojko's EM program
 void Cell_info::Output_hydro_information_header() {
-    string fname = "hydro_info_header_h";
+    string fname = DATA.output_dir + "hydro_info_header_h";
 
     // Open output file
     ofstream outfile;
@@ -102,11 +105,13 @@ void Cell_info::Output_hydro_information_header() {
 //! This function outputs hydro evolution file in binary format
 void Cell_info::OutputEvolutionDataXYEta(SCGrid &arena, 
                                          double tau) {
-    const string out_name_xyeta = "evolution_xyeta.dat";
-    const string out_name_W_xyeta =
-                        "evolution_Wmunu_over_epsilon_plus_P_xyeta.dat";
-    const string out_name_bulkpi_xyeta = "evolution_bulk_pressure_xyeta.dat";
-    const string out_name_q_xyeta = "evolution_qmu_xyeta.dat";
+    const string out_name_xyeta = DATA.output_dir + "evolution_xyeta.dat";
+    const string out_name_W_xyeta = (
+        DATA.output_dir + "evolution_Wmunu_over_epsilon_plus_P_xyeta.dat");
+    const string out_name_bulkpi_xyeta = (
+        DATA.output_dir + "evolution_bulk_pressure_xyeta.dat");
+    const string out_name_q_xyeta = (
+        DATA.output_dir + "evolution_qmu_xyeta.dat");
     string out_open_mode;
     FILE *out_file_xyeta        = NULL;
     FILE *out_file_W_xyeta      = NULL;
@@ -295,7 +300,7 @@ void Cell_info::OutputEvolutionDataXYEta_chun(SCGrid &arena,
     // Here ueta = tau*ueta, Wieta = tau*Wieta, qeta = tau*qeta
     // Here Wij is reduced variables Wij/(e+P) used in delta f
     // and qi is reduced variables qi/kappa_hat
-    const string out_name_xyeta = "evolution_all_xyeta.dat";
+    const string out_name_xyeta = DATA.output_dir + "evolution_all_xyeta.dat";
     string out_open_mode;
     FILE *out_file_xyeta;
     // If it's the first timestep, overwrite the previous file
@@ -425,7 +430,8 @@ void Cell_info::OutputEvolutionDataXYEta_photon(SCGrid &arena, double tau) {
     // Here ueta = tau*ueta, Wieta = tau*Wieta, qeta = tau*qeta
     // Here Wij is reduced variables Wij/(e+P) used in delta f
     // and qi is reduced variables qi/kappa_hat
-    const string out_name_xyeta = "evolution_for_photon_xyeta.dat";
+    const string out_name_xyeta = (DATA.output_dir
+                                   + "evolution_for_photon_xyeta.dat");
     string out_open_mode;
     FILE *out_file_xyeta;
     // If it's the first timestep, overwrite the previous file
@@ -541,26 +547,29 @@ void Cell_info::OutputEvolutionDataXYEta_photon(SCGrid &arena, double tau) {
 
 //! This function prints to the screen the maximum local energy density,
 //! the maximum temperature in the current grid
-void Cell_info::get_maximum_energy_density(SCGrid &arena) {
+//! the cells of inactive tiles are skipped
+void Cell_info::get_maximum_energy_density(SCGrid &arena,
+                                           const ActiveTiles &active_tiles) {
     double eps_max  = 0.0;
     double rhob_max = 0.0;
     double T_max    = 0.0;
 
-    // get the grid information
-    const int neta = arena.nEta();
-    const int nx   = arena.nX();
-    const int ny   = arena.nY();
-
-    #pragma omp parallel for collapse(3) reduction(max:eps_max, rhob_max, T_max)
-    for (int ieta = 0; ieta < neta; ieta++)
-    for (int ix = 0; ix < nx; ix++) 
-    for (int iy = 0; iy < ny; iy++) {
-        const auto eps_local  = arena(ix, iy, ieta).epsilon;
-        const auto rhob_local = arena(ix, iy, ieta).rhob;
-        eps_max  = std::max(eps_max,  eps_local );
-        rhob_max = std::max(rhob_max, rhob_local);
-        T_max    = std::max(T_max,    eos.get_temperature(eps_local, rhob_local) );
+    const GridTiles &tiles = active_tiles.get_tiles();
+    #pragma omp parallel for schedule(dynamic) reduction(max:eps_max, rhob_max, T_max)
+    for (int itile = 0; itile < tiles.size(); itile++) {
+        if (!active_tiles.tile_active(itile)) continue;
+        tiles.for_each_cell_in_tile(itile, [&](int ix, int iy, int ieta) {
+            const auto eps_local  = arena(ix, iy, ieta).epsilon;
+            const auto rhob_local = arena(ix, iy, ieta).rhob;
+            eps_max  = std::max(eps_max,  eps_local );
+            rhob_max = std::max(rhob_max, rhob_local);
+            T_max    = std::max(T_max,
+                                eos.get_temperature(eps_local, rhob_local));
+        });
     }
+    eps_max  = domain.max(eps_max);
+    rhob_max = domain.max(rhob_max);
+    T_max    = domain.max(T_max);
     eps_max *= 0.19733;   // GeV/fm^3
     T_max *= 0.19733;     // GeV
     music_message << "eps_max = " << eps_max << " GeV/fm^3, "
@@ -571,44 +580,47 @@ void Cell_info::get_maximum_energy_density(SCGrid &arena) {
 
 
 //! This function checks the total energy and total net baryon number
-//! at a give proper time
+//! at a give proper time, summed over the active tiles
 void Cell_info::check_conservation_law(SCGrid &arena, SCGrid &arena_prev,
-                                       double tau) {
+                                       double tau,
+                                       const ActiveTiles &active_tiles) {
     double N_B     = 0.0;
     double T_tau_t = 0.0;
     double deta    = DATA.delta_eta;
     double dx      = DATA.delta_x;
     double dy      = DATA.delta_y;
-    const int neta = arena.nEta();
-    const int nx   = arena.nX();
-    const int ny   = arena.nY();
-
-    #pragma omp parallel for collapse(3) reduction(+:N_B, T_tau_t)
-    for (int ieta = 0; ieta < neta; ieta++)     
-    for (int ix = 0; ix < nx; ix++) 
-    for (int iy = 0; iy < ny; iy++) {
-        const auto& c      = arena     (ix, iy, ieta);
-        const auto& c_prev = arena_prev(ix, iy, ieta);
-
-        const double eta_s = deta*ieta - (DATA.eta_size)/2.0;
-        const double cosh_eta = cosh(eta_s);
-        const double sinh_eta = sinh(eta_s);
-        N_B += (c.rhob*c.u[0] + c_prev.Wmunu[10]);
-        const double Pi00_rk_0 = (c_prev.pi_b
-                                  *(-1.0 + c_prev.u[0]*c_prev.u[0]));
-        const double e_local   = c.epsilon;
-        const double rhob      = c.rhob;
-        const double pressure  = eos.get_pressure(e_local, rhob);
-        const double u0        = c.u[0];
-        const double u3        = c.u[3];
-        const double T00_local = (e_local + pressure)*u0*u0 - pressure;
-        const double T03_local = (e_local + pressure)*u0*u3;
-        const double T_tau_tau = (T00_local + c_prev.Wmunu[0] + Pi00_rk_0);
-
-        const double Pi03_rk_0 = c_prev.pi_b*c_prev.u[0]*c_prev.u[3];
-        const double T_tau_eta = T03_local + c_prev.Wmunu[3] + Pi03_rk_0;
-        T_tau_t += T_tau_tau*cosh_eta + T_tau_eta*sinh_eta;
+
+    const GridTiles &tiles = active_tiles.get_tiles();
+    #pragma omp parallel for schedule(dynamic) reduction(+:N_B, T_tau_t)
+    for (int itile = 0; itile < tiles.size(); itile++) {
+        if (!active_tiles.tile_active(itile)) continue;
+        tiles.for_each_cell_in_tile(itile, [&](int ix, int iy, int ieta) {
+            const auto& c      = arena     (ix, iy, ieta);
+            const auto& c_prev = arena_prev(ix, iy, ieta);
+
+            const double eta_s = (deta*(domain.eta_begin() + ieta)
+                                  - (DATA.eta_size)/2.0);
+            const double cosh_eta = cosh(eta_s);
+            const double sinh_eta = sinh(eta_s);
+            N_B += (c.rhob*c.u[0] + c_prev.Wmunu[10]);
+            const double Pi00_rk_0 = (c_prev.pi_b
+                                      *(-1.0 + c_prev.u[0]*c_prev.u[0]));
+            const double e_local   = c.epsilon;
+            const double rhob      = c.rhob;
+            const double pressure  = eos.get_pressure(e_local, rhob);
+            const double u0        = c.u[0];
+            const double u3        = c.u[3];
+            const double T00_local = (e_local + pressure)*u0*u0 - pressure;
+            const double T03_local = (e_local + pressure)*u0*u3;
+            const double T_tau_tau = (T00_local + c_prev.Wmunu[0] + Pi00_rk_0);
+
+            const double Pi03_rk_0 = c_prev.pi_b*c_prev.u[0]*c_prev.u[3];
+            const double T_tau_eta = T03_local + c_prev.Wmunu[3] + Pi03_rk_0;
+            T_tau_t += T_tau_tau*cosh_eta + T_tau_eta*sinh_eta;
+        });
     }
+    N_B     = domain.sum(N_B);
+    T_tau_t = domain.sum(T_tau_t);
     double factor = tau*dx*dy*deta;
     N_B *= factor;
     T_tau_t *= factor*0.19733;  // GeV
@@ -689,7 +701,7 @@ void Cell_info::Gubser_flow_check_file(SCGrid &arena, double tau) {
     }
 
     ostringstream filename;
-    filename << "Gubser_flow_check_tau_" << tau << ".dat";
+    filename << DATA.output_dir << "Gubser_flow_check_tau_" << tau << ".dat";
     ofstream output_file(filename.str().c_str());
 
     double dx = DATA.delta_x;
@@ -722,7 +734,7 @@ void Cell_info::Gubser_flow_check_file(SCGrid &arena, double tau) {
 //! This function outputs files to cross check with 1+1D simulation
 void Cell_info::output_1p1D_check_file(SCGrid &arena, double tau) {
     ostringstream filename;
-    filename << "1+1D_check_tau_" << tau << ".dat";
+    filename << DATA.output_dir << "1+1D_check_tau_" << tau << ".dat";
     ofstream output_file(filename.str().c_str());
 
     double unit_convert = 0.19733;  // hbarC
@@ -743,7 +755,8 @@ void Cell_info::output_1p1D_check_file(SCGrid &arena, double tau) {
 
 //! This function outputs energy density and n_b for making movies
 void Cell_info::output_evolution_for_movie(SCGrid &arena, double tau) {
-    const string out_name_xyeta = "evolution_for_movie_xyeta.dat";
+    const string out_name_xyeta = (DATA.output_dir
+                                   + "evolution_for_movie_xyeta.dat");
     string out_open_mode;
     FILE *out_file_xyeta;
     // If it's the first timestep, overwrite the previous file
@@ -812,7 +825,7 @@ void Cell_info::output_evolution_for_movie(SCGrid &arena, double tau) {
 //! This function dumps the energy density and net baryon density
 void Cell_info::output_energy_density_and_rhob_disitrubtion(SCGrid &arena,
                                                             string filename) {
-    ofstream output_file(filename.c_str());
+    ofstream output_file((DATA.output_dir + filename).c_str());
     const double unit_convert = 0.19733;  // hbarC [GeV*fm]
     const int n_skip_x   = DATA.output_evolution_every_N_x;
     const int n_skip_y   = DATA.output_evolution_every_N_y;
@@ -834,7 +847,7 @@ void Cell_info::output_energy_density_and_rhob_disitrubtion(SCGrid &arena,
 void Cell_info::monitor_fluid_cell(SCGrid &arena, int ix, int iy, int ieta,
                                    double tau) {
     ostringstream filename;
-    filename << "monitor_fluid_cell_ix_" << ix << "_iy_" << iy
+    filename << DATA.output_dir << "monitor_fluid_cell_ix_" << ix << "_iy_" << iy
              << "_ieta_" << ieta << ".dat";
     ofstream output_file(filename.str().c_str(),
                          std::ofstream::out | std::ofstream::app);
@@ -1018,7 +1031,8 @@ double Cell_info::get_deltaf_coeff_14moments(double T, double muB,
 void Cell_info::output_average_phase_diagram_trajectory(
                 double tau, double eta_min, double eta_max, SCGrid &arena) {
     ostringstream filename;
-    filename << "averaged_phase_diagram_trajectory_eta_" << eta_min
+    filename << DATA.output_dir << "averaged_phase_diagram_trajectory_eta_"
+             << eta_min
              << "_" << eta_max << ".dat";
     fstream of(filename.str().c_str(), std::fstream::app | std::fstream::out);
     if (fabs(tau - DATA.tau0) < 1e-10) {
@@ -1075,15 +1089,6 @@ void Cell_info::output_average_phase_diagram_trajectory(
 //! This function outputs system's momentum anisotropy as a function of tau
 void Cell_info::output_momentum_anisotropy_vs_tau(
                 double tau, double eta_min, double eta_max, SCGrid &arena) {
-    ostringstream filename;
-    filename << "momentum_anisotropy_eta_" << eta_min
-             << "_" << eta_max << ".dat";
-    fstream of(filename.str().c_str(), std::fstream::app | std::fstream::out);
-    if (fabs(tau - DATA.tau0) < 1e-10) {
-        of << "# tau(fm)  epsilon_p(ideal)  epsilon_p(full)  "
-           << "ecc_2  ecc_3  R_Pi  gamma"
-           << endl;
-    }
     double ideal_num1 = 0.0;
     double ideal_num2 = 0.0;
     double ideal_den  = 0.0;
@@ -1103,8 +1108,8 @@ void Cell_info::output_momentum_anisotropy_vs_tau(
     for (int ieta = 0; ieta < arena.nEta(); ieta++) {
         double eta = 0.0;
         if (DATA.boost_invariant == 0) {
-            eta = ((static_cast<double>(ieta))*(DATA.delta_eta)
-                    - (DATA.eta_size)/2.0);
+            eta = ((static_cast<double>(domain.eta_begin() + ieta))
+                    *(DATA.delta_eta) - (DATA.eta_size)/2.0);
         }
         if (eta < eta_max && eta > eta_min) {
             double x_o   = 0.0;
@@ -1167,6 +1172,31 @@ void Cell_info::output_momentum_anisotropy_vs_tau(
             }
         }
     }
+
+    // every rank sums over its own eta slices
+    double *partial_sums[] = {&ideal_num1, &ideal_num2, &ideal_den,
+                              &full_num1, &full_num2, &full_den,
+                              &ecc2_num1, &ecc2_num2, &ecc2_den,
+                              &ecc3_num1, &ecc3_num2, &ecc3_den,
+                              &R_Pi_num, &R_Pi_den, &u_perp_num, &u_perp_den};
+    if (domain.n_ranks() > 1) {
+        std::vector<double> sums;
+        for (auto partial : partial_sums) sums.push_back(*partial);
+        domain.sum(sums);
+        for (unsigned int i = 0; i < sums.size(); i++)
+            *partial_sums[i] = sums[i];
+    }
+    if (!domain.is_root()) return;
+
+    ostringstream filename;
+    filename << DATA.output_dir << "momentum_anisotropy_eta_" << eta_min
+             << "_" << eta_max << ".dat";
+    fstream of(filename.str().c_str(), std::fstream::app | std::fstream::out);
+    if (fabs(tau - DATA.tau0) < 1e-10) {
+        of << "# tau(fm)  epsilon_p(ideal)  epsilon_p(full)  "
+           << "ecc_2  ecc_3  R_Pi  gamma"
+           << endl;
+    }
     double ep_ideal = sqrt(ideal_num1*ideal_num1 + ideal_num2*ideal_num2)/ideal_den;
     double ep_full  = sqrt(full_num1*full_num1 + full_num2*full_num2)/full_den;
     double ecc2     = sqrt(ecc2_num1*ecc2_num1 + ecc2_num2*ecc2_num2)/ecc2_den;
@@ -11,12 +11,15 @@
 #include "eos.h"
 #include "cell.h"
 #include "grid.h"
+#include "grid_tiles.h"
+#include "domain.h"
 #include "pretty_ostream.h"
 
 class Cell_info {
  private:
     const InitData &DATA;
     const EOS &eos;
+    const Domain &domain;
     pretty_ostream music_message;
     
     int deltaf_qmu_coeff_table_length_T;
@@ -40,7 +43,8 @@ class Cell_info {
     double **deltaf_coeff_tb_14mom_Bpi_shear;
 
  public:
-    Cell_info(const InitData &DATA_in, const EOS &eos_ptr_in);
+    Cell_info(const InitData &DATA_in, const EOS &eos_ptr_in,
+              const Domain &domain_in);
     ~Cell_info();
 
     //! This function outputs a header files for JF and Gojko's EM programs
@@ -68,7 +72,8 @@ class Cell_info {
 
     //! This function prints to the screen the maximum local energy density,
     //! the maximum temperature in the current grid
-    void get_maximum_energy_density(SCGrid &arena);
+    void get_maximum_energy_density(SCGrid &arena,
+                                    const ActiveTiles &active_tiles);
 
     //! This function outputs energy density and n_b for making movies
     void output_evolution_for_movie(SCGrid &arena, double tau);
@@ -84,7 +89,8 @@ class Cell_info {
     
     //! This function checks the total energy and total net baryon number
     //! at a give proper time
-    void check_conservation_law(SCGrid &arena, SCGrid &arena_prev, double tau);
+    void check_conservation_law(SCGrid &arena, SCGrid &arena_prev, double tau,
+                                const ActiveTiles &active_tiles);
 
     //! This function outputs the evolution of hydrodynamic variables at a
     //! give fluid cell
@@ -0,0 +1,201 @@
+#include <unistd.h>
+#include <array>
+#include <cmath>
+#include <vector>
+#include "grid_tiles.h"
+#include "doctest.h"
+
+GridTiles::GridTiles(int nx_in, int ny_in, int neta_in, int bytes_per_cell,
+                     int tile_x, int tile_y, int tile_eta) :
+    nx(nx_in), ny(ny_in), neta(neta_in) {
+    // fill half of L2 with one tile, keep at least a few vector lengths
+    // of contiguous cells along x
+    const long cells = std::max(1L, l2_cache_size()/2
+                                    /std::max(1, bytes_per_cell));
+    const int auto_x   = static_cast<int>(
+                            std::min<long>(nx, std::max(32L, cells/16)));
+    const long rest    = std::max(1L, cells/auto_x);
+    const int auto_eta = static_cast<int>(std::min<long>(
+                    neta, std::max(1L, std::lround(std::sqrt(rest)))));
+    const int auto_y   = static_cast<int>(std::min<long>(
+                    ny, std::max(1L, rest/auto_eta)));
+
+    tx   = tile_x   > 0 ? std::min(tile_x,   nx)   : auto_x;
+    ty   = tile_y   > 0 ? std::min(tile_y,   ny)   : auto_y;
+    teta = tile_eta > 0 ? std::min(tile_eta, neta) : auto_eta;
+    tx   = std::max(tx, 1);
+    ty   = std::max(ty, 1);
+    teta = std::max(teta, 1);
+
+    ntx   = (nx   + tx   - 1)/tx;
+    nty   = (ny   + ty   - 1)/ty;
+    nteta = (neta + teta - 1)/teta;
+}
+
+
+long GridTiles::l2_cache_size() {
+    static const long l2_size = []() {
+        long size = 0;
+#ifdef _SC_LEVEL2_CACHE_SIZE
+        size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+        return size > 0 ? size : 256*1024L;
+    }();
+    return l2_size;
+}
+
+
+ActiveTiles::ActiveTiles(const GridTiles &tiles_in, int margin_in,
+                         int reach_in) :
+    tiles(tiles_in), margin(margin_in), reach(reach_in) {
+    set_all_active();
+}
+
+
+void ActiveTiles::set_all_active() {
+    active.assign(tiles.size(), 1);
+    needed.assign(tiles.size(), 1);
+}
+
+
+void ActiveTiles::mark_box(std::vector<char> &flags, int x0, int x1,
+                           int y0, int y1, int eta0, int eta1) const {
+    x0   = std::max(x0, 0);
+    y0   = std::max(y0, 0);
+    eta0 = std::max(eta0, 0);
+    x1   = std::min(x1, tiles.nX() - 1);
+    y1   = std::min(y1, tiles.nY() - 1);
+    eta1 = std::min(eta1, tiles.nEta() - 1);
+    for (int iteta = eta0/tiles.tile_neta(); iteta <= eta1/tiles.tile_neta();
+         iteta++)
+    for (int ity = y0/tiles.tile_ny(); ity <= y1/tiles.tile_ny(); ity++)
+    for (int itx = x0/tiles.tile_nx(); itx <= x1/tiles.tile_nx(); itx++) {
+        flags[tiles.tile_index(itx, ity, iteta)] = 1;
+    }
+}
+
+
+void ActiveTiles::update(const SCGrid &arena, double e_threshold) {
+    const int ntiles = tiles.size();
+    // bounding box {x0, x1, y0, y1, eta0, eta1} of the hot cells of
+    // every tile; x0 > x1 if there is none
+    std::vector<std::array<int, 6>> hot_box(ntiles);
+    #pragma omp parallel for schedule(dynamic)
+    for (int itile = 0; itile < ntiles; itile++) {
+        std::array<int, 6> box = {{tiles.nX(), -1, tiles.nY(), -1,
+                                   tiles.nEta(), -1}};
+        tiles.for_each_cell_in_tile(itile, [&](int ix, int iy, int ieta) {
+            if (arena(ix, iy, ieta).epsilon > e_threshold) {
+                box[0] = std::min(box[0], ix);
+                box[1] = std::max(box[1], ix);
+                box[2] = std::min(box[2], iy);
+                box[3] = std::max(box[3], iy);
+                box[4] = std::min(box[4], ieta);
+                box[5] = std::max(box[5], ieta);
+            }
+        });
+        hot_box[itile] = box;
+    }
+
+    active.assign(ntiles, 0);
+    for (const auto &box : hot_box) {
+        if (box[0] > box[1]) continue;
+        mark_box(active, box[0] - margin, box[1] + margin,
+                 box[2] - margin, box[3] + margin,
+                 box[4] - margin, box[5] + margin);
+    }
+
+    needed.assign(ntiles, 0);
+    for (int itile = 0; itile < ntiles; itile++) {
+        if (!active[itile]) continue;
+        const int x0   = (itile%tiles.n_tiles_x())*tiles.tile_nx();
+        const int y0   = ((itile/tiles.n_tiles_x())%tiles.n_tiles_y())
+                         *tiles.tile_ny();
+        const int eta0 = (itile/(tiles.n_tiles_x()*tiles.n_tiles_y()))
+                         *tiles.tile_neta();
+        mark_box(needed, x0 - reach, x0 + tiles.tile_nx() - 1 + reach,
+                 y0 - reach, y0 + tiles.tile_ny() - 1 + reach,
+                 eta0 - reach, eta0 + tiles.tile_neta() - 1 + reach);
+    }
+}
+
+
+int ActiveTiles::n_active() const {
+    return static_cast<int>(std::count(active.begin(), active.end(), 1));
+}
+
+
+TEST_CASE("GridTiles visits every cell once, in storage order per tile") {
+    const int nx = 13, ny = 7, neta = 5;
+    GridTiles tiles(nx, ny, neta, 8, 4, 3, 2);
+    CHECK(tiles.size() == 4*3*3);
+
+    std::vector<int> visits(nx*ny*neta, 0);
+    for (int itile = 0; itile < tiles.size(); itile++) {
+        int last = -1;
+        tiles.for_each_cell_in_tile(itile, [&](int ix, int iy, int ieta) {
+            const int idx = nx*(ny*ieta + iy) + ix;
+            CHECK(idx > last);
+            last = idx;
+            visits[idx]++;
+        });
+    }
+    for (auto &v : visits) CHECK(v == 1);
+}
+
+TEST_CASE("GridTiles picks a tile shape automatically") {
+    GridTiles tiles(200, 200, 64, 500);
+    CHECK(tiles.tile_nx()   >= 1);
+    CHECK(tiles.tile_nx()   <= 200);
+    CHECK(tiles.tile_ny()   <= 200);
+    CHECK(tiles.tile_neta() <= 64);
+    CHECK(tiles.tile_nx()*tiles.tile_ny()*tiles.tile_neta()*500L
+          <= std::max(GridTiles::l2_cache_size(), 32L*500L));
+
+    GridTiles tiles_2d(201, 201, 1, 500);
+    CHECK(tiles_2d.tile_neta() == 1);
+
+    std::vector<int> visits(201*201, 0);
+    tiles_2d.for_each_cell([&](int ix, int iy, int ieta) {
+        visits[201*iy + ix] += 1 + ieta;
+    });
+    for (auto &v : visits) CHECK(v == 1);
+}
+
+TEST_CASE("ActiveTiles follows the cells above the threshold") {
+    const int nx = 32, ny = 24, neta = 3;
+    SCGrid arena(nx, ny, neta);
+    for (int ieta = 0; ieta < neta; ieta++)
+    for (int iy = 0; iy < ny; iy++)
+    for (int ix = 0; ix < nx; ix++) {
+        arena(ix, iy, ieta).epsilon = 1e-11;
+    }
+    GridTiles tiles(nx, ny, neta, 8, 4, 4, 1);
+    ActiveTiles active_tiles(tiles, 2, 2);
+    CHECK(active_tiles.n_active() == tiles.size());
+
+    active_tiles.update(arena, 1e-5);
+    CHECK(active_tiles.n_active() == 0);
+    CHECK(!active_tiles.cell_needed(0, 0, 0));
+
+    // a hot cell two cells away from the upper x edge of its tile;
+    // with margin 2 the active cells span x in [4, 11], y in [0, 7]
+    // and all of eta
+    arena(6, 5, 1).epsilon = 1.;
+    active_tiles.update(arena, 1e-5);
+    CHECK(active_tiles.n_active() == 2*2*3);
+    CHECK(active_tiles.cell_active(6, 5, 1));
+    CHECK(active_tiles.cell_active(11, 0, 0));
+    CHECK(!active_tiles.cell_active(3, 5, 1));
+    CHECK(!active_tiles.cell_active(12, 5, 1));
+    CHECK(!active_tiles.cell_active(6, 8, 1));
+
+    // needed: the active tiles plus 2 cells, rounded out to whole tiles
+    CHECK(active_tiles.cell_needed(0, 5, 1));
+    CHECK(active_tiles.cell_needed(15, 11, 2));
+    CHECK(!active_tiles.cell_needed(16, 5, 1));
+    CHECK(!active_tiles.cell_needed(6, 12, 1));
+
+    active_tiles.set_all_active();
+    CHECK(active_tiles.cell_active(31, 23, 2));
+}
@@ -0,0 +1,121 @@
+#ifndef SRC_GRID_TILES_H_
+#define SRC_GRID_TILES_H_
+
+#include <algorithm>
+#include <vector>
+#include "grid.h"
+
+//! Cache-blocked traversal of an nx*ny*neta grid.
+//! The grid is cut into tiles of tx*ty*teta cells. Threads take whole
+//! tiles and walk every tile in storage order (x fastest, then y, then
+//! eta), so consecutive iterations touch consecutive memory and the
+//! stencil neighbours of a tile stay in cache while it is worked on.
+class GridTiles {
+ private:
+    int nx, ny, neta;
+    int tx, ty, teta;       // tile extents
+    int ntx, nty, nteta;    // number of tiles in each direction
+
+ public:
+    //! Tile extents <= 0 are picked from the L2 cache size, assuming
+    //! bytes_per_cell bytes are touched for every cell of a tile.
+    GridTiles(int nx_in, int ny_in, int neta_in, int bytes_per_cell,
+              int tile_x = 0, int tile_y = 0, int tile_eta = 0);
+
+    int size()       const {return ntx*nty*nteta;}
+    int tile_nx()    const {return tx;}
+    int tile_ny()    const {return ty;}
+    int tile_neta()  const {return teta;}
+    int n_tiles_x()   const {return ntx;}
+    int n_tiles_y()   const {return nty;}
+    int n_tiles_eta() const {return nteta;}
+    int nX()   const {return nx;}
+    int nY()   const {return ny;}
+    int nEta() const {return neta;}
+
+    //! index of the tile at tile coordinates (itx, ity, iteta)
+    int tile_index(int itx, int ity, int iteta) const {
+        return itx + ntx*(ity + nty*iteta);
+    }
+    //! index of the tile that contains cell (ix, iy, ieta)
+    int tile_of(int ix, int iy, int ieta) const {
+        return tile_index(ix/tx, iy/ty, ieta/teta);
+    }
+
+    //! calls func(ix, iy, ieta) for every cell of tile itile,
+    //! in storage order
+    template<class Func>
+    void for_each_cell_in_tile(const int itile, Func func) const {
+        const int itx   = itile%ntx;
+        const int ity   = (itile/ntx)%nty;
+        const int iteta = itile/(ntx*nty);
+        const int x0    = itx*tx;
+        const int y0    = ity*ty;
+        const int eta0  = iteta*teta;
+        const int x1    = std::min(nx,   x0   + tx);
+        const int y1    = std::min(ny,   y0   + ty);
+        const int eta1  = std::min(neta, eta0 + teta);
+        for (int ieta = eta0; ieta < eta1; ieta++)
+        for (int iy   = y0;   iy   < y1;   iy++  )
+        for (int ix   = x0;   ix   < x1;   ix++  ) {
+            func(ix, iy, ieta);
+        }
+    }
+
+    //! parallel loop over all cells; for reductions, write the
+    //! omp loop over tiles by hand around for_each_cell_in_tile
+    template<class Func>
+    void for_each_cell(Func func) const {
+        #pragma omp parallel for schedule(dynamic)
+        for (int itile = 0; itile < size(); itile++) {
+            for_each_cell_in_tile(itile, func);
+        }
+    }
+
+    //! size of the L2 cache in bytes (256 kB if it cannot be determined)
+    static long l2_cache_size();
+};
+
+
+//! Activity mask over the tiles of a grid, used to skip the cells that sit
+//! at the vacuum floor. A tile is active if one of its cells lies within
+//! margin cells (along every axis) of a cell with epsilon above the
+//! threshold; only active cells are evolved. A tile is needed if one of
+//! its cells lies within reach cells of an active tile: the stencils of
+//! the active cells read these neighbours, so their EOS output and face
+//! fluxes are still evaluated.
+class ActiveTiles {
+ private:
+    GridTiles tiles;
+    int margin;
+    int reach;
+    std::vector<char> active;
+    std::vector<char> needed;
+
+    //! flags every tile that overlaps the cells [x0, x1] x [y0, y1] x
+    //! [eta0, eta1], clipped to the grid
+    void mark_box(std::vector<char> &flags, int x0, int x1, int y0, int y1,
+                  int eta0, int eta1) const;
+
+ public:
+    //! all tiles start active
+    ActiveTiles(const GridTiles &tiles_in, int margin_in, int reach_in);
+
+    const GridTiles& get_tiles() const {return tiles;}
+
+    void set_all_active();
+    //! e_threshold in the units of arena (1/fm^4)
+    void update(const SCGrid &arena, double e_threshold);
+
+    bool tile_active(int itile) const {return active[itile] != 0;}
+    bool tile_needed(int itile) const {return needed[itile] != 0;}
+    bool cell_active(int ix, int iy, int ieta) const {
+        return active[tiles.tile_of(ix, iy, ieta)] != 0;
+    }
+    bool cell_needed(int ix, int iy, int ieta) const {
+        return needed[tiles.tile_of(ix, iy, ieta)] != 0;
+    }
+    int n_active() const;
+};
+
+#endif  // SRC_GRID_TILES_H_
@@ -16,8 +16,10 @@
 
 using namespace std;
 
-Init::Init(const EOS &eosIn, InitData &DATA_in, hydro_source &hydro_source_in) :
-    DATA(DATA_in), eos(eosIn) , hydro_source_terms(hydro_source_in) {}
+Init::Init(const EOS &eosIn, InitData &DATA_in, hydro_source &hydro_source_in,
+           const Domain &domain_in) :
+    DATA(DATA_in), eos(eosIn) , hydro_source_terms(hydro_source_in),
+    domain(domain_in) {}
 
 void Init::InitArena(SCGrid &arena_prev, SCGrid &arena_current,
                      SCGrid &arena_future) {
@@ -105,7 +107,8 @@ void Init::InitArena(SCGrid &arena_prev, SCGrid &arena_current,
 
     InitTJb(arena_prev, arena_current);
 
-    if (DATA.output_initial_density_profiles == 1) {
+    // every rank sets up the whole grid, the root rank writes it out
+    if (DATA.output_initial_density_profiles == 1 && domain.is_root()) {
         output_initial_density_profiles(arena_current);
     }
 }/* InitArena */
@@ -207,7 +210,7 @@ void Init::InitTJb(SCGrid &arena_prev, SCGrid &arena_current) {
     } else if (DATA.Initial_profile == 101) {
         initial_UMN_with_rhob(arena_prev, arena_current);
     }
-    output_2D_eccentricities(0, arena_current);
+    if (domain.is_root()) output_2D_eccentricities(0, arena_current);
     music_message.info("initial distribution done.");
 }
 
@@ -441,7 +444,15 @@ void Init::initial_IPGlasma_XY(int ieta, SCGrid &arena_prev,
     double eta = (DATA.delta_eta)*ieta - (DATA.eta_size)/2.0;
     double eta_envelop_ed = eta_profile_normalisation(eta);
     int entropy_flag = DATA.initializeEntropy;
+    vector<double> local_sd(ny), rhob_y(ny, 0.), epsilon_y(ny);
     for (int ix = 0; ix < nx; ix++) {
+        if (entropy_flag != 0) {
+            for (int iy = 0; iy < ny; iy++) {
+                local_sd[iy] = (temp_profile_ed[ix][iy]*DATA.sFactor
+                                *eta_envelop_ed);
+            }
+            eos.get_s2e(ny, local_sd.data(), rhob_y.data(), epsilon_y.data());
+        }
         for (int iy = 0; iy< ny; iy++) {
             double rhob = 0.0;
             double epsilon = 0.0;
@@ -449,9 +460,7 @@ void Init::initial_IPGlasma_XY(int ieta, SCGrid &arena_prev,
                 epsilon = (temp_profile_ed[ix][iy]*eta_envelop_ed
                            *DATA.sFactor/hbarc);  // 1/fm^4
             } else {
-                double local_sd = (temp_profile_ed[ix][iy]*DATA.sFactor
-                                   *eta_envelop_ed);
-                epsilon = eos.get_s2e(local_sd, rhob);
+                epsilon = epsilon_y[iy];
             }
             if (epsilon < 0.00000000001)
                 epsilon = 0.00000000001;
@@ -566,7 +575,15 @@ void Init::initial_IPGlasma_XY_with_pi(int ieta, SCGrid &arena_prev,
     double eta = (DATA.delta_eta)*(ieta) - (DATA.eta_size)/2.0;
     double eta_envelop_ed = eta_profile_normalisation(eta);
     int entropy_flag = DATA.initializeEntropy;
+    vector<double> local_sd(ny), rhob_y(ny, 0.), epsilon_y(ny);
     for (int ix = 0; ix < nx; ix++) {
+        if (entropy_flag != 0) {
+            for (int iy = 0; iy < ny; iy++) {
+                local_sd[iy] = (temp_profile_ed[iy + ix*ny]*DATA.sFactor
+                                *eta_envelop_ed);
+            }
+            eos.get_s2e(ny, local_sd.data(), rhob_y.data(), epsilon_y.data());
+        }
         for (int iy = 0; iy< ny; iy++) {
             int idx = iy + ix*ny;
             double rhob = 0.0;
@@ -575,9 +592,7 @@ void Init::initial_IPGlasma_XY_with_pi(int ieta, SCGrid &arena_prev,
                 epsilon = (temp_profile_ed[idx]*eta_envelop_ed
                            *DATA.sFactor/hbarc);  // 1/fm^4
             } else {
-                double local_sd = (temp_profile_ed[idx]*DATA.sFactor
-                                   *eta_envelop_ed);
-                epsilon = eos.get_s2e(local_sd, rhob);
+                epsilon = epsilon_y[iy];
             }
             if (epsilon < 0.00000000001)
                 epsilon = 0.00000000001;
@@ -652,29 +667,34 @@ void Init::initial_MCGlb_with_rhob_XY(int ieta, SCGrid &arena_prev,
     double eta_rhob_right    = eta_rhob_right_factor(eta);
 
     int entropy_flag = DATA.initializeEntropy;
+    vector<double> local_sd(ny), rhob_y(ny), epsilon_y(ny);
     for (int ix = 0; ix < nx; ix++) {
         for (int iy = 0; iy< ny; iy++) {
-            double rhob = 0.0;
-            double epsilon = 0.0;
             if (DATA.turn_on_rhob == 1) {
-                rhob = (
+                rhob_y[iy] = (
                     (temp_profile_rhob_TA[ix][iy]*eta_rhob_left
                      + temp_profile_rhob_TB[ix][iy]*eta_rhob_right));
             } else {
-                rhob = 0.0;
+                rhob_y[iy] = 0.0;
             }
             if (entropy_flag == 0) {
-                epsilon = (
+                epsilon_y[iy] = (
                     (temp_profile_TA[ix][iy]*eta_envelop_left
                      + temp_profile_TB[ix][iy]*eta_envelop_right)
                     *DATA.sFactor/hbarc);   // 1/fm^4
             } else {
-                double local_sd = (
+                local_sd[iy] = (
                     (temp_profile_TA[ix][iy]*eta_envelop_left
                      + temp_profile_TB[ix][iy]*eta_envelop_right)
                     *DATA.sFactor);         // 1/fm^3
-                epsilon = eos.get_s2e(local_sd, rhob);
             }
+        }
+        if (entropy_flag != 0) {
+            eos.get_s2e(ny, local_sd.data(), rhob_y.data(), epsilon_y.data());
+        }
+        for (int iy = 0; iy< ny; iy++) {
+            double rhob = rhob_y[iy];
+            double epsilon = epsilon_y[iy];
             if (epsilon < 0.00000000001)
                 epsilon = 0.00000000001;
 
@@ -712,12 +732,14 @@ void Init::initial_trento_XY(int ieta, SCGrid &arena_prev, SCGrid &arena_current
                 exit(1);
             }
 
+            vector<double> s(nx), rhob_x(nx, 0.), epsilon_x(nx);
             for (size_t ix = 0; ix < nx; ix++) {
-                double s = lineVector[ix];
-                s /= hbarc;//
+                s[ix] = lineVector[ix]/hbarc;
+            }
+            eos.get_s2e(nx, s.data(), rhob_x.data(), epsilon_x.data());
 
-                double epsilon = eos.get_s2e(s, 0.0);
-                epsilon = max(epsilon, 1e-11);
+            for (size_t ix = 0; ix < nx; ix++) {
+                double epsilon = max(epsilon_x[ix], 1e-11);
 
                 double rhob = 0.;
 
@@ -948,21 +970,24 @@ void Init::initial_UMN_with_rhob(SCGrid &arena_prev, SCGrid &arena_current) {
 
     double dummy;
     double ed_local, rhob_local;
+    vector<double> sd_bg(ny), rhob_bg(ny, 0.), ed_bg(ny);
     for (int ieta = 0; ieta < DATA.neta; ieta++) {
         double eta = (DATA.delta_eta)*ieta - (DATA.eta_size)/2.0;
         double eta_envelop_left = eta_profile_left_factor(eta);
         double eta_envelop_right = eta_profile_right_factor(eta);
         for (int ix = 0; ix < nx; ix++) {
+            for (int iy = 0; iy < ny; iy++) {
+                sd_bg[iy] = (
+                      temp_profile_TA[ix][iy]*eta_envelop_left
+                    + temp_profile_TB[ix][iy]*eta_envelop_right)*DATA.sFactor;
+            }
+            eos.get_s2e(ny, sd_bg.data(), rhob_bg.data(), ed_bg.data());
             for (int iy = 0; iy< ny; iy++) {
                 double rhob = 0.0;
                 double epsilon = 0.0;
                 profile >> dummy >> dummy >> dummy >> ed_local >> rhob_local;
                 rhob = rhob_local;
-                double sd_bg = (
-                      temp_profile_TA[ix][iy]*eta_envelop_left
-                    + temp_profile_TB[ix][iy]*eta_envelop_right)*DATA.sFactor;
-                double ed_bg = eos.get_s2e(sd_bg, 0.0);
-                epsilon = ed_bg + ed_local/hbarc;    // 1/fm^4
+                epsilon = ed_bg[iy] + ed_local/hbarc;    // 1/fm^4
                 if (epsilon < 0.00000000001) {
                     epsilon = 0.00000000001;
                 }
@@ -1143,7 +1168,7 @@ void Init::output_initial_density_profiles(SCGrid &arena) {
     // and net baryon density profile (if turn_on_rhob == 1)
     // for checking purpose
     music_message.info("output initial density profiles into a file... ");
-    ofstream of("check_initial_density_profiles.dat");
+    ofstream of(DATA.output_dir + "check_initial_density_profiles.dat");
     of << "# x(fm)  y(fm)  eta  ed(GeV/fm^3)";
     if (DATA.turn_on_rhob == 1)
         of << "  rhob(1/fm^3)";
@@ -1170,7 +1195,7 @@ void Init::output_initial_density_profiles(SCGrid &arena) {
 void Init::output_2D_eccentricities(int ieta, SCGrid &arena) {
     // this function outputs a set of eccentricities (cumulants) to a file
     music_message.info("output initial eccentricities into a file... ");
-    ofstream of("ecc.dat");
+    ofstream of(DATA.output_dir + "ecc.dat");
     of << "#No recentering correction has been made! Must use full expression for cumulants!\n";
     of << "#i\tj\t<z^i zbar^j>_eps\t<z^i zbar^j>_U\t<z^i zbar^j>_Ubar\t<z^i zbar^j>_s\n";
     int zmax = 12;
@@ -1259,7 +1284,7 @@ void Init::output_2D_eccentricities(int ieta, SCGrid &arena) {
 	cout << "eps2 = " << abs(-W22/W02) << endl;
 	cout << "shear= " << DATA.shear_to_s << endl;
 ofstream outfile4;
-outfile4.open("excE.dat",ios::out|ios::app);
+outfile4.open(DATA.output_dir + "excE.dat",ios::out|ios::app);
 outfile4 << "#eps2      eps3      eps4      eps5      eps6      eps7\n";
 outfile4<<" " << abs(-W22/W02) << " " << abs(-W33/pow(W02,1.5)) <<
 " " << abs(-eps[4][0]/eps[2][2]) << " " << abs(-W55/pow(W02,2.5)) << " " << abs(-eps[6][0]/eps[3][3])
@@ -1270,7 +1295,7 @@ outfile4.close();
 	cout << "Using entropy as weight instead of energy density:\n";
 	cout << "eps2S = " << abs(-SW22/SW02) << endl;
 ofstream outfile3;
-outfile3.open("excS.dat",ios::out|ios::app);
+outfile3.open(DATA.output_dir + "excS.dat",ios::out|ios::app);
 outfile3<<" " << abs(-SW22/SW02) << " " << arg(-SW22/SW02) <<endl;
 outfile3.close();
 	cout << "eps3S = " << -SW33/pow(SW02,1.5) << endl;
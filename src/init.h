@@ -12,6 +12,7 @@
 #include "grid.h"
 #include "eos.h"
 #include "hydro_source.h"
+#include "domain.h"
 #include "pretty_ostream.h"
 
 class Init {
@@ -19,10 +20,12 @@ class Init {
     InitData &DATA;
     const EOS &eos;
     hydro_source &hydro_source_terms;
+    const Domain &domain;
     pretty_ostream music_message;
 
  public:
-    Init(const EOS &eos, InitData &DATA_in, hydro_source &hydro_source_in);
+    Init(const EOS &eos, InitData &DATA_in, hydro_source &hydro_source_in,
+         const Domain &domain_in);
 
     void InitArena(SCGrid &arena_prev, SCGrid &arena_current,
                    SCGrid &arena_future);
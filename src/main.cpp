@@ -6,6 +6,7 @@
 #include <sys/stat.h>
 
 #include "music.h"
+#include "ensemble.h"
 #include "music_logo.h"
 
 // main program
@@ -13,13 +14,22 @@ int main(int argc, char *argv[]) {
     std::string input_file;
     InitData DATA __attribute__ ((aligned (64)));
 
+    Domain::initialize(argc, argv);
     if (argc > 1)
         input_file = *(argv+1);
     else
         input_file = "";
 
     MUSIC_LOGO::welcome_message();
-    MUSIC music_hydro(input_file);
+    const ParameterList parameters = ParameterList::from_file(input_file);
+    if (parameters.has("ensemble_list")) {
+        Ensemble ensemble(parameters);
+        ensemble.run();
+        Domain::finalize();
+        return(0);
+    }
+
+    MUSIC music_hydro(parameters);
     int running_mode = music_hydro.get_running_mode();
 
     if (running_mode == 1 || running_mode == 2) {
@@ -39,6 +49,7 @@ int main(int argc, char *argv[]) {
         music_hydro.output_transport_coefficients();
     }
 
+    Domain::finalize();
     return(0);
 }  /* main */
 
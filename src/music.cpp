@@ -17,6 +17,16 @@ MUSIC::MUSIC(std::string input_file) :
 }
 
 
+MUSIC::MUSIC(const ParameterList &parameters) :
+    DATA(ReadInParameters::read_in_parameters(parameters)),
+    eos(DATA),
+    hydro_source_terms(DATA) {
+    mode = DATA.mode;
+    flag_hydro_run = 0;
+    flag_hydro_initialized = 0;
+}
+
+
 MUSIC::~MUSIC() {
     if (flag_hydro_initialized == 1) {
         delete init;
@@ -34,8 +44,15 @@ int MUSIC::initialize_hydro() {
 //    int status = system(
 //                    "rm surface.dat surface?.dat surface??.dat 2> /dev/null");
 
-    init = new Init(eos, DATA, hydro_source_terms);
+    init = new Init(eos, DATA, hydro_source_terms, domain);
     init->InitArena(arena_prev, arena_current, arena_future);
+    // every rank sets up the whole grid and keeps its own slices
+    domain.decompose(arena_current.nEta());
+    if (domain.n_ranks() > 1) {
+        arena_prev    = domain.local_slab(arena_prev);
+        arena_current = domain.local_slab(arena_current);
+        arena_future  = domain.local_slab(arena_future);
+    }
     flag_hydro_initialized = 1;
     return(1);
 }
@@ -47,7 +64,9 @@ int MUSIC::run_hydro() {
         delete evolve;
     }
 
-    evolve = new Evolve(eos, DATA, hydro_source_terms);
+    evolve = new Evolve(eos, DATA, hydro_source_terms, domain);
+    // Cooper-Frye follows in this process and takes the surface in memory
+    if (mode == 1) evolve->keep_surface_in_memory();
 
     evolve->EvolveIt(arena_prev, arena_current, arena_future);
         
@@ -58,10 +77,15 @@ int MUSIC::run_hydro() {
 
 //! this is a shell function to run Cooper-Frye
 int MUSIC::run_Cooper_Frye() {
+    // the merged freeze-out surface is read on the root rank
+    if (!domain.is_root()) return(0);
     if (freeze != nullptr) {
         delete freeze;
     }
     freeze = new Freeze(&DATA);
+    if (flag_hydro_run == 1 && mode == 1 && domain.n_ranks() == 1) {
+        freeze->set_freeze_out_surface(evolve->take_surface());
+    }
     freeze->CooperFrye_pseudo(DATA.particleSpectrumNumber, mode, &DATA, &eos);
     return(0);
 }
@@ -10,6 +10,7 @@
 #include "init.h"
 #include "eos.h"
 #include "evolve.h"
+#include "domain.h"
 #include "hydro_source.h"
 #include "read_in_parameters.h"
 #include "pretty_ostream.h"
@@ -34,6 +35,9 @@ class MUSIC {
     SCGrid arena_current;
     SCGrid arena_future;
 
+    //! the eta slices of the hydro grid that this MPI rank evolves
+    Domain domain;
+
     Init *init     = nullptr;
     Evolve *evolve = nullptr;
     Freeze *freeze = nullptr;
@@ -44,6 +48,7 @@ class MUSIC {
 
  public:
     MUSIC(std::string input_file);
+    MUSIC(const ParameterList &parameters);
     ~MUSIC();
 
     //! this function returns the running mode
@@ -0,0 +1,109 @@
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "parameter_list.h"
+#include "pretty_ostream.h"
+#include "util.h"
+#include "doctest.h"
+
+using std::string;
+
+ParameterList ParameterList::from_file(const string &input_file) {
+    if (!Util::IsFile(input_file)) {
+        string tmpfilename = "input.default";
+        if (input_file == "") {
+            fprintf(stderr, "No input file name specified.\n");
+            fprintf(stderr, "Creating a default file named input.default\n");
+        } else {
+            std::cerr << "The file named " << input_file << " is absent."
+                      << std::endl;
+            std::cout << "Creating " << input_file << "..." << std::endl;
+            tmpfilename = input_file;
+        }
+        std::ofstream tmp_file(tmpfilename.c_str());
+        tmp_file << "EndOfData" << std::endl;
+        tmp_file.close();
+        exit(1);
+    }
+    std::ifstream input(input_file.c_str());
+    return from_stream(input);
+}
+
+
+ParameterList ParameterList::from_stream(std::istream &input) {
+    ParameterList parameters;
+    string line;
+    while (getline(input, line) && line.compare("EndOfData") != 0) {
+        string para_string;
+        std::stringstream line_ss(line);
+        getline(line_ss, para_string, '#');  // remove the comments
+        string para_name, para_val;
+        std::stringstream para_stream(para_string);
+        if (!(para_stream >> para_name)) continue;
+        para_stream >> para_val;
+        if (parameters.values.count(para_name) == 0) {
+            parameters.names.push_back(para_name);
+            parameters.values[para_name] = para_val;
+        }
+    }
+    return parameters;
+}
+
+
+void ParameterList::warn_bad_value(const string &name) const {
+    pretty_ostream music_message;
+    music_message << "Can not read the value \"" << values.at(name)
+                  << "\" of parameter " << name << ", using its default.";
+    music_message.flush("warning");
+}
+
+
+std::vector<string> ParameterList::unused_names() const {
+    std::vector<string> unused;
+    for (const auto &name : names) {
+        if (requested.count(name) == 0) unused.push_back(name);
+    }
+    return unused;
+}
+
+
+TEST_CASE("ParameterList reads an input file in one pass") {
+    std::istringstream input(
+        "# a comment line\n"
+        "echo_level  1       # trailing comment\n"
+        "\n"
+        "Delta_Tau   0.02\n"
+        "echo_level  5\n"
+        "freeze_out_method 4\n"
+        "Initial_Distribution_input_filename  initial/sd.dat\n"
+        "EndOfData\n"
+        "after_the_end 1\n");
+    const ParameterList parameters = ParameterList::from_stream(input);
+
+    CHECK(parameters.get("echo_level", 9) == 1);
+    CHECK(parameters.get("Delta_Tau", 0.1) == 0.02);
+    CHECK(parameters.get("Eta_grid_size", 14.) == 14.);
+    CHECK(parameters.get("Initial_Distribution_input_filename", "")
+          == "initial/sd.dat");
+    CHECK(parameters.has("Delta_Tau"));
+    CHECK(!parameters.has("after_the_end"));
+    CHECK(parameters.unused_names() == std::vector<string>{"freeze_out_method"});
+}
+
+TEST_CASE("ParameterList can be set up in memory") {
+    ParameterList parameters;
+    parameters.set("Delta_Tau", 0.1/3.);
+    parameters.set("mode", 2);
+    parameters.set("mode", 3);
+    parameters.set("Initial_Distribution_input_filename", "sd.dat");
+    CHECK(parameters.get("Delta_Tau", 0.) == 0.1/3.);
+    CHECK(parameters.get("mode", 1) == 3);
+    CHECK(parameters.get("Initial_Distribution_input_filename", "")
+          == "sd.dat");
+
+    parameters.set("Eta_grid_size", "wide");
+    CHECK(parameters.get("Eta_grid_size", 14.) == 14.);
+}
@@ -0,0 +1,72 @@
+#ifndef SRC_PARAMETER_LIST_H_
+#define SRC_PARAMETER_LIST_H_
+
+#include <iomanip>
+#include <istream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+//! Input parameters of one run as name -> value pairs.
+//! from_file() reads a MUSIC input file in a single pass: one "name value"
+//! pair per line, '#' starts a comment, reading stops at EndOfData, and
+//! the first occurrence of a name wins. Batch drivers can instead set()
+//! the values in memory and never touch the filesystem.
+class ParameterList {
+ private:
+    std::unordered_map<std::string, std::string> values;
+    std::vector<std::string> names;     // in the order they were given
+    mutable std::unordered_set<std::string> requested;
+
+    void warn_bad_value(const std::string &name) const;
+
+ public:
+    //! exits if input_file does not exist, after creating it with a
+    //! single EndOfData line as a template
+    static ParameterList from_file(const std::string &input_file);
+    static ParameterList from_stream(std::istream &input);
+
+    //! sets or overrides a parameter
+    template<class T>
+    void set(const std::string &name, const T &value) {
+        std::ostringstream ss;
+        ss << std::setprecision(std::numeric_limits<double>::max_digits10)
+           << value;
+        if (values.count(name) == 0) names.push_back(name);
+        values[name] = ss.str();
+    }
+
+    bool has(const std::string &name) const {
+        requested.insert(name);
+        return values.count(name) > 0;
+    }
+
+    //! value of name converted to T, or default_value if it is not set
+    //! or cannot be read as a T
+    template<class T>
+    T get(const std::string &name, const T &default_value) const {
+        requested.insert(name);
+        const auto it = values.find(name);
+        if (it == values.end()) return default_value;
+        T value = default_value;
+        std::istringstream ss(it->second);
+        if (!(ss >> value)) {
+            warn_bad_value(name);
+            return default_value;
+        }
+        return value;
+    }
+
+    std::string get(const std::string &name,
+                    const char *default_value) const {
+        return get<std::string>(name, default_value);
+    }
+
+    //! names that were given but never asked for by get() or has()
+    std::vector<std::string> unused_names() const;
+};
+
+#endif  // SRC_PARAMETER_LIST_H_
@@ -1,7 +1,10 @@
 
 #include <iostream>
+#include <algorithm>
 #include <cstring>
+#include <sys/stat.h>
 #include "./read_in_parameters.h"
+#include "./domain.h"
 
 using namespace std;
 
@@ -10,96 +13,77 @@ namespace ReadInParameters {
 pretty_ostream music_message;
 
 InitData read_in_parameters(std::string input_file) {
-    InitData parameter_list;
+    return read_in_parameters(ParameterList::from_file(input_file));
+}
 
-    // this function reads in parameters
-    string tempinput;
+
+InitData read_in_parameters(const ParameterList &parameters) {
+    InitData parameter_list;
 
     // echo_level controls the mount of
     // warning message output during the evolution
-    double temp_echo_level = 9;
-    tempinput = Util::StringFind4(input_file, "echo_level");
-    if(tempinput != "empty") istringstream ( tempinput ) >> temp_echo_level;
+    double temp_echo_level = parameters.get<double>("echo_level", 9);
     parameter_list.echo_level = temp_echo_level;
 
 
     // Initial_profile:
-    int tempInitial_profile = 1;
-    tempinput = Util::StringFind4(input_file, "Initial_profile");
-    if (tempinput != "empty") istringstream(tempinput) >> tempInitial_profile;
+    int tempInitial_profile = parameters.get<int>("Initial_profile", 1);
     parameter_list.Initial_profile = tempInitial_profile;
 
     // Initial_profile:
-    int temp_string_dump_mode = 1;
-    tempinput = Util::StringFind4(input_file, "string_dump_mode");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_string_dump_mode;
+    int temp_string_dump_mode = parameters.get<int>("string_dump_mode", 1);
     parameter_list.string_dump_mode = temp_string_dump_mode;
 
     // hydro source
-    double temp_string_quench_factor = 0.;
-    tempinput = Util::StringFind4(input_file, "string_quench_factor");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_string_quench_factor;
+    double temp_string_quench_factor = parameters.get<double>(
+        "string_quench_factor", 0.);
     parameter_list.string_quench_factor = temp_string_quench_factor;
 
     // hydro source
-    double temp_parton_quench_factor = 1.;
-    tempinput = Util::StringFind4(input_file, "parton_quench_factor");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_parton_quench_factor;
+    double temp_parton_quench_factor = parameters.get<double>(
+        "parton_quench_factor", 1.);
     parameter_list.parton_quench_factor = temp_parton_quench_factor;
 
     // boost-invariant
-    int temp_boost_invariant = 0;
-    tempinput = Util::StringFind4(input_file, "boost_invariant");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_boost_invariant;
+    int temp_boost_invariant = parameters.get<int>("boost_invariant", 0);
     if (temp_boost_invariant == 0) {
         parameter_list.boost_invariant = false;
     } else {
         parameter_list.boost_invariant = true;
     }
 
-    int temp_output_initial_profile = 0;
-    tempinput = Util::StringFind4(input_file,
-                                  "output_initial_density_profiles");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_output_initial_profile;
+    // transverse_boundary: boundary condition in x and y
+    // 0: zero gradient, 1: periodic, 2: reflective
+    int temp_transverse_boundary = parameters.get<int>(
+        "transverse_boundary", 0);
+    parameter_list.transverse_boundary = temp_transverse_boundary;
+
+    int temp_output_initial_profile = parameters.get<int>(
+        "output_initial_density_profiles", 0);
     parameter_list.output_initial_density_profiles =
                                             temp_output_initial_profile;
 
     //Select the profile to use in eta for the energy/entropy initialisation
     //1 for Hirano's central plateau + Gaussian decay
     //2 for a Woods-Saxon proinput_file
-    int tempinitial_eta_profile = 1;
-    tempinput = Util::StringFind4(input_file, "initial_eta_profile");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempinitial_eta_profile;
+    int tempinitial_eta_profile = parameters.get<int>("initial_eta_profile", 1);
     parameter_list.initial_eta_profile = tempinitial_eta_profile;
 
     // eta envelope function parameter for rhob
-    int temp_rhob_flag = 1;
-    tempinput = Util::StringFind4(input_file, "initial_eta_rhob_profile");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_rhob_flag;
+    int temp_rhob_flag = parameters.get<int>("initial_eta_rhob_profile", 1);
     parameter_list.initial_eta_rhob_profile = temp_rhob_flag;
 
     //initialize_with_entropy:
     //0: scale with energy density
     //1: scale with entropy density
-    int tempinitializeEntropy = 0;
-    tempinput = Util::StringFind4(input_file, "initialize_with_entropy");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempinitializeEntropy;
+    int tempinitializeEntropy = parameters.get<int>(
+        "initialize_with_entropy", 0);
     parameter_list.initializeEntropy = tempinitializeEntropy;
 
     // T_freeze: freeze out temperature
     // only used with use_eps_for_freeze_out = 0
-    double tempTFO = 0.12;
-    tempinput = Util::StringFind4(input_file, "T_freeze");
-    if (tempinput != "empty") {
-        istringstream(tempinput) >> tempTFO;
+    double tempTFO = parameters.get<double>("T_freeze", 0.12);
+    if (parameters.has("T_freeze")) {
         // if only freeze out temperature is set, freeze out by temperature
         parameter_list.useEpsFO = 0;
     }
@@ -107,72 +91,85 @@ InitData read_in_parameters(std::string input_file) {
 
     // epsilon_freeze: freeze-out energy density in GeV/fm^3
     // only used with use_eps_for_freeze_out = 1
-    double tempepsilonFreeze = 0.12;
-    tempinput = Util::StringFind4(input_file, "epsilon_freeze");
-    if (tempinput != "empty") {
-        istringstream(tempinput) >> tempepsilonFreeze;
+    double tempepsilonFreeze = parameters.get<double>("epsilon_freeze", 0.12);
+    if (parameters.has("epsilon_freeze")) {
         // if epsilon_freeze is set, freeze out by epsilon
         parameter_list.useEpsFO = 1;
     }
     parameter_list.epsilonFreeze = tempepsilonFreeze;
 
-    int temp_N_freeze_out = 1;
-    tempinput = Util::StringFind4(input_file, "N_freeze_out");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_N_freeze_out;
+    int temp_N_freeze_out = parameters.get<int>("N_freeze_out", 1);
     parameter_list.N_freeze_out = temp_N_freeze_out;
 
     //use_eps_for_freeze_out:
     // 0: freeze out at constant temperature T_freeze
     // 1: freeze out at constant energy density epsilon_freeze
     // if set in input input_file, overide above defaults
-    int tempuseEpsFO = parameter_list.useEpsFO;
-    tempinput = Util::StringFind4(input_file, "use_eps_for_freeze_out");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempuseEpsFO;
+    int tempuseEpsFO = parameters.get<int>(
+        "use_eps_for_freeze_out", parameter_list.useEpsFO);
     parameter_list.useEpsFO = tempuseEpsFO;
 
-    string temp_freeze_list_filename = "eps_freeze_list_s95p_v1.dat";
-    tempinput = Util::StringFind4(input_file, "freeze_list_filename");
-    if (tempinput != "empty")
-        temp_freeze_list_filename.assign(tempinput);
+    string temp_freeze_list_filename = parameters.get(
+        "freeze_list_filename", "eps_freeze_list_s95p_v1.dat");
     parameter_list.freeze_list_filename.assign(temp_freeze_list_filename);
 
-    double temp_eps_freeze_max = 0.18;
-    tempinput = Util::StringFind4(input_file, "eps_freeze_max");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_eps_freeze_max;
+    double temp_eps_freeze_max = parameters.get<double>("eps_freeze_max", 0.18);
     parameter_list.eps_freeze_max = temp_eps_freeze_max;
 
-    double temp_eps_freeze_min = 0.18;
-    tempinput = Util::StringFind4(input_file, "eps_freeze_min");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_eps_freeze_min;
+    double temp_eps_freeze_min = parameters.get<double>("eps_freeze_min", 0.18);
     parameter_list.eps_freeze_min = temp_eps_freeze_min;
 
-    int temp_freeze_eps_flag = 0;
-    tempinput = Util::StringFind4(input_file, "freeze_eps_flag");
-    if (tempinput != "empty")
-        istringstream (tempinput) >> temp_freeze_eps_flag;
+    int temp_freeze_eps_flag = parameters.get<int>("freeze_eps_flag", 0);
     parameter_list.freeze_eps_flag = temp_freeze_eps_flag;
 
-    int temp_freeze_surface_binary = 0;
-    tempinput = Util::StringFind4(input_file, "freeze_surface_in_binary");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_freeze_surface_binary;
+    int temp_freeze_surface_binary = parameters.get<int>(
+        "freeze_surface_in_binary", 0);
     if (temp_freeze_surface_binary == 0) {
         parameter_list.freeze_surface_in_binary = false;
     } else {
         parameter_list.freeze_surface_in_binary = true;
     }
 
+    // freeze_surface_double_precision: 1 writes the values of the binary
+    // surface as doubles, 0 as floats
+    int temp_freeze_surface_double = parameters.get<int>(
+        "freeze_surface_double_precision", 0);
+    parameter_list.freeze_surface_double_precision = (
+                                        temp_freeze_surface_double != 0);
+
+    // freeze_surface_to_file: 0 keeps the surface in memory only, for the
+    // Cooper-Frye of the same run (mode 1 on a single MPI rank)
+    int temp_freeze_surface_to_file = parameters.get<int>(
+        "freeze_surface_to_file", 1);
+    parameter_list.freeze_surface_to_file = (temp_freeze_surface_to_file != 0);
+
+    // freeze_surface_index_for_spectra: with several freeze-out
+    // thresholds, Cooper-Frye uses the surface of the threshold with this
+    // index (from 0) in their list
+    int temp_freeze_surface_index = parameters.get<int>(
+        "freeze_surface_index_for_spectra", 0);
+    parameter_list.freeze_surface_index_for_spectra = (
+                                                temp_freeze_surface_index);
+
+    // freeze_out_band_margin: the freeze-out surface of 3+1D runs is only
+    // searched within this many cubes of the surface of the last
+    // freeze-out step (0: all cubes are searched at every step)
+    // freeze_out_full_sweep_every: number of freeze-out steps after which
+    // all cubes are searched again
+    int temp_freeze_out_band_margin = parameters.get<int>(
+        "freeze_out_band_margin", 0);
+    parameter_list.freeze_out_band_margin = std::max(
+        0, temp_freeze_out_band_margin);
+    int temp_freeze_out_full_sweep_every = parameters.get<int>(
+        "freeze_out_full_sweep_every", 10);
+    parameter_list.freeze_out_full_sweep_every = std::max(
+        1, temp_freeze_out_full_sweep_every);
+
     //particle_spectrum_to_compute:
     // 0: Do all up to number_of_particles_to_include
     // any natural number: Do the particle with this (internal) ID
-    int tempparticleSpectrumNumber = 0;
-    tempinput = Util::StringFind4(input_file, "particle_spectrum_to_compute");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempparticleSpectrumNumber;
+    int tempparticleSpectrumNumber = parameters.get<int>(
+        "particle_spectrum_to_compute", 0);
     parameter_list.particleSpectrumNumber = tempparticleSpectrumNumber;
 
     // mode:
@@ -183,14 +180,11 @@ InitData read_in_parameters(std::string input_file) {
     // 4: Resonance decays only.
     // 13: Compute observables from previously-computed thermal spectra
     // 14: Compute observables from post-decay spectra
-    int tempmode = 1;
-    tempinput = Util::StringFind4(input_file, "mode");
-    if (tempinput != "empty") {
-        istringstream(tempinput) >> tempmode;
-    } else {
+    if (!parameters.has("mode")) {
         music_message.error("Must specify mode. Exiting.");
         exit(1);
     }
+    int tempmode = parameters.get<int>("mode", 1);
     parameter_list.mode = tempmode;
 
     //EOS_to_use:
@@ -207,64 +201,40 @@ InitData read_in_parameters(std::string input_file) {
     // 10: finite muB EOS from A. Monnai (up to mu_B^4)
     // 11: finite muB EOS from Pasi
     // 12: finite muB EOS from A. Monnai (up to mu_B^6)
-    int tempwhichEOS = 2;
-    tempinput = Util::StringFind4(input_file, "EOS_to_use");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempwhichEOS;
+    int tempwhichEOS = parameters.get<int>("EOS_to_use", 2);
     parameter_list.whichEOS = tempwhichEOS;
 
     // number_of_particles_to_include:
     // This determines up to which particle in the list spectra
     // should be computed (mode=3) or resonances should be included (mode=4)
     // current maximum = 319
-    int tempNumberOfParticlesToInclude = 2;
-    tempinput = Util::StringFind4(input_file,
-                                  "number_of_particles_to_include");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempNumberOfParticlesToInclude;
+    int tempNumberOfParticlesToInclude = parameters.get<int>(
+        "number_of_particles_to_include", 2);
     parameter_list.NumberOfParticlesToInclude = tempNumberOfParticlesToInclude;
 
     // freeze_out_method:
     // 2: Schenke's more complex method
-    int tempfreezeOutMethod = 4;
-    tempinput = Util::StringFind4(input_file, "freeze_out_method");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempfreezeOutMethod;
+    int tempfreezeOutMethod = parameters.get<int>("freeze_out_method", 4);
     parameter_list.freezeOutMethod = tempfreezeOutMethod;
 
     // average_surface_over_this_many_time_steps:
     // Only save every N timesteps for finding freeze out surface
-    int tempfacTau = 1;
-    tempinput = Util::StringFind4(input_file,
-                                  "average_surface_over_this_many_time_steps");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempfacTau;
+    int tempfacTau = parameters.get<int>(
+        "average_surface_over_this_many_time_steps", 1);
     parameter_list.facTau = tempfacTau;
 
-    int tempfac_x = 1;
-    tempinput = Util::StringFind4(input_file, "freeze_Ncell_x_step");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempfac_x;
+    int tempfac_x = parameters.get<int>("freeze_Ncell_x_step", 1);
     parameter_list.fac_x = tempfac_x;
     parameter_list.fac_y = tempfac_x;
 
-    int tempfac_eta = 1;
-    tempinput = Util::StringFind4(input_file, "freeze_Ncell_eta_step");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempfac_eta;
+    int tempfac_eta = parameters.get<int>("freeze_Ncell_eta_step", 1);
     parameter_list.fac_eta = tempfac_eta;
 
     // Grid_size_in_*
     // number of cells in x,y direction
-    int tempnx = 10;
-    tempinput = Util::StringFind4(input_file, "Grid_size_in_x");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempnx;
+    int tempnx = parameters.get<int>("Grid_size_in_x", 10);
     parameter_list.nx = tempnx;
-    int tempny = 10;
-    tempinput = Util::StringFind4(input_file, "Grid_size_in_y");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempny;
+    int tempny = parameters.get<int>("Grid_size_in_y", 10);
     parameter_list.ny = tempny;
 
     // Grid_size_in_eta
@@ -272,31 +242,45 @@ InitData read_in_parameters(std::string input_file) {
     // One cell is positioned at eta=0,
     // half the cells are at negative eta,
     // the rest (one fewer) are at positive eta
-    int tempneta = 1;
-    tempinput = Util::StringFind4(input_file, "Grid_size_in_eta");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempneta;
+    int tempneta = parameters.get<int>("Grid_size_in_eta", 1);
     parameter_list.neta = tempneta;
 
+    // tile_size_x, tile_size_y, tile_size_eta:
+    // number of cells in one cache tile of the grid sweeps,
+    // 0 picks them from the L2 cache size
+    int temptile_size_x = parameters.get<int>("tile_size_x", 0);
+    parameter_list.tile_size_x = temptile_size_x;
+    int temptile_size_y = parameters.get<int>("tile_size_y", 0);
+    parameter_list.tile_size_y = temptile_size_y;
+    int temptile_size_eta = parameters.get<int>("tile_size_eta", 0);
+    parameter_list.tile_size_eta = temptile_size_eta;
+
+    // precompute_flow_derivatives:
+    // 1: evaluate theta, Du^mu, sigma^{mu nu} and D^mu(mu_B/T) for the
+    //    whole grid before the update of the viscous quantities
+    // 0: evaluate them cell by cell, which needs less memory
+    int tempprecompute_flow_derivatives = parameters.get<int>(
+                                        "precompute_flow_derivatives", 1);
+    parameter_list.precompute_flow_derivatives =
+                                        tempprecompute_flow_derivatives;
+
+    // active_region_threshold:
+    // energy density [GeV/fm^3] below which tiles of cells far from
+    // the fluid are frozen instead of evolved, 0 evolves every cell
+    double tempactive_region_threshold = parameters.get<double>(
+                                        "active_region_threshold", 0.);
+    parameter_list.active_region_threshold = tempactive_region_threshold;
+
     // grid_size_in_fm:
     // total length of box in x,y direction in fm (minus delta_*)
-    double tempx_size = 25.;
-    tempinput = Util::StringFind4(input_file, "X_grid_size_in_fm");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempx_size;
+    double tempx_size = parameters.get<double>("X_grid_size_in_fm", 25.);
     parameter_list.x_size = tempx_size;
-    double tempy_size = 25.;
-    tempinput = Util::StringFind4(input_file, "Y_grid_size_in_fm");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempy_size;
+    double tempy_size = parameters.get<double>("Y_grid_size_in_fm", 25.);
     parameter_list.y_size = tempy_size;
 
 
     // switch for baryon current propagation
-    int tempturn_on_rhob = 0;
-    tempinput = Util::StringFind4(input_file, "Include_Rhob_Yes_1_No_0");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempturn_on_rhob;
+    int tempturn_on_rhob = parameters.get<int>("Include_Rhob_Yes_1_No_0", 0);
     parameter_list.turn_on_rhob = tempturn_on_rhob;
     if (parameter_list.turn_on_rhob == 1)
        parameter_list.alpha_max = 5;
@@ -305,26 +289,18 @@ InitData read_in_parameters(std::string input_file) {
 
     // Eta_grid_size:  total length of box in eta direction (minus delta_eta)
     // e.g., neta=8 and eta_size=8 has 8 cells that run from eta=-4 to eta=3
-    double tempeta_size = 8.;
-    tempinput = Util::StringFind4(input_file, "Eta_grid_size");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempeta_size;
+    double tempeta_size = parameters.get<double>("Eta_grid_size", 8.);
     parameter_list.eta_size = tempeta_size;
 
     // Total_evolution_time_tau
     // total evolution time in [fm]. in case of freeze_out_method = 2,3,
     // evolution will halt earlier if all cells are frozen out.
-    double temptau_size = 50.;
-    tempinput = Util::StringFind4(input_file, "Total_evolution_time_tau");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temptau_size;
+    double temptau_size = parameters.get<double>(
+        "Total_evolution_time_tau", 50.);
     parameter_list.tau_size = temptau_size;
 
     // Initial_time_tau_0:  in fm
-    double temptau0 = 0.4;
-    tempinput = Util::StringFind4(input_file, "Initial_time_tau_0");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temptau0;
+    double temptau0 = parameters.get<double>("Initial_time_tau_0", 0.4);
     parameter_list.tau0 = temptau0;
 
     /* x-grid, for instance, runs from 0 to nx */
@@ -344,28 +320,52 @@ InitData read_in_parameters(std::string input_file) {
 
     // Delta_Tau:
     // time step to use in [fm].
-    double tempdelta_tau = 0.02;
-    tempinput = Util::StringFind4(input_file, "Delta_Tau");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempdelta_tau;
+    double tempdelta_tau = parameters.get<double>("Delta_Tau", 0.02);
     parameter_list.delta_tau = tempdelta_tau;
     music_message << " DeltaTau = " << parameter_list.delta_tau << " fm";
     music_message.flush("info");
 
+    // adaptive_time_step:
+    // 1: Delta_Tau is only the first time step, the following ones keep
+    //    sum_i a_i dtau/dx^i at adaptive_CFL, with a_i the largest KT
+    //    signal speeds, and stay below a third of the shortest relaxation
+    //    time and below adaptive_delta_tau_max [fm]
+    int tempadaptive_time_step = parameters.get<int>("adaptive_time_step", 0);
+    parameter_list.adaptive_time_step = tempadaptive_time_step;
+    double tempadaptive_CFL = parameters.get<double>("adaptive_CFL", 0.3);
+    parameter_list.adaptive_CFL = tempadaptive_CFL;
+    double tempadaptive_delta_tau_max = parameters.get<double>(
+                                            "adaptive_delta_tau_max", 0.1);
+    parameter_list.adaptive_delta_tau_max = tempadaptive_delta_tau_max;
+
     // output_evolution_data:
     // 1: output bulk information at every grid point at every time step
-    int tempoutputEvolutionData = 0;
-    tempinput = Util::StringFind4(input_file, "output_evolution_data");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempoutputEvolutionData;
+    int tempoutputEvolutionData = parameters.get<int>(
+        "output_evolution_data", 0);
     parameter_list.outputEvolutionData = tempoutputEvolutionData;
 
-    int temp_output_movie_flag = 0;
-    tempinput = Util::StringFind4(input_file, "output_movie_flag");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_output_movie_flag;
+    int temp_output_movie_flag = parameters.get<int>("output_movie_flag", 0);
     parameter_list.output_movie_flag = temp_output_movie_flag;
 
+    // output_dir: directory for the hydro output files and the surface,
+    // created if needed; the working directory by default
+    string temp_output_dir = parameters.get("output_dir", "");
+    if (temp_output_dir != "" && temp_output_dir.back() != '/') {
+        temp_output_dir += "/";
+    }
+    if (temp_output_dir != "") {
+        mkdir(temp_output_dir.c_str(), 0755);
+        struct stat dir_info;
+        if (stat(temp_output_dir.c_str(), &dir_info) != 0
+                || !S_ISDIR(dir_info.st_mode)) {
+            music_message << "Can not create the output directory "
+                          << temp_output_dir;
+            music_message.flush("error");
+            exit(1);
+        }
+    }
+    parameter_list.output_dir = temp_output_dir;
+
     parameter_list.nt = static_cast<int>(
             parameter_list.tau_size/(parameter_list.delta_tau) + 0.5);
     music_message << "read_in_parameters: Time step size = "
@@ -375,503 +375,333 @@ InitData read_in_parameters(std::string input_file) {
                   << parameter_list.nt;
     music_message.flush("info");
 
-    double temp_eta_0 = 3.0;
-    tempinput = Util::StringFind4(input_file, "eta_rhob_0");
-    if (tempinput != "empty") istringstream (tempinput) >> temp_eta_0;
+    double temp_eta_0 = parameters.get<double>("eta_rhob_0", 3.0);
     parameter_list.eta_rhob_0 = temp_eta_0;
-    double temp_eta_width = 1.0;
-    tempinput = Util::StringFind4(input_file, "eta_rhob_width");
-    if (tempinput != "empty") istringstream (tempinput) >> temp_eta_width;
+    double temp_eta_width = parameters.get<double>("eta_rhob_width", 1.0);
     parameter_list.eta_rhob_width = temp_eta_width;
-    double temp_eta_plateau_height = 0.5;
-    tempinput = Util::StringFind4(input_file, "eta_rhob_plateau_height");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_eta_plateau_height;
+    double temp_eta_plateau_height = parameters.get<double>(
+        "eta_rhob_plateau_height", 0.5);
     parameter_list.eta_rhob_plateau_height = temp_eta_plateau_height;
-    double temp_eta_width_1 = 1.0;
-    tempinput = Util::StringFind4(input_file, "eta_rhob_width_1");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_eta_width_1;
+    double temp_eta_width_1 = parameters.get<double>("eta_rhob_width_1", 1.0);
     parameter_list.eta_rhob_width_1 = temp_eta_width_1;
-    double temp_eta_width_2 = 1.0;
-    tempinput = Util::StringFind4(input_file, "eta_rhob_width_2");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_eta_width_2;
+    double temp_eta_width_2 = parameters.get<double>("eta_rhob_width_2", 1.0);
     parameter_list.eta_rhob_width_2 = temp_eta_width_2;
 
     // Eta_fall_off:
     // width of half-Gaussian on each side of a central pleateau in eta
-    double tempeta_fall_off  = 0.4;
-    tempinput = Util::StringFind4(input_file, "Eta_fall_off");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempeta_fall_off ;
+    double tempeta_fall_off = parameters.get<double>("Eta_fall_off", 0.4);
     parameter_list.eta_fall_off  = tempeta_fall_off;
 
     // Eta_plateau_size:
     // width of the flat region symmetrical around eta=0
-    double tempeta_flat = 20.0;
-    tempinput = Util::StringFind4(input_file, "Eta_plateau_size");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempeta_flat;
+    double tempeta_flat = parameters.get<double>("Eta_plateau_size", 20.0);
     parameter_list.eta_flat = tempeta_flat;
 
     // s_factor:  for use with IP-Glasma initial conditions
-    double tempsFactor   = 20.;
-    tempinput = Util::StringFind4(input_file, "s_factor");
-    if (tempinput != "empty") istringstream ( tempinput ) >> tempsFactor  ;
+    double tempsFactor = parameters.get<double>("s_factor", 20.);
     parameter_list.sFactor   = tempsFactor;
 
     // for calculation of spectra:
     // max_pseudorapidity:
     // spectra calculated from zero to this pseudorapidity in +eta and -eta
-    double tempmax_pseudorapidity = 5.0;
-    tempinput = Util::StringFind4(input_file, "max_pseudorapidity");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempmax_pseudorapidity;
+    double tempmax_pseudorapidity = parameters.get<double>(
+        "max_pseudorapidity", 5.0);
     parameter_list.max_pseudorapidity = tempmax_pseudorapidity;
 
     // pseudo_steps:
     // steps in pseudorapidity in calculation of spectra
-    int temppseudo_steps = 51;
-    tempinput = Util::StringFind4(input_file, "pseudo_steps");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temppseudo_steps;
+    int temppseudo_steps = parameters.get<int>("pseudo_steps", 51);
     parameter_list.pseudo_steps = temppseudo_steps;
 
     // phi_steps
     // steps in azimuthal angle in calculation of spectra
-    int tempphi_steps = 48;
-    tempinput = Util::StringFind4(input_file, "phi_steps");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempphi_steps  ;
+    int tempphi_steps = parameters.get<int>("phi_steps", 48);
     parameter_list.phi_steps = tempphi_steps;
 
     // min_pt:
     // spectra calculated from this to max_pt transverse momentum in GeV
-    double tempmin_pt   = 0.3;
-    tempinput = Util::StringFind4(input_file, "min_pt");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempmin_pt  ;
+    double tempmin_pt = parameters.get<double>("min_pt", 0.3);
     parameter_list.min_pt = tempmin_pt;
 
     // max_pt:
     // spectra calculated from min_pt to this transverse momentum in GeV
-    double tempmax_pt   = 3.0;
-    tempinput = Util::StringFind4(input_file, "max_pt");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempmax_pt;
+    double tempmax_pt = parameters.get<double>("max_pt", 3.0);
     parameter_list.max_pt = tempmax_pt;
 
-    double tempa1_ecc   = 0.0;
-    tempinput = Util::StringFind4(input_file, "a1_ecc");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempa1_ecc;
+    double tempa1_ecc = parameters.get<double>("a1_ecc", 0.0);
     parameter_list.a1_ecc = tempa1_ecc;
 
-    double tempa2_ecc   = 0.1;
-    tempinput = Util::StringFind4(input_file, "a2_ecc");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempa2_ecc;
+    double tempa2_ecc = parameters.get<double>("a2_ecc", 0.1);
     parameter_list.a2_ecc = tempa2_ecc;
 
-    double tempa3_ecc   = 0.1;
-    tempinput = Util::StringFind4(input_file, "a3_ecc");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempa3_ecc;
+    double tempa3_ecc = parameters.get<double>("a3_ecc", 0.1);
     parameter_list.a3_ecc = tempa3_ecc;
 
-    double tempa4_ecc   = 0.1;
-    tempinput = Util::StringFind4(input_file, "a4_ecc");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempa4_ecc;
+    double tempa4_ecc = parameters.get<double>("a4_ecc", 0.1);
     parameter_list.a4_ecc = tempa4_ecc;
 
-    double tempa5_ecc   = 0.1;
-    tempinput = Util::StringFind4(input_file, "a5_ecc");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempa5_ecc;
+    double tempa5_ecc = parameters.get<double>("a5_ecc", 0.1);
     parameter_list.a5_ecc = tempa5_ecc;
 
-    double tempa6_ecc   = 0.1;
-    tempinput = Util::StringFind4(input_file, "a6_ecc");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempa6_ecc;
+    double tempa6_ecc = parameters.get<double>("a6_ecc", 0.1);
     parameter_list.a6_ecc = tempa6_ecc;
 
-    double tempa7_ecc   = 0.1;
-    tempinput = Util::StringFind4(input_file, "a7_ecc");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempa7_ecc;
+    double tempa7_ecc = parameters.get<double>("a7_ecc", 0.1);
     parameter_list.a7_ecc = tempa7_ecc;
 
-    double tempnorm_ecc   = 100.0;
-    tempinput = Util::StringFind4(input_file, "norm_ecc");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempnorm_ecc;
+    double tempnorm_ecc = parameters.get<double>("norm_ecc", 100.0);
     parameter_list.norm_ecc = tempnorm_ecc;
 //constant from Wood-Saxon thickness function
-    double temprho0   = 0.160423;
-    tempinput = Util::StringFind4(input_file, "rho0");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temprho0;
+    double temprho0 = parameters.get<double>("rho0", 0.160423);
     parameter_list.rho0 = temprho0;
 
     // pt_steps:
     // steps in transverse momentum in calculation of spectra
-    int temppt_steps   = 60;
-    tempinput = Util::StringFind4(input_file, "pt_steps");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temppt_steps  ;
+    int temppt_steps = parameters.get<int>("pt_steps", 60);
     parameter_list.pt_steps = temppt_steps;
 
     // pseudofreeze
     // Calculate spectra at fixed,
     // equally-spaced grid in pseudorapidity, pt, and phi
-    int temppseudofreeze = 1;
-    tempinput = Util::StringFind4(input_file, "pseudofreeze");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temppseudofreeze;
+    int temppseudofreeze = parameters.get<int>("pseudofreeze", 1);
     parameter_list.pseudofreeze = temppseudofreeze;
 
     // Runge_Kutta_order:  must be 1 or 2
-    int temprk_order = 1;
-    tempinput = Util::StringFind4(input_file, "Runge_Kutta_order");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temprk_order;
+    int temprk_order = parameters.get<int>("Runge_Kutta_order", 1);
     parameter_list.rk_order = temprk_order;
 
 
     // Minmod_Theta: theta parameter in the min-mod like limiter
-    double tempminmod_theta   = 1.8;
-    tempinput = Util::StringFind4(input_file, "Minmod_Theta");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempminmod_theta  ;
+    double tempminmod_theta = parameters.get<double>("Minmod_Theta", 1.8);
     parameter_list.minmod_theta = tempminmod_theta;
 
     // Viscosity_Flag_Yes_1_No_0:   set to 0 for ideal hydro
-    int tempviscosity_flag = 1;
-    tempinput = Util::StringFind4(input_file, "Viscosity_Flag_Yes_1_No_0");
-    if(tempinput != "empty") istringstream ( tempinput ) >> tempviscosity_flag;
+    int tempviscosity_flag = parameters.get<int>(
+        "Viscosity_Flag_Yes_1_No_0", 1);
     parameter_list.viscosity_flag = tempviscosity_flag;
 
     // Include_Shear_Visc_Yes_1_No_0
-    int tempturn_on_shear = 0;
-    tempinput = Util::StringFind4(input_file, "Include_Shear_Visc_Yes_1_No_0");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempturn_on_shear;
+    int tempturn_on_shear = parameters.get<int>(
+        "Include_Shear_Visc_Yes_1_No_0", 0);
     parameter_list.turn_on_shear = tempturn_on_shear;
 
     // T_dependent_Shear_to_S_ratio:
     // if 1, ignore constant eta/s
     // and use hard-coded T-dependent shear viscosity
-    int tempT_dependent_shear_to_s = 0;
-    tempinput = Util::StringFind4(input_file, "T_dependent_Shear_to_S_ratio");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempT_dependent_shear_to_s;
+    int tempT_dependent_shear_to_s = parameters.get<int>(
+        "T_dependent_Shear_to_S_ratio", 0);
     parameter_list.T_dependent_shear_to_s = tempT_dependent_shear_to_s;
 
     //Shear_to_S_ratio:  constant eta/s
-    double tempshear_to_s = 0.00;
-    tempinput = Util::StringFind4(input_file, "Shear_to_S_ratio");
-    if (tempinput != "empty") {
-        istringstream(tempinput) >> tempshear_to_s;
-    } else if (parameter_list.turn_on_shear == 1
-                && parameter_list.T_dependent_shear_to_s == 0) {
+    double tempshear_to_s = parameters.get<double>("Shear_to_S_ratio", 0.00);
+    if (!parameters.has("Shear_to_S_ratio")
+            && parameter_list.turn_on_shear == 1
+            && parameter_list.T_dependent_shear_to_s == 0) {
         cerr << "please define Shear_to_S_ratio!" << endl;
         exit(1);
     }
     parameter_list.shear_to_s = tempshear_to_s;
 
     // Include_Bulk_Visc_Yes_1_No_0
-    int tempturn_on_bulk = 0;
-    tempinput = Util::StringFind4(input_file, "Include_Bulk_Visc_Yes_1_No_0");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempturn_on_bulk;
+    int tempturn_on_bulk = parameters.get<int>(
+        "Include_Bulk_Visc_Yes_1_No_0", 0);
     parameter_list.turn_on_bulk = tempturn_on_bulk;
 
-    int tempT_dependent_bulk_to_s = 0;
-    tempinput = Util::StringFind4(input_file, "T_dependent_Bulk_to_S_ratio");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempT_dependent_bulk_to_s;
+    int tempT_dependent_bulk_to_s = parameters.get<int>(
+        "T_dependent_Bulk_to_S_ratio", 0);
     parameter_list.T_dependent_bulk_to_s = tempT_dependent_bulk_to_s;
 
     //Bulk_to_S_ratio:  constant zeta/s
-    //double tempbulk_to_s = 0.01;
-    //tempinput = Util::StringFind4(input_file, "Bulk_to_S_ratio");
-    //if (tempinput != "empty") {
-    //    istringstream(tempinput) >> tempbulk_to_s;
-    //} else if (parameter_list.turn_on_bulk == 1
-    //            && parameter_list.T_dependent_bulk_to_s == 0) {
+    //double tempbulk_to_s = parameters.get<double>("Bulk_to_S_ratio", 0.01);
+    //if (!parameters.has("Bulk_to_S_ratio")
+    //        && parameter_list.turn_on_bulk == 1
+    //        && parameter_list.T_dependent_bulk_to_s == 0) {
     //    cerr << "please define Bulk_to_S_ratio!" << endl;
     //    exit(1);
     //}
     //parameter_list.bulk_to_s = tempbulk_to_s;
 
     // Include secord order terms
-    int tempturn_on_second_order = 0;
-    tempinput = Util::StringFind4(input_file, "Include_second_order_terms");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempturn_on_second_order;
+    int tempturn_on_second_order = parameters.get<int>(
+        "Include_second_order_terms", 0);
     parameter_list.include_second_order_terms = tempturn_on_second_order;
 
-    int tempturn_on_diff = 0;
-    tempinput = Util::StringFind4(input_file, "turn_on_baryon_diffusion");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempturn_on_diff;
+    int tempturn_on_diff = parameters.get<int>("turn_on_baryon_diffusion", 0);
     parameter_list.turn_on_diff = tempturn_on_diff;
 
     // kappa coefficient
-    double temp_kappa_coefficient = 0.0;
-    tempinput = Util::StringFind4(input_file, "kappa_coefficient");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_kappa_coefficient;
+    double temp_kappa_coefficient = parameters.get<double>(
+        "kappa_coefficient", 0.0);
     parameter_list.kappa_coefficient = temp_kappa_coefficient;
 
     // Include_deltaf:
     // Looks like 0 sets delta_f=0, 1 uses standard quadratic ansatz,
     // and 2 is supposed to use p^(2-alpha)
-    int tempinclude_deltaf = 1;
-    tempinput = Util::StringFind4(input_file, "Include_deltaf");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempinclude_deltaf;
+    int tempinclude_deltaf = parameters.get<int>("Include_deltaf", 1);
     parameter_list.include_deltaf = tempinclude_deltaf;
 
-    int tempinclude_deltaf_bulk = 0;
-    tempinput = Util::StringFind4(input_file, "Include_deltaf_bulk");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempinclude_deltaf_bulk;
+    int tempinclude_deltaf_bulk = parameters.get<int>("Include_deltaf_bulk", 0);
     parameter_list.include_deltaf_bulk = tempinclude_deltaf_bulk;
 
-    int tempinclude_deltaf_qmu = 0;
-    tempinput = Util::StringFind4(input_file, "Include_deltaf_qmu");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempinclude_deltaf_qmu;
+    int tempinclude_deltaf_qmu = parameters.get<int>("Include_deltaf_qmu", 0);
     parameter_list.include_deltaf_qmu = tempinclude_deltaf_qmu;
 
-    int temp_deltaf_14moments = 0;
-    tempinput = Util::StringFind4(input_file, "deltaf_14moments");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_deltaf_14moments;
+    int temp_deltaf_14moments = parameters.get<int>("deltaf_14moments", 0);
     parameter_list.deltaf_14moments = temp_deltaf_14moments;
 
     // Do_FreezeOut_Yes_1_No_0
     // set to 0 to bypass freeze out surface finder
-    int tempdoFreezeOut = 1;
-    tempinput = Util::StringFind4(input_file, "Do_FreezeOut_Yes_1_No_0");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempdoFreezeOut;
+    int tempdoFreezeOut = parameters.get<int>("Do_FreezeOut_Yes_1_No_0", 1);
     parameter_list.doFreezeOut = tempdoFreezeOut;
 
-    int tempdoFreezeOut_lowtemp = 1;
-    tempinput = Util::StringFind4(input_file, "Do_FreezeOut_lowtemp");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempdoFreezeOut_lowtemp;
+    int tempdoFreezeOut_lowtemp = parameters.get<int>(
+        "Do_FreezeOut_lowtemp", 1);
     parameter_list.doFreezeOut_lowtemp = tempdoFreezeOut_lowtemp;
 
     // Initial_Distribution_input_filename
-    string tempinitName = "initial/initial_ed.dat";
-    tempinput = Util::StringFind4(input_file,
-                                  "Initial_Distribution_input_filename");
-    if (tempinput != "empty")
-        tempinitName.assign(tempinput);
+    string tempinitName = parameters.get(
+        "Initial_Distribution_input_filename", "initial/initial_ed.dat");
     parameter_list.initName.assign(tempinitName);
 
     // Initial_Distribution_Filename for rhob
-    string tempinitName_rhob = "initial/initial_rhob.dat";
-    tempinput = Util::StringFind4(input_file,
-                                  "Initial_Rhob_Distribution_Filename");
-    if (tempinput != "empty")
-        tempinitName_rhob.assign(tempinput);
+    string tempinitName_rhob = parameters.get(
+        "Initial_Rhob_Distribution_Filename", "initial/initial_rhob.dat");
     parameter_list.initName_rhob.assign(tempinitName_rhob);
 
     // Initial_Distribution_Filename for ux
-    string tempinitName_ux = "initial/initial_ux.dat";
-    tempinput = Util::StringFind4(input_file,
-                                  "Initial_ux_Distribution_Filename");
-    if (tempinput != "empty")
-        tempinitName_ux.assign(tempinput);
+    string tempinitName_ux = parameters.get(
+        "Initial_ux_Distribution_Filename", "initial/initial_ux.dat");
     parameter_list.initName_ux.assign(tempinitName_ux);
     // Initial_Distribution_Filename for uy
-    string tempinitName_uy = "initial/initial_uy.dat";
-    tempinput = Util::StringFind4(input_file,
-                                  "Initial_uy_Distribution_Filename");
-    if (tempinput != "empty")
-        tempinitName_uy.assign(tempinput);
+    string tempinitName_uy = parameters.get(
+        "Initial_uy_Distribution_Filename", "initial/initial_uy.dat");
     parameter_list.initName_uy.assign(tempinitName_uy);
     // Initial_Distribution_Filename for TA
-    string tempinitName_TA = "initial/initial_TA.dat";
-    tempinput = Util::StringFind4(input_file,
-                                  "Initial_TA_Distribution_Filename");
-    if (tempinput != "empty")
-        tempinitName_TA.assign(tempinput);
+    string tempinitName_TA = parameters.get(
+        "Initial_TA_Distribution_Filename", "initial/initial_TA.dat");
     parameter_list.initName_TA.assign(tempinitName_TA);
     // Initial_Distribution_Filename for TB
-    string tempinitName_TB = "initial/initial_TB.dat";
-    tempinput = Util::StringFind4(input_file,
-                                  "Initial_TB_Distribution_Filename");
-    if (tempinput != "empty")
-        tempinitName_TB.assign(tempinput);
+    string tempinitName_TB = parameters.get(
+        "Initial_TB_Distribution_Filename", "initial/initial_TB.dat");
     parameter_list.initName_TB.assign(tempinitName_TB);
     // Initial_Distribution_Filename for rhob TA
-    string tempinitName_rhob_TA = "initial/initial_rhob_TA.dat";
-    tempinput = Util::StringFind4(input_file,
-                                  "Initial_rhob_TA_Distribution_Filename");
-    if (tempinput != "empty")
-        tempinitName_rhob_TA.assign(tempinput);
+    string tempinitName_rhob_TA = parameters.get(
+        "Initial_rhob_TA_Distribution_Filename", "initial/initial_rhob_TA.dat");
     parameter_list.initName_rhob_TA.assign(tempinitName_rhob_TA);
     // Initial_Distribution_Filename for rhob TB
-    string tempinitName_rhob_TB = "initial/initial_TB.dat";
-    tempinput = Util::StringFind4(input_file,
-                                  "Initial_rhob_TB_Distribution_Filename");
-    if (tempinput != "empty")
-        tempinitName_rhob_TB.assign(tempinput);
+    string tempinitName_rhob_TB = parameters.get(
+        "Initial_rhob_TB_Distribution_Filename", "initial/initial_TB.dat");
     parameter_list.initName_rhob_TB.assign(tempinitName_rhob_TB);
 
     // Initial_Distribution_AMPT_filename for AMPT
-    string tempinitName_AMPT = "initial/initial_AMPT.dat";
-    tempinput = Util::StringFind4(input_file,
-                                  "Initial_Distribution_AMPT_filename");
-    if (tempinput != "empty")
-        tempinitName_AMPT.assign(tempinput);
+    string tempinitName_AMPT = parameters.get(
+        "Initial_Distribution_AMPT_filename", "initial/initial_AMPT.dat");
     parameter_list.initName_AMPT.assign(tempinitName_AMPT);
 
     // compute beam rapidity according to the collision energy
-    double temp_ecm = 2760;
-    tempinput = Util::StringFind4(input_file, "ecm");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_ecm;
+    double temp_ecm = parameters.get<double>("ecm", 2760);
     parameter_list.ecm = temp_ecm;
     double y_beam = atanh(sqrt(1. - 1./pow(temp_ecm/2., 2.)));
     parameter_list.beam_rapidity = y_beam;
 
 
-    int tempoutputBinaryEvolution = 0;
-    tempinput = Util::StringFind4(input_file, "outputBinaryEvolution");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempoutputBinaryEvolution;
+    int tempoutputBinaryEvolution = parameters.get<int>(
+        "outputBinaryEvolution", 0);
     parameter_list.outputBinaryEvolution = tempoutputBinaryEvolution;
 
     //  Make MUSIC output additionnal hydro information
     //  0 for false (do not output), 1 for true
-    int tempoutput_hydro_debug_info = 0;
-    tempinput = Util::StringFind4(input_file, "output_hydro_debug_info");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempoutput_hydro_debug_info;
+    int tempoutput_hydro_debug_info = parameters.get<int>(
+        "output_hydro_debug_info", 0);
     parameter_list.output_hydro_debug_info = tempoutput_hydro_debug_info;
 
     // The evolution is outputted every
     // "output_evolution_every_N_timesteps" timesteps
-    int temp_evo_N_tau = 1;
-    tempinput = Util::StringFind4(input_file,
-                                  "output_evolution_every_N_timesteps");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_evo_N_tau;
+    int temp_evo_N_tau = parameters.get<int>(
+        "output_evolution_every_N_timesteps", 1);
     parameter_list.output_evolution_every_N_timesteps = temp_evo_N_tau;
 
-    int temp_evo_N_x = 1;
-    tempinput = Util::StringFind4(input_file, "output_evolution_every_N_x");
-    if(tempinput != "empty") istringstream ( tempinput ) >> temp_evo_N_x;
+    int temp_evo_N_x = parameters.get<int>("output_evolution_every_N_x", 1);
     parameter_list.output_evolution_every_N_x = temp_evo_N_x;
     parameter_list.output_evolution_every_N_y = temp_evo_N_x;
 
-    int temp_evo_N_eta = 1;
-    tempinput = Util::StringFind4(input_file, "output_evolution_every_N_eta");
-    if(tempinput != "empty") istringstream ( tempinput ) >> temp_evo_N_eta;
+    int temp_evo_N_eta = parameters.get<int>("output_evolution_every_N_eta", 1);
     parameter_list.output_evolution_every_N_eta = temp_evo_N_eta;
 
-    double temp_evo_T_cut = 0.105;  // GeV
-    tempinput = Util::StringFind4(input_file, "output_evolution_T_cut");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_evo_T_cut;
+    double temp_evo_T_cut = parameters.get<double>(
+        "output_evolution_T_cut", 0.105);  // GeV
     parameter_list.output_evolution_T_cut = temp_evo_T_cut;
 
     // Make MUSIC output a C header input_file containing
     // informations about the hydro parameters used
     // 0 for false (do not output), 1 for true
-    bool tempoutput_hydro_params_header = false;
-    tempinput = Util::StringFind4(input_file, "output_hydro_params_header");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> tempoutput_hydro_params_header;
+    bool tempoutput_hydro_params_header = parameters.get<bool>(
+        "output_hydro_params_header", false);
     parameter_list.output_hydro_params_header = tempoutput_hydro_params_header;
 
     // initial parameters for mode 14
-    double temp_dNdy_y_min = -0.5;
-    tempinput = Util::StringFind4(input_file, "dNdy_y_min");
-    if(tempinput != "empty") istringstream ( tempinput ) >> temp_dNdy_y_min;
+    double temp_dNdy_y_min = parameters.get<double>("dNdy_y_min", -0.5);
     parameter_list.dNdy_y_min = temp_dNdy_y_min;
 
-    double temp_dNdy_y_max = 0.5;
-    tempinput = Util::StringFind4(input_file, "dNdy_y_max");
-    if(tempinput != "empty") istringstream ( tempinput ) >> temp_dNdy_y_max;
+    double temp_dNdy_y_max = parameters.get<double>("dNdy_y_max", 0.5);
     parameter_list.dNdy_y_max = temp_dNdy_y_max;
 
-    double temp_dNdy_eta_min = -2.0;
-    tempinput = Util::StringFind4(input_file, "dNdy_eta_min");
-    if(tempinput != "empty") istringstream ( tempinput ) >> temp_dNdy_eta_min;
+    double temp_dNdy_eta_min = parameters.get<double>("dNdy_eta_min", -2.0);
     parameter_list.dNdy_eta_min = temp_dNdy_eta_min;
 
-    double temp_dNdy_eta_max = 2.0;
-    tempinput = Util::StringFind4(input_file, "dNdy_eta_max");
-    if(tempinput != "empty") istringstream ( tempinput ) >> temp_dNdy_eta_max;
+    double temp_dNdy_eta_max = parameters.get<double>("dNdy_eta_max", 2.0);
     parameter_list.dNdy_eta_max = temp_dNdy_eta_max;
 
-    int temp_dNdy_nrap = 30;
-    tempinput = Util::StringFind4(input_file, "dNdy_nrap");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_dNdy_nrap;
+    int temp_dNdy_nrap = parameters.get<int>("dNdy_nrap", 30);
     parameter_list.dNdy_nrap = temp_dNdy_nrap;
 
-    double temp_dNdyptdpt_y_min = -0.5;
-    tempinput = Util::StringFind4(input_file, "dNdyptdpt_y_min");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_dNdyptdpt_y_min;
+    double temp_dNdyptdpt_y_min = parameters.get<double>(
+        "dNdyptdpt_y_min", -0.5);
     parameter_list.dNdyptdpt_y_min = temp_dNdyptdpt_y_min;
 
-    double temp_dNdyptdpt_y_max = 0.5;
-    tempinput = Util::StringFind4(input_file, "dNdyptdpt_y_max");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_dNdyptdpt_y_max;
+    double temp_dNdyptdpt_y_max = parameters.get<double>(
+        "dNdyptdpt_y_max", 0.5);
     parameter_list.dNdyptdpt_y_max = temp_dNdyptdpt_y_max;
 
-    double temp_dNdyptdpt_eta_min = -0.5;
-    tempinput = Util::StringFind4(input_file, "dNdyptdpt_eta_min");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_dNdyptdpt_eta_min;
+    double temp_dNdyptdpt_eta_min = parameters.get<double>(
+        "dNdyptdpt_eta_min", -0.5);
     parameter_list.dNdyptdpt_eta_min = temp_dNdyptdpt_eta_min;
 
-    double temp_dNdyptdpt_eta_max = 0.5;
-    tempinput = Util::StringFind4(input_file, "dNdyptdpt_eta_max");
-    if (tempinput != "empty")
-        istringstream(tempinput) >> temp_dNdyptdpt_eta_max;
+    double temp_dNdyptdpt_eta_max = parameters.get<double>(
+        "dNdyptdpt_eta_max", 0.5);
     parameter_list.dNdyptdpt_eta_max = temp_dNdyptdpt_eta_max;
 
 
 
     // tolerance for copying spectra -- particles with almost the same mass and chemical potential don't need to be recalculated
     // When tolerances are set to zero, results are exact -- only particles with exactly the same mass and (PCE, baryon) chemical potential are copied
-    double tempMassTolerance = 1e-5; // maximum fractional difference in mass.
+    // maximum fractional difference in mass.
     // This value (>= 1e-5) reduces the number of particles calculated from 319 to 99.
     // Exact result obtaineed by reducing to 0.  Further speedup possible by
     // choosing a value larger than, e.g., 0.001, with small decrease in accuracy
-    tempinput = Util::StringFind4(input_file, "MassTolerance");
-    if(tempinput != "empty") istringstream ( tempinput ) >> tempMassTolerance;
+    double tempMassTolerance = parameters.get<double>("MassTolerance", 1e-5);
     parameter_list.MassTolerance = tempMassTolerance;
 
     // tolerance for PCE chemical potential. Run tests to find optimal value.
-    double tempMuTolerance = 1e-2;
-    tempinput = Util::StringFind4(input_file, "MuTolerance");
-    if(tempinput != "empty") istringstream ( tempinput ) >> tempMuTolerance;
+    double tempMuTolerance = parameters.get<double>("MuTolerance", 1e-2);
     parameter_list.MuTolerance = tempMuTolerance;
 
     music_message.info("Done read_in_parameters.");
-    check_parameters(parameter_list, input_file);
+    check_parameters(parameter_list, parameters);
+    parameter_list.delta_tau_backward = parameter_list.delta_tau;
+
+    for (const auto &name : parameters.unused_names()) {
+        music_message << "Unknown parameter " << name << " is ignored.";
+        music_message.flush("warning");
+    }
 
     return parameter_list;
 }
 
 
 
-void check_parameters(InitData &parameter_list, std::string input_file) {
+void check_parameters(InitData &parameter_list,
+                      const ParameterList &parameters) {
     music_message.info("Checking input parameter list ... ");
 
     if (parameter_list.Initial_profile < 0) {
@@ -932,6 +762,25 @@ void check_parameters(InitData &parameter_list, std::string input_file) {
         exit(1);
     }
 
+    // without the surface file, only the Cooper-Frye of the same run in
+    // the same process (mode 1 on a single rank) sees the surface
+    if (!parameter_list.freeze_surface_to_file
+            && (parameter_list.mode != 1 || Domain::world_size() > 1)) {
+        music_message << "freeze_surface_to_file = 0 needs mode = 1 on a "
+                      << "single MPI rank, the freeze-out surface would be "
+                      << "lost otherwise.";
+        music_message.flush("error");
+        exit(1);
+    }
+
+    if (parameter_list.freeze_surface_index_for_spectra < 0) {
+        music_message << "freeze_surface_index_for_spectra = "
+                      << parameter_list.freeze_surface_index_for_spectra
+                      << " must not be negative.";
+        music_message.flush("error");
+        exit(1);
+    }
+
     if (parameter_list.freezeOutMethod != 4) {
         music_message << "Invalid option for freeze_out_method: "
                       << parameter_list.freezeOutMethod;
@@ -998,6 +847,19 @@ void check_parameters(InitData &parameter_list, std::string input_file) {
         parameter_list.eta_size = 0.0;
     }
 
+    if (parameter_list.transverse_boundary < 0
+        || parameter_list.transverse_boundary > 2) {
+        music_message << "transverse_boundary = "
+                      << parameter_list.transverse_boundary
+                      << " is not supported! "
+                      << "Please choose 0 (zero gradient), 1 (periodic) "
+                      << "or 2 (reflective).";
+        music_message.flush("error");
+        exit(1);
+    }
+
+    int temp_CFL_condition = parameters.get<int>(
+                                "reset_dtau_use_CFL_condition", 1);
     if (parameter_list.delta_tau > 0.1) {
         music_message << "Warning: Delta_Tau = " << parameter_list.delta_tau
                       << " maybe too large! "
@@ -1005,11 +867,6 @@ void check_parameters(InitData &parameter_list, std::string input_file) {
         music_message.flush("warning");
 
         bool reset_dtau_use_CFL_condition = true;
-        int temp_CFL_condition = 1;
-        string tempinput = Util::StringFind4(input_file,
-                                      "reset_dtau_use_CFL_condition");
-        if (tempinput != "empty")
-            istringstream(tempinput) >> temp_CFL_condition;
         if (temp_CFL_condition == 0)
             reset_dtau_use_CFL_condition = false;
 
@@ -1033,6 +890,30 @@ void check_parameters(InitData &parameter_list, std::string input_file) {
         }
     }
 
+    if (parameter_list.adaptive_time_step == 1
+            && (parameter_list.adaptive_CFL <= 0.
+                || parameter_list.adaptive_delta_tau_max
+                   < parameter_list.delta_tau)) {
+        music_message << "adaptive_CFL = " << parameter_list.adaptive_CFL
+                      << " must be positive and adaptive_delta_tau_max = "
+                      << parameter_list.adaptive_delta_tau_max
+                      << " fm must not be below Delta_Tau = "
+                      << parameter_list.delta_tau << " fm.";
+        music_message.flush("error");
+        exit(1);
+    }
+
+    // the hydro source terms deposit over windows of Delta_Tau
+    if (parameter_list.adaptive_time_step == 1
+            && (parameter_list.Initial_profile == 13
+                || parameter_list.Initial_profile == 30)) {
+        music_message << "adaptive_time_step = 1 is not supported with "
+                      << "hydro source terms (Initial_profile = "
+                      << parameter_list.Initial_profile << ").";
+        music_message.flush("error");
+        exit(1);
+    }
+
     if (parameter_list.min_pt > parameter_list.max_pt) {
         music_message << "min_pt = " << parameter_list.min_pt << " > "
                       << "max_pt = " << parameter_list.max_pt;
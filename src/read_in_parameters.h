@@ -4,6 +4,7 @@
 #include <string>
 
 #include "data.h"
+#include "parameter_list.h"
 #include "util.h"
 #include "emoji.h"
 #include "pretty_ostream.h"
@@ -11,7 +12,9 @@
 //! This class handles read in parameters
 namespace ReadInParameters {
     InitData read_in_parameters(std::string input_file);
-    void check_parameters(InitData &parameter_list, std::string input_file);
+    InitData read_in_parameters(const ParameterList &parameters);
+    void check_parameters(InitData &parameter_list,
+                          const ParameterList &parameters);
 }
 
 #endif  // SRC_READ_IN_PARAMETERS_H_
@@ -1,11 +1,62 @@
 // Copyright 2011 @ Bjoern Schenke, Sangyong Jeon, and Charles Gale
 #include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
 #include "data.h"
 #include "cell.h"
 #include "grid.h"
 #include "eos.h"
 #include "reconst.h"
+#include "doctest.h"
+
+namespace {
+
+//! initial guess of the flow velocity from the cell's previous u^0
+inline double velocity_guess(const ReconstCell &grid_pt) {
+    double v_guess = sqrt(1. - 1./(grid_pt.u[0]*grid_pt.u[0] + 1e-15));
+    if (v_guess != v_guess) {
+        v_guess = 0.0;
+    }
+    return v_guess;
+}
+
+//! f(v) and f'(v) for the velocity solver, given the EOS at
+//! e = T00 - v M and rho = J0 sqrt(1 - v^2)
+inline void velocity_fdf(const double v, const double T00, const double M,
+                         const double J0, const double pressure,
+                         const double dPde, const double dPdrho,
+                         double &fv, double &dfdv) {
+    const double temp  = sqrt(1. - v*v);
+    const double temp1 = T00 + pressure;
+    const double temp2 = v/temp;
+
+    fv   = v - M/temp1;
+    dfdv = 1. - M/(temp1*temp1)*(M*dPde + J0*temp2*dPdrho);
+}
+
+//! f(u0) and f'(u0) for the u0 solver, given the EOS at
+//! e = T00 - v M and rho = J0/u0
+inline void u0_fdf(const double u0, const double T00, const double K00,
+                   const double M, const double J0, const double pressure,
+                   const double dPde, const double dPdrho,
+                   double &fu0, double &dfdu0) {
+    const double v       = sqrt(1. - 1./(u0*u0));
+    const double dedu0   = - M/(u0*u0*u0*v + 1e-15);
+    const double drhodu0 = - J0/(u0*u0);
+
+    const double temp1 = (T00 + pressure)*(T00 + pressure) - K00;
+    const double denorm1 = sqrt(temp1);
+    const double temp = (T00 + pressure)/denorm1;
+
+    fu0    = u0 - temp;
+    dfdu0  = 1. + (dedu0*dPde + drhodu0*dPdrho)*K00/(temp1*denorm1);
+}
+
+}  // namespace
+
+const int Reconst::batch_width;
 
 Reconst::Reconst(const EOS &eosIn, const InitData &DATA_in) :
     eos(eosIn),
@@ -20,7 +71,7 @@ Reconst::Reconst(const EOS &eosIn, const InitData &DATA_in) :
 }
 
 ReconstCell Reconst::ReconstIt_shell(double tau, const TJbVec &tauq_vec,
-                                     const Cell_small &grid_pt) {
+                                     const ReconstCell &grid_pt) {
     ReconstCell grid_p1;
 
     TJbVec q_vec;
@@ -39,11 +90,173 @@ ReconstCell Reconst::ReconstIt_shell(double tau, const TJbVec &tauq_vec,
     return grid_p1;
 }
 
+void Reconst::ReconstIt_batch(int n, double tau, const TJbVec *tauq_vec,
+                              const ReconstCell *grid_pt,
+                              ReconstCell *grid_p) {
+    for (int i0 = 0; i0 < n; i0 += batch_width) {
+        ReconstIt_lanes(std::min(batch_width, n - i0), tau, tauq_vec + i0,
+                        grid_pt + i0, grid_p + i0);
+    }
+}
+
+
+//! ReconstIt_shell for up to batch_width cells. Every lane goes through
+//! the same steps as ReconstIt_velocity_Newton. The EOS is looked up lane
+//! by lane; the Newton updates run over all lanes with masks, and a lane
+//! drops out when it converges or fails.
+void Reconst::ReconstIt_lanes(const int n_lanes, double tau,
+                              const TJbVec *tauq_vec,
+                              const ReconstCell *grid_pt,
+                              ReconstCell *grid_p) {
+    const int W = batch_width;
+    TJbVec q[W];
+    double T00[W], K00[W], M[W], J0[W];
+    int flag[W];            // 0: not solved yet, 1: solved, -1/-2: failed
+    bool running[W], solve_u0[W];
+    int iter[W];
+    double x[W], abs_error[W], rel_error[W];
+    double pressure[W], dPde[W], dPdrho[W];
+
+    for (int l = 0; l < W; l++) {
+        if (l < n_lanes) {
+            for (int i = 0; i < 5; i++) {
+                q[l][i] = tauq_vec[l][i]/tau;
+            }
+        } else {
+            q[l] = {1., 0., 0., 0., 0.};
+        }
+        K00[l] = q[l][1]*q[l][1] + q[l][2]*q[l][2] + q[l][3]*q[l][3];
+        M[l]   = sqrt(K00[l]);
+        T00[l] = q[l][0];
+        J0[l]  = q[l][4];
+        flag[l] = 0;
+        if (l >= n_lanes) {
+            flag[l] = 1;
+        } else if ((T00[l] < abs_err) || ((T00[l] - K00[l]/T00[l]) < 0.0)) {
+            if (echo_level > 9) {
+                music_message.warning(
+                        "Reconst velocity Newton:: can not find solution!");
+                music_message << "T00 = " << T00[l] << ", K00 = " << K00[l];
+                music_message.flush("warning");
+            }
+            flag[l] = -2;
+        }
+        running[l] = (flag[l] == 0);
+        solve_u0[l] = false;
+        x[l] = (l < n_lanes ? velocity_guess(grid_pt[l]) : 0.);
+        iter[l] = 0;
+        abs_error[l] = 0.;
+        rel_error[l] = 0.;
+    }
+
+    // Newton iterations: first for v, then for u0 in the lanes with
+    // v >= v_critical. x holds v or u0.
+    for (int solver = 0; solver < 2; solver++) {
+        const double x_min = (solver == 0 ? 0.0 : 1.0);
+        int n_running = 0;
+        for (int l = 0; l < W; l++) n_running += running[l];
+        while (n_running > 0) {
+            for (int l = 0; l < W; l++) {
+                pressure[l] = 0.;
+                dPde[l]     = 0.;
+                dPdrho[l]   = 0.;
+                if (!running[l]) continue;
+                double epsilon, rho;
+                if (solver == 0) {
+                    epsilon = T00[l] - x[l]*M[l];
+                    rho     = J0[l]*sqrt(1. - x[l]*x[l]);
+                } else {
+                    epsilon = T00[l] - sqrt(1. - 1./(x[l]*x[l]))*M[l];
+                    rho     = J0[l]/x[l];
+                }
+                pressure[l] = eos.get_pressure(epsilon, rho);
+                dPde[l]     = eos.p_e_func(epsilon, rho);
+                dPdrho[l]   = eos.p_rho_func(epsilon, rho);
+            }
+
+            #pragma omp simd
+            for (int l = 0; l < W; l++) {
+                const double x_prev = running[l] ? x[l] : 0.5 + x_min;
+                double f, dfdx;
+                if (solver == 0) {
+                    velocity_fdf(x_prev, T00[l], M[l], J0[l], pressure[l],
+                                 dPde[l], dPdrho[l], f, dfdx);
+                } else {
+                    u0_fdf(x_prev, T00[l], K00[l], M[l], J0[l], pressure[l],
+                           dPde[l], dPdrho[l], f, dfdx);
+                }
+                double x_next = x_prev - f/dfdx;
+                x_next = (solver == 0 ? std::max(0.0, std::min(1.0, x_next))
+                                      : std::max(1.0, x_next));
+                if (running[l]) {
+                    abs_error[l] = f;
+                    rel_error[l] = 2.*f/(x_next + x_prev + 1e-15);
+                    x[l] = x_next;
+                }
+            }
+
+            for (int l = 0; l < W; l++) {
+                if (!running[l]) continue;
+                iter[l]++;
+                if (iter[l] > max_iter) {
+                    if (echo_level > 5) {
+                        report_Newton_failure(iter[l], x[l], x[l],
+                                              abs_error[l], rel_error[l]);
+                    }
+                    flag[l] = -1;
+                    running[l] = false;
+                    n_running--;
+                } else if (!(   fabs(abs_error[l]) > abs_err
+                             && fabs(rel_error[l]) > rel_err)) {
+                    running[l] = false;
+                    n_running--;
+                }
+            }
+        }
+
+        if (solver == 0) {
+            // lanes with large velocities go on with the u0 solver
+            for (int l = 0; l < W; l++) {
+                if (flag[l] != 0 || x[l] < v_critical) continue;
+                x[l] = 1./sqrt(1. - x[l]*x[l]);
+                solve_u0[l] = true;
+                iter[l] = 0;
+                running[l] = true;
+            }
+        }
+    }
+
+    for (int l = 0; l < n_lanes; l++) {
+        if (flag[l] == 0) {
+            double u0, epsilon, rhob;
+            if (!solve_u0[l]) {
+                const double v = x[l];
+                u0 = 1./(sqrt(1. - v*v) + v*abs_err);
+                epsilon = T00[l] - v*sqrt(K00[l]);
+                rhob = J0[l]/u0;
+            } else {
+                u0 = x[l];
+                epsilon = T00[l] - sqrt((1. - 1./(u0*u0))*K00[l]);
+                rhob = J0[l]/u0;
+            }
+            flag[l] = set_primitive_variables(grid_p[l], q[l], u0, epsilon,
+                                              rhob, grid_pt[l]);
+        }
+
+        if (flag[l] == -1) {
+            revert_grid(grid_p[l], grid_pt[l]);
+        } else if (flag[l] == -2) {
+            regulate_grid(grid_p[l], q[l][0]);
+        }
+    }
+}
+
+
 //! This function reverts the grid information back its values
 //! at the previous time step
 void Reconst::revert_grid(ReconstCell &grid_current,
-                          const Cell_small &grid_prev) const {
-    grid_current.e = grid_prev.epsilon;
+                          const ReconstCell &grid_prev) const {
+    grid_current.e = grid_prev.e;
     grid_current.rhob = grid_prev.rhob;
     grid_current.u = grid_prev.u;
 }
@@ -53,7 +266,7 @@ void Reconst::revert_grid(ReconstCell &grid_current,
 //! use Newton's method to solve v and u0
 int Reconst::ReconstIt_velocity_Newton(ReconstCell &grid_p, double tau,
                                        const TJbVec &q,
-                                       const Cell_small &grid_pt) {
+                                       const ReconstCell &grid_pt) {
     double K00 = q[1]*q[1] + q[2]*q[2] + q[3]*q[3];
     double M   = sqrt(K00);
     double T00 = q[0];
@@ -72,12 +285,9 @@ int Reconst::ReconstIt_velocity_Newton(ReconstCell &grid_p, double tau,
         return(-2);
     }
 
-    double u[4], epsilon, pressure, rhob;
-    
-    double v_guess = sqrt(1. - 1./(grid_pt.u[0]*grid_pt.u[0] + 1e-15));
-    if (v_guess != v_guess) {
-        v_guess = 0.0;
-    }
+    double u0, epsilon, rhob;
+
+    double v_guess = velocity_guess(grid_pt);
     double v_solution = 0.0;
     int v_status = solve_velocity_Newton(v_guess, T00, M, J0, v_solution);
     if (v_status == 0) {
@@ -85,9 +295,9 @@ int Reconst::ReconstIt_velocity_Newton(ReconstCell &grid_p, double tau,
     }
     
     if (v_solution < v_critical) {
-        u[0] = 1./(sqrt(1. - v_solution*v_solution) + v_solution*abs_err);
+        u0 = 1./(sqrt(1. - v_solution*v_solution) + v_solution*abs_err);
         epsilon = T00 - v_solution*sqrt(K00);
-        rhob = J0/u[0];
+        rhob = J0/u0;
     } else {  // for large velocity, solve u0
         double u0_guess = 1./sqrt(1. - v_solution*v_solution);
         double u0_solution = u0_guess;
@@ -95,19 +305,32 @@ int Reconst::ReconstIt_velocity_Newton(ReconstCell &grid_p, double tau,
         if (u0_status == 0) {
             return(-1);
         }
-        u[0] = u0_solution;
+        u0 = u0_solution;
         epsilon = T00 - sqrt((1. - 1./(u0_solution*u0_solution))*K00);
         rhob = J0/u0_solution;
     }
 
+    return(set_primitive_variables(grid_p, q, u0, epsilon, rhob, grid_pt));
+}
+
+
+//! fills grid_p from the solution u0 of the cell with conserved
+//! densities q; returns -1 if u0 jumped too far from the value of grid_pt
+int Reconst::set_primitive_variables(ReconstCell &grid_p, const TJbVec &q,
+                                     double u0, double epsilon, double rhob,
+                                     const ReconstCell &grid_pt) {
+    const double T00 = q[0];
+    double u[4], pressure;
+    u[0] = u0;
+
     double check_u0_var = std::abs(u[0] - grid_pt.u[0])/grid_pt.u[0];
     if (check_u0_var > 100.) {
-        if (grid_pt.epsilon > 1e-6 && echo_level > 2) {
+        if (grid_pt.e > 1e-6 && echo_level > 2) {
             music_message << "Reconst velocity Newton:: "
                           << "u0 varies more than 100 times compared to "
                           << "its value at previous time step";
             music_message.flush("warning");
-            music_message << "e = " << grid_pt.epsilon
+            music_message << "e = " << grid_pt.e
                           << ", u[0] = " << u[0]
                           << ", prev_u[0] = " << grid_pt.u[0];
             music_message.flush("warning");
@@ -179,13 +402,7 @@ int Reconst::solve_velocity_Newton(const double v_guess, const double T00,
 
     v_solution = v_next;
     if (v_status == 0 && echo_level > 5) {
-        music_message.warning(
-                "Reconst velocity Newton:: can not find solution!");
-        music_message.warning("output the results at the last iteration:");
-        music_message.warning("iter  [lower, upper]  root  err(est)");
-        music_message << iter << "   [" << v_prev << ",  " << v_next
-                      << "]  " << abs_error_v << "  " << rel_error_v;
-        music_message.flush("warning");
+        report_Newton_failure(iter, v_prev, v_next, abs_error_v, rel_error_v);
     }
     return(v_status);
 }
@@ -217,36 +434,37 @@ int Reconst::solve_u0_Newton(const double u0_guess, const double T00,
 
     u0_solution = u0_next;
     if (u0_status == 0 && echo_level > 5) {
-        music_message.warning(
-                "Reconst velocity Newton:: can not find solution!");
-        music_message.warning(
-                "output the results at the last iteration:");
-        music_message.warning("iter  [lower, upper]  root  err(est)");
-        music_message << iter_u0 << "   [" << u0_prev << ",  "
-                      << u0_next << "]  " << abs_error_u0 << "  "
-                      << rel_error_u0;
-        music_message.flush("warning");
+        report_Newton_failure(iter_u0, u0_prev, u0_next,
+                              abs_error_u0, rel_error_u0);
     }
     return(u0_status);
 }
 
 
+void Reconst::report_Newton_failure(int iter, double x_prev, double x_next,
+                                    double abs_error, double rel_error) {
+    music_message.warning(
+            "Reconst velocity Newton:: can not find solution!");
+    music_message.warning("output the results at the last iteration:");
+    music_message.warning("iter  [lower, upper]  root  err(est)");
+    music_message << iter << "   [" << x_prev << ",  " << x_next
+                  << "]  " << abs_error << "  " << rel_error;
+    music_message.flush("warning");
+}
+
+
 
 void Reconst::reconst_velocity_fdf(const double v, const double T00,
                                    const double M, const double J0,
                                    double &fv, double &dfdv) const {
     const double epsilon = T00 - v*M;
-    const double temp    = sqrt(1. - v*v);
-    const double rho     = J0*temp;
+    const double rho     = J0*sqrt(1. - v*v);
 
     const double pressure = eos.get_pressure(epsilon, rho);
-    const double temp1    = T00 + pressure;
-    const double temp2    = v/temp;
     const double dPde     = eos.p_e_func(epsilon, rho);
     const double dPdrho   = eos.p_rho_func(epsilon, rho);
 
-    fv   = v - M/temp1;
-    dfdv = 1. - M/(temp1*temp1)*(M*dPde + J0*temp2*dPdrho);
+    velocity_fdf(v, T00, M, J0, pressure, dPde, dPdrho, fv, dfdv);
 }
 
 void Reconst::reconst_u0_fdf(const double u0, const double T00,
@@ -256,17 +474,98 @@ void Reconst::reconst_u0_fdf(const double u0, const double T00,
     const double epsilon = T00 - v*M;
     const double rho     = J0/u0;
 
-    const double dedu0   = - M/(u0*u0*u0*v + 1e-15);
-    const double drhodu0 = - J0/(u0*u0);
-
     const double pressure = eos.get_pressure(epsilon, rho);
     const double dPde     = eos.p_e_func(epsilon, rho);
     const double dPdrho   = eos.p_rho_func(epsilon, rho);
 
-    const double temp1 = (T00 + pressure)*(T00 + pressure) - K00;
-    const double denorm1 = sqrt(temp1);
-    const double temp = (T00 + pressure)/denorm1;
+    u0_fdf(u0, T00, K00, M, J0, pressure, dPde, dPdrho, fu0, dfdu0);
+}
 
-    fu0    = u0 - temp;
-    dfdu0  = 1. + (dedu0*dPde + drhodu0*dPdrho)*K00/(temp1*denorm1);
+
+namespace {
+
+//! random cells and their conserved densities, with flow up to
+//! gamma ~ 10 so that both Newton solvers are used
+void make_test_cells(const EOS &eos, int n, std::vector<TJbVec> &tauq,
+                     std::vector<ReconstCell> &guess) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> uni(0., 1.);
+    tauq.resize(n);
+    guess.resize(n);
+    for (int i = 0; i < n; i++) {
+        const double e    = 1e-3 + 50.*uni(gen);
+        const double rhob = uni(gen);
+        const double p    = eos.get_pressure(e, rhob);
+        FlowVec u = {0., 3.*(2.*uni(gen) - 1.), 3.*(2.*uni(gen) - 1.),
+                     3.*(2.*uni(gen) - 1.)};
+        u[0] = sqrt(1. + u[1]*u[1] + u[2]*u[2] + u[3]*u[3]);
+        tauq[i][0] = (e + p)*u[0]*u[0] - p;
+        for (int mu = 1; mu < 4; mu++) tauq[i][mu] = (e + p)*u[0]*u[mu];
+        tauq[i][4] = rhob*u[0];
+        guess[i].e       = e;
+        guess[i].rhob    = rhob;
+        guess[i].u       = {1. + 0.5*(u[0] - 1.), u[1]/2., u[2]/2., u[3]/2.};
+        if (i%97 == 0) tauq[i][0] = -1.;   // no solution, regulated
+    }
+}
+
+}  // namespace
+
+
+TEST_CASE("ReconstIt_batch agrees with ReconstIt_shell") {
+    InitData DATA;
+    DATA.whichEOS   = 0;
+    DATA.echo_level = 0;
+    EOS eos(DATA);
+    Reconst reconst(eos, DATA);
+
+    const int n = 1003;
+    std::vector<TJbVec> tauq;
+    std::vector<ReconstCell> guess;
+    make_test_cells(eos, n, tauq, guess);
+
+    std::vector<ReconstCell> batch(n);
+    reconst.ReconstIt_batch(n, 1., tauq.data(), guess.data(),
+                            batch.data());
+    for (int i = 0; i < n; i++) {
+        const ReconstCell single = reconst.ReconstIt_shell(1., tauq[i],
+                                                           guess[i]);
+        CHECK(batch[i].e    == doctest::Approx(single.e));
+        CHECK(batch[i].rhob == doctest::Approx(single.rhob));
+        for (int mu = 0; mu < 4; mu++) {
+            CHECK(batch[i].u[mu] == doctest::Approx(single.u[mu]));
+        }
+    }
+}
+
+
+// run with --no-skip to see the rates
+TEST_CASE("ReconstIt_batch microbenchmark" * doctest::skip()) {
+    InitData DATA;
+    DATA.whichEOS   = 0;
+    DATA.echo_level = 0;
+    EOS eos(DATA);
+    Reconst reconst(eos, DATA);
+
+    const int n = 1000000;
+    std::vector<TJbVec> tauq;
+    std::vector<ReconstCell> guess;
+    make_test_cells(eos, n, tauq, guess);
+    std::vector<ReconstCell> result(n);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        result[i] = reconst.ReconstIt_shell(1., tauq[i], guess[i]);
+    }
+    const std::chrono::duration<double> t_single =
+                                std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    reconst.ReconstIt_batch(n, 1., tauq.data(), guess.data(),
+                            result.data());
+    const std::chrono::duration<double> t_batch =
+                                std::chrono::steady_clock::now() - start;
+
+    MESSAGE("ReconstIt_shell: " << n/t_single.count() << " solves/s");
+    MESSAGE("ReconstIt_batch: " << n/t_batch.count()  << " solves/s");
 }
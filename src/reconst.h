@@ -12,6 +12,16 @@
 #include "pretty_ostream.h"
 #include "data_struct.h"
 
+//! epsilon, rhob and u of a cell, the guess and the fallback of the
+//! solvers below
+inline ReconstCell primitive_variables(SCGrid::const_reference cell) {
+    ReconstCell grid_p;
+    grid_p.e    = cell.epsilon;
+    grid_p.rhob = cell.rhob;
+    grid_p.u    = cell.u;
+    return(grid_p);
+}
+
 class Reconst {
  private:
     const EOS &eos;
@@ -28,18 +38,41 @@ class Reconst {
     int echo_level;
     const double v_critical;
 
+    void ReconstIt_lanes(const int n_lanes, double tau,
+                         const TJbVec *tauq_vec,
+                         const ReconstCell *grid_pt,
+                         ReconstCell *grid_p);
+
+    int set_primitive_variables(ReconstCell &grid_p, const TJbVec &q,
+                                double u0, double epsilon, double rhob,
+                                const ReconstCell &grid_pt);
+
+    void report_Newton_failure(int iter, double x_prev, double x_next,
+                               double abs_error, double rel_error);
+
  public:
+    //! number of cells whose Newton iterations run in lock step in
+    //! ReconstIt_batch, one AVX-512 or two AVX2 registers of doubles
+    static const int batch_width = 8;
+
     Reconst() = default;
     Reconst(const EOS &eos, const InitData &DATA_in);
 
     ReconstCell ReconstIt_shell(double tau, const TJbVec &tauq_vec,
-                                const Cell_small &grid_pt);
+                                const ReconstCell &grid_pt);
+
+    //! ReconstIt_shell for n independent cells: grid_p[i] is reconstructed
+    //! from tauq_vec[i] with grid_pt[i] as the guess and fallback.
+    //! Results are the same as from n calls of ReconstIt_shell.
+    void ReconstIt_batch(int n, double tau, const TJbVec *tauq_vec,
+                         const ReconstCell *grid_pt,
+                         ReconstCell *grid_p);
 
     void revert_grid(ReconstCell &grid_current,
-                     const Cell_small &grid_prev) const;
+                     const ReconstCell &grid_prev) const;
 
     int ReconstIt_velocity_Newton(ReconstCell &grid_p, double tau,
-                                  const TJbVec &q, const Cell_small &grid_pt);
+                                  const TJbVec &q, const ReconstCell &grid_pt);
     
     void reconst_velocity_fdf(const double v, const double T00, const double M,
                               const double J0, double &fv, double &dfdv) const;
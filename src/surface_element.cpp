@@ -0,0 +1,436 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+
+#include "surface_element.h"
+#include "pretty_ostream.h"
+#include "doctest.h"
+
+namespace {
+
+const char surface_magic[8] = "MUSICSF";
+const int32_t surface_version = 1;
+//! values per element of all fields, which the files before version 1
+//! hold as floats without a header
+const int all_fields = 32;
+
+static_assert(sizeof(SurfaceFileHeader) == 80,
+              "the header of the surface files has a fixed layout");
+
+int surface_field_mask(const InitData &DATA) {
+    return((DATA.turn_on_bulk ? SurfaceFileHeader::bulk : 0)
+           | (DATA.turn_on_rhob ? SurfaceFileHeader::rhob : 0)
+           | (DATA.turn_on_diff ? SurfaceFileHeader::diff : 0));
+}
+
+int surface_n_fields(int field_mask) {
+    return(26 + ((field_mask & SurfaceFileHeader::bulk) ? 1 : 0)
+              + ((field_mask & SurfaceFileHeader::rhob) ? 1 : 0)
+              + ((field_mask & SurfaceFileHeader::diff) ? 4 : 0));
+}
+
+//! the values of cell in the order of the binary records, returns how
+//! many there are
+template <typename T>
+int pack_surface_element(const SurfaceElement &cell, int field_mask,
+                         T *record) {
+    int n = 0;
+    for (int i = 0; i < 4; i++) record[n++] = cell.x[i];
+    for (int i = 0; i < 4; i++) record[n++] = cell.s[i];
+    for (int i = 0; i < 4; i++) record[n++] = cell.u[i];
+    record[n++] = cell.epsilon_f;
+    record[n++] = cell.T_f;
+    record[n++] = cell.mu_B;
+    record[n++] = cell.eps_plus_p_over_T_FO;
+    for (int i = 0; i < 4; i++)
+        for (int j = i; j < 4; j++) record[n++] = cell.W[i][j];
+    if (field_mask & SurfaceFileHeader::bulk) record[n++] = cell.pi_b;
+    if (field_mask & SurfaceFileHeader::rhob) record[n++] = cell.rho_B;
+    if (field_mask & SurfaceFileHeader::diff)
+        for (int i = 0; i < 4; i++) record[n++] = cell.q[i];
+    return(n);
+}
+
+//! cell from a binary record, the fields outside field_mask are 0
+template <typename T>
+void unpack_surface_element(const char *bytes, int field_mask,
+                            SurfaceElement &cell) {
+    T record[all_fields];
+    std::memcpy(record, bytes, surface_n_fields(field_mask)*sizeof(T));
+    int n = 0;
+    for (int i = 0; i < 4; i++) cell.x[i] = record[n++];
+    for (int i = 0; i < 4; i++) cell.s[i] = record[n++];
+    for (int i = 0; i < 4; i++) cell.u[i] = record[n++];
+    cell.epsilon_f            = record[n++];
+    cell.T_f                  = record[n++];
+    cell.mu_B                 = record[n++];
+    cell.eps_plus_p_over_T_FO = record[n++];
+    for (int i = 0; i < 4; i++)
+        for (int j = i; j < 4; j++) cell.W[i][j] = record[n++];
+    cell.pi_b  = (field_mask & SurfaceFileHeader::bulk) ? record[n++] : 0.;
+    cell.rho_B = (field_mask & SurfaceFileHeader::rhob) ? record[n++] : 0.;
+    for (int i = 0; i < 4; i++) {
+        cell.q[i] = (field_mask & SurfaceFileHeader::diff) ? record[n++] : 0.;
+    }
+}
+
+}  // namespace
+
+
+SurfaceFileHeader surface_file_header(const InitData &DATA, double epsFO) {
+    SurfaceFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, surface_magic, sizeof(header.magic));
+    header.version         = surface_version;
+    header.value_bytes     = (DATA.freeze_surface_double_precision ? 8 : 4);
+    header.field_mask      = surface_field_mask(DATA);
+    header.n_fields        = surface_n_fields(header.field_mask);
+    header.n_elements      = 0;
+    header.boost_invariant = DATA.boost_invariant;
+    header.nx              = DATA.nx;
+    header.ny              = DATA.ny;
+    header.neta            = DATA.neta;
+    header.delta_x         = DATA.delta_x;
+    header.delta_y         = DATA.delta_y;
+    header.delta_eta       = DATA.delta_eta;
+    header.epsFO           = epsFO;
+    return(header);
+}
+
+
+std::vector<double> freeze_out_thresholds(const InitData &DATA) {
+    std::vector<double> epsFO_list;
+    if (DATA.freeze_eps_flag == 0) {
+        // constant spacing the energy density
+        const int n_freeze_surf = DATA.N_freeze_out;
+        const double d_epsFO = ((DATA.eps_freeze_max - DATA.eps_freeze_min)
+                                /(n_freeze_surf - 1 + 1e-15));
+        for (int isurf = 0; isurf < n_freeze_surf; isurf++)
+            epsFO_list.push_back(DATA.eps_freeze_min + isurf*d_epsFO);
+    } else if (DATA.freeze_eps_flag == 1) {
+        // read in from a file
+        pretty_ostream music_message;
+        std::ifstream freeze_list_file(DATA.freeze_list_filename.c_str());
+        if (!freeze_list_file) {
+            music_message << "can not open freeze-out list file: "
+                          << DATA.freeze_list_filename;
+            music_message.flush("error");
+            exit(1);
+        }
+        std::string dummy;
+        double temp_epsFO, dummyd;
+        std::getline(freeze_list_file, dummy);  // get rid of the comment
+        while (1) {
+            freeze_list_file >> temp_epsFO >> dummyd >> dummyd
+                             >> dummyd >> dummyd >> dummyd >> dummyd;
+            if (freeze_list_file.eof()) break;
+            epsFO_list.push_back(temp_epsFO);
+        }
+    } else {
+        pretty_ostream music_message;
+        music_message << "unrecoginze freeze_eps_flag = "
+                      << DATA.freeze_eps_flag;
+        music_message.flush("error");
+        exit(1);
+    }
+    return(epsFO_list);
+}
+
+
+std::string surface_file_name(const InitData &DATA,
+                              const std::vector<double> &epsFO_list,
+                              int i_freezesurf, int file_id) {
+    std::ostringstream filename;
+    filename << DATA.output_dir << "surface";
+    if (epsFO_list.size() > 1) {
+        filename << "_eps_" << epsFO_list[i_freezesurf];
+        if (file_id >= 0) filename << "_";
+    }
+    if (file_id >= 0) filename << file_id;
+    filename << ".dat";
+    return(filename.str());
+}
+
+
+void write_surface_element(std::ostream &s_file, const SurfaceElement &cell,
+                           const InitData &DATA) {
+    if (DATA.freeze_surface_in_binary) {
+        const int field_mask = surface_field_mask(DATA);
+        if (DATA.freeze_surface_double_precision) {
+            double record[all_fields];
+            const int n = pack_surface_element(cell, field_mask, record);
+            s_file.write(reinterpret_cast<const char*>(record),
+                         n*sizeof(double));
+        } else {
+            float record[all_fields];
+            const int n = pack_surface_element(cell, field_mask, record);
+            s_file.write(reinterpret_cast<const char*>(record),
+                         n*sizeof(float));
+        }
+    } else {
+        s_file << std::scientific << std::setprecision(10)
+               << cell.x[0] << " " << cell.x[1] << " "
+               << cell.x[2] << " " << cell.x[3] << " "
+               << cell.s[0] << " " << cell.s[1] << " "
+               << cell.s[2] << " " << cell.s[3] << " "
+               << cell.u[0] << " " << cell.u[1] << " "
+               << cell.u[2] << " " << cell.u[3] << " "
+               << cell.epsilon_f << " " << cell.T_f << " " << cell.mu_B << " "
+               << cell.eps_plus_p_over_T_FO << " "
+               << cell.W[0][0] << " " << cell.W[0][1] << " "
+               << cell.W[0][2] << " " << cell.W[0][3] << " "
+               << cell.W[1][1] << " " << cell.W[1][2] << " "
+               << cell.W[1][3] << " "
+               << cell.W[2][2] << " " << cell.W[2][3] << " "
+               << cell.W[3][3] << " ";
+        if (DATA.turn_on_bulk)   // 27th column
+            s_file << cell.pi_b << " ";
+        if (DATA.turn_on_rhob)   // 28th column
+            s_file << cell.rho_B << " ";
+        if (DATA.turn_on_diff)   // 29-32th column
+            s_file << cell.q[0] << " " << cell.q[1] << " "
+                   << cell.q[2] << " " << cell.q[3] << " ";
+        s_file << std::endl;
+    }
+}
+
+
+std::vector<SurfaceElement> read_binary_surface_file(
+                                        const std::string &filename) {
+    pretty_ostream music_message;
+    std::vector<SurfaceElement> surface;
+    const int fd = open(filename.c_str(), O_RDONLY);
+    struct stat file_stat;
+    if (fd < 0 || fstat(fd, &file_stat) != 0) {
+        music_message << "Can not open the surface file " << filename;
+        music_message.flush("error");
+        exit(1);
+    }
+    const int64_t size = file_stat.st_size;
+    if (size == 0) {
+        close(fd);
+        return(surface);
+    }
+    void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        music_message << "Can not map the surface file " << filename;
+        music_message.flush("error");
+        exit(1);
+    }
+    const char *bytes = static_cast<const char*>(mapped);
+
+    SurfaceFileHeader header;
+    int64_t offset = sizeof(header);
+    if (size >= offset
+            && std::memcmp(bytes, surface_magic, sizeof(surface_magic)) == 0) {
+        std::memcpy(&header, bytes, sizeof(header));
+        if (header.version != surface_version
+                || (header.value_bytes != 4 && header.value_bytes != 8)
+                || header.n_fields != surface_n_fields(header.field_mask)
+                || size < offset + header.n_elements*header.record_bytes()) {
+            music_message << filename << " is not a surface file of version "
+                          << surface_version << " or it is cut short.";
+            music_message.flush("error");
+            exit(1);
+        }
+    } else {
+        header.value_bytes = 4;
+        header.field_mask  = (SurfaceFileHeader::bulk | SurfaceFileHeader::rhob
+                              | SurfaceFileHeader::diff);
+        header.n_fields    = all_fields;
+        header.n_elements  = size/header.record_bytes();
+        offset = 0;
+    }
+
+    surface.resize(header.n_elements);
+    for (int64_t i = 0; i < header.n_elements; i++) {
+        const char *record = bytes + offset + i*header.record_bytes();
+        if (header.value_bytes == 8) {
+            unpack_surface_element<double>(record, header.field_mask,
+                                           surface[i]);
+        } else {
+            unpack_surface_element<float>(record, header.field_mask,
+                                          surface[i]);
+        }
+    }
+    munmap(mapped, size);
+    return(surface);
+}
+
+
+const std::streamoff SurfaceSink::buffer_size;
+
+
+SurfaceSink::SurfaceSink(const InitData &DATA_in, bool keep_in_memory_in) :
+    DATA(DATA_in), keep_in_memory(keep_in_memory_in) {}
+
+
+void SurfaceSink::open(const std::string &filename, double epsFO,
+                       bool with_header) {
+    file.open(filename.c_str(), std::ios::out | std::ios::binary);
+    n_elements = 0;
+    file_has_header = (with_header && DATA.freeze_surface_in_binary);
+    if (file_has_header) {
+        const SurfaceFileHeader header = surface_file_header(DATA, epsFO);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+}
+
+
+void SurfaceSink::add(const SurfaceElement &cell) {
+    if (DATA.freeze_surface_to_file) {
+        write_surface_element(buffer, cell, DATA);
+        n_elements++;
+        if (file.is_open() && buffer.tellp() >= buffer_size) flush();
+    }
+    if (keep_in_memory) cells.push_back(cell);
+}
+
+
+void SurfaceSink::append(SurfaceSink &other) {
+    if (DATA.freeze_surface_to_file) {
+        buffer << other.buffer.str();
+        other.buffer.str("");
+        n_elements += other.n_elements;
+        other.n_elements = 0;
+        if (file.is_open() && buffer.tellp() >= buffer_size) flush();
+    }
+    if (keep_in_memory) {
+        cells.insert(cells.end(), other.cells.begin(), other.cells.end());
+        other.cells.clear();
+    }
+}
+
+
+void SurfaceSink::flush() {
+    if (!file.is_open()) return;
+    const std::string block = buffer.str();
+    file.write(block.data(), block.size());
+    buffer.str("");
+}
+
+
+void SurfaceSink::close() {
+    flush();
+    if (!file.is_open()) return;
+    if (file_has_header) {
+        file.seekp(offsetof(SurfaceFileHeader, n_elements));
+        file.write(reinterpret_cast<const char*>(&n_elements),
+                   sizeof(n_elements));
+    }
+    file.close();
+}
+
+
+std::vector<SurfaceElement> SurfaceSink::take_cells() {
+    std::vector<SurfaceElement> taken;
+    taken.swap(cells);
+    return(taken);
+}
+
+
+namespace {
+
+SurfaceElement test_surface_element(double shift) {
+    SurfaceElement cell;
+    std::memset(&cell, 0, sizeof(cell));
+    for (int i = 0; i < 4; i++) {
+        cell.x[i] = 1.1 + i + shift;
+        cell.s[i] = 0.3*i - shift;
+        cell.u[i] = 1.0 + 0.01*i;
+        cell.q[i] = 1e-3*(i + 1);
+        for (int j = i; j < 4; j++) cell.W[i][j] = 0.1*i - 0.07*j + shift;
+    }
+    cell.epsilon_f            = 0.18 + shift;
+    cell.T_f                  = 0.15;
+    cell.mu_B                 = 0.01;
+    cell.eps_plus_p_over_T_FO = 1.6;
+    cell.pi_b                 = -0.02;
+    cell.rho_B                = 0.05;
+    return(cell);
+}
+
+}  // namespace
+
+TEST_CASE("binary surface files keep the fields of the run") {
+    InitData DATA;
+    DATA.freeze_surface_in_binary        = true;
+    DATA.freeze_surface_double_precision = true;
+    DATA.freeze_surface_to_file          = true;
+    DATA.turn_on_bulk = 1;
+    DATA.turn_on_rhob = 0;
+    DATA.turn_on_diff = 0;
+    DATA.boost_invariant = false;
+    DATA.nx = 4;
+    DATA.ny = 5;
+    DATA.neta = 6;
+    DATA.delta_x = DATA.delta_y = DATA.delta_eta = 0.1;
+
+    const std::string filename = "unittest_surface.dat";
+    SurfaceSink sink(DATA, false);
+    sink.open(filename, 0.18);
+    SurfaceSink piece(DATA, false);
+    piece.add(test_surface_element(0.));
+    piece.add(test_surface_element(0.5));
+    sink.append(piece);
+    sink.add(test_surface_element(1.));
+    sink.close();
+
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    SurfaceFileHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    CHECK(header.n_elements == 3);
+    CHECK(header.n_fields == 27);
+    CHECK(header.value_bytes == 8);
+    CHECK(header.neta == 6);
+    CHECK(header.epsFO == 0.18);
+    file.close();
+
+    const std::vector<SurfaceElement> surface = (
+                                    read_binary_surface_file(filename));
+    remove(filename.c_str());
+    REQUIRE(surface.size() == 3);
+    const SurfaceElement cell = test_surface_element(0.5);
+    for (int i = 0; i < 4; i++) {
+        CHECK(surface[1].x[i] == cell.x[i]);
+        CHECK(surface[1].s[i] == cell.s[i]);
+        CHECK(surface[1].W[i][3] == cell.W[i][3]);
+        CHECK(surface[1].q[i] == 0.);
+    }
+    CHECK(surface[1].pi_b == cell.pi_b);
+    CHECK(surface[1].rho_B == 0.);
+    CHECK(surface[2].epsilon_f == test_surface_element(1.).epsilon_f);
+}
+
+TEST_CASE("binary surface files without a header hold 32 floats") {
+    InitData DATA;
+    DATA.freeze_surface_in_binary        = true;
+    DATA.freeze_surface_double_precision = false;
+    DATA.turn_on_bulk = 1;
+    DATA.turn_on_rhob = 1;
+    DATA.turn_on_diff = 1;
+
+    const std::string filename = "unittest_surface_legacy.dat";
+    std::ofstream file(filename.c_str(), std::ios::binary);
+    write_surface_element(file, test_surface_element(0.), DATA);
+    write_surface_element(file, test_surface_element(0.25), DATA);
+    file.close();
+
+    const std::vector<SurfaceElement> surface = (
+                                    read_binary_surface_file(filename));
+    remove(filename.c_str());
+    REQUIRE(surface.size() == 2);
+    const SurfaceElement cell = test_surface_element(0.25);
+    CHECK(surface[1].x[0] == static_cast<float>(cell.x[0]));
+    CHECK(surface[1].q[3] == static_cast<float>(cell.q[3]));
+    CHECK(surface[1].rho_B == static_cast<float>(cell.rho_B));
+}
@@ -0,0 +1,120 @@
+#ifndef SRC_SURFACE_ELEMENT_H_
+#define SRC_SURFACE_ELEMENT_H_
+
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "data.h"
+
+//! One element of the freeze-out hyper-surface, as found by Evolve and
+//! integrated over by Freeze
+typedef struct surfaceElement {
+    double x[4];            // position in (tau, x, y, eta)
+    double sinh_eta_s;      // caching the sinh and cosh of eta_s
+    double cosh_eta_s;
+    double s[4];            // hypersurface vector in (tau, x, y, eta)
+    double u[4];            // flow velocity in (tau, x, y, eta)
+    double W[4][4];         // W^{\mu\nu}
+    double q[4];            // baryon diffusion current
+    double pi_b;            // bulk pressure
+    double rho_B;           // net baryon density
+
+    double epsilon_f;
+    double T_f;
+    double mu_B;
+    double eps_plus_p_over_T_FO;  // (energy_density+pressure)/temperature
+} SurfaceElement;
+
+//! Header of the binary surface files (freeze_surface_in_binary). It is
+//! followed by n_elements records of n_fields floats or doubles in the
+//! byte order of the machine: tau, x, y, eta, d^3sigma_mu, u^mu,
+//! epsilon_f, T_f, mu_B, (epsilon+P)/T, the 10 independent W^{mu nu},
+//! then pi_b, rho_B and q^mu when field_mask has their bits.
+struct SurfaceFileHeader {
+    enum Fields {bulk = 1, rhob = 2, diff = 4};
+
+    char magic[8];          // "MUSICSF"
+    int32_t version;
+    int32_t value_bytes;    // 4 (float) or 8 (double)
+    int32_t field_mask;
+    int32_t n_fields;
+    int64_t n_elements;
+    int32_t boost_invariant;
+    int32_t nx, ny, neta;
+    double delta_x, delta_y, delta_eta;
+    double epsFO;           // threshold of the surface in GeV/fm^3
+
+    int64_t record_bytes() const {return(int64_t(n_fields)*value_bytes);}
+};
+
+//! the header of the surface with threshold epsFO of a run with DATA,
+//! without elements yet
+SurfaceFileHeader surface_file_header(const InitData &DATA, double epsFO);
+
+//! the freeze-out energy densities in GeV/fm^3 of a run with DATA: the
+//! N_freeze_out ones from eps_freeze_min to eps_freeze_max, or the ones
+//! in freeze_list_filename (freeze_eps_flag = 1)
+std::vector<double> freeze_out_thresholds(const InitData &DATA);
+
+//! surface.dat, or surface_eps_<epsFO>.dat for each of several
+//! thresholds in epsFO_list; file_id >= 0 names the piece
+//! surface<file_id>.dat (surface_eps_<epsFO>_<file_id>.dat) of one rank
+//! instead
+std::string surface_file_name(const InitData &DATA,
+                              const std::vector<double> &epsFO_list,
+                              int i_freezesurf, int file_id = -1);
+
+//! appends cell to a surface file: one record of the binary format (see
+//! SurfaceFileHeader), or one line of text; pi_b, rho_B and q are only
+//! there when the run evolves them
+void write_surface_element(std::ostream &s_file, const SurfaceElement &cell,
+                           const InitData &DATA);
+
+//! the elements of the binary surface file filename; files without a
+//! header are read as records of 32 floats (the format before version 1)
+std::vector<SurfaceElement> read_binary_surface_file(
+                                        const std::string &filename);
+
+//! Destination of the surface elements found by one thread. They are
+//! formatted into a buffer that goes to the surface file in large blocks
+//! (if DATA.freeze_surface_to_file) and can also be kept in memory. The
+//! file stays open for the whole run.
+class SurfaceSink {
+ private:
+    const InitData &DATA;
+    const bool keep_in_memory;
+    std::ofstream file;
+    std::ostringstream buffer;
+    std::vector<SurfaceElement> cells;
+    //! elements of the file, counted for its header
+    int64_t n_elements = 0;
+    bool file_has_header = false;
+
+ public:
+    //! the buffer is written once it holds this many bytes
+    static const std::streamoff buffer_size = 1 << 22;
+
+    SurfaceSink(const InitData &DATA_in, bool keep_in_memory_in);
+
+    //! truncates filename and writes the buffer there from now on; a
+    //! sink without a file only collects the elements. Binary files
+    //! start with the header of the surface with threshold epsFO,
+    //! unless they are pieces that are merged later (with_header false)
+    void open(const std::string &filename, double epsFO,
+              bool with_header = true);
+    void add(const SurfaceElement &cell);
+    //! moves the elements of other behind the ones of this sink
+    void append(SurfaceSink &other);
+    //! writes the buffer to the file
+    void flush();
+    //! writes the rest of the buffer and the number of elements
+    void close();
+    //! the elements kept in memory, which the sink gives up
+    std::vector<SurfaceElement> take_cells();
+};
+
+#endif  // SRC_SURFACE_ELEMENT_H_
@@ -9,45 +9,62 @@
 U_derivative::U_derivative(const InitData &DATA_in, const EOS &eosIn) :
     DATA(DATA_in),
     eos(eosIn),
-    minmod(DATA_in) {
+    minmod(DATA_in),
+    n_directions(DATA_in.boost_invariant ? 2 : 3) {
+    // the eta column of dUsup stays zero for boost-invariant runs
     dUsup = {0.0};
 }
 
 //! This function is a shell function to calculate parital^\nu u^\mu
-void U_derivative::MakedU(double tau, SCGrid &arena_prev, SCGrid &arena_current,
-                          int ix, int iy, int ieta) {
+void U_derivative::MakedU(double tau, const CellStencil &stencil,
+                          SCGrid::const_reference grid_pt_prev,
+                          const ThermoCell &thermo_prev) {
     dUsup = {0.0};
 
     // this calculates du/dx, du/dy, (du/deta)/tau
-    MakeDSpatial(tau, arena_current, ix, iy, ieta);
+    MakeDSpatial(tau, stencil);
     // this calculates du/dtau
-    MakeDTau(tau, &arena_prev(ix, iy, ieta), &arena_current(ix, iy, ieta));
+    MakeDTau(tau, grid_pt_prev, stencil.centre(),
+             thermo_prev, stencil.thermo_centre());
 }
 
 
-//! this function returns the expansion rate on the grid
-double U_derivative::calculate_expansion_rate(
-        double tau, SCGrid &arena, int ieta, int ix, int iy) {
+void U_derivative::calculate_derivatives(double tau,
+                                         const CellStencil &stencil,
+                                         SCGrid::const_reference grid_pt_prev,
+                                         const ThermoCell &thermo_prev,
+                                         DerivativeCell &derivatives) {
+    MakedU(tau, stencil, grid_pt_prev, thermo_prev);
+    const FlowVec u = stencil.centre().u;
+    derivatives.theta = calculate_expansion_rate(tau, u);
+    calculate_Du_supmu(tau, u, derivatives.a);
+    calculate_velocity_shear_tensor(tau, u, derivatives.a, derivatives.sigma);
+    get_DmuMuBoverTVec(derivatives.DmuBoverT);
+}
+
+
+//! this function returns the expansion rate of a cell with flow u
+double U_derivative::calculate_expansion_rate(double tau, const FlowVec &u) {
     double partial_mu_u_supmu = 0.0;
     for (int mu = 0; mu < 4; mu++) {
         double gfac = (mu == 0 ? -1.0 : 1.0);
         // for expansion rate: theta
         partial_mu_u_supmu += dUsup[mu][mu]*gfac;
     }
-    double theta = partial_mu_u_supmu + arena(ix,iy,ieta).u[0]/tau;
+    double theta = partial_mu_u_supmu + u[0]/tau;
     return(theta);
 }
 
 
 //! this function returns Du^\mu
-void U_derivative::calculate_Du_supmu(double tau, SCGrid &arena, int ieta,
-                                      int ix, int iy, DumuVec &a) {
+void U_derivative::calculate_Du_supmu(double tau, const FlowVec &u,
+                                      DumuVec &a) {
     for (int mu = 0; mu <= 4; mu++) {
         double u_supnu_partial_nu_u_supmu = 0.0;
         for (int nu = 0; nu < 4; nu++) {
             double tfac = (nu==0 ? -1.0 : 1.0);
             u_supnu_partial_nu_u_supmu += (
-                tfac*arena(ix,iy,ieta).u[nu]
+                tfac*u[nu]
                 *dUsup[mu][nu]);
         }
         a[mu] = u_supnu_partial_nu_u_supmu;
@@ -57,16 +74,16 @@ void U_derivative::calculate_Du_supmu(double tau, SCGrid &arena, int ieta,
 
 //! This funciton returns the velocity shear tensor sigma^\mu\nu
 void U_derivative::calculate_velocity_shear_tensor(
-                double tau, SCGrid &arena, int ieta, int ix, int iy,
-                DumuVec &a_local, VelocityShearVec &sigma) {
-    FlowVec u_local = arena(ix, iy, ieta).u;
+                double tau, const FlowVec &u, DumuVec &a_local,
+                VelocityShearVec &sigma) {
+    const FlowVec &u_local = u;
     double dUsup_local[4][4];
     for (int i = 0; i < 4; i++) {
         for (int j = 0; j < 4; j++) {
             dUsup_local[i][j] = dUsup[i][j];
         }
     }
-    double theta_u_local = calculate_expansion_rate(tau, arena, ieta, ix, iy);
+    double theta_u_local = calculate_expansion_rate(tau, u_local);
     double gfac = 0.0;
     double sigma_local[4][4];
     for (int a = 1; a < 4; a++) {
@@ -128,8 +145,7 @@ void U_derivative::get_DmuMuBoverTVec(DmuMuBoverTVec &vec) {
 }
 
 
-int U_derivative::MakeDSpatial(double tau, SCGrid &arena,
-                               int ix, int iy, int ieta) {
+int U_derivative::MakeDSpatial(double tau, const CellStencil &stencil) {
     const double delta[4] = {
       0.0,
       DATA.delta_x,
@@ -138,15 +154,14 @@ int U_derivative::MakeDSpatial(double tau, SCGrid &arena,
     };  // taken care of the tau factor
 
     // calculate dUsup[m][n] = partial_n u_m
-    Neighbourloop(arena, ix, iy, ieta, NLAMBDAS{
+    for (int direction = 1; direction <= n_directions; direction++) {
         for (int m = 1; m <= 3; m++) {
-            const double f   = c.u[m];
-            const double fp1 = p1.u[m];
-            const double fm1 = m1.u[m];
-            const double g   = minmod.minmod_dx(fp1, f, fm1) / delta[direction];
-            dUsup[m][direction] = g;
+            dUsup[m][direction] = stencil.minmod_slope(minmod, direction,
+                        [m](SCGrid::const_reference cell) {return cell.u[m];}
+                    )/delta[direction];
         }
-    });
+    }
+    SCGrid::const_reference grid_pt = stencil.centre();
 
     /* for u[0], use u[0]u[0] = 1 + u[i]u[i] */
     /* u[0]_m = u[i]_m (u[i]/u[0]) */
@@ -155,9 +170,9 @@ int U_derivative::MakeDSpatial(double tau, SCGrid &arena,
         double f = 0.0;
         for (int m = 1; m <= 3; m++) {
             // (partial_n u^m) u[m]
-            f += dUsup[m][n]*(arena(ix, iy, ieta).u[m]);
+            f += dUsup[m][n]*(grid_pt.u[m]);
         }
-        f /= arena(ix, iy, ieta).u[0];
+        f /= grid_pt.u[0];
         dUsup[0][n] = f;
     }
 
@@ -166,32 +181,25 @@ int U_derivative::MakeDSpatial(double tau, SCGrid &arena,
     // dUsup[rk_flag][4][n] = partial_n (muB/T)
     // partial_x (muB/T) and partial_y (muB/T) first
     int m = 4;  // means (muB/T)
-    double rhob, eps, muB, T;
-    rhob = arena(ix, iy, ieta).rhob;
-    eps = arena(ix, iy, ieta).epsilon;
-    muB = eos.get_mu(eps, rhob);
-    T = eos.get_temperature(eps, rhob);
-    double f = muB/T;
-    Neighbourloop(arena, ix, iy, ieta, NLAMBDAS{
-        double fp1, fm1;
-        fp1 = ( eos.get_mu(p1.epsilon, p1.rhob)
-               /eos.get_temperature(p1.epsilon, p1.rhob));
-        fm1 = ( eos.get_mu(m1.epsilon, m1.rhob)
-               /eos.get_temperature(m1.epsilon, m1.rhob));
-        double g = minmod.minmod_dx(fp1, f, fm1)/delta[direction];
-        dUsup[m][direction] = g;
-    });
+    for (int direction = 1; direction <= n_directions; direction++) {
+        dUsup[m][direction] = stencil.thermo_minmod_slope(minmod, direction,
+                    [](const ThermoCell &cell) {return cell.muB/cell.T;}
+                )/delta[direction];
+    }
     return 1;
 }/* MakeDSpatial */
 
 int U_derivative::MakeDTau(double tau,
-                           Cell_small *grid_pt_prev, Cell_small *grid_pt) {
+                           SCGrid::const_reference grid_pt_prev,
+                           SCGrid::const_reference grid_pt,
+                           const ThermoCell &thermo_prev,
+                           const ThermoCell &thermo) {
     /* this makes dU[m][0] = partial^tau u^m */
     /* note the minus sign at the end because of g[0][0] = -1 */
     double f;
     for (int m = 1; m < 4; m++) {
         /* first order is more stable */
-        f = (grid_pt->u[m] - grid_pt_prev->u[m])/DATA.delta_tau;
+        f = (grid_pt.u[m] - grid_pt_prev.u[m])/DATA.delta_tau_backward;
         dUsup[m][0] = -f;  // g00 = -1
     }
 
@@ -203,27 +211,19 @@ int U_derivative::MakeDTau(double tau,
     f = 0.0;
     for (int m = 1; m < 4; m++) {
         /* (partial_0 u^m) u[m] */
-        f += dUsup[m][0]*(grid_pt->u[m]);
+        f += dUsup[m][0]*(grid_pt.u[m]);
     }
-    f /= grid_pt->u[0];
+    f /= grid_pt.u[0];
     dUsup[0][0] = f;
 
     // Sangyong Nov 18 2014
     // Here we make the time derivative of (muB/T)
-    double tildemu, tildemu_prev, rhob, eps, muB, T;
+    double tildemu, tildemu_prev;
     int m = 4;
     // first order is more stable backward derivative
-    rhob         = grid_pt->rhob;
-    eps          = grid_pt->epsilon;
-    muB          = eos.get_mu(eps, rhob);
-    T            = eos.get_temperature(eps, rhob);
-    tildemu      = muB/T;
-    rhob         = grid_pt_prev->rhob;
-    eps          = grid_pt_prev->epsilon;
-    muB          = eos.get_mu(eps, rhob);
-    T            = eos.get_temperature(eps, rhob);
-    tildemu_prev = muB/T;
-    f            = (tildemu - tildemu_prev)/(DATA.delta_tau);
+    tildemu      = thermo.muB/thermo.T;
+    tildemu_prev = thermo_prev.muB/thermo_prev.T;
+    f            = (tildemu - tildemu_prev)/(DATA.delta_tau_backward);
     dUsup[m][0]  = -f;  // g00 = -1
     return 1;
 }
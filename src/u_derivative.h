@@ -5,6 +5,7 @@
 #include "data.h"
 #include "cell.h"
 #include "grid.h"
+#include "cell_stencil.h"
 #include "data_struct.h"
 #include <string.h>
 #include <iostream>
@@ -15,29 +16,42 @@ class U_derivative {
      const EOS &eos;
      Minmod minmod;
      dUsupMat dUsup;
+     //! 2 for boost-invariant runs, whose eta gradients vanish
+     const int n_directions;
 
  public:
     U_derivative(const InitData &DATA_in, const EOS &eosIn);
-    void MakedU(double tau, SCGrid &arena_prev, SCGrid &arena_current,
-                int ix, int iy, int ieta);
-
-    //! this function returns the expansion rate on the grid
-    double calculate_expansion_rate(double tau, SCGrid &arena,
-                                    int ieta, int ix, int iy);
+    //! stencil holds the cell of arena_current with its neighbours and
+    //! their EOS output; grid_pt_prev and thermo_prev are the same cell
+    //! in arena_prev
+    void MakedU(double tau, const CellStencil &stencil,
+                SCGrid::const_reference grid_pt_prev,
+                const ThermoCell &thermo_prev);
+
+    //! theta, Du^mu, sigma^{mu nu} and D^mu(mu_B/T) of the cell in
+    //! stencil, from the same arguments as MakedU
+    void calculate_derivatives(double tau, const CellStencil &stencil,
+                               SCGrid::const_reference grid_pt_prev,
+                               const ThermoCell &thermo_prev,
+                               DerivativeCell &derivatives);
+
+    //! this function returns the expansion rate of a cell with flow u
+    double calculate_expansion_rate(double tau, const FlowVec &u);
 
     //! this function returns Du^\mu
-    void calculate_Du_supmu(double tau, SCGrid &arena, int ieta, int ix, int iy,
-                            DumuVec &a);
+    void calculate_Du_supmu(double tau, const FlowVec &u, DumuVec &a);
 
     //! this function returns the vector D^\mu(\mu_B/T)
     void get_DmuMuBoverTVec(DmuMuBoverTVec &vec);
 
     //! This funciton returns the velocity shear tensor sigma^\mu\nu
     void calculate_velocity_shear_tensor(
-        double tau, SCGrid &arena, int ieta, int ix, int iy,
-        DumuVec &a_local, VelocityShearVec &sigma);
-    int MakeDSpatial(double tau, SCGrid &arena, int ix, int iy, int ieta);
-    int MakeDTau(double tau, Cell_small *grid_pt_prev, Cell_small *grid_pt);
+        double tau, const FlowVec &u, DumuVec &a_local,
+        VelocityShearVec &sigma);
+    int MakeDSpatial(double tau, const CellStencil &stencil);
+    int MakeDTau(double tau, SCGrid::const_reference grid_pt_prev,
+                 SCGrid::const_reference grid_pt,
+                 const ThermoCell &thermo_prev, const ThermoCell &thermo);
 };
 
 #endif
@@ -50,7 +50,6 @@ namespace Util {
     
     int IsFile(std::string);
     
-    std::string StringFind4(std::string file_name, std::string str_in);
     
     double lin_int(double x1,double x2,double f1,double f2,double x);
 